@@ -20,6 +20,8 @@
 // Includes
 	#include <fstream>
 	#include <cmath>
+	#include <algorithm>
+	#include <vector>
 	#include "GLIPLib.hpp"
 	#include <GL/glfw.h>
 	#include <stdlib.h>
@@ -77,6 +79,7 @@
 				timeConv = 0.0,
 				timeMix  = 0.0,
 				timeFFT	 = 0.0,
+				timeFFTRadix2 = 0.0,
 				timeIFFT = 0.0;
 			int i=0;
 
@@ -145,6 +148,35 @@
 			Pipeline* fft2D = new Pipeline(GenerateFFT2DPipeline::generate(fmt.getWidth(), fmt.getHeight(), FFTModules::Shifted), "FFT2D");
 			Pipeline* ifft2D = new Pipeline(GenerateFFT2DPipeline::generate(fmt.getWidth(), fmt.getHeight(), FFTModules::Inversed | FFTModules::Shifted), "IFFT2D");
 
+			// Same transform with the original radix-2 passes, for comparison :
+			Pipeline* fft2DRadix2 = new Pipeline(GenerateFFT2DPipeline::generate(fmt.getWidth(), fmt.getHeight(), FFTModules::Shifted | FFTModules::Radix2), "FFT2DRadix2");
+
+			log << "Plan of the transform : " << std::endl;
+			log << FFTModules::getPlanDescription(GenerateFFT2DPipeline::getPlan(fmt.getWidth(), fmt.getHeight(), FFTModules::Shifted));
+
+			// Compare the results on the first input :
+			{
+				(*fft2D) << p1->out(0) << Pipeline::Process;
+				(*fft2DRadix2) << p1->out(0) << Pipeline::Process;
+
+				const int numValues = fmt.getWidth()*fmt.getHeight()*4;
+				float	*mixedRadix = new float[numValues],
+					*radix2 = new float[numValues];
+				fft2D->out().read(mixedRadix, GL_RGBA, GL_FLOAT);
+				fft2DRadix2->out().read(radix2, GL_RGBA, GL_FLOAT);
+
+				float maxError = 0.0f, maxValue = 0.0f;
+				for(int k=0; k<numValues; k+=4)
+				{
+					maxError = std::max(maxError, std::max(std::abs(mixedRadix[k]-radix2[k]), std::abs(mixedRadix[k+1]-radix2[k+1])));
+					maxValue = std::max(maxValue, radix2[k+2]);
+				}
+				log << "Maximum difference with the radix-2 FFT : " << maxError << " (maximum modulus : " << maxValue << ")" << std::endl;
+
+				delete[] mixedRadix;
+				delete[] radix2;
+			}
+
 			// Convolution :
 			LayoutLoader loader;
 			loader.addRequiredElement("format", fft2D->out().format());
@@ -160,6 +192,7 @@
 			mix.enablePerfsMonitoring();
 
 			fft2D->enablePerfsMonitoring();
+			fft2DRadix2->enablePerfsMonitoring();
 			ifft2D->enablePerfsMonitoring();
 
 			// Geometry : 
@@ -187,6 +220,8 @@
 					timeGOL += p1->getTotalTiming();
 					(*fft2D) << p1->out(0) << Pipeline::Process;
 					timeFFT += fft2D->getTotalTiming();
+					(*fft2DRadix2) << p1->out(0) << Pipeline::Process;
+					timeFFTRadix2 += fft2DRadix2->getTotalTiming();
 				}
 				else
 				{
@@ -194,6 +229,8 @@
 					timeGOL += p2->getTotalTiming();
 					(*fft2D) << p2->out(0) << Pipeline::Process;
 					timeFFT += fft2D->getTotalTiming();
+					(*fft2DRadix2) << p2->out(0) << Pipeline::Process;
+					timeFFTRadix2 += fft2DRadix2->getTotalTiming();
 				}
 
 				conv << fft2D->out() << Pipeline::Process;
@@ -235,11 +272,13 @@
 			log << "Mean duration for CONV    : " << timeConv/i << " ms" << std::endl;
 			log << "Mean duration for MIX     : " << timeMix/i << " ms" << std::endl;
 			log << "Mean duration for FFT2D   : " << timeFFT/i << " ms" << std::endl;
+			log << "Mean duration for FFT2D (radix-2) : " << timeFFTRadix2/i << " ms" << std::endl;
 			log << "Mean duration for IFFT2D   : " << timeIFFT/i << " ms" << std::endl;
 			log << "> End" << std::endl;
 			log.close();
 
 			delete ifft2D;
+			delete fft2DRadix2;
 			delete fft2D;
 			delete p1;
 			delete p2;
@@ -1,5 +1,7 @@
 // Include
     #include <iostream>
+    #include <cmath>
+    #include <algorithm>
     #include <QApplication>
     #include "GLIPLib.hpp"
     #include "WindowRendering.hpp"
@@ -9,6 +11,65 @@
     using namespace Glip::CoreGL;
     using namespace Glip::CorePipeline;
 
+// Compare the results of a chain of pointwise filters with and without fusion (see Pipeline::FusePointwiseFilters) :
+bool testFusion(void)
+{
+	HdlTextureFormat fmt(16, 16, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+
+	// The uniform variable has the name of a swizzle :
+	FilterLayout 	scale("Scale", fmt, ShaderSource(	"#version 130\n"
+								"uniform sampler2D inputTexture;\n"
+								"uniform float x;\n"
+								"out vec4 outputTexture;\n"
+								"void main()\n"
+								"{\n"
+								"	vec4 c = texelFetch(inputTexture, ivec2(gl_FragCoord.xy), 0);\n"
+								"	outputTexture = vec4(c.x * x, c.y, 0.0, 1.0);\n"
+								"}\n")),
+			offset("Offset", fmt, ShaderSource(	"#version 130\n"
+								"uniform sampler2D inputTexture;\n"
+								"out vec4 outputTexture;\n"
+								"void main()\n"
+								"{\n"
+								"	outputTexture = texelFetch(inputTexture, ivec2(gl_FragCoord.xy), 0) + vec4(0.5);\n"
+								"}\n"));
+
+	PipelineLayout layout("FusionTest");
+	layout.addInput("inputTexture");
+	layout.addOutput("outputTexture");
+	layout.add(scale, "Scale");
+	layout.add(offset, "Offset");
+	layout.connectToInput("inputTexture", "Scale", "inputTexture");
+	layout.connect("Scale", "outputTexture", "Offset", "inputTexture");
+	layout.connectToOutput("Offset", "outputTexture", "outputTexture");
+
+	std::vector<float> data(4*fmt.getWidth()*fmt.getHeight(), 0.5f);
+	HdlTexture input(fmt);
+	input.write(&data[0]);
+
+	Pipeline	unfused(layout, "Unfused"),
+			fused(layout, "Fused", Pipeline::FusePointwiseFilters);
+	std::cout << fused.getFusionReport();
+
+	std::vector<float> results[2];
+	Pipeline* pipelines[2] = {&unfused, &fused};
+	for(int k=0; k<2; k++)
+	{
+		(*pipelines[k])[pipelines[k]->getElementID("Scale")].program().setVar("x", GL_FLOAT, 0.62f);
+		(*pipelines[k]) << input << Pipeline::Process;
+
+		results[k].resize(data.size());
+		pipelines[k]->out(0).read(&results[k][0], GL_RGBA, GL_FLOAT);
+	}
+
+	float maxError = 0.0f;
+	for(unsigned int k=0; k<data.size(); k++)
+		maxError = std::max(maxError, std::abs(results[0][k] - results[1][k]));
+
+	std::cout << "Fusion : unfused " << results[0][0] << ", fused " << results[1][0] << ", maximum error " << maxError << std::endl;
+	return maxError<1e-6f;
+}
+
 int main(int argc, char** argv)
 {
     std::cout << "GLIP-Lib Test GL Context" << std::endl;
@@ -19,6 +80,9 @@ int main(int argc, char** argv)
 		QApplication app(argc,argv);
 		WindowRenderer window(640, 480);
 
+		if(!testFusion())
+			std::cout << "The fused pipeline does not match the original pipeline." << std::endl;
+
 		// Test : 
 		std::string test;
 		std::cout << "Type : " << std::endl;
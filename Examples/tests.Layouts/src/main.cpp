@@ -9,6 +9,7 @@
 // Namespaces
     using namespace Glip::CoreGL;
     using namespace Glip::CorePipeline;
+    using namespace Glip::Modules;
 
 int main(int argc, char** argv)
 {
@@ -25,7 +26,7 @@ int main(int argc, char** argv)
         ShaderSource src("./Filters/gradient2.glsl");
         FilterLayout fl("TestFilterLayout", fmt, src);
 
-        std::cout << "Type : " << fl.getTypeName() << std::endl;
+        std::cout << "Type : " << fl.getLayoutName() << std::endl;
         std::cout << "Input ports : " << std::endl;
         for(int i=0; i<fl.getNumInputPort(); i++)
             std::cout << "    <" << fl.getInputPortName(i) << '>' << std::endl;
@@ -58,7 +59,7 @@ int main(int argc, char** argv)
         //pl.connectToOutput("Test1", "red", "Output2"); Exception OK
         pl.connectToOutput("Test1", "green", "Output3");
 
-        std::cout << "Pipeline name : " << pl.getTypeName() << std::endl;
+        std::cout << "Pipeline name : " << pl.getLayoutName() << std::endl;
         std::cout << "Checking Pipeline Layout : " << std::endl;
         pl.check();
         std::cout << "Done... (*)" << std::endl;
@@ -99,8 +100,43 @@ int main(int argc, char** argv)
         std::cout << "Caught an exception : " << std::endl << e.what() << std::endl;
     }
 
+    // Load the scripts using the LayoutLoader keywords and modules, and build their pipelines (which requires a context) :
+    QGLWidget widget;
+    widget.makeCurrent();
+    HandleOpenGL::init();
+
+    const char* scripts[] = {   "./Filters/halo.ppl",
+                                "./Filters/computeFilter.ppl",
+                                "./Filters/instancedGrid.ppl",
+                                "./Filters/reduction.ppl",
+                                "./Filters/histogram.ppl",
+                                "./Filters/fftOptions.ppl" };
+    const int numScripts = sizeof(scripts)/sizeof(const char*);
+    int numFailures = 0;
+
+    for(int k=0; k<numScripts; k++)
+    {
+        try
+        {
+            LayoutLoader loader;
+            LayoutLoaderModule::addBasicModules(loader);
+
+            PipelineLayout layout = loader.getPipelineLayout(scripts[k]);
+            Pipeline pipeline(layout, "ScriptTest");
+
+            std::cout << "Script " << scripts[k] << " : " << pipeline.getNumInputPort() << " input(s), " << pipeline.getNumOutputPort() << " output(s), " << pipeline.getNumActions() << " action(s)." << std::endl;
+        }
+        catch(std::exception& e)
+        {
+            numFailures++;
+            std::cout << "Caught an exception while loading the script " << scripts[k] << " : " << std::endl << e.what() << std::endl;
+        }
+    }
+
+    std::cout << "Scripts : " << (numScripts-numFailures) << "/" << numScripts << " loaded." << std::endl;
+
     std::cout << "End Test Layouts" << std::endl;
 
-    return 0;
+    return (numFailures==0) ? 0 : 1;
 }
 
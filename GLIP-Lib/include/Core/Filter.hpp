@@ -41,6 +41,7 @@
 			class HdlProgram;
 			class HdlVBO;
 			class HdlFBO;
+			class HdlDynamicData;
 		}
 
 		namespace CorePipeline
@@ -70,9 +71,12 @@
 							dFactor,
 							blendingEquation,
 							depthTestingFunction;
+					int		halo;
+					std::string	haloVariable;
 
 					// Friends
 					friend class FilterLayout;
+					friend class ComputeFilterLayout;
 
 				protected :
 					// Tools
@@ -87,6 +91,7 @@
 
 					bool isStandardVertexSource(void) const;
 					bool isStandardGeometryModel(void) const;
+					bool isCompute(void) const;
 					int getNumUniformVars(void) const;
 					bool isClearingEnabled(void) const;
 					void enableClearing(void);
@@ -101,6 +106,10 @@
 					const GLenum& getDepthTestingFunction(void) const;
 					void enableDepthTesting(const GLenum& _depthTestingFunction = GL_LESS);
 					void disableDepthTesting(void);
+					int getHalo(void) const;
+					const std::string& getHaloVariable(void) const;
+					void setHalo(int _halo);
+					void setHalo(const std::string& variableName);
 			};
 
 			/**
@@ -117,6 +126,43 @@
 					FilterLayout(const std::string& type, const HdlAbstractTextureFormat& fout, const std::map<GLenum, ShaderSource*>& sources, GeometryModel* geometry = NULL);
 			};
 
+			/**
+			\class ComputeFilterLayout
+			\brief Layout of a filter running a compute shader instead of rendering a geometry.
+
+			The input ports are the samplers (uniform sampler2D) and the read only images (uniform readonly image2D) of the compute shader, the output ports are its other images. The outputs are bound as images with the format of the filter, which must be a sized format with 1, 2 or 4 channels (GL_RGBA32F, GL_R32UI, ..., see HdlTexture::getImageFormat), the same goes for the read only images. The work groups are dispatched over the outputs (or the region of interest, see Pipeline::setRegionOfInterest), with the size declared by the shader. The bottom-left corner of the region is given to the shader by the uniform variable named by ComputeFilterLayout::regionOriginName (ivec2, (0, 0) for the whole outputs); if the shader does not use it, the groups are dispatched from the corner of the outputs up to the region instead. The shader must check that its invocations are inside the output (imageSize) :
+			\code
+				#version 430
+				layout(local_size_x = 16, local_size_y = 16) in;
+
+				uniform sampler2D inputTexture;
+				layout(rgba32f) writeonly uniform image2D outputImage;
+				uniform ivec2 glipRegionOrigin;
+
+				void main()
+				{
+					const ivec2 p = glipRegionOrigin + ivec2(gl_GlobalInvocationID.xy);
+					if(any(greaterThanEqual(p, imageSize(outputImage))))
+						return;
+					imageStore(outputImage, p, texelFetch(inputTexture, p, 0));
+				}
+			\endcode
+
+			The filters are instantiated as Filter objects in a Pipeline, and mixed freely with the fragment filters. The Pipeline inserts the memory barriers needed before the actions reading the results of a compute filter. Clearing is disabled by default (see AbstractFilterLayout::enableClearing, needed for scattering filters such as histograms). Compute filters require OpenGL 4.3 or GL_ARB_compute_shader.
+			**/
+			class GLIP_API ComputeFilterLayout : public FilterLayout
+			{
+				private :
+					static std::map<GLenum, ShaderSource*> makeSources(const ShaderSource& computeSource);
+
+				public :
+					/// Name of the uniform variable (ivec2) receiving the bottom-left corner of the region computed.
+					static std::string regionOriginName;
+
+					// Tools
+					ComputeFilterLayout(const std::string& type, const HdlAbstractTextureFormat& fout, const ShaderSource& computeSource);
+			};
+
 			/**
 			\class Filter
 			\brief Filter object.
@@ -131,12 +177,23 @@
 					bool				firstRun,
 									broken;
 					std::vector<HdlTexture*>	arguments;
+					std::vector<HdlDynamicData*>	uniformsState;
+					unsigned int			uniformsVersion,
+									uniformsModifications;
+					int				region[4];
+					std::vector<bool>		imageInputs;
+					int				workGroupSize[3];
+					GLint				regionOriginLocation;
+
+					void acquireProgram(void);
+					void dispatch(HdlFBO& renderer);
 
 				protected :
 					// Tools
 					Filter(const AbstractFilterLayout&, const std::string& name);
 
 					void setInputForNextRendering(int id, HdlTexture* ptr);
+					void setRegionForNextRendering(int x=0, int y=0, int width=0, int height=0);
 					void process(HdlFBO& renderer);
 
 					// Friends
@@ -147,6 +204,9 @@
 					virtual ~Filter(void);
 
 					HdlProgram& program(void);
+					int getWorkGroupSize(int i) const;
+					unsigned int getUniformsVersion(void);
+					int getCurrentHalo(void);
 					bool wentThroughFirstRun(void) const;
 					bool isBroken(void) const;
 			};
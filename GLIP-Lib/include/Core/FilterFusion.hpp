@@ -0,0 +1,101 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : FilterFusion.hpp                                                                          */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Fusion of chains of pointwise filters into a single shader.                               */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    FilterFusion.hpp
+ * \brief   Fusion of chains of pointwise filters into a single shader.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __GLIPLIB_FILTER_FUSION__
+#define __GLIPLIB_FILTER_FUSION__
+
+	// Includes
+	#include <string>
+	#include <vector>
+	#include <set>
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+	#include "Core/ShaderSource.hpp"
+	#include "Core/Filter.hpp"
+
+	namespace Glip
+	{
+		namespace CorePipeline
+		{
+			// Fusion tools
+			/**
+			\class FilterFusion
+			\brief Analysis and generation tools for the fusion of chains of pointwise filters (see Pipeline::FusePointwiseFilters).
+
+			A filter can be fused with the filter reading its output if :
+			- both have a single fragment shader (standard vertex source and quad geometry) and do not use gl_FragColor/gl_FragData,
+			- the producer has a single output, is read by this consumer only, has no blending nor depth test, does not discard fragments and has the same size than the consumer,
+			- the output format of the producer has 1 to 4 normalized or floating point channels,
+			- the consumer only samples this input at the current fragment : <i>texture</i>, <i>texture2D</i>, <i>textureLod</i> or <i>texelFetch</i> (at level 0) with the coordinates gl_TexCoord[0].st, gl_FragCoord.xy/vec2(S) or ivec2(gl_FragCoord.xy), either directly or through a single-assignment local variable (S being the size of the texture, given by a literal, textureSize or a const ivec2 such as the ones generated by FORMAT_TO_CONSTANT).
+
+			The generated shader contains the sources of the chain, all their identifiers being prefixed, each main function called in turn. The samplings of the fused inputs are replaced by the output variable of the producer, converted as the intermediate texture would (missing channels and clamping of the normalized formats, the quantization is not emulated).
+			**/
+			class GLIP_API FilterFusion
+			{
+				private :
+					enum TokenKind
+					{
+						Blank,
+						Directive,
+						Identifier,
+						Number,
+						Symbol
+					};
+
+					struct Token
+					{
+						TokenKind	kind;
+						std::string	text;
+					};
+
+					struct Replacement
+					{
+						int		begin,
+								end;		// Last token, included.
+						std::string	text;
+					};
+
+					FilterFusion(void);
+
+					static void tokenize(const std::string& source, std::vector<Token>& tokens);
+					static bool isReserved(const std::string& word);
+					static int nextToken(const std::vector<Token>& tokens, int k);
+					static int previousToken(const std::vector<Token>& tokens, int k);
+					static int matchingParenthesis(const std::vector<Token>& tokens, int k);
+					static std::string compact(const std::vector<Token>& tokens, int begin, int end);
+					static bool isZero(const std::string& str);
+					static bool isSizeExpression(const std::vector<Token>& tokens, const std::string& expr, const std::string& samplerName, int width, int height);
+					static bool isFragmentCoordinates(const std::vector<Token>& tokens, const std::string& expr, const std::string& samplerName, int width, int height, bool integer, int depth);
+					static bool findSamplings(const std::vector<Token>& tokens, const std::string& samplerName, int width, int height, const std::string& value, std::vector<Replacement>& replacements, std::string& reason);
+					static std::string getConversion(const HdlAbstractTextureFormat& format, const std::string& value);
+
+				public :
+					static bool isFusable(const AbstractFilterLayout& layout, std::string& reason);
+					static bool canFuse(const AbstractFilterLayout& producer, const AbstractFilterLayout& consumer, int consumerPort, std::string& reason);
+					static ShaderSource generate(const std::vector<const AbstractFilterLayout*>& chain, const std::vector<int>& fusedPorts, const std::vector<std::string>& prefixes);
+			};
+		}
+	}
+
+#endif
+
@@ -0,0 +1,107 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : GLStateCache.hpp                                                                          */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Cache of the OpenGL state, filters redundant state changes.                               */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    GLStateCache.hpp
+ * \brief   Cache of the OpenGL state, filters redundant state changes.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __GLIPLIB_GL_STATE_CACHE__
+#define __GLIPLIB_GL_STATE_CACHE__
+
+	// Includes
+	#include <map>
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+
+	namespace Glip
+	{
+		namespace CoreGL
+		{
+			// State cache
+			/**
+			\class GLStateCache
+			\brief Tracks the bound program, framebuffer, textures, blending, depth testing, viewport, scissor test and clear color of the context.
+
+			The state is only tracked inside a scope (between GLStateCache::beginScope and GLStateCache::endScope, as done by Pipeline::process) : a call which would not change the current state is skipped. The state is considered unknown when the scope starts, and the default bindings are restored when it ends (no program, no framebuffer, no texture on the used units, blending, depth testing and scissor test disabled). Outside of a scope, every call is forwarded to OpenGL.
+
+			The cache assumes that all the changes made inside a scope are made through this class (or the Hdl* objects). Call GLStateCache::invalidate after changing the state directly.
+			**/
+			class GLIP_API GLStateCache
+			{
+				private :
+					static int			scopeDepth;
+					static bool			programKnown,
+									framebufferKnown,
+									activeUnitKnown,
+									blendingKnown,
+									depthTestingKnown,
+									viewportKnown,
+									scissorKnown,
+									clearColorKnown;
+					static GLuint			program,
+									framebuffer;
+					static GLenum			activeUnit;
+					static std::map<GLenum,GLuint>	textures;
+					static bool			blending,
+									depthTesting,
+									scissorTest;
+					static GLenum			sFactor,
+									dFactor,
+									blendingEquation,
+									depthTestingFunction;
+					static GLint			viewport[4],
+									scissorBox[4];
+					static GLfloat			clearColor[4];
+					static unsigned int		numIssuedCalls,
+									numSkippedCalls;
+
+					GLStateCache(void);
+
+					static bool count(bool issue);
+
+				public :
+					static void beginScope(void);
+					static void endScope(void);
+					static bool isActive(void);
+					static void invalidate(void);
+
+					static void useProgram(GLuint _program);
+					static void bindFramebuffer(GLuint _framebuffer);
+					static void activeTexture(GLenum unit);
+					static bool bindTexture(GLenum unit, GLuint texture);
+					static void bindTexture(GLuint texture);
+					static void setBlending(bool enabled, GLenum _sFactor = GL_ONE, GLenum _dFactor = GL_ZERO, GLenum _blendingEquation = GL_FUNC_ADD);
+					static void setDepthTesting(bool enabled, GLenum _depthTestingFunction = GL_LESS);
+					static void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+					static void setScissor(bool enabled, GLint x = 0, GLint y = 0, GLsizei width = 0, GLsizei height = 0);
+					static void setClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
+
+					static void forgetProgram(GLuint _program);
+					static void forgetFramebuffer(GLuint _framebuffer);
+					static void forgetTexture(GLuint texture);
+
+					static unsigned int getNumIssuedCalls(void);
+					static unsigned int getNumSkippedCalls(void);
+					static void resetCounters(void);
+			};
+		}
+	}
+
+#endif
+
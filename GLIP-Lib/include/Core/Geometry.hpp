@@ -63,6 +63,8 @@
 						PointsGrid2D,
 						/// 3D grid of dots.
 						PointsGrid3D,
+						/// 2D grid of dots, drawn as instances of a single row.
+						InstancedPointsGrid2D,
 						/// Unknown geometry type.
 						Unknown
 					};
@@ -72,6 +74,7 @@
 								normals,
 								texCoords;
 					std::vector<GLuint>	elements;
+					unsigned int		numInstances;
 
 				protected :
 					// Tools :
@@ -107,6 +110,7 @@
 					GLuint& c(GLuint i);
 					GLuint& d(GLuint i);
 					void generateNormals(void);
+					void setNumInstances(unsigned int n);
 
 				public :
 								/// Geometry Type.
@@ -129,6 +133,7 @@
 
 					unsigned int getNumVertices(void) const;
 					unsigned int getNumElements(void) const;
+					unsigned int getNumInstances(void) const;
 					const GLenum& getGLPrimitive(void) const;
 					const GLfloat& x(GLuint i) const;
 					const GLfloat& y(GLuint i) const;
@@ -233,6 +238,22 @@
 						PointsGrid3D(const PointsGrid3D& mdl);
 				};
 
+				/**
+				\class InstancedPointsGrid2D
+				\brief Geometry : a 2D grid of points, stored as a single row drawn once per line of the grid.
+
+				Only the first row of the grid is stored in the VBO (the vertex at the column j has the coordinates (j, 0)), the row is then drawn <i>height</i> times with instancing. The vertex shader finds the column of the point with gl_VertexID and its row with gl_InstanceID. The memory footprint is linear in the width of the grid instead of its area, which matters for the scatter passes covering a whole image (one point per pixel).
+				**/
+				class GLIP_API InstancedPointsGrid2D : public GeometryModel
+				{
+					public :
+						const int width,
+							  height;
+
+						InstancedPointsGrid2D(int w, int h);
+						InstancedPointsGrid2D(const InstancedPointsGrid2D& mdl);
+				};
+
 				/**
 				\class CustomModel
 				\brief Geometry : build a model.
@@ -26,6 +26,8 @@
 
 	// Includes
         #include <vector>
+	#include <list>
+	#include <set>
 	#include "Core/LibTools.hpp"
         #include "Core/HdlTexture.hpp"
         #include "Core/OglInclude.hpp"
@@ -81,7 +83,8 @@
 					GLuint				fboID;
 					bool				firstRendering;
 					HdlRenderBuffer*		depthBuffer;
-					bool				depthBufferAttached;
+					bool				depthBufferAttached,
+									scissorEnabled;
 
 					// Tools
 					void bindTextureToFBO(int i);
@@ -103,7 +106,7 @@
 					bool		hasDepthBuffer(void);
 					void		removeDepthBuffer(void);
 
-					void		beginRendering(int usedTarget=0, bool useExistingDepthBuffer=false);
+					void		beginRendering(int usedTarget=0, bool useExistingDepthBuffer=false, int viewportWidth=0, int viewportHeight=0, int scissorX=0, int scissorY=0, int scissorWidth=0, int scissorHeight=0);
 					void		endRendering(void);
 					void		bind(void);
 					HdlTexture* 	operator[](int i);
@@ -116,6 +119,47 @@
 					static int    getIndexFromAttachment(GLenum attachment);
 					static void   unbind(void);
 			};
+
+			// FBO Pool
+			/**
+			\class HdlFBOPool
+			\brief Shared pool of frame buffer objects (and their targets), indexed by format.
+
+			The Pipeline buffers cells lease their targets from this pool and return them when they are destroyed. The returned objects are kept idle, up to a high-water mark (in bytes), and given back to the next request with the same format and number of targets. This avoids allocating GPU memory again for pipelines which are created and destroyed repeatedly.
+
+			The default high-water mark is 0 : the pooling is opt-in and, until it is raised, the objects are deleted as soon as they are returned. The returned objects are reset to the state of a new object (no depth buffer, texture parameters of the format). The pool is global and assumes that all the objects belong to the same GL context; the idle objects must be released with HdlFBOPool::trim before the context is destroyed.
+			\code
+				// Keep up to 256MB of idle render targets :
+				HdlFBOPool::setHighWaterMark(256*1024*1024);
+
+				// ... create and destroy Pipeline objects ...
+
+				// Before destroying the context :
+				HdlFBOPool::trim();
+			\endcode
+			**/
+			class GLIP_API HdlFBOPool
+			{
+				private :
+					static std::list<HdlFBO*>	idleList;		// From the least recently returned to the most recently returned.
+					static std::set<HdlFBO*>	leasedSet;
+					static size_t			highWaterMark;
+					static size_t			idleMemory;
+					static int			numReused;
+
+					HdlFBOPool(void);
+
+				public :
+					static HdlFBO*	lease(const HdlAbstractTextureFormat& format, int numTargets = 1);
+					static bool	release(HdlFBO* fbo);
+					static void	trim(size_t maxIdleMemory = 0);
+					static void	setHighWaterMark(size_t bytes);
+					static size_t	getHighWaterMark(void);
+					static int	getNumIdle(void);
+					static size_t	getIdleMemory(void);
+					static int	getNumLeased(void);
+					static int	getNumReused(void);
+			};
 		}
 	}
 
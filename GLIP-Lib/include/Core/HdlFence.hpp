@@ -0,0 +1,86 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : HdlFence.hpp                                                                              */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : OpenGL Sync Object Handle                                                                 */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    HdlFence.hpp
+ * \brief   OpenGL Sync Object Handle (fences)
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __HDLFENCE_INCLUDE__
+#define __HDLFENCE_INCLUDE__
+
+	// GL include
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+
+	namespace Glip
+	{
+		namespace CoreGL
+		{
+			// Fence Handle
+			/**
+			\class HdlFence
+			\brief Object handle for an OpenGL fence (sync object), marking a point in the command stream.
+
+			The fence is signaled once the GPU has completed all the commands issued before HdlFence::insert. Inserting the fence again moves it to the current point of the command stream.
+			\code
+				myPipeline << input << Pipeline::Process;
+				fence.insert();
+
+				// ... Other work on the CPU ...
+
+				if(fence.isSignaled())
+					myPipeline.out(0).read(...);	// Will not stall.
+			\endcode
+
+			Without sync objects (before OpenGL 3.2 or OpenGL ES 3.0), the fence falls back to glFinish : the CPU waits for the GPU the first time the fence is tested.
+			**/
+			class GLIP_API HdlFence
+			{
+				private :
+					// Data
+					#if defined(GLIP_USE_GLES) || defined(GLIP_USE_GLES2)
+					void*		sync;		// Sync objects are not available.
+					#else
+					GLsync		sync;
+					#endif
+					bool		pending;
+
+					// No copy :
+					HdlFence(const HdlFence&);
+					const HdlFence& operator=(const HdlFence&);
+
+				public :
+					// Tools
+					HdlFence(void);
+					~HdlFence(void);
+
+					void insert(void);
+					void release(void);
+					bool isPending(void) const;
+					bool isSignaled(void);
+					bool wait(double timeout = -1.0);
+
+					// Static tools
+					static bool isSupported(void);
+			};
+		}
+	}
+
+#endif
+
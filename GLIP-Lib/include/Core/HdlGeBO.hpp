@@ -25,8 +25,10 @@
 #define __HDLGEBO_INCLUDE__
 
 	// GL include
+	#include <deque>
 	#include "Core/LibTools.hpp"
         #include "Core/OglInclude.hpp"
+	#include "Core/HdlFence.hpp"
 
 	namespace Glip
 	{
@@ -36,6 +38,19 @@
 			/**
 			\class HdlGeBO
 			\brief Object handle for OpenGL Buffer Object (VBO, PBO, VAO, ...).
+
+			A buffer can be created with a persistent mapping (OpenGL 4.4 or GL_ARB_buffer_storage, see HdlGeBO::isPersistentMappingSupported) : its storage is immutable and stays mapped, coherently, for the lifetime of the object. HdlGeBO::map then only binds the buffer and returns the persistent pointer, and HdlGeBO::write / HdlGeBO::subWrite copy directly to it. The storage cannot be orphaned, the host must not overwrite data which the GPU has not consumed yet. The regions of the buffer can be sub-allocated as a ring, with fences protecting the regions in use :
+			\code
+				HdlGeBO buffer(4*frameSize, GL_PIXEL_UNPACK_BUFFER, GL_STREAM_DRAW, true);
+
+				// For each frame :
+				GLintptr offset = buffer.allocateRegion(frameSize);	// Waits if the GPU still uses this part of the buffer.
+				std::memcpy(reinterpret_cast<char*>(buffer.getPersistentPointer()) + offset, frame, frameSize);
+				buffer.bind();
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, reinterpret_cast<GLvoid*>(offset));
+				HdlGeBO::unbind(GL_PIXEL_UNPACK_BUFFER);
+				buffer.fenceRegions();					// Protect the regions used by the commands above.
+			\endcode
 			**/
 			class GLIP_API HdlGeBO
 			{
@@ -45,6 +60,19 @@
 					GLenum		buildTarget,
 							buildUsage;
 					GLsizeiptr 	size;
+					bool		persistent;
+					void*		persistentPtr;
+
+					struct Region
+					{
+						GLintptr	offset;
+						GLsizeiptr	size;
+						HdlFence*	fence;
+					};
+
+					GLintptr		head;
+					std::deque<Region>	regions;
+
 					static bool 	binding[4];
 					static bool 	mapping[4];	// VS/CL will complain if these two are not splitted.
 
@@ -56,7 +84,7 @@
 
 				public :
 					// Tools
-					HdlGeBO(GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage);
+					HdlGeBO(GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage, bool _persistent = false);
 					HdlGeBO(GLuint id, GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage);
 					~HdlGeBO(void);
 
@@ -68,12 +96,17 @@
 					void* map(GLenum access = GL_NONE, GLenum target = GL_NONE);
 					void write(const void* data);
 					void subWrite(const void* data, GLsizeiptr size, GLintptr offset);
+					bool isPersistent(void) const;
+					void* getPersistentPointer(void);
+					GLintptr allocateRegion(GLsizeiptr regionSize, GLsizeiptr alignment = 4);
+					void fenceRegions(void);
 
 					// Static tools
 					static void unbind(GLenum target);
 					static void unmap(GLenum target);
 					static bool isBound(GLenum target);
 					static bool isMapped(GLenum target);
+					static bool isPersistentMappingSupported(void);
 			};
 
 			/*
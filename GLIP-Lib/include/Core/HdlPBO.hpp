@@ -80,8 +80,8 @@ For reading operations, use Glip::Modules::PBOTextureReader.
 
 				public :
 					// Tools
-					HdlPBO(int _w, int _h, int _c, int _cs, GLenum aim, GLenum freq, int size=-1);
-					HdlPBO(const HdlAbstractTextureFormat& fmt, GLenum aim, GLenum freq);
+					HdlPBO(int _w, int _h, int _c, int _cs, GLenum aim, GLenum freq, int size=-1, bool persistent=false);
+					HdlPBO(const HdlAbstractTextureFormat& fmt, GLenum aim, GLenum freq, bool persistent=false);
 					~HdlPBO(void);
 
 					int  getWidth(void);
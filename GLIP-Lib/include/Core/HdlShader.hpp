@@ -31,6 +31,7 @@
 	#include "Core/HdlDynamicData.hpp"
 	#include <string>
         #include <fstream>
+	#include <map>
 
 namespace Glip
 {
@@ -61,12 +62,33 @@ namespace Glip
 		/**
 		\class HdlProgram
 		\brief Object handle for OpenGL Program (A vertex and a fragment program).
+
+		The locations of the uniform variables are resolved once and cached by the program (the cache is cleared by HdlProgram::link). A HdlProgram::UniformHandle can be obtained with HdlProgram::getUniformHandle in order to skip the name lookup entirely. When the driver supports it (OpenGL 4.1 or ARB_separate_shader_objects), the uniforms are written with glProgramUniform* and the program does not need to be bound.
 		**/
 		class GLIP_API HdlProgram
 		{
 			public :
 				static const int numShaderTypes = 6; 
 
+				/**
+				\struct UniformHandle
+				\brief Pre-resolved location and type of a uniform variable, see HdlProgram::getUniformHandle. A handle is only valid for the link of the program it was obtained from.
+				**/
+				struct GLIP_API UniformHandle
+				{
+					/// Name of the variable.
+					std::string	name;
+					/// Location of the variable in the program.
+					GLint		location;
+					/// Type of the variable (as reported by glGetActiveUniform).
+					GLenum		type;
+					/// Link generation of the program when the handle was created.
+					unsigned int	generation;
+
+					UniformHandle(void);
+					bool isValid(void) const;
+				};
+
 			private :
 				// Data
 				bool 				valid;
@@ -75,6 +97,16 @@ namespace Glip
 								attachedFragmentShader;
 				std::vector<std::string>	activeUniforms;
 				std::vector<GLenum>		activeTypes;
+				std::map<std::string, GLint>	locations;
+				unsigned int			generation,
+								modifications;
+
+				void checkHandle(const UniformHandle& handle) const;
+				void writeUniform(const std::string& varName, GLint loc, GLenum t, const GLint* v);
+				void writeUniform(const std::string& varName, GLint loc, GLenum t, const GLuint* v);
+				void writeUniform(const std::string& varName, GLint loc, GLenum t, const GLfloat* v);
+				void writeUniform(const std::string& varName, GLint loc, const HdlDynamicData& data);
+				void updateActiveUniforms(void);
 
 			public :
 				// Functions
@@ -85,9 +117,13 @@ namespace Glip
 				void updateShader(const HdlShader& shader, bool linkNow = true);
 				void link(void);
 				void use(void);
+				bool getBinary(GLenum& format, std::vector<char>& binary) const;
+				bool loadBinary(GLenum format, const std::vector<char>& binary);
+				bool getWorkGroupSize(int& x, int& y, int& z) const;
 
 				const std::vector<std::string>& getUniformsNames(void) const;
 				const std::vector<GLenum>& getUniformsTypes(void) const;
+				unsigned int getModificationsCount(void) const;
 
 				void setFragmentLocation(const std::string& fragName, int frag);
 				void setVar(const std::string& varName, GLenum type, int v0, int v1=0, int v2=0, int v3=0);
@@ -98,16 +134,123 @@ namespace Glip
 				void setVar(const std::string& varName, GLenum type, float* v);
 				void setVar(const std::string& varName, const HdlDynamicData& data);
 
+				GLint getUniformLocation(const std::string& varName);
+				UniformHandle getUniformHandle(const std::string& varName, GLenum type = GL_NONE);
+				void setVar(const UniformHandle& handle, int v0, int v1=0, int v2=0, int v3=0);
+				void setVar(const UniformHandle& handle, const int* v);
+				void setVar(const UniformHandle& handle, unsigned int v0, unsigned int v1=0, unsigned int v2=0, unsigned int v3=0);
+				void setVar(const UniformHandle& handle, const unsigned int* v);
+				void setVar(const UniformHandle& handle, float v0, float v1=0, float v2=0, float v3=0);
+				void setVar(const UniformHandle& handle, const float* v);
+				void setVar(const UniformHandle& handle, const HdlDynamicData& data);
+
 				void getVar(const std::string& varName, int* ptr);
 				void getVar(const std::string& varName, unsigned int* ptr);
 				void getVar(const std::string& varName, float* ptr);
 				void getVar(const std::string& varName, HdlDynamicData& data);
 
 				bool isUniformVariableValid(const std::string& varName);
+				void saveUniforms(std::vector<HdlDynamicData*>& state);
+				void restoreUniforms(const std::vector<HdlDynamicData*>& state);
 	
 				// Static tools :
 				static int maxVaryingVar(void);
 				static void stopProgram(void);
+				static bool isDirectUniformAccessAvailable(void);
+		};
+
+		// Shared programs registry
+		/**
+		\class HdlProgramRegistry
+		\brief Context-wide, reference counted, registry of the linked programs, indexed by the content of their sources.
+
+		The filters built from identical sources (for instance the same layout instantiated in several pipelines) share a single program and its shaders. Each filter keeps its own copy of the uniform variables : the filter currently owning the program is recorded here and the variables are saved/restored (see HdlProgram::saveUniforms and HdlProgram::restoreUniforms) when another filter uses the program. The variables of double precision types are not saved.
+
+		The registry is disabled by default (saving and restoring the variables has a cost on each switch between two filters sharing a program, which is only worth it when the pipelines contain many identical filters). It only affects the filters created after a change of HdlProgramRegistry::setEnabled.
+		**/
+		class GLIP_API HdlProgramRegistry
+		{
+			private :
+				struct Entry
+				{
+					std::string			key;
+					std::vector<HdlShader*>		shaders;
+					int				numUsers;
+					const void*			owner;
+					std::vector<HdlDynamicData*>	defaultState;
+				};
+
+				static bool					enabled;
+				static std::map<std::string, HdlProgram*>	programs;
+				static std::map<const HdlProgram*, Entry>	entries;
+				static int					numReused;
+
+				HdlProgramRegistry(void);
+
+				static Entry& getEntry(const HdlProgram* program, const std::string& functionName);
+
+			public :
+				static void setEnabled(bool _enabled);
+				static bool isEnabled(void);
+
+				static HdlProgram* acquire(const std::string& key);
+				static void add(const std::string& key, HdlProgram* program, const std::vector<HdlShader*>& shaders, const void* owner);
+				static void release(const HdlProgram* program, const void* user);
+				static bool isRegistered(const HdlProgram* program);
+				static int getNumUsers(const HdlProgram* program);
+				static const void* getOwner(const HdlProgram* program);
+				static void setOwner(const HdlProgram* program, const void* owner);
+				static const std::vector<HdlDynamicData*>& getDefaultState(const HdlProgram* program);
+
+				static int getNumPrograms(void);
+				static int getNumReused(void);
+		};
+
+		// Program binary cache
+		/**
+		\class HdlProgramCache
+		\brief Opt-in on-disk cache of the linked programs binaries (glGetProgramBinary/glProgramBinary).
+
+		The cache is disabled by default. Once enabled, the filters look for the binary of their program before compiling the shaders. The binaries are stored in the given directory (which must exist), in files named after a hash of the key. The key contains the vendor, renderer, OpenGL and GLSL versions strings and the full text of the shaders sources (including the definitions they contain), the complete key is also saved in the file and compared on load.
+
+		When the driver rejects a binary (for instance after an update), the program is compiled from the sources and the entry is replaced.
+		\code
+			HdlProgramCache::enable("./cache");
+
+			// ... build the pipelines ...
+
+			std::cout << "Hits : " << HdlProgramCache::getNumHits() << ", misses : " << HdlProgramCache::getNumMisses() << std::endl;
+		\endcode
+		**/
+		class GLIP_API HdlProgramCache
+		{
+			private :
+				static std::string	directory;
+				static int		numHits,
+							numMisses,
+							numRejected,
+							numStored;
+
+				HdlProgramCache(void);
+
+				static std::string getFullKey(const std::string& key);
+				static std::string getFilename(const std::string& fullKey);
+
+			public :
+				static void enable(const std::string& _directory);
+				static void disable(void);
+				static bool isEnabled(void);
+				static const std::string& getDirectory(void);
+				static bool isSupported(void);
+
+				static bool load(const std::string& key, HdlProgram& program);
+				static bool store(const std::string& key, const HdlProgram& program);
+
+				static int getNumHits(void);
+				static int getNumMisses(void);
+				static int getNumRejected(void);
+				static int getNumStored(void);
+				static void resetStatistics(void);
 		};
 	}
 }
@@ -134,16 +134,22 @@
 			/**
 			\class HdlTexture
 			\brief Object handle for OpenGL textures.
+
+			When immutable storage is available (OpenGL 4.2 or GL_ARB_texture_storage) and the format has a sized equivalent, the storage of the texture and of its mipmaps is allocated once with glTexStorage2D at construction (see HdlTexture::isImmutable). HdlTexture::write then only updates the content of this storage. Otherwise, the storage is (re)defined by each call to HdlTexture::write.
 			**/
 			class GLIP_API HdlTexture : public HdlAbstractTextureFormat
 			{
 				private :
 					// Data
 					GLuint texID;
-					bool proxy;
+					bool proxy,
+					     immutable,
+					     allocated;
+					unsigned int generation;
 
 					// Functions
 					HdlTexture(const HdlTexture&); // No-copy
+					void	checkRegion(const std::string& caller, int x, int y, int w, int h, int level) const;
 
 				public :
 					// Functions
@@ -153,13 +159,20 @@
 
 					GLuint	getID(void) const;
 					bool	isProxy(void) const;
+					bool	isImmutable(void) const;
+					bool	isAllocated(void) const;
+					void	allocate(void);
+					unsigned int getGeneration(void) const;
+					void	touch(void);
 					int	getSizeOnGPU(int m=0);
 					void	bind(GLenum unit=GL_TEXTURE0); // previously GL_TEXTURE0_ARB, for GLES compatibility.
 					void	bind(int unit);
 					void	write(GLvoid *texData, GLenum pixelFormat = GL_ZERO, GLenum pixelDepth = GL_ZERO, int alignment=-1);
 					void	writeCompressed(GLvoid *texData, int size, GLenum pixelFormat = GL_ZERO, GLenum pixelDepth = GL_ZERO, int alignment=-1);
+					void	writeRegion(const GLvoid *texData, int x, int y, int w, int h, int level = 0, GLenum pixelFormat = GL_ZERO, GLenum pixelDepth = GL_ZERO, int alignment=-1);
 					void	fill(char dataByte);
 					void	read(GLvoid *data, GLenum pixelFormat = GL_ZERO, GLenum pixelDepth = GL_ZERO, int alignment=-1);
+					void	readRegion(GLvoid *data, int x, int y, int w, int h, int level = 0, GLenum pixelFormat = GL_ZERO, GLenum pixelDepth = GL_ZERO, int alignment=-1);
 					GLenum	getInternalMode(void);
 					bool	checkForConsistency(bool verbose = false);
 					void	setMinFilter(GLenum mf);
@@ -174,6 +187,8 @@
 					static void unbind(GLenum unit=GL_TEXTURE0); // previously GL_TEXTURE0_ARB, for GLES compatibility.
 					static void unbind(int unit);
 					static int  getMaxImageUnits(void);
+					static GLenum getSizedMode(GLenum mode);
+					static GLenum getImageFormat(GLenum mode);
 			};
 		}
 	}
@@ -45,7 +45,8 @@
 						nElements,
 						dim,
 						nIndPerElement,
-						dimTexCoords;
+						dimTexCoords,
+						nInstances;
 					bool	hasNormals;
 					HdlGeBO *vertices,
 						*elements;
@@ -55,12 +56,13 @@
 					GLenum 	type;
 
 				public :
-					HdlVBO(int _nVert, int _dim, GLenum freq, const GLfloat* _vertices, int _nElements=0, int _nIndPerElement=0, const GLuint* _elements=NULL, GLenum _type=GL_POINTS, const GLfloat* _normals=NULL, int _dimTexCoords=0, const GLfloat* _texcoords=NULL);
+					HdlVBO(int _nVert, int _dim, GLenum freq, const GLfloat* _vertices, int _nElements=0, int _nIndPerElement=0, const GLuint* _elements=NULL, GLenum _type=GL_POINTS, const GLfloat* _normals=NULL, int _dimTexCoords=0, const GLfloat* _texcoords=NULL, int _nInstances=1);
 					~HdlVBO(void);
 
 					int    getVerticesCount(void);
 					int    getShapeDimension(void);
 					int    getElementsCount(void);
+					int    getInstancesCount(void);
 					GLenum getType(void);
 					void   draw(void);
 
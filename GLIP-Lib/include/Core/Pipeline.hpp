@@ -32,6 +32,7 @@
 	#include "Core/LibTools.hpp"
         #include "Core/Component.hpp"
         #include "Core/Filter.hpp"
+	#include "Core/HdlFence.hpp"
 
 	namespace Glip
 	{
@@ -44,6 +45,7 @@
 			class ShaderSource;
 			class HdlShader;
 			class HdlProgram;
+			class HdlDynamicData;
 		}
 
 		namespace CorePipeline
@@ -257,6 +259,41 @@ the buffers cell which represents the needed buffers for one full computation. A
 		}
 	}
 \endcode
+
+Partial execution : the filters which do not contribute to any output are never processed. If only some of the outputs are needed, declare them and only the filters they depend on will be processed :
+\code
+	std::vector<int> outputs;
+	outputs.push_back(myPipeline.getOutputPortID("preview"));
+	myPipeline.setActiveOutputs(outputs);
+
+	myPipeline << input1 << input2 << ... << Pipeline::Process;	// The other outputs are not updated.
+
+	myPipeline.setAllOutputsActive();				// Back to the default behavior.
+\endcode
+
+Region of interest : if only a rectangle of the outputs is needed, declare it and the filters will only render the part of their outputs it depends on. The region is propagated from the outputs to the inputs, expanded by the halo declared by each filter (see AbstractFilterLayout::setHalo, the filters without declaration need their whole inputs) :
+\code
+	myPipeline.setRegionOfInterest(x, y, width, height);		// In the pixels of the first output, (0, 0) being the bottom-left corner.
+
+	myPipeline << input1 << input2 << ... << Pipeline::Process;	// The outputs are undefined outside of the region.
+
+	myPipeline.clearRegionOfInterest();				// Back to the default behavior.
+\endcode
+
+Frames in flight : the pipeline can rotate through a ring of buffers cells by itself, a fence being inserted after each run. The CPU can then prepare the next frame while the GPU is still processing the previous ones, and only waits when it actually needs the results of a frame :
+\code
+	myPipeline.enableFramesInFlight(3);
+
+	for(int k=0; k<numFrames; k++)
+	{
+		myPipeline << inputs[k] << Pipeline::Process;		// Renders in the next cell of the ring.
+		tokens.push_back(myPipeline.getLastFrame());
+
+		// Read the results of an older frame, if they are ready :
+		if(k>=2 && myPipeline.isFrameReady(tokens[k-2]))
+			myPipeline.out(0, tokens[k-2].cellID).read(...);
+	}
+\endcode
 **/
 			class GLIP_API Pipeline : public AbstractPipelineLayout, public Component
 			{
@@ -270,11 +307,34 @@ the buffers cell which represents the needed buffers for one full computation. A
 						Reset
 					};
 
+					///Buffers allocation flags (see Pipeline::Pipeline).
+					enum AllocationFlag
+					{
+						///Allow a filter to render in the bottom-left sub-rectangle of a larger intermediate buffer (same mode, depth, filtering and wrapping, no mipmaps). The filters reading these outputs must address them with texelFetch (e.g. from gl_FragCoord) and not with normalized coordinates.
+						AllowSubRectangleReuse	= 0x01,
+						///Fuse the chains of pointwise filters into single filters (see CorePipeline::FilterFusion for the rules and Pipeline::getFusionReport for the result). The uniform variables of the original filters remain accessible through Pipeline::operator[] and are forwarded to the fused filter before each run.
+						FusePointwiseFilters	= 0x02,
+						///Keep the results of the filters between the runs and only process the filters whose inputs (see HdlTexture::getGeneration) or uniform variables (see Filter::getUniformsVersion) changed since they were processed in the current buffers cell. The intermediate buffers are not shared between the filters in this mode. The filters using blending or depth testing are always processed.
+						IncrementalProcessing	= 0x04
+					};
+
+					///Token identifying a run of the pipeline (see Pipeline::enableFramesInFlight).
+					struct GLIP_API FrameToken
+					{
+						///Number of the run (starting at 1, 0 for an invalid token).
+						unsigned int	frame;
+						///ID of the buffers cell holding the results of the run.
+						int		cellID;
+
+						FrameToken(void);
+					};
+
 				private :
 					struct ActionHub
 					{
 						std::vector<int> 		inputBufferIdx;		// The index of the buffer providing the argument k.
 						std::vector<int> 		inputArgumentIdx;	// The index of the output providing the argument k.
+						std::vector<int>		inputActionIdx;		// The index of the action providing the argument k (THIS_PIPELINE for the inputs of the pipeline).
 						int				bufferIdx;		// The index of the buffer to use for output.
 						int				filterIdx;		// The index of the filter.
 					};
@@ -283,6 +343,28 @@ the buffers cell which represents the needed buffers for one full computation. A
 					{
 						int 				bufferIdx;		// The index of the targeted buffer holding the input.
 						int				outputIdx;		// The index of the output for this buffer which has to be used.
+						int				actionIdx;		// The index of the action producing this output.
+					};
+
+					struct FusionHub
+					{
+						std::vector<int>		membersIdx;		// The indices of the filters replaced, in order.
+						std::vector<std::string>	prefixes;		// The prefix of the variables of each filter in the fused source.
+						std::vector< std::vector<HdlDynamicData*> > states;	// The uniform variables of each filter, last forwarded.
+						std::vector<unsigned int>	versions;		// The version of the uniform variables of each filter, last forwarded.
+					};
+
+					struct Region
+					{
+						int				x,			// Left edge, in pixels of the filter.
+										y,			// Bottom edge.
+										width,			// Width (0 for an empty region).
+										height;			// Height.
+
+						Region(int _x = 0, int _y = 0, int _width = 0, int _height = 0);
+						bool contains(const Region& r) const;
+						void merge(const Region& r);
+						static Region fromNormalized(double left, double bottom, double right, double top, int fullWidth, int fullHeight, int margin = 0);
 					};
 
 					struct BufferFormatsCell
@@ -297,6 +379,13 @@ the buffers cell which represents the needed buffers for one full computation. A
 					struct BuffersCell
 					{
 						std::vector<HdlFBO*>		buffersList;
+						std::vector<unsigned int>	actionsVersions;	// The number of times each action was processed in this cell (see Pipeline::IncrementalProcessing).
+						std::vector<unsigned int>	uniformsVersions;	// The version of the uniform variables of the filter when the action was last processed.
+						std::vector< std::vector<const HdlTexture*> > inputsTextures;	// The inputs of the pipeline read by the action when it was last processed (NULL for the intermediate buffers).
+						std::vector< std::vector<unsigned int> > inputsVersions;	// The generations of these inputs, or the versions of the producing actions.
+						std::vector<Region>		renderedRegions;	// The region of the outputs rendered when the action was last processed.
+						unsigned int			frame;			// The number of the last run rendered in this cell (0 if none).
+						HdlFence			fence;			// Signaled when the GPU completed this run.
 		
 						BuffersCell(const BufferFormatsCell& bufferFormats);
 						~BuffersCell(void);
@@ -310,12 +399,32 @@ the buffers cell which represents the needed buffers for one full computation. A
 					std::vector<Filter*>			filtersList;					
 					std::vector<ActionHub>			actionsList;
 					std::vector<OutputHub>			outputsList;
+					std::vector<bool>			activeOutputs;
+					std::map<std::vector<bool>, std::vector<int> > activeActionsCache;	// The actions needed, per mask of active outputs.
+					const std::vector<int>*			activeActions;
 					std::map<int, int>			filtersGlobalIDsList;
+					std::vector<int>			fusedInto;		// For each filter, the index of the fused filter replacing it or -1.
+					std::map<int, FusionHub>		fusionsList;		// The fusions, indexed by the fused filter.
+					std::string				fusionReport;
+					bool					regionOfInterestEnabled;
+					double					regionOfInterest[4];	// Normalized coordinates of the left, bottom, right and top edges.
+					std::vector<Region>			actionsRegions;		// The region of the outputs of each action needed for the next run.
+					int					allocationFlags;
+					size_t					intermediateMemoryPeak;
+					std::vector<int>			framesCells;		// The ring of cells used for the frames in flight.
+					int					framesPosition;		// Position of the last cell used in the ring.
+					unsigned int				framesCounter;		// Number of runs.
+					FrameToken				lastFrame;
 
 					bool 					firstRun,
 										broken,
 										perfsMonitoring;
-					GLuint					queryObject;
+					int					perfsFramesDepth,
+										perfsCurrentFrame;
+					std::vector<GLuint>			queryObjects;		// Ring of timer queries, perfsFramesDepth frames of actionsList.size() queries.
+					std::vector<bool>			pendingFrames;		// For each frame of the ring, true if its results were not collected yet.
+					std::vector< std::vector<int> >		framesActions;		// For each frame of the ring, the actions which were executed.
+					int					numProcessedActions;
 					std::vector<double>			perfs;
 					double					totalPerf;
 
@@ -323,7 +432,15 @@ the buffers cell which represents the needed buffers for one full computation. A
 					Pipeline(const AbstractPipelineLayout& p, const std::string& name, bool fake);
 					void cleanInput(void);
 					void build(int& currentIdx, std::vector<Filter*>& filters, std::map<int, int>& filtersGlobalID, std::vector<Connection>& connections, AbstractPipelineLayout& originalLayout);
+					void fuseFilters(int& currentIdx, std::vector<Connection>& connections);
+					void forwardUniforms(FusionHub& fusion, Filter& fused);
 					void allocateBuffers(std::vector<Connection>& connections);
+					void updateActiveActions(void);
+					void updateRegions(void);
+					bool isActionUpToDate(int k, const Region& region);
+					void recordAction(int k, const Region& region);
+					void collectPerfs(bool waitOldest);
+					void releaseQueries(void);
 
 				protected :
 					// Tools
@@ -331,11 +448,26 @@ the buffers cell which represents the needed buffers for one full computation. A
 
 				public :
 					// Tools
-					Pipeline(const AbstractPipelineLayout& p, const std::string& name);
+					Pipeline(const AbstractPipelineLayout& p, const std::string& name, int _allocationFlags = 0);
 					~Pipeline(void);
 
 					int 			getNumActions(void) const;
 					int 			getSize(bool askDriver = false);
+					int			getNumBuffers(void) const;
+					size_t			getIntermediateMemory(void) const;
+					size_t			getIntermediateMemoryPeak(void) const;
+					void			setActiveOutputs(const std::vector<int>& outputs);
+					void			setActiveOutputs(const std::vector<std::string>& portNames);
+					void			setAllOutputsActive(void);
+					bool			isOutputActive(int i) const;
+					void			setRegionOfInterest(int x, int y, int width, int height, int output = 0);
+					void			clearRegionOfInterest(void);
+					bool			hasRegionOfInterest(void) const;
+					int			getHalo(void);
+					int			getNumActiveActions(void) const;
+					int			getNumProcessedActions(void) const;
+					void			invalidate(void);
+					const std::string&	getFusionReport(void) const;
 
 					Pipeline& 		operator<<(HdlTexture& texture);
 					Pipeline& 		operator<<(Pipeline& pipeline);
@@ -354,7 +486,15 @@ the buffers cell which represents the needed buffers for one full computation. A
 					void			changeTargetBuffersCell(int cellID);
 					void			removeBuffersCell(int cellID);
 
-					void 			enablePerfsMonitoring(void);
+					void			enableFramesInFlight(int numFrames = 3);
+					void			disableFramesInFlight(void);
+					int			getNumFramesInFlight(void) const;
+					FrameToken		getLastFrame(void) const;
+					bool			isFrameValid(const FrameToken& token) const;
+					bool			isFrameReady(const FrameToken& token);
+					bool			waitFrame(const FrameToken& token, double timeout = -1.0);
+
+					void 			enablePerfsMonitoring(int numFrames = 3);
 					void 			disablePerfsMonitoring(void);
 					double			getTiming(int filterID);
 					double 			getTiming(int action, std::string& filterName);
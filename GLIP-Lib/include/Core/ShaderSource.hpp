@@ -51,6 +51,8 @@ ShaderSource src(myShader);
 \endcode
 
 The shader source will be parsed to find input and output ports name. In the case that you are using gl_FragColor, the name of the output port will be the one contained by string ShaderSource::portNameForFragColor.
+
+The 2D image uniforms (image2D, iimage2D, uimage2D) are listed separately, the images declared readonly being inputs and the others outputs (see ShaderSource::getInputImages and ShaderSource::getOutputImages). They are the ports of the compute filters (see CorePipeline::ComputeFilterLayout).
 **/
 			class GLIP_API ShaderSource
 			{
@@ -80,6 +82,8 @@ The shader source will be parsed to find input and output ports name. In the cas
 					std::vector<std::string> 	uniformVars;
 					std::vector<GLenum>		uniformVarsType;
 					std::vector<std::string> 	outFragments;
+					std::vector<std::string>	inImages2D,
+									outImages2D;
 					bool 				compatibilityRequest;
 					int 				versionNumber,
 									startLine;
@@ -120,6 +124,8 @@ The shader source will be parsed to find input and output ports name. In the cas
 					const std::vector<std::string>& getOutputVars(void) const;
 					const std::vector<std::string>& getUniformVars(void) const;
 					const std::vector<GLenum>& getUniformTypes(void) const;
+					const std::vector<std::string>& getInputImages(void) const;
+					const std::vector<std::string>& getOutputImages(void) const;
 			};
 		}
 	}
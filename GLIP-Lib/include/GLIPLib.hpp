@@ -38,10 +38,12 @@
 			#include "Core/Exception.hpp"
 
 			// GL wrappers
+			#include "Core/GLStateCache.hpp"
 			#include "Core/ShaderSource.hpp"
 			#include "Core/HdlTexture.hpp"
 			#include "Core/HdlFBO.hpp"
 			#include "Core/HdlGeBO.hpp"
+			#include "Core/HdlFence.hpp"
 			#include "Core/HdlPBO.hpp"
 			#include "Core/HdlShader.hpp"
 			#include "Core/HdlVBO.hpp"
@@ -49,6 +51,7 @@
 			// Pipeline Tools
 			#include "Core/Geometry.hpp"
 			#include "Core/Filter.hpp"
+			#include "Core/FilterFusion.hpp"
 			#include "Core/Pipeline.hpp"
 
 			// Modules
@@ -25,6 +25,8 @@
 #define __FFT1D_INCLUDE__
 
 	// Includes
+	#include <string>
+	#include <vector>
 	#include "Core/LibTools.hpp"
 	#include "Core/OglInclude.hpp"
 	#include "Modules/LayoutLoaderModules.hpp"
@@ -50,11 +52,77 @@ namespace Glip
 				/// The computation will use of old gl_FragColor GLSL built-in variable.
 				CompatibilityMode	= 0x01000,
 				/// Pipelines have no input (the user must provide a PRE-function).
-				NoInput			= 0x10000
+				NoInput			= 0x10000,
+				/// Use the original radix-2 passes (one pass per level, followed by a bit reversal shuffle).
+				Radix2			= 0x100000,
+				/// Use radix-4 passes (and a single radix-2 pass if needed).
+				Radix4			= 0x200000,
+				/// Use radix-8 passes (and a single radix-4 or radix-2 pass if needed).
+				Radix8			= 0x400000,
+				/// The input is real (red channel), the output is the non-redundant half-spectrum (width/2+1 columns).
+				RealInput		= 0x1000000,
+				/// Perform the reciprocal transform of a half-spectrum (as produced with RealInput), the output is real (red channel).
+				RealOutput		= 0x2000000,
+				/// Transform two signals at once, the first in the red and green channels and the second in the blue and alpha channels.
+				Batched			= 0x4000000,
+				/// Read the twiddle factors from a table computed on the CPU in double precision (see GenerateFFT1DPipeline::getTwiddles) instead of computing them in the shaders.
+				TwiddleTexture		= 0x8000000,
+				/// Accumulate the butterflies in double precision (requires GL_ARB_gpu_shader_fp64, see isDoublePrecisionAvailable).
+				DoublePrecision		= 0x10000000
 				// Update Flag getFlag(const std::string& str)
 			};
 
+			/// Kind of pass of a transform (see Pass).
+			enum PassKind
+			{
+				/// Butterflies of the original radix-2 decomposition (see Radix2).
+				Radix2Butterfly,
+				/// Bit reversal shuffle ending the original radix-2 decomposition.
+				Radix2Shuffle,
+				/// Pass of the mixed radix decomposition.
+				MixedRadix,
+				/// Extraction of the half-spectrum of a real signal (see RealInput).
+				Unpack,
+				/// Bluestein algorithm, transform of the chirp filter.
+				BluesteinChirp,
+				/// Bluestein algorithm, transform of the modulated signal.
+				BluesteinSignal,
+				/// Bluestein algorithm, reciprocal transform of the product of the two previous transforms. The last pass demodulates the result.
+				BluesteinConvolution
+			};
+
+			/// Description of a pass of a transform (see GenerateFFT1DPipeline::getPlan and GenerateFFT2DPipeline::getPlan).
+			struct GLIP_API Pass
+			{
+				/// Name of the filter performing the pass.
+				std::string	name;
+				/// Kind of pass.
+				PassKind	kind;
+				/// True if the pass transforms the rows.
+				bool		horizontal;
+				/// Number of values gathered for each output texel.
+				int		radix,
+				/// Size of the sub-transforms computed by the previous passes (1 for the first pass).
+						span,
+				/// Size of the transform (larger than the signal for the Bluestein passes).
+						length,
+				/// Width of the output texture.
+						width,
+				/// Height of the output texture.
+						height;
+
+				Pass(const std::string& _name, PassKind _kind, int _radix, int _span, int _length, int _width, int _height, bool _horizontal=true);
+			};
+
 			GLIP_API_FUNC Flag getFlag(const std::string& str);
+			GLIP_API_FUNC bool isMixedRadixSize(int size);
+			GLIP_API_FUNC std::vector<int> getRadices(int size, int flags = 0);
+			GLIP_API_FUNC int getBluesteinLength(int size, int flags = 0);
+			GLIP_API_FUNC std::vector<Pass> getPasses(int size, int flags = 0);
+			GLIP_API_FUNC std::string getPlanDescription(const std::vector<Pass>& plan);
+			GLIP_API_FUNC std::vector<int> getTwiddleOrders(int size, int flags = 0);
+			GLIP_API_FUNC std::vector<float> getTwiddleTable(const std::vector<int>& orders);
+			GLIP_API_FUNC bool isDoublePrecisionAvailable(void);
 		}
 
 		/**
@@ -66,6 +134,26 @@ namespace Glip
 
 		The FFT is computed in single precision. The pipeline will have the input port <i>inputTexture</i> and the output port <i>outputTexture</i>. The input texture will have the real part in its red channel and the imaginary part in its green channel. 
 
+		By default, the transform is split in radix-8 and radix-4 passes (see FFTModules::getRadices) : each pass gathers several values per output and the pipeline has about three times fewer passes than with the radix-2 decomposition, the results are in natural order and no shuffle pass is needed. The radix can be forced with the flags FFTModules::Radix2, FFTModules::Radix4 and FFTModules::Radix8.
+
+		For a real signal, the flag FFTModules::RealInput packs the even and odd samples in a complex signal of half the size, and the output contains only the non-redundant half of the spectrum (width/2+1 texels, the other half is its conjugate). The flag FFTModules::RealOutput performs the matching reciprocal transform : it expects such a half-spectrum (width/2+1 texels) and outputs a real signal of <i>width</i> samples, in the red channel. These flags cannot be used with FFTModules::Shifted nor FFTModules::Radix2.
+
+		With the flag FFTModules::Batched, two signals are transformed at once : the first in the red and green channels, the second in the blue and alpha channels (all the intermediate textures are in the GL_RGBA32F format). The output has the same layout, the modulus is not computed. With FFTModules::RealInput, the real signals are read in the red and blue channels and their half-spectra are written in the red-green and blue-alpha channels. With FFTModules::RealOutput, the real results are written in the red and blue channels.
+
+		The size does not need to be a power of 2. If it only has the prime factors 2, 3, 5 and 7, radix-3, radix-5 and radix-7 passes are added to the decomposition (a 1920 texels transform needs 5 passes). Otherwise, the transform is computed with the Bluestein algorithm : the signal is modulated by a chirp and convolved with the chirp filter, with three transforms of a larger size (see FFTModules::getBluesteinLength). The passes chosen for a transform can be listed with GenerateFFT1DPipeline::getPlan, for instance to predict its cost :
+		\code
+		std::cout << FFTModules::getPlanDescription(GenerateFFT1DPipeline::getPlan(1920)) << std::endl;
+		\endcode
+
+		The precision can be traded for speed explicitly. With the flag FFTModules::TwiddleTexture, the twiddle factors are not computed with sin and cos in the shaders but read from a table computed in double precision on the CPU. The pipeline then has the additional input port <i>twiddleTexture</i>, which must receive a texture of format GenerateFFT1DPipeline::getTwiddleFormat filled with GenerateFFT1DPipeline::getTwiddles :
+		\code
+		const int flags = FFTModules::TwiddleTexture;
+		HdlTexture twiddles(GenerateFFT1DPipeline::getTwiddleFormat(1920, flags));
+		std::vector<float> table = GenerateFFT1DPipeline::getTwiddles(1920, flags);
+		twiddles.write(&table[0]);
+		\endcode
+		With the flag FFTModules::DoublePrecision, the values gathered by each pass are accumulated in double precision (the intermediate textures are still in single precision). This requires GL_ARB_gpu_shader_fp64 (see FFTModules::isDoublePrecisionAvailable) and gives the best accuracy with FFTModules::TwiddleTexture, as the table also holds the residual of each factor. These flags cannot be used with FFTModules::Radix2.
+
 		Here is an example of PRE and POST functions given when creating the pipeline via a LayoutLoader script. Note that you can provide the content of the blocks PRE and POST directly to the GenerateFFT1DPipeline::generate function.
 		\code
 		CALL:GENERATE_FFT1D_PIPELINE(512, FFTPipelineLayout)
@@ -97,6 +185,8 @@ namespace Glip
 			private :
 				static ShaderSource generateRadix2Code(int width, int currentLevel, int flags, const ShaderSource& pre);
 				static ShaderSource generateLastShuffleCode(int width, int flags, const ShaderSource& post);
+				static ShaderSource generateMixedRadixCode(int width, const FFTModules::Pass& pass, int flags, const ShaderSource& pre, const ShaderSource& post);
+				static ShaderSource generateUnpackCode(int width, int flags, const ShaderSource& post);
 
 			public :
 				GenerateFFT1DPipeline(void);
@@ -105,6 +195,11 @@ namespace Glip
 
 				static const std::string getInputPortName(void);
 				static const std::string getOutputPortName(void);
+				static const std::string getChirpPortName(void);
+				static const std::string getTwiddlePortName(void);
+				static std::vector<FFTModules::Pass> getPlan(int width, int flags = 0);
+				static HdlTextureFormat getTwiddleFormat(int width, int flags = 0);
+				static std::vector<float> getTwiddles(int width, int flags = 0);
 				static PipelineLayout generate(int width, int flags = 0, const ShaderSource& pre=std::string(), const ShaderSource& post=std::string());
 		};
 
@@ -117,6 +212,23 @@ namespace Glip
 
 		The FFT is computed in single precision. The pipeline will have the input port <i>inputTexture</i> and the output port <i>outputTexture</i>. The input texture will have the real part in its red channel and the imaginary part in its green channel. 
 
+		As for GenerateFFT1DPipeline, the rows then the columns are transformed with radix-8 and radix-4 passes by default (a 2048x2048 transform needs 8 passes instead of 23). The radix can be forced with the flags FFTModules::Radix2, FFTModules::Radix4 and FFTModules::Radix8.
+
+		For a real image, the flag FFTModules::RealInput halves the work of the horizontal passes and the size of the vertical passes : the output contains the width/2+1 first columns of the spectrum (the others are obtained by Hermitian symmetry). The flag FFTModules::RealOutput performs the matching reciprocal transform, from a (width/2+1)x<i>height</i> half-spectrum to a real image in the red channel. With these flags, FFTModules::Shifted only applies to the vertical direction, and FFTModules::Radix2 cannot be used :
+		\code
+		CALL:GENERATE_FFT2D_PIPELINE(512, 512, FFTPipeline, REAL_INPUT)
+		CALL:GENERATE_FFT2D_PIPELINE(512, 512, IFFTPipeline, REAL_OUTPUT)
+		\endcode
+
+		As in 1D, the sizes do not need to be powers of 2 : a 1920x1080 transform uses radix-3 and radix-5 passes (10 passes in total, instead of 8 passes on 2048x2048 textures with zero padding), and the directions whose size has a prime factor larger than 7 are computed with the Bluestein algorithm. The plan can be listed with GenerateFFT2DPipeline::getPlan.
+
+		The flags FFTModules::TwiddleTexture and FFTModules::DoublePrecision are also available (see GenerateFFT1DPipeline), the table of twiddle factors is given by GenerateFFT2DPipeline::getTwiddleFormat and GenerateFFT2DPipeline::getTwiddles and holds the factors of both directions.
+
+		Several images can be transformed in one set of passes : the flag FFTModules::Batched transforms two signals per texel (red-green and blue-alpha, see GenerateFFT1DPipeline) and the images can be stacked vertically in slices (the texture is then <i>width</i>x<i>height*numSlices</i>, each slice is transformed independently). For instance, for a RGB image, the red and green channels are batched in a first slice and the blue channel in a second one (the PRE and POST functions receive the position in the slice) :
+		\code
+		CALL:GENERATE_FFT2D_PIPELINE(512, 512, ColorFFTPipeline, BATCHED, REAL_INPUT, 2)
+		\endcode
+
 		Here is an example of PRE and POST functions given when creating the pipeline via a LayoutLoader script. Note that you can provide the content of the blocks PRE and POST directly to the GenerateFFT2DPipeline::generate function.
 		\code
 		CALL:GENERATE_FFT2D_PIPELINE(512, 512, FFTPipelineLayout)
@@ -148,6 +260,7 @@ namespace Glip
 			private :
 				static ShaderSource generateRadix2Code(int width, int oppositeWidth, int currentLevel, int flags, bool horizontal, const ShaderSource& pre);
 				static ShaderSource generateLastShuffleCode(int width, int oppositeWidth, int flags, bool horizontal, const ShaderSource& post);
+				static ShaderSource generateMixedRadixCode(int width, int height, int numSlices, const FFTModules::Pass& pass, int flags, const ShaderSource& pre, const ShaderSource& post);
 
 			public :
 				GenerateFFT2DPipeline(void);
@@ -156,7 +269,12 @@ namespace Glip
 
 				static const std::string getInputPortName(void);
 				static const std::string getOutputPortName(void);
-				static PipelineLayout generate(int width, int height, int flags = 0, const ShaderSource& pre=std::string(), const ShaderSource& post=std::string());
+				static const std::string getChirpPortName(void);
+				static const std::string getTwiddlePortName(void);
+				static std::vector<FFTModules::Pass> getPlan(int width, int height, int flags = 0, int numSlices = 1);
+				static HdlTextureFormat getTwiddleFormat(int width, int height, int flags = 0);
+				static std::vector<float> getTwiddles(int width, int height, int flags = 0);
+				static PipelineLayout generate(int width, int height, int flags = 0, const ShaderSource& pre=std::string(), const ShaderSource& post=std::string(), int numSlices = 1);
 		};
 	}
 }
@@ -0,0 +1,106 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : Histogram.hpp                                                                             */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Histogram pipeline generator.                                                             */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    Histogram.hpp
+ * \brief   Histogram pipeline generator.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __GLIPLIB_HISTOGRAM__
+#define __GLIPLIB_HISTOGRAM__
+
+	// Includes
+	#include <map>
+	#include <vector>
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+	#include "Modules/LayoutLoaderModules.hpp"
+
+namespace Glip
+{
+	using namespace Glip::CoreGL;
+	using namespace Glip::CorePipeline;
+
+	namespace Modules
+	{
+		namespace HistogramModules
+		{
+			/// Flag describing the computation options.
+			enum Flag
+			{
+				/// Divide the counts by the number of pixels of the input.
+				Normalized		= 0x00001,
+				/// Do not use the compute shaders, even if they are available.
+				NoCompute		= 0x00010
+				// Update Flag getFlag(const std::string& str)
+			};
+
+			GLIP_API_FUNC Flag getFlag(const std::string& str);
+		}
+
+		/**
+		\class GenerateHistogramPipeline
+		\brief Generate a PipelineLayout computing the histograms of the channels of a texture.
+		\related HistogramModules
+
+		The pipeline has the input port <i>inputTexture</i> and the output port <i>outputTexture</i>, a texture of <i>numBins</i>x1 texels in the GL_RGBA32F format. The histogram of each of the selected channels is written in the same channel of the output (the other channels are set to zero). Values outside of the range [<i>minimum</i>, <i>maximum</i>] are not counted, all the pixels of the input are considered :
+		\code
+		CALL:GENERATE_HISTOGRAM_PIPELINE(inputFormat, HistogramPipeline, 256, RGB, 0.0, 1.0, NORMALIZED)
+		\endcode
+
+		A PRE function can be used to transform the data before the binning, for instance to compute the histogram of the luminance :
+		\code
+		CALL:GENERATE_HISTOGRAM_PIPELINE(inputFormat, LuminanceHistogramPipeline, 64, R)
+		{
+			PRE
+			{
+				vec4 pre(in vec4 c, in vec2 x) // c is the texel at the normalized position x.
+				{
+					return vec4(dot(c.rgb, vec3(0.2126, 0.7152, 0.0722)), 0.0, 0.0, 0.0);
+				}
+			}
+		}
+		\endcode
+
+		When the compute shaders are available (see GenerateHistogramPipeline::isComputeAvailable) and unless the flag HistogramModules::NoCompute is set, each work group counts a band of rows of the input in shared memory with atomic operations, then a second pass sums the bands. Otherwise, each pixel is scattered as a point onto its bin with additive blending. The points come from a GeometryPrimitives::InstancedPointsGrid2D : only a single row of the grid is stored.
+		**/
+		class GLIP_API GenerateHistogramPipeline : public LayoutLoaderModule
+		{
+			private :
+				static std::vector<int> getChannels(const std::string& channels);
+				static void generateBinningCode(std::string& str, std::map<int,ShaderSource::LineInfo>& linesInfo, int& lineCounter, int numBins, const std::vector<int>& channels, float minimum, float maximum, const ShaderSource& pre);
+				static ShaderSource generateCountCode(int width, int height, int numBins, int bandHeight, const std::vector<int>& channels, float minimum, float maximum, const ShaderSource& pre);
+				static ShaderSource generateSumCode(int numBands, int numPixels, int flags);
+				static ShaderSource generateScatterCode(int width, int height, int numBins, const std::vector<int>& channels, float minimum, float maximum, int flags, const ShaderSource& pre);
+				static ShaderSource generateAccumulateCode(void);
+
+			public :
+				GenerateHistogramPipeline(void);
+
+				void apply(LAYOUT_LOADER_ARGUMENTS_LIST);
+
+				static const std::string getInputPortName(void);
+				static const std::string getOutputPortName(void);
+				static bool isComputeAvailable(void);
+				static PipelineLayout generate(int width, int height, int numBins, const std::string& channels = "RGB", float minimum = 0.0f, float maximum = 1.0f, int flags = 0, const ShaderSource& pre=std::string());
+		};
+	}
+}
+
+#endif
+
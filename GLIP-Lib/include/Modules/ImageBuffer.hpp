@@ -38,6 +38,9 @@ namespace Glip
 
 	namespace Modules
 	{
+		// Prototypes
+		class UploadQueue;
+
 		// Structures :
 /**
 \class ImageBuffer
@@ -80,6 +83,7 @@ namespace Glip
 				const ImageBuffer& operator>>(HdlTexture& texture) const;
 				const ImageBuffer& operator>>(ImageBuffer& image) const;
 				const ImageBuffer& operator>>(void* bytes) const;
+				const ImageBuffer& upload(HdlTexture& texture, UploadQueue& queue) const;
 
 				bool isInside(const int& x, const int& y) const;
 				bool isInside(const int& x, const int& y, const GLenum& channel) const;
@@ -77,6 +77,9 @@ namespace Glip
 			KW_LL_CALL,
 			KW_LL_SAFE_CALL,
 			KW_LL_UNIQUE,
+			KW_LL_HALO,
+			KW_LL_COMPUTE_FILTER_LAYOUT,
+			KW_LL_INSTANCED_GRID_2D,
 			LL_NumKeywords,
 			LL_UnknownKeyword
 		};
@@ -247,7 +250,7 @@ Define a model, which can be used as the base drawing in a filter.
 <table class="glipDescrTable">
 <tr class="glipDescrHeaderRow"><th class="glipDescrHeaderFirstColumn">Argument</th><th>Description</th></tr>
 <tr class="glipDescrRow"><td><i>name</i></td>				<td>Name of the model.</td></tr>
-<tr class="glipDescrRow"><td><i>type</i></td>				<td>Type of the geometry. Can be GRID_2D, GRID_3D or CUSTOM_MODEL.</td></tr>
+<tr class="glipDescrRow"><td><i>type</i></td>				<td>Type of the geometry. Can be GRID_2D, GRID_3D, INSTANCED_GRID_2D or CUSTOM_MODEL.</td></tr>
 <tr class="glipDescrRow"><td><i>argument_0</i></td>			<td>Argument, depending on the choice of the geometry.</td></tr>
 </table>
 
@@ -280,6 +283,20 @@ Create a 3D grid of dots.
 <tr class="glipDescrRow"><td><i>depth</i></td>				<td>Number of dots in the Z direction.</td></tr>
 </table>
 
+#### InstancedGrid2D
+<blockquote>
+<b>GEOMETRY</b>:<i>name</i>(INSTANCED_GRID_2D, <i>width</i>, <i>height</i>)
+</blockquote>
+
+Create a 2D grid of dots, of which only one row is stored, drawn once per line of the grid (see CorePipeline::GeometryPrimitives::InstancedPointsGrid2D). The vertex shader reads the column in gl_VertexID and the row in gl_InstanceID.
+
+<table class="glipDescrTable">
+<tr class="glipDescrHeaderRow"><th class="glipDescrHeaderFirstColumn">Argument</th><th>Description</th></tr>
+<tr class="glipDescrRow"><td><i>name</i></td>				<td>Name of the model.</td></tr>
+<tr class="glipDescrRow"><td><i>width</i></td>				<td>Number of dots in the X direction.</td></tr>
+<tr class="glipDescrRow"><td><i>height</i></td>				<td>Number of dots in the Y direction.</td></tr>
+</table>
+
 #### CustomModel
 <blockquote>
 <b>GEOMETRY</b>:<i>name</i>(CUSTOM_MODEL, <i>primitive</i>, <i>hasNormals</i>, <i>hasTexCoords</i>)<br>
@@ -484,6 +501,39 @@ Enable blending in the filter and setup the parameters.
 <tr class="glipDescrRow"><td><i>depthTestFunction</i></td>		<td>Function for the depth test.</td></tr>
 </table>
 
+### Halo
+<blockquote>
+<b>HALO</b>(<i>halo</i>)
+</blockquote>
+
+Declare the distance, in pixels of the inputs, around the current fragment outside of which the inputs are not read (see Pipeline::setRegionOfInterest). Without this declaration, the whole inputs are considered needed.
+
+<table class="glipDescrTable">
+<tr class="glipDescrHeaderRow"><th class="glipDescrHeaderFirstColumn">Argument</th><th>Description</th></tr>
+<tr class="glipDescrRow"><td><i>halo</i></td>				<td>Either a positive integer (0 for a pointwise filter) or the name of an integer uniform variable of the filter holding it (e.g. the radius of a convolution kernel).</td></tr>
+</table>
+
+### Compute Filter Layout
+<blockquote>
+<b>COMPUTE_FILTER_LAYOUT</b>:<i>name</i>(<i>outputFormatName</i>, <i>computeShaderSourceName</i>)
+</blockquote>
+<blockquote>
+<b>COMPUTE_FILTER_LAYOUT</b>:<i>name</i>(<i>outputFormatName</i>, <i>computeShaderSourceName</i>)<br>
+{<br>
+&nbsp;&nbsp;&nbsp;&nbsp; <i>extraOptions</i><br>
+}
+</blockquote>
+
+Define a filter layout running a compute shader (see CorePipeline::ComputeFilterLayout). Its input ports are the samplers and the read only images of the shader, its output ports are the other images. Clearing is disabled unless GL_CLEAR(TRUE) is given.
+
+<table class="glipDescrTable">
+<tr class="glipDescrHeaderRow"><th class="glipDescrHeaderFirstColumn">Argument</th><th>Description</th></tr>
+<tr class="glipDescrRow"><td><i>name</i></td>				<td>Name of the filter layout created.</td></tr>
+<tr class="glipDescrRow"><td><i>outputFormatName</i></td>		<td>Name of the format for the output, it must be a sized format with 1, 2 or 4 channels (e.g. GL_RGBA32F).</td></tr>
+<tr class="glipDescrRow"><td><i>computeShaderSourceName</i></td>	<td>Name of the compute shader source.</td></tr>
+<tr class="glipDescrRow"><td><i>extraOptions</i></td>			<td>Set of options for the filter layout : GL_CLEAR, HALO.</td></tr>
+</table>
+
 ## Pipeline Layout
 ### Pipeline Layout
 <blockquote>
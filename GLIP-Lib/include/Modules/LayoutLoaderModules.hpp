@@ -690,7 +690,7 @@ Generate the 1D FFT Pipeline transformation.
 <tr class="glipDescrHeaderRow"><th class="glipDescrHeaderFirstColumn">Argument</th><th>Description</th></tr>
 <tr class="glipDescrRow"><td><i>width</i></td> <td>Width, can be either a numeral or the name of an existing format.</td></tr>
 <tr class="glipDescrRow"><td><i>name</i></td> <td>Name of the new pipeline.</td></tr>
-<tr class="glipDescrRow"><td><i>options...</i></td> <td>Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT.</td></tr>
+<tr class="glipDescrRow"><td><i>options...</i></td> <td>Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT, RADIX_2, RADIX_4, RADIX_8, REAL_INPUT, REAL_OUTPUT, BATCHED, TWIDDLE_TEXTURE, DOUBLE_PRECISION.</td></tr>
 </table>
 
 <b>Body</b> : PRE{...} block contains a filtering function to be applied before the FFT. It must define a function vec4 pre(in vec4 colorFromTexture, in float x). POST{...} block contains a filtering function to be applied after the FFT. It must implement a function vec4 post(in vec4 colorAfterFFT, in float x). Both of these block can declare their own uniform variables.
@@ -710,11 +710,54 @@ Generate the 2D FFT Pipeline transformation.
 <tr class="glipDescrRow"><td><i>width</i></td> <td>Width, can be either a numeral or the name of an existing format.</td></tr>
 <tr class="glipDescrRow"><td><i>height</i></td> <td>Height, can be either a numeral or the name of an existing format.</td></tr>
 <tr class="glipDescrRow"><td><i>name</i></td> <td>Name of the new pipeline.</td></tr>
-<tr class="glipDescrRow"><td><i>options...</i></td> <td>Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT.</td></tr>
+<tr class="glipDescrRow"><td><i>options...</i></td> <td>Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT, RADIX_2, RADIX_4, RADIX_8, REAL_INPUT, REAL_OUTPUT, BATCHED, TWIDDLE_TEXTURE, DOUBLE_PRECISION and the number of slices stacked vertically in the texture (1 by default).</td></tr>
 </table>
 
 <b>Body</b> : PRE{...} block contains a filtering function to be applied before the FFT. It must define a function vec4 pre(in vec4 colorFromTexture, in vec2 x). POST{...} block contains a filtering function to be applied after the FFT. It must implement a function vec4 post(in vec4 colorAfterFFT, in vec2 x). Both of these block can declare their own uniform variables.
 
+### GENERATE_REDUCTION_PIPELINE
+<blockquote>
+<b>CALL</b>:GENERATE_REDUCTION_PIPELINE(format, name, operations... [, options...])<br>
+[{<br>
+&nbsp;&nbsp;&nbsp;&nbsp;<i>body</i><br>
+}]<br>
+</blockquote>
+
+Generate a Pipeline reducing a texture to a single texel (sum, minimum, maximum, mean, argmin or argmax).
+
+<table class="glipDescrTable">
+<tr class="glipDescrHeaderRow"><th class="glipDescrHeaderFirstColumn">Argument</th><th>Description</th></tr>
+<tr class="glipDescrRow"><td><i>format</i></td> <td>Name of the format of the input texture.</td></tr>
+<tr class="glipDescrRow"><td><i>name</i></td> <td>Name of the new pipeline.</td></tr>
+<tr class="glipDescrRow"><td><i>operations...</i></td> <td>Either one operation for all the channels or one operation per channel : SUM, MIN, MAX, MEAN. ARGMIN and ARGMAX must be used alone.</td></tr>
+<tr class="glipDescrRow"><td><i>options...</i></td> <td>Options to be used by the reduction : BLOCK_8X8, NO_COMPUTE.</td></tr>
+</table>
+
+<b>Body</b> : PRE{...} block contains a filtering function to be applied before the reduction. It must define a function vec4 pre(in vec4 colorFromTexture, in vec2 x). It can declare its own uniform variables.
+
+### GENERATE_HISTOGRAM_PIPELINE
+<blockquote>
+<b>CALL</b>:GENERATE_HISTOGRAM_PIPELINE(format, name, numBins [, channels, minimum, maximum, options...])<br>
+[{<br>
+&nbsp;&nbsp;&nbsp;&nbsp;<i>body</i><br>
+}]<br>
+</blockquote>
+
+Generate a Pipeline computing the histograms of the channels of a texture, over all its pixels.
+
+<table class="glipDescrTable">
+<tr class="glipDescrHeaderRow"><th class="glipDescrHeaderFirstColumn">Argument</th><th>Description</th></tr>
+<tr class="glipDescrRow"><td><i>format</i></td> <td>Name of the format of the input texture.</td></tr>
+<tr class="glipDescrRow"><td><i>name</i></td> <td>Name of the new pipeline.</td></tr>
+<tr class="glipDescrRow"><td><i>numBins</i></td> <td>Number of bins of the histograms, the width of the output texture.</td></tr>
+<tr class="glipDescrRow"><td><i>channels</i></td> <td>Channels to be binned, among RGBA (default : RGB).</td></tr>
+<tr class="glipDescrRow"><td><i>minimum</i></td> <td>Lower bound of the first bin (default : 0.0).</td></tr>
+<tr class="glipDescrRow"><td><i>maximum</i></td> <td>Upper bound of the last bin (default : 1.0).</td></tr>
+<tr class="glipDescrRow"><td><i>options...</i></td> <td>Options to be used by the histogram : NORMALIZED, NO_COMPUTE.</td></tr>
+</table>
+
+<b>Body</b> : PRE{...} block contains a filtering function to be applied before the binning. It must define a function vec4 pre(in vec4 colorFromTexture, in vec2 x). It can declare its own uniform variables.
+
 ### LOAD_OBJ_GEOMETRY
 <blockquote>
 <b>CALL</b>:LOAD_OBJ_GEOMETRY(filename, geometryName [, strict])<br>
@@ -29,5 +29,10 @@
 	#include "Modules/ImageBuffer.hpp"
 	#include "Modules/FFT.hpp"
 	#include "Modules/GeometryLoader.hpp"
+	#include "Modules/TiledExecutor.hpp"
+	#include "Modules/ReadbackQueue.hpp"
+	#include "Modules/UploadQueue.hpp"
+	#include "Modules/Reduction.hpp"
+	#include "Modules/Histogram.hpp"
 
 #endif
@@ -0,0 +1,130 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : ReadbackQueue.hpp                                                                         */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Module : Asynchronous readback of textures through pixel pack buffers.                    */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    ReadbackQueue.hpp
+ * \brief   Module : Asynchronous readback of textures through pixel pack buffers.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __GLIPLIB_READBACK_QUEUE__
+#define __GLIPLIB_READBACK_QUEUE__
+
+	// Includes
+	#include <vector>
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+	#include "Core/HdlTexture.hpp"
+	#include "Core/HdlPBO.hpp"
+	#include "Core/HdlFence.hpp"
+	#include "Modules/ImageBuffer.hpp"
+
+namespace Glip
+{
+	using namespace Glip::CoreGL;
+
+	namespace Modules
+	{
+/**
+\class ReadbackQueue
+\brief Read textures back to the host without stalling, through a ring of pixel pack buffers.
+
+ImageBuffer::operator<<(HdlTexture&) waits for the GPU to complete all the pending commands before returning. ReadbackQueue::read only queues the copy of the texture into a pixel pack buffer, followed by a fence, and returns immediately with a ticket. The data can be retrieved later, once the GPU is done, as an ImageBuffer or by mapping the buffer directly :
+\code
+	ReadbackQueue queue(3);
+
+	for(int k=0; k<numFrames; k++)
+	{
+		myPipeline << inputs[k] << Pipeline::Process;
+		tickets.push_back(queue.read(myPipeline.out(0)));
+
+		// Collect the results of an older frame, if the GPU is done :
+		if(k>=2 && queue.isReady(tickets[k-2]))
+			queue.get(tickets[k-2], results[k-2]);
+	}
+\endcode
+
+A sub-rectangle or a single channel of the texture can be read to reduce the size of the transfer :
+\code
+	ReadbackQueue::Ticket ticket = queue.read(texture, x, y, width, height, GL_RED);
+	ImageBuffer* redChannel = queue.get(ticket);	// Of size width x height, with a single channel.
+\endcode
+
+The queue holds at most as many readbacks as it has buffers : a ticket becomes invalid once its buffer is reused by a newer read (see ReadbackQueue::isValid). When available, the buffers are persistently mapped (see HdlGeBO::isPersistentMappingSupported) and ReadbackQueue::map only waits for the fence of the readback.
+**/
+		class GLIP_API ReadbackQueue
+		{
+			public :
+				/// Ticket identifying a readback (see ReadbackQueue::read).
+				struct GLIP_API Ticket
+				{
+					/// Index of the buffer in the ring.
+					int		slot;
+					/// Number of the readback (starting at 1, 0 for an invalid ticket).
+					unsigned int	serial;
+
+					Ticket(void);
+				};
+
+			private :
+				struct Slot
+				{
+					HdlPBO*		buffer;
+					HdlFence	fence;
+					unsigned int	serial;
+					int		width,
+							height;
+					GLenum		mode,
+							depth;
+
+					Slot(void);
+					~Slot(void);
+				};
+
+				std::vector<Slot*>	slots;
+				int			position;
+				unsigned int		counter;
+				int			mappedSlot;
+				GLuint			readFramebuffer;
+
+				// No copy :
+				ReadbackQueue(const ReadbackQueue&);
+				const ReadbackQueue& operator=(const ReadbackQueue&);
+
+				Slot& check(const Ticket& ticket, const std::string& caller) const;
+
+			public :
+				ReadbackQueue(int numBuffers = 3);
+				~ReadbackQueue(void);
+
+				int getNumBuffers(void) const;
+				Ticket read(HdlTexture& texture, GLenum channel = GL_NONE);
+				Ticket read(HdlTexture& texture, int x, int y, int width, int height, GLenum channel = GL_NONE);
+				bool isValid(const Ticket& ticket) const;
+				bool isReady(const Ticket& ticket);
+				bool wait(const Ticket& ticket, double timeout = -1.0);
+				HdlTextureFormat getFormat(const Ticket& ticket) const;
+				const void* map(const Ticket& ticket);
+				void unmap(void);
+				ImageBuffer* get(const Ticket& ticket);
+				void get(const Ticket& ticket, ImageBuffer& image, int x = 0, int y = 0);
+		};
+	}
+}
+
+#endif
+
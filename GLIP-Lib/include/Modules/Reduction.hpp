@@ -0,0 +1,121 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : Reduction.hpp                                                                             */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Reduction pipeline generator (sum, minimum, maximum, mean, argmin, argmax).               */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    Reduction.hpp
+ * \brief   Reduction pipeline generator (sum, minimum, maximum, mean, argmin, argmax).
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __GLIPLIB_REDUCTION__
+#define __GLIPLIB_REDUCTION__
+
+	// Includes
+	#include <vector>
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+	#include "Modules/LayoutLoaderModules.hpp"
+
+namespace Glip
+{
+	using namespace Glip::CoreGL;
+	using namespace Glip::CorePipeline;
+
+	namespace Modules
+	{
+		namespace ReductionModules
+		{
+			/// Operation performed by the reduction.
+			enum Operation
+			{
+				/// Sum of the values.
+				Sum,
+				/// Minimum of the values.
+				Minimum,
+				/// Maximum of the values.
+				Maximum,
+				/// Mean of the values.
+				Mean,
+				/// Minimum of the red channel and its position (value, x, y, 1).
+				ArgMin,
+				/// Maximum of the red channel and its position (value, x, y, 1).
+				ArgMax
+				// Update Operation getOperation(const std::string& str)
+			};
+
+			/// Flag describing the computation options.
+			enum Flag
+			{
+				/// Gather blocks of 8x8 texels per pass instead of 4x4.
+				Block8x8		= 0x00001,
+				/// Do not use the compute shaders, even if they are available.
+				NoCompute		= 0x00010
+				// Update Flag getFlag(const std::string& str)
+			};
+
+			GLIP_API_FUNC bool isOperation(const std::string& str);
+			GLIP_API_FUNC Operation getOperation(const std::string& str);
+			GLIP_API_FUNC Flag getFlag(const std::string& str);
+		}
+
+		/**
+		\class GenerateReductionPipeline
+		\brief Generate a PipelineLayout reducing a texture to a single texel.
+		\related ReductionModules
+
+		Each pass gathers blocks of 4x4 (or 8x8, see ReductionModules::Block8x8) texels, the pipeline has as many passes as needed to reach a 1x1 texture. The pipeline has the input port <i>inputTexture</i> and the output port <i>outputTexture</i>, which is a single texel in the GL_RGBA32F format. The operation can be given for all the channels at once, or for each channel independently :
+		\code
+		CALL:GENERATE_REDUCTION_PIPELINE(inputFormat, StatisticsPipeline, MIN, MAX, MEAN, SUM)
+		\endcode
+
+		The operations ReductionModules::ArgMin and ReductionModules::ArgMax must be used alone, they reduce the red channel and output its extremal value in the red channel, the coordinates of the corresponding texel in the green and blue channels. A PRE function can be used to select or transform the data, it is applied on the input texels before the first pass :
+		\code
+		CALL:GENERATE_REDUCTION_PIPELINE(inputFormat, BrightestPipeline, ARGMAX, BLOCK_8X8)
+		{
+			PRE
+			{
+				vec4 pre(in vec4 c, in vec2 x) // c is the texel at the normalized position x.
+				{
+					return vec4(dot(c.rgb, vec3(0.2126, 0.7152, 0.0722)), 0.0, 0.0, 0.0);
+				}
+			}
+		}
+		\endcode
+
+		When the compute shaders are available (see GenerateReductionPipeline::isComputeAvailable) the passes are compute filters (see CorePipeline::ComputeFilterLayout), unless the flag ReductionModules::NoCompute is set. The result can be read back without stalling with ReadbackQueue, the transfer is a single texel.
+		**/
+		class GLIP_API GenerateReductionPipeline : public LayoutLoaderModule
+		{
+			private :
+				static ShaderSource generateCode(int inputWidth, int inputHeight, int blockSize, const std::vector<ReductionModules::Operation>& operations, bool first, bool last, int numPixels, bool compute, const ShaderSource& pre);
+
+			public :
+				GenerateReductionPipeline(void);
+
+				void apply(LAYOUT_LOADER_ARGUMENTS_LIST);
+
+				static const std::string getInputPortName(void);
+				static const std::string getOutputPortName(void);
+				static bool isComputeAvailable(void);
+				static PipelineLayout generate(int width, int height, ReductionModules::Operation operation, int flags = 0, const ShaderSource& pre=std::string());
+				static PipelineLayout generate(int width, int height, const std::vector<ReductionModules::Operation>& operations, int flags = 0, const ShaderSource& pre=std::string());
+		};
+	}
+}
+
+#endif
+
@@ -0,0 +1,110 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : TiledExecutor.hpp                                                                         */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Module : Tiled execution of a pipeline on large host images.                              */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    TiledExecutor.hpp
+ * \brief   Module : Tiled execution of a pipeline on large host images.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __GLIPLIB_TILED_EXECUTOR__
+#define __GLIPLIB_TILED_EXECUTOR__
+
+	// Includes
+	#include <vector>
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+	#include "Core/HdlTexture.hpp"
+	#include "Core/HdlGeBO.hpp"
+	#include "Core/Pipeline.hpp"
+	#include "Modules/ImageBuffer.hpp"
+
+namespace Glip
+{
+	using namespace Glip::CoreGL;
+	using namespace Glip::CorePipeline;
+
+	namespace Modules
+	{
+/**
+\class TiledExecutor
+\brief Apply a pipeline to host images larger than its inputs (for instance larger than HdlAbstractTextureFormat::getMaxSize), tile by tile.
+
+The pipeline must be built for inputs and outputs of the size of a tile. The images are split into overlapping tiles : each tile is extended by the halo of the pipeline (see Pipeline::getHalo) on each side, and only its center (the tile minus the halo) is copied to the outputs. The tiles are shifted to stay inside the images, their borders then coincide with the borders of the images and the filters see the same edges as they would on the whole images.
+
+The tiles go through the current buffers cell of the pipeline, which is reused for all of them : the GPU memory needed is bounded by the size of a tile, whatever the size of the images. The upload of a tile and the readback of the previous one are double-buffered (two sets of input textures and two sets of pixel pack buffers), the CPU copies the results of a tile while the GPU processes the next one.
+\code
+	// The pipeline was built for 2048x2048 inputs, from a layout declaring the halo of its filters :
+	TiledExecutor executor(myPipeline, 2048, 2048);
+
+	ImageBuffer	*scan = ImageBuffer::load("scan.raw"),
+			result(*scan);
+
+	executor.process(*scan, result);
+\endcode
+**/
+		class GLIP_API TiledExecutor
+		{
+			private :
+				struct PendingTile
+				{
+					bool		valid;
+					int		xTile,		// Bottom-left corner of the center of the tile, in the outputs of the pipeline.
+							yTile,
+							xImage,		// Bottom-left corner of the center of the tile, in the images.
+							yImage,
+							width,		// Size of the center of the tile.
+							height;
+				};
+
+				Pipeline&			pipeline;
+				const int			tileWidth,
+								tileHeight,
+								fixedHalo;
+				std::vector<HdlTexture*>	inputsTiles[2];
+				std::vector<HdlGeBO*>		readbackBuffers[2];
+				std::vector<HdlTextureFormat>	readbackFormats;
+				PendingTile			pendingTiles[2];
+
+				// No copy :
+				TiledExecutor(const TiledExecutor&);
+				const TiledExecutor& operator=(const TiledExecutor&);
+
+				static void split(int size, int tileSize, int halo, std::vector<int>& origins, std::vector<int>& starts, std::vector<int>& lengths);
+				const ImageBuffer& prepare(const std::vector<const ImageBuffer*>& inputs, const std::vector<ImageBuffer*>& outputs);
+				void upload(const ImageBuffer& image, HdlTexture& texture, int x, int y);
+				void readback(int slot, const std::vector<ImageBuffer*>& outputs);
+				void stitch(int slot, const std::vector<ImageBuffer*>& outputs);
+				void clean(void);
+
+			public :
+				TiledExecutor(Pipeline& _pipeline, int _tileWidth, int _tileHeight, int _halo=-1);
+				~TiledExecutor(void);
+
+				int getTileWidth(void) const;
+				int getTileHeight(void) const;
+				int getHalo(void);
+				int getNumTiles(int width, int height);
+
+				void process(const std::vector<const ImageBuffer*>& inputs, const std::vector<ImageBuffer*>& outputs);
+				void process(const ImageBuffer& input, ImageBuffer& output);
+		};
+	}
+}
+
+#endif
+
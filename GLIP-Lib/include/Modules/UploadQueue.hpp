@@ -0,0 +1,110 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : UploadQueue.hpp                                                                           */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Module : Streaming upload of textures through pixel unpack buffers.                       */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    UploadQueue.hpp
+ * \brief   Module : Streaming upload of textures through pixel unpack buffers.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#ifndef __GLIPLIB_UPLOAD_QUEUE__
+#define __GLIPLIB_UPLOAD_QUEUE__
+
+	// Includes
+	#include <vector>
+	#include "Core/LibTools.hpp"
+	#include "Core/OglInclude.hpp"
+	#include "Core/HdlTexture.hpp"
+	#include "Core/HdlPBO.hpp"
+	#include "Core/HdlFence.hpp"
+	#include "Modules/ImageBuffer.hpp"
+
+namespace Glip
+{
+	using namespace Glip::CoreGL;
+
+	namespace Modules
+	{
+/**
+\class UploadQueue
+\brief Stream data to existing textures through a ring of pixel unpack buffers.
+
+HdlTexture::write and ImageBuffer::operator>>(HdlTexture&) reallocate the storage of the texture (glTexImage2D) and copy the data synchronously. UploadQueue copies the data in a mapped pixel unpack buffer and updates the existing storage of the texture with glTexSubImage2D, the transfer to the GPU is then asynchronous. Each buffer of the ring is fenced after use : if the GPU did not consume it yet when it comes back in the ring, its storage is orphaned instead of waiting.
+\code
+	UploadQueue uploader(3);
+
+	for(int k=0; k<numFrames; k++)
+	{
+		uploader.write(texture, frames[k]);			// From an ImageBuffer, or from a raw pointer.
+		myPipeline << texture << Pipeline::Process;
+	}
+\endcode
+
+The data can also be produced directly in the mapped buffer, to save a copy :
+\code
+	unsigned char* ptr = reinterpret_cast<unsigned char*>(uploader.map(texture));
+	decodeFrame(ptr);						// Fill the rows of the texture, bottom row first.
+	uploader.submit();
+\endcode
+
+The texture is allocated on first use if it has no storage yet. When available, the buffers are persistently mapped (see HdlGeBO::isPersistentMappingSupported) : UploadQueue::map and UploadQueue::submit then do not map nor unmap anything.
+**/
+		class GLIP_API UploadQueue
+		{
+			private :
+				struct Slot
+				{
+					HdlPBO*		buffer;
+					HdlFence	fence;
+
+					Slot(void);
+					~Slot(void);
+				};
+
+				std::vector<Slot*>	slots;
+				int			position,
+							mappedSlot;
+				HdlTexture*		target;
+				int			region[4],
+							alignment;
+				GLenum			pixelFormat,
+							pixelDepth;
+				size_t			mappedSize;
+				int			numOrphanings;
+
+				// No copy :
+				UploadQueue(const UploadQueue&);
+				const UploadQueue& operator=(const UploadQueue&);
+
+			public :
+				UploadQueue(int numBuffers = 3);
+				~UploadQueue(void);
+
+				int getNumBuffers(void) const;
+				int getNumOrphanings(void) const;
+				bool isMapped(void) const;
+				void* map(HdlTexture& texture, int x = 0, int y = 0, int width = 0, int height = 0, GLenum _pixelFormat = GL_ZERO, GLenum _pixelDepth = GL_ZERO, int _alignment = -1);
+				size_t getMappedSize(void) const;
+				void submit(void);
+				void write(HdlTexture& texture, const void* data, int x = 0, int y = 0, int width = 0, int height = 0, GLenum _pixelFormat = GL_ZERO, GLenum _pixelDepth = GL_ZERO, int _alignment = -1);
+				void write(HdlTexture& texture, const ImageBuffer& image, int x = 0, int y = 0);
+		};
+	}
+}
+
+#endif
+
@@ -29,6 +29,7 @@
 #include "Core/HdlShader.hpp"
 #include "Core/HdlVBO.hpp"
 #include "Core/HdlFBO.hpp"
+#include "Core/GLStateCache.hpp"
 #include "devDebugTools.hpp"
 #include "Core/Geometry.hpp"
 
@@ -54,7 +55,8 @@
 		sFactor(GL_ONE),
 		dFactor(GL_ONE),
 		blendingEquation(GL_FUNC_ADD),
-		depthTestingFunction(GL_LESS)
+		depthTestingFunction(GL_LESS),
+		halo(-1)
 	{
 		for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
 			shaderSources[k] = NULL;
@@ -76,7 +78,9 @@
 		sFactor(c.sFactor),
 		dFactor(c.dFactor),
 		blendingEquation(c.blendingEquation),
-		depthTestingFunction(c.depthTestingFunction)
+		depthTestingFunction(c.depthTestingFunction),
+		halo(c.halo),
+		haloVariable(c.haloVariable)
 	{
 		for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
 			shaderSources[k] = NULL;
@@ -151,6 +155,15 @@
 		return isStandardGeometry;
 	}
 
+	/**
+	\fn bool AbstractFilterLayout::isCompute(void) const
+	\return true if the filter runs a compute shader instead of rendering its geometry (see ComputeFilterLayout).
+	**/
+	bool AbstractFilterLayout::isCompute(void) const
+	{
+		return shaderSources[HandleOpenGL::getShaderTypeIndex(GL_COMPUTE_SHADER)]!=NULL;
+	}
+
 	/**
 	\fn bool AbstractFilterLayout::isClearingEnabled(void) const
 	\return true if clearing is enabled.		
@@ -295,6 +308,48 @@
 		depthTesting = false;
 	}
 
+	/**
+	\fn int AbstractFilterLayout::getHalo(void) const
+	\brief Get the halo of the filter : the distance, in pixels of the inputs, around the current fragment outside of which the inputs are not read. It is used to propagate the region of interest of a Pipeline (see Pipeline::setRegionOfInterest).
+	\return The halo, or -1 if it was not declared or if it is given by a uniform variable (see AbstractFilterLayout::getHaloVariable).
+	**/
+	int AbstractFilterLayout::getHalo(void) const
+	{
+		return halo;
+	}
+
+	/**
+	\fn const std::string& AbstractFilterLayout::getHaloVariable(void) const
+	\brief Get the name of the integer uniform variable holding the halo of the filter (for instance the radius of a convolution kernel set at run time).
+	\return The name of the variable, or an empty string if the halo is constant.
+	**/
+	const std::string& AbstractFilterLayout::getHaloVariable(void) const
+	{
+		return haloVariable;
+	}
+
+	/**
+	\fn void AbstractFilterLayout::setHalo(int _halo)
+	\brief Declare the halo of the filter. For instance, a pointwise filter has a halo of 0 and a 5x5 convolution has a halo of 2. The declaration is not checked against the shader.
+	\param _halo The halo, in pixels of the inputs. A negative value means that the halo is unknown.
+	**/
+	void AbstractFilterLayout::setHalo(int _halo)
+	{
+		halo = (_halo<0) ? -1 : _halo;
+		haloVariable.clear();
+	}
+
+	/**
+	\fn void AbstractFilterLayout::setHalo(const std::string& variableName)
+	\brief Declare that the halo of the filter is given by the current value of one of its integer uniform variables.
+	\param variableName The name of the variable.
+	**/
+	void AbstractFilterLayout::setHalo(const std::string& variableName)
+	{
+		halo = -1;
+		haloVariable = variableName;
+	}
+
 // FilterLayout
 	/**
 	\fn FilterLayout::FilterLayout(const std::string& type, const HdlAbstractTextureFormat& fout, const ShaderSource& fragmentSource, GeometryModel* geometry)
@@ -351,6 +406,16 @@
 		if(sources.empty())
 			throw Exception("FilterLayout::FilterLayout - No ShaderSource provided.", __FILE__, __LINE__, Exception::CoreException);
 
+		std::map<GLenum, ShaderSource*>::const_iterator itCompute = sources.find(GL_COMPUTE_SHADER);
+		if(itCompute!=sources.end() && itCompute->second!=NULL)
+		{
+			for(std::map<GLenum, ShaderSource*>::const_iterator it=sources.begin(); it!=sources.end(); it++)
+			{
+				if(it->first!=GL_COMPUTE_SHADER && it->second!=NULL)
+					throw Exception("FilterLayout::FilterLayout - The compute shader of " + type + " cannot be combined with a " + getGLEnumNameSafe(it->first) + ".", __FILE__, __LINE__, Exception::CoreException);
+			}
+		}
+
 		// Copy the sources, and the find the input/output variables : 
 		std::set<std::string>	varsIn,
 					varsOut;
@@ -361,9 +426,14 @@
 				shaderSources[HandleOpenGL::getShaderTypeIndex(it->first)] = new ShaderSource(*it->second);
 			
 				const std::vector<std::string>  currentVarsIn = it->second->getInputVars(),
-							 	currentVarsOut = it->second->getOutputVars();
+							 	currentVarsOut = it->second->getOutputVars(),
+								currentImagesIn = it->second->getInputImages(),
+								currentImagesOut = it->second->getOutputImages();
 				varsIn.insert(currentVarsIn.begin(), currentVarsIn.end());
-				varsOut.insert(currentVarsOut.begin(), currentVarsOut.end());
+				if(it->first==GL_FRAGMENT_SHADER) // The outputs of the other stages are varyings, not rendering targets.
+					varsOut.insert(currentVarsOut.begin(), currentVarsOut.end());
+				varsIn.insert(currentImagesIn.begin(), currentImagesIn.end());
+				varsOut.insert(currentImagesOut.begin(), currentImagesOut.end());
 			}
 		}
 		// Build Ports :
@@ -386,6 +456,37 @@
 		}
 	}
 
+// ComputeFilterLayout
+	std::string ComputeFilterLayout::regionOriginName = "glipRegionOrigin";
+
+	std::map<GLenum, ShaderSource*> ComputeFilterLayout::makeSources(const ShaderSource& computeSource)
+	{
+		std::map<GLenum, ShaderSource*> sources;
+		sources[GL_COMPUTE_SHADER] = const_cast<ShaderSource*>(&computeSource); // Copied by the FilterLayout constructor.
+		return sources;
+	}
+
+	/**
+	\fn ComputeFilterLayout::ComputeFilterLayout(const std::string& type, const HdlAbstractTextureFormat& fout, const ShaderSource& computeSource)
+	\brief ComputeFilterLayout constructor.
+	\param type The typename of the filter layout.
+	\param fout The texture format of all the outputs, it must be a sized format.
+	\param computeSource The ShaderSource of the compute shader.
+	**/
+	ComputeFilterLayout::ComputeFilterLayout(const std::string& type, const HdlAbstractTextureFormat& fout, const ShaderSource& computeSource)
+	 : 	AbstractComponentLayout(type),
+		ComponentLayout(type),
+		HdlAbstractTextureFormat(fout),
+		AbstractFilterLayout(type, fout),
+		FilterLayout(type, fout, makeSources(computeSource))
+	{
+		if(getNumOutputPort()==0)
+			throw Exception("ComputeFilterLayout::ComputeFilterLayout - The compute shader of " + type + " has no output image (uniform image2D not declared readonly).", __FILE__, __LINE__, Exception::CoreException);
+
+		// The outputs are usually entirely written by the shader :
+		disableClearing();
+	}
+
 // Filter
 	/**
 	\fn Filter::Filter(const AbstractFilterLayout& c, const std::string& name)
@@ -399,8 +500,14 @@
 		HdlAbstractTextureFormat(c), 
 		AbstractFilterLayout(c),
 		prgm(NULL), 
-		geometry(NULL) 
+		geometry(NULL),
+		uniformsVersion(0),
+		uniformsModifications(0),
+		regionOriginLocation(-1)
 	{
+		region[0] = region[1] = region[2] = region[3] = 0;
+		workGroupSize[0] = workGroupSize[1] = workGroupSize[2] = 0;
+
 		const int 	limInput  = HdlTexture::getMaxImageUnits(),
 				limOutput = HdlFBO::getMaximumColorAttachment();
 
@@ -420,83 +527,170 @@
 		// Build arguments table :
 		arguments.assign(getNumInputPort(), reinterpret_cast<HdlTexture*>(NULL));
 
-		try
+		// The compute filters bind their outputs, and their read only images, as images :
+		imageInputs.assign(getNumInputPort(), false);
+		if(isCompute())
 		{
-			// Build the shaders and the program : 
-			prgm 	= new HdlProgram;
-
 			#ifdef GLIP_USE_GL
-				const GLenum listShaderTypeEnum[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER, GL_GEOMETRY_SHADER};
-			#else
-				const GLenum listShaderTypeEnum[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER};
+			if(!(GLEW_VERSION_4_3 || GLEW_ARB_compute_shader))
 			#endif
-			for(unsigned int k=0; k<(sizeof(listShaderTypeEnum)/sizeof(GLenum)); k++)
+				throw Exception("Filter::Filter - Filter " + getFullName() + " is a compute filter, which requires OpenGL 4.3 or GL_ARB_compute_shader.", __FILE__, __LINE__, Exception::CoreException);
+
+			if(HdlTexture::getImageFormat(getGLMode())==GL_NONE)
+				throw Exception("Filter::Filter - The format " + getGLEnumNameSafe(getGLMode()) + " of the compute filter " + getFullName() + " cannot be bound as an image (a format with 1, 2 or 4 channels supported by the image load/store operations is required, see HdlTexture::getImageFormat).", __FILE__, __LINE__, Exception::CoreException);
+
+			const std::vector<std::string>& inputImages = getShaderSource(GL_COMPUTE_SHADER)->getInputImages();
+			for(int i=0; i<getNumInputPort(); i++)
+				imageInputs[i] = (std::find(inputImages.begin(), inputImages.end(), getInputPortName(i))!=inputImages.end());
+		}
+
+		#ifdef GLIP_USE_GL
+			const GLenum listShaderTypeEnum[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER, GL_GEOMETRY_SHADER};
+		#else
+			const GLenum listShaderTypeEnum[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER};
+		#endif
+		const unsigned int numShaderTypesEnum = sizeof(listShaderTypeEnum)/sizeof(GLenum);
+
+		// Key of the program in the registry and in the cache (the sources and the outputs locations) :
+		std::string programKey;
+		if(HdlProgramRegistry::isEnabled() || HdlProgramCache::isEnabled())
+		{
+			for(unsigned int k=0; k<numShaderTypesEnum; k++)
 			{
 				const ShaderSource* ptr = getShaderSource(listShaderTypeEnum[k]);
 				if(ptr!=NULL)
-				{
-					shaders[k] = new HdlShader(listShaderTypeEnum[k], *ptr);
-					prgm->updateShader(*shaders[k], false);
-				}
+					programKey += getGLEnumNameSafe(listShaderTypeEnum[k]) + "\n" + ptr->getSource() + "\n";
 			}
-			prgm->link();
+			for(int i=0; i<getNumOutputPort(); i++)
+				programKey += getOutputPortName(i) + "\n";
 		}
-		catch(Exception& e)
-		{
-			for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
-			{
-				delete shaders[k];
-				shaders[k] = NULL;
-			}
 
-			delete prgm;
-			prgm = NULL;
+		// Share the program of an identical filter :
+		if(HdlProgramRegistry::isEnabled())
+			prgm = HdlProgramRegistry::acquire(programKey);
 
-			Exception m("Filter::Filter - Caught an exception while creating the shaders for " + getFullName(), __FILE__, __LINE__, Exception::CoreException);
-			m << e;
-			throw m;
+		if(prgm!=NULL)
+		{
+			// Start from the default values of the variables :
+			const std::vector<HdlDynamicData*>& defaultState = HdlProgramRegistry::getDefaultState(prgm);
+			for(std::vector<HdlDynamicData*>::const_iterator it=defaultState.begin(); it!=defaultState.end(); it++)
+				uniformsState.push_back((*it!=NULL) ? HdlDynamicData::copy(**it) : NULL);
 		}
-
-		try
+		else
 		{
-			// Test if this filter is using out vec4's : 
-			bool allRequireCompatibility = true;
-			for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
-				allRequireCompatibility = allRequireCompatibility && (shaders[k]==NULL || shaders[k]->requiresCompatibility());
+			bool restored = false;
 
-			if(!allRequireCompatibility)
+			try
 			{
-				for(int i=0; i<getNumOutputPort(); i++)
-					prgm->setFragmentLocation(getOutputPortName(i), i);
+				// Build the shaders and the program : 
+				prgm 	= new HdlProgram;
+
+				if(HdlProgramCache::isEnabled())
+					restored = HdlProgramCache::load(programKey, *prgm);
 
-				// Now link to apply the change of locations (link must be done before setting any uniform values, including input sampler2D) : 
-				prgm->link();
+				if(!restored)
+				{
+					for(unsigned int k=0; k<numShaderTypesEnum; k++)
+					{
+						const ShaderSource* ptr = getShaderSource(listShaderTypeEnum[k]);
+						if(ptr!=NULL)
+						{
+							shaders[k] = new HdlShader(listShaderTypeEnum[k], *ptr);
+							prgm->updateShader(*shaders[k], false);
+						}
+					}
+					prgm->link();
+				}
 			}
+			catch(Exception& e)
+			{
+				for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
+				{
+					delete shaders[k];
+					shaders[k] = NULL;
+				}
 
-			// Set the names of the samplers :
-			for(int i=0; i<getNumInputPort(); i++)
-				prgm->setVar(getInputPortName(i), GL_INT, i);
-			
-			prgm->stopProgram();
-		}
-		catch(Exception& e)
-		{
-			for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
+				delete prgm;
+				prgm = NULL;
+
+				Exception m("Filter::Filter - Caught an exception while creating the shaders for " + getFullName(), __FILE__, __LINE__, Exception::CoreException);
+				m << e;
+				throw m;
+			}
+
+			try
 			{
-				delete shaders[k];
-				shaders[k] = NULL;
+				// Test if this filter is using out vec4's : 
+				bool allRequireCompatibility = true;
+				for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
+					allRequireCompatibility = allRequireCompatibility && (shaders[k]==NULL || shaders[k]->requiresCompatibility());
+
+				if(!restored && !allRequireCompatibility && !isCompute())
+				{
+					for(int i=0; i<getNumOutputPort(); i++)
+						prgm->setFragmentLocation(getOutputPortName(i), i);
+
+					// Now link to apply the change of locations (link must be done before setting any uniform values, including input sampler2D) : 
+					prgm->link();
+				}
+
+				if(!restored && HdlProgramCache::isEnabled())
+					HdlProgramCache::store(programKey, *prgm);
+
+				// Set the names of the samplers (and the units of the images, after the outputs) :
+				for(int i=0; i<getNumInputPort(); i++)
+					prgm->setVar(getInputPortName(i), GL_INT, imageInputs[i] ? (getNumOutputPort() + i) : i);
+
+				if(isCompute())
+				{
+					for(int i=0; i<getNumOutputPort(); i++)
+						prgm->setVar(getOutputPortName(i), GL_INT, i);
+				}
+				
+				prgm->stopProgram();
+
+				// Give the program and the shaders to the registry :
+				if(HdlProgramRegistry::isEnabled())
+				{
+					std::vector<HdlShader*> programShaders;
+					for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
+					{
+						if(shaders[k]!=NULL)
+							programShaders.push_back(shaders[k]);
+						shaders[k] = NULL;
+					}
+
+					HdlProgramRegistry::add(programKey, prgm, programShaders, this);
+				}
 			}
+			catch(Exception& e)
+			{
+				for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
+				{
+					delete shaders[k];
+					shaders[k] = NULL;
+				}
 
-			delete prgm;
-			prgm = NULL;
+				delete prgm;
+				prgm = NULL;
 
-			Exception m("Filter::Filter - Caught an exception while editing the samplers for " + getFullName(), __FILE__, __LINE__, Exception::CoreException);
-			m << e;
-			throw m;
+				Exception m("Filter::Filter - Caught an exception while editing the samplers for " + getFullName(), __FILE__, __LINE__, Exception::CoreException);
+				m << e;
+				throw m;
+			}
+		}
+
+		// Build the geometry, or get the size of the work groups (checked on the first run) :
+		if(!isCompute())
+			geometry = new GeometryInstance( getGeometryModel(), GL_STATIC_DRAW );
+		else
+		{
+			prgm->getWorkGroupSize(workGroupSize[0], workGroupSize[1], workGroupSize[2]);
+			regionOriginLocation = prgm->getUniformLocation(ComputeFilterLayout::regionOriginName);
 		}
 
-		// Build the geometry :
-		geometry = new GeometryInstance( getGeometryModel(), GL_STATIC_DRAW );
+		// The initialization of the samplers is not a modification :
+		uniformsModifications = prgm->getModificationsCount();
 
 		// Finally : 
 		broken = false;
@@ -504,12 +698,46 @@
 
 	Filter::~Filter(void)
 	{
-		delete prgm;
+		if(HdlProgramRegistry::isRegistered(prgm))
+			HdlProgramRegistry::release(prgm, this);
+		else
+			delete prgm;
 		for(unsigned int k=0; k<HandleOpenGL::numShaderTypes; k++)
 			delete shaders[k];
+		for(std::vector<HdlDynamicData*>::iterator it=uniformsState.begin(); it!=uniformsState.end(); it++)
+			delete *it;
 		delete geometry;
 	}
 
+	/**
+	\fn void Filter::acquireProgram(void)
+	\brief Load the uniform variables of this filter in its program, if the program is shared with other filters (see HdlProgramRegistry). The variables of the previous owner are saved first.
+	**/
+	void Filter::acquireProgram(void)
+	{
+		// The last user of a shared program might not own it (if the owner was released) :
+		if(!HdlProgramRegistry::isRegistered(prgm))
+			return;
+
+		const void* owner = HdlProgramRegistry::getOwner(prgm);
+
+		if(owner!=this)
+		{
+			if(owner!=NULL)
+			{
+				Filter* previous = const_cast<Filter*>(reinterpret_cast<const Filter*>(owner));
+				previous->getUniformsVersion();
+				prgm->saveUniforms(previous->uniformsState);
+			}
+
+			prgm->restoreUniforms(uniformsState);
+			HdlProgramRegistry::setOwner(prgm, this);
+
+			// Loading the variables of this filter is not a modification :
+			uniformsModifications = prgm->getModificationsCount();
+		}
+	}
+
 	/**
 	\fn void Filter::setInputForNextRendering(int id, HdlTexture* ptr)
 	\brief Sets input texture for next rendering.
@@ -523,6 +751,22 @@
 		arguments[id] = ptr;
 	}
 
+	/**
+	\fn void Filter::setRegionForNextRendering(int x, int y, int width, int height)
+	\brief Restrict the next rendering to a region of the outputs, the other pixels are left untouched (see HdlFBO::beginRendering).
+	\param x Left edge of the region.
+	\param y Bottom edge of the region.
+	\param width Width of the region. Default is 0 which means the whole outputs.
+	\param height Height of the region. Default is 0 which means the whole outputs.
+	**/
+	void Filter::setRegionForNextRendering(int x, int y, int width, int height)
+	{
+		region[0] = x;
+		region[1] = y;
+		region[2] = width;
+		region[3] = height;
+	}
+
 	/**
 	\fn void Filter::process(HdlFBO& renderer)
 	\brief Start the rendering process.
@@ -532,35 +776,27 @@
 	{
 		if(renderer.getAttachmentCount()<getNumOutputPort())
 			throw Exception("Filter::process - Renderer doesn't have as many texture targets as Filter " + getFullName() + " has outputs.", __FILE__, __LINE__, Exception::CoreException);
+
+		if(isCompute())
+		{
+			dispatch(renderer);
+			return ;
+		}
 		
 		// Pre-depth test : 
 			if(isDepthTestingEnabled() && !renderer.hasDepthBuffer())
 				renderer.addDepthBuffer();
 
-		// Prepare the renderer	
-			renderer.beginRendering(getNumOutputPort(), isDepthTestingEnabled());
+		// Prepare the renderer (the target might be larger than this filter, see Pipeline::AllowSubRectangleReuse) :
+			renderer.beginRendering(getNumOutputPort(), isDepthTestingEnabled(), getWidth(), getHeight(), region[0], region[1], region[2], region[3]);
 	
 		// Enable states
-			if(isDepthTestingEnabled())
-			{
-				glEnable(GL_DEPTH_TEST);
-				glDepthFunc(getDepthTestingFunction());
-			}
-			else
-				glDisable(GL_DEPTH_TEST);
-
-			if(isBlendingEnabled())
-			{
-				glEnable(GL_BLEND);
-				glBlendFunc(getSFactor(), getDFactor());
-				glBlendEquation(getBlendingEquation());
-			}
-			else
-				glDisable(GL_BLEND);
+			GLStateCache::setDepthTesting(isDepthTestingEnabled(), getDepthTestingFunction());
+			GLStateCache::setBlending(isBlendingEnabled(), getSFactor(), getDFactor(), getBlendingEquation());
 
 			if(isClearingEnabled())
 			{
-				glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+				GLStateCache::setClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 			}
 
@@ -574,6 +810,7 @@
 		#endif
 
 		// Load the shader
+			acquireProgram();
 			prgm->use();
 			
 		// Test on first run : 
@@ -613,19 +850,23 @@
 				}
 			}
 
-		// Stop using the shader
-			HdlProgram::stopProgram();
+		// Inside a GLStateCache scope (see Pipeline::process), the state is left as is for the next filter and restored at the end of the scope :
+			if(!GLStateCache::isActive())
+			{
+				// Stop using the shader
+					HdlProgram::stopProgram();
 
-		// Remove from stack
-			if(isDepthTestingEnabled())
-				glDisable(GL_DEPTH_TEST);
+				// Remove from stack
+					if(isDepthTestingEnabled())
+						GLStateCache::setDepthTesting(false);
 
-			if(isBlendingEnabled())
-				glDisable(GL_BLEND);
+					if(isBlendingEnabled())
+						GLStateCache::setBlending(false);
 
-		// Unload
-			for(int i=0; i<getNumInputPort(); i++)
-				HdlTexture::unbind(i);
+				// Unload
+					for(int i=0; i<getNumInputPort(); i++)
+						HdlTexture::unbind(i);
+			}
 
 		// End rendering
 			renderer.endRendering();
@@ -646,16 +887,184 @@
 			}
 	}
 
+	/**
+	\fn void Filter::dispatch(HdlFBO& renderer)
+	\brief Run the compute shader over the targets of the renderer, bound as images.
+	\param renderer The FBO holding the targets.
+	**/
+	void Filter::dispatch(HdlFBO& renderer)
+	{
+		#ifdef GLIP_USE_GL
+			if(workGroupSize[0]<=0 || workGroupSize[1]<=0)
+			{
+				firstRun	= false;
+				broken		= true;
+				throw Exception("Filter::process - Unable to read the size of the work groups of the compute filter " + getFullName() + ".", __FILE__, __LINE__, Exception::CoreException);
+			}
+
+			// The region of the outputs to compute :
+			int	x	= region[0],
+				y	= region[1],
+				width	= (region[2]<=0) ? getWidth() : region[2],
+				height	= (region[3]<=0) ? getHeight() : region[3];
+
+			// Clear through the framebuffer (the whole targets are bound as images) :
+			if(isClearingEnabled())
+			{
+				renderer.beginRendering(getNumOutputPort(), false, getWidth(), getHeight(), region[0], region[1], region[2], region[3]);
+				GLStateCache::setClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+				glClear(GL_COLOR_BUFFER_BIT);
+				renderer.endRendering();
+			}
+
+			// Bind the inputs and the outputs :
+			for(int i=0; i<getNumInputPort(); i++)
+			{
+				if(imageInputs[i])
+				{
+					const GLenum imageFormat = HdlTexture::getImageFormat(arguments[i]->getGLMode());
+					if(imageFormat==GL_NONE)
+						throw Exception("Filter::process - The format " + getGLEnumNameSafe(arguments[i]->getGLMode()) + " of the input " + getInputPortName(i) + " of the compute filter " + getFullName() + " cannot be bound as an image.", __FILE__, __LINE__, Exception::CoreException);
+					glBindImageTexture(getNumOutputPort() + i, arguments[i]->getID(), 0, GL_FALSE, 0, GL_READ_ONLY, imageFormat);
+				}
+				else
+					arguments[i]->bind(i);
+			}
+
+			for(int i=0; i<getNumOutputPort(); i++)
+			{
+				HdlTexture* target = renderer[i];
+				glBindImageTexture(i, target->getID(), 0, GL_FALSE, 0, GL_READ_WRITE, HdlTexture::getImageFormat(target->getGLMode()));
+			}
+
+			acquireProgram();
+			prgm->use();
+
+			// The invocations start at the bottom-left corner of the region, given to the shader (not a modification of the variables of the filter). Otherwise, they start at the corner of the outputs :
+			if(regionOriginLocation!=-1)
+				glUniform2i(regionOriginLocation, x, y);
+			else
+			{
+				width	+= x;
+				height	+= y;
+			}
+
+			const GLuint	numGroupsX = (width + workGroupSize[0] - 1) / workGroupSize[0],
+					numGroupsY = (height + workGroupSize[1] - 1) / workGroupSize[1];
+
+			glDispatchCompute(numGroupsX, numGroupsY, 1);
+
+			if(firstRun)
+			{
+				const GLenum err = glGetError();
+
+				if(err!=GL_NO_ERROR)
+				{
+					HdlProgram::stopProgram();
+
+					firstRun 	= false;
+					broken 		= true;
+					throw Exception("Filter::process : Exception caught on first run of filter " + getFullName() + ". The error occured after the dispatch of the compute shader, GL error : " + getGLEnumNameSafe(err) + " - " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::CoreException);
+				}
+				else
+					firstRun	= false;
+			}
+
+			// The mipmaps are built from the written images :
+			if(renderer.getMaxLevel()>0)
+			{
+				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+				for(int i=0; i<getNumOutputPort(); i++)
+				{
+					GLStateCache::bindTexture(renderer[i]->getID());
+					glGenerateMipmap(GL_TEXTURE_2D);
+				}
+				GLStateCache::bindTexture(0);
+			}
+
+			if(!GLStateCache::isActive())
+			{
+				HdlProgram::stopProgram();
+
+				for(int i=0; i<getNumInputPort(); i++)
+				{
+					if(!imageInputs[i])
+						HdlTexture::unbind(i);
+				}
+			}
+		#else
+			UNUSED_PARAMETER(renderer)
+			throw Exception("Filter::process - Compute filters are not currently supported under GLES.", __FILE__, __LINE__, Exception::GLException);
+		#endif
+	}
+
 	/**
 	\fn HdlProgram& Filter::program(void)
-	\brief Access the program carried.
+	\brief Access the program carried. If the program is shared with identical filters (see HdlProgramRegistry), the uniform variables of this filter are loaded first. The reference should not be kept across the processing of other filters.
 	\return Reference to the program.
 	**/
 	HdlProgram& Filter::program(void)
 	{
+		acquireProgram();
 		return *prgm;
 	}
 
+	/**
+	\fn int Filter::getWorkGroupSize(int i) const
+	\brief Get the size of the work groups of a compute filter (see ComputeFilterLayout), as declared by its shader.
+	\param i The dimension (0 for X, 1 for Y, 2 for Z).
+	\return The number of invocations along this dimension, or 0 if the filter is not a compute filter.
+	**/
+	int Filter::getWorkGroupSize(int i) const
+	{
+		if(i<0 || i>2)
+			throw Exception("Filter::getWorkGroupSize - Invalid dimension " + toString(i) + ".", __FILE__, __LINE__, Exception::CoreException);
+
+		return workGroupSize[i];
+	}
+
+	/**
+	\fn unsigned int Filter::getUniformsVersion(void)
+	\brief Get the version of the uniform variables of this filter. It is incremented when at least one of the variables was modified (see HdlProgram::getModificationsCount) since the previous call, and can be used to detect changes.
+	\return The version of the uniform variables.
+	**/
+	unsigned int Filter::getUniformsVersion(void)
+	{
+		// If the program is shared, only its current owner can have been modified :
+		const bool loaded = !HdlProgramRegistry::isRegistered(prgm) || HdlProgramRegistry::getOwner(prgm)==this;
+
+		if(loaded && prgm->getModificationsCount()!=uniformsModifications)
+		{
+			uniformsModifications = prgm->getModificationsCount();
+			uniformsVersion++;
+		}
+
+		return uniformsVersion;
+	}
+
+	/**
+	\fn int Filter::getCurrentHalo(void)
+	\brief Get the current halo of the filter (see AbstractFilterLayout::getHalo), reading the uniform variable holding it if needed (see AbstractFilterLayout::getHaloVariable).
+	\return The halo, in pixels of the inputs, or -1 if it is unknown.
+	**/
+	int Filter::getCurrentHalo(void)
+	{
+		if(getHaloVariable().empty())
+			return getHalo();
+
+		const std::vector<std::string>&	names = prgm->getUniformsNames();
+		const std::vector<GLenum>&	types = prgm->getUniformsTypes();
+		std::vector<std::string>::const_iterator it = std::find(names.begin(), names.end(), getHaloVariable());
+
+		if(it==names.end() || types[it - names.begin()]!=GL_INT)
+			throw Exception("Filter::getCurrentHalo - The halo of the filter " + getFullName() + " is given by the variable \"" + getHaloVariable() + "\" which is not an active integer uniform variable of its program.", __FILE__, __LINE__, Exception::CoreException);
+
+		int value = -1;
+		program().getVar(getHaloVariable(), &value);
+
+		return (value<0) ? -1 : value;
+	}
+
 	/**
 	\fn bool Filter::wentThroughFirstRun(void) const
 	\brief Check if the filter was already applied, at least once.
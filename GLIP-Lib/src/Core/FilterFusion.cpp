@@ -0,0 +1,870 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : FilterFusion.cpp                                                                          */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Fusion of chains of pointwise filters into a single shader.                               */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    FilterFusion.cpp
+ * \brief   Fusion of chains of pointwise filters into a single shader.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <map>
+#include "Core/Exception.hpp"
+#include "Core/FilterFusion.hpp"
+
+using namespace Glip::CoreGL;
+using namespace Glip::CorePipeline;
+
+// FilterFusion
+	/**
+	\fn void FilterFusion::tokenize(const std::string& source, std::vector<Token>& tokens)
+	\brief Split a GLSL source into tokens. Whitespaces and comments are kept as blank tokens and the preprocessor lines as single directive tokens, so that the source can be written back.
+	\param source The source.
+	\param tokens The tokens (output).
+	**/
+	void FilterFusion::tokenize(const std::string& source, std::vector<Token>& tokens)
+	{
+		const size_t n = source.size();
+		size_t i = 0;
+		bool lineStart = true;
+
+		tokens.clear();
+
+		while(i<n)
+		{
+			const char c = source[i];
+			const char next = (i+1<n) ? source[i+1] : '\0';
+			size_t j = i+1;
+			Token t;
+
+			if(c=='\n')
+			{
+				t.kind = Blank;
+				lineStart = true;
+			}
+			else if(c==' ' || c=='\t' || c=='\r')
+			{
+				while(j<n && (source[j]==' ' || source[j]=='\t' || source[j]=='\r'))
+					j++;
+				t.kind = Blank;
+			}
+			else if(c=='#' && lineStart)
+			{
+				// Until the end of the line, with continuations :
+				while(j<n && !(source[j]=='\n' && source[j-1]!='\\'))
+					j++;
+				t.kind = Directive;
+			}
+			else if(c=='/' && next=='/')
+			{
+				while(j<n && source[j]!='\n')
+					j++;
+				t.kind = Blank;
+			}
+			else if(c=='/' && next=='*')
+			{
+				j = source.find("*/", i+2);
+				j = (j==std::string::npos) ? n : j+2;
+				t.kind = Blank;
+			}
+			else if(std::isalpha(c) || c=='_')
+			{
+				while(j<n && (std::isalnum(source[j]) || source[j]=='_'))
+					j++;
+				t.kind = Identifier;
+			}
+			else if(std::isdigit(c) || (c=='.' && std::isdigit(next)))
+			{
+				while(j<n && (std::isalnum(source[j]) || source[j]=='.' || source[j]=='_' || ((source[j]=='+' || source[j]=='-') && (source[j-1]=='e' || source[j-1]=='E'))))
+					j++;
+				t.kind = Number;
+			}
+			else
+			{
+				static const char* operators[] = {"<<=", ">>=", "==", "!=", "<=", ">=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "++", "--", "&&", "||", "^^", "<<", ">>"};
+				const size_t numOperators = sizeof(operators)/sizeof(operators[0]);
+
+				for(size_t k=0; k<numOperators; k++)
+				{
+					const std::string op = operators[k];
+					if(source.compare(i, op.size(), op)==0)
+					{
+						j = i + op.size();
+						break;
+					}
+				}
+				t.kind = Symbol;
+			}
+
+			if(t.kind!=Blank)
+				lineStart = false;
+
+			t.text = source.substr(i, j-i);
+			tokens.push_back(t);
+			i = j;
+		}
+	}
+
+	/**
+	\fn bool FilterFusion::isReserved(const std::string& word)
+	\brief Test if a word is a GLSL keyword, type or built-in function (which must not be renamed).
+	\param word The word to test.
+	\return True if the word is reserved.
+	**/
+	bool FilterFusion::isReserved(const std::string& word)
+	{
+		static const char* reservedList[] = {	"attribute", "const", "uniform", "varying", "buffer", "shared", "coherent", "volatile", "restrict", "readonly", "writeonly", "layout", "centroid", "flat", "smooth", "noperspective", "patch", "sample", "break", "continue", "do", "for", "while", "switch", "case", "default", "if", "else", "subroutine", "in", "out", "inout", "true", "false", "invariant", "precise", "discard", "return", "lowp", "mediump", "highp", "precision", "struct", "void", "bool", "int", "uint", "float", "double", "atomic_uint", "defined",
+							"abs", "acos", "acosh", "all", "any", "asin", "asinh", "atan", "atanh", "barrier", "bitCount", "bitfieldExtract", "bitfieldInsert", "bitfieldReverse", "ceil", "clamp", "cos", "cosh", "cross", "degrees", "determinant", "dFdx", "dFdy", "dFdxCoarse", "dFdxFine", "dFdyCoarse", "dFdyFine", "distance", "dot", "equal", "exp", "exp2", "faceforward", "findLSB", "findMSB", "floatBitsToInt", "floatBitsToUint", "floor", "fma", "fract", "frexp", "fwidth", "fwidthCoarse", "fwidthFine", "greaterThan", "greaterThanEqual", "imulExtended", "intBitsToFloat", "interpolateAtCentroid", "interpolateAtOffset", "interpolateAtSample", "inverse", "inversesqrt", "isinf", "isnan", "ldexp", "length", "lessThan", "lessThanEqual", "log", "log2", "matrixCompMult", "max", "memoryBarrier", "memoryBarrierShared", "memoryBarrierImage", "memoryBarrierBuffer", "groupMemoryBarrier", "min", "mix", "mod", "modf", "noise1", "noise2", "noise3", "noise4", "normalize", "not", "notEqual", "outerProduct", "packDouble2x32", "packHalf2x16", "packSnorm2x16", "packSnorm4x8", "packUnorm2x16", "packUnorm4x8", "pow", "radians", "reflect", "refract", "round", "roundEven", "sign", "sin", "sinh", "smoothstep", "sqrt", "step", "tan", "tanh", "transpose", "trunc", "uaddCarry", "umulExtended", "unpackDouble2x32", "unpackHalf2x16", "unpackSnorm2x16", "unpackSnorm4x8", "unpackUnorm2x16", "unpackUnorm4x8", "usubBorrow", "uintBitsToFloat",
+							"texelFetch", "texelFetchOffset", "texture", "textureGather", "textureGatherOffset", "textureGatherOffsets", "textureGrad", "textureGradOffset", "textureLod", "textureLodOffset", "textureOffset", "textureProj", "textureProjGrad", "textureProjGradOffset", "textureProjLod", "textureProjLodOffset", "textureProjOffset", "textureQueryLevels", "textureQueryLod", "textureSize", "texture1D", "texture1DLod", "texture1DProj", "texture2D", "texture2DLod", "texture2DProj", "texture2DProjLod", "texture3D", "texture3DLod", "texture3DProj", "textureCube", "textureCubeLod", "shadow2D", "shadow2DProj", "ftransform",
+							"imageLoad", "imageStore", "imageSize", "imageAtomicAdd", "imageAtomicMin", "imageAtomicMax", "imageAtomicAnd", "imageAtomicOr", "imageAtomicXor", "imageAtomicExchange", "imageAtomicCompSwap", "atomicAdd", "atomicMin", "atomicMax", "atomicAnd", "atomicOr", "atomicXor", "atomicExchange", "atomicCompSwap", "atomicCounter", "atomicCounterIncrement", "atomicCounterDecrement", "EmitVertex", "EndPrimitive"};
+		static const std::set<std::string> reserved(reservedList, reservedList + sizeof(reservedList)/sizeof(reservedList[0]));
+
+		if(reserved.find(word)!=reserved.end())
+			return true;
+
+		// Types (vectors, matrices, samplers and images) :
+		static const char* typesPrefixes[] = {"vec", "ivec", "uvec", "bvec", "dvec", "mat", "dmat", "sampler", "isampler", "usampler", "image", "iimage", "uimage"};
+		for(size_t k=0; k<sizeof(typesPrefixes)/sizeof(typesPrefixes[0]); k++)
+		{
+			const std::string prefix = typesPrefixes[k];
+			if(word.compare(0, prefix.size(), prefix)==0 && word.size()>prefix.size() && (std::isdigit(word[prefix.size()]) || std::isupper(word[prefix.size()])))
+				return true;
+		}
+
+		return word.compare(0, 3, "gl_")==0;
+	}
+
+	/**
+	\fn int FilterFusion::nextToken(const std::vector<Token>& tokens, int k)
+	\brief Find the next non-blank token.
+	\param tokens The tokens.
+	\param k The current index.
+	\return The index of the next non-blank token, or -1 if there is none.
+	**/
+	int FilterFusion::nextToken(const std::vector<Token>& tokens, int k)
+	{
+		for(k=k+1; k<static_cast<int>(tokens.size()); k++)
+		{
+			if(tokens[k].kind!=Blank)
+				return k;
+		}
+		return -1;
+	}
+
+	/**
+	\fn int FilterFusion::previousToken(const std::vector<Token>& tokens, int k)
+	\brief Find the previous non-blank token.
+	\param tokens The tokens.
+	\param k The current index.
+	\return The index of the previous non-blank token, or -1 if there is none.
+	**/
+	int FilterFusion::previousToken(const std::vector<Token>& tokens, int k)
+	{
+		for(k=k-1; k>=0; k--)
+		{
+			if(tokens[k].kind!=Blank)
+				return k;
+		}
+		return -1;
+	}
+
+	/**
+	\fn int FilterFusion::matchingParenthesis(const std::vector<Token>& tokens, int k)
+	\brief Find the closing parenthesis.
+	\param tokens The tokens.
+	\param k The index of the opening parenthesis.
+	\return The index of the closing parenthesis, or -1 if there is none.
+	**/
+	int FilterFusion::matchingParenthesis(const std::vector<Token>& tokens, int k)
+	{
+		int level = 0;
+		for(; k<static_cast<int>(tokens.size()); k++)
+		{
+			if(tokens[k].text=="(")
+				level++;
+			else if(tokens[k].text==")")
+			{
+				level--;
+				if(level==0)
+					return k;
+			}
+		}
+		return -1;
+	}
+
+	/**
+	\fn std::string FilterFusion::compact(const std::vector<Token>& tokens, int begin, int end)
+	\brief Concatenate the non-blank tokens of a range.
+	\param tokens The tokens.
+	\param begin The first token.
+	\param end The last token (included).
+	\return The expression, without blanks.
+	**/
+	std::string FilterFusion::compact(const std::vector<Token>& tokens, int begin, int end)
+	{
+		std::string res;
+		for(int k=begin; k<=end; k++)
+		{
+			if(tokens[k].kind!=Blank)
+				res += tokens[k].text;
+		}
+		return res;
+	}
+
+	/**
+	\fn bool FilterFusion::isZero(const std::string& str)
+	\brief Test if a literal is zero.
+	\param str The literal.
+	\return True if the literal is a zero integer or floating point value.
+	**/
+	bool FilterFusion::isZero(const std::string& str)
+	{
+		if(str.empty() || !(std::isdigit(str[0]) || str[0]=='.'))
+			return false;
+
+		char* end = NULL;
+		const double value = std::strtod(str.c_str(), &end);
+
+		return (*end=='\0' || ((*end=='f' || *end=='F') && *(end+1)=='\0')) && value==0.0;
+	}
+
+	/**
+	\fn bool FilterFusion::isSizeExpression(const std::vector<Token>& tokens, const std::string& expr, const std::string& samplerName, int width, int height)
+	\brief Test if a compacted expression evaluates to the size of the texture.
+	\param tokens The tokens of the source (to resolve the constants).
+	\param expr The expression.
+	\param samplerName The name of the sampler.
+	\param width The width of the texture.
+	\param height The height of the texture.
+	\return True if the expression is the size of the texture.
+	**/
+	bool FilterFusion::isSizeExpression(const std::vector<Token>& tokens, const std::string& expr, const std::string& samplerName, int width, int height)
+	{
+		if(expr=="textureSize(" + samplerName + ",0)")
+			return true;
+
+		// Constructors :
+		std::string inner;
+		if(expr.compare(0, 5, "vec2(")==0 && expr[expr.size()-1]==')')
+			inner = expr.substr(5, expr.size()-6);
+		else if(expr.compare(0, 6, "ivec2(")==0 && expr[expr.size()-1]==')')
+			inner = expr.substr(6, expr.size()-7);
+
+		if(!inner.empty())
+		{
+			const size_t comma = inner.find(',');
+
+			if(comma==std::string::npos)
+				return isSizeExpression(tokens, inner, samplerName, width, height);
+			else if(inner.find_first_of("(,", comma+1)!=std::string::npos)
+				return false;
+			else
+			{
+				const std::string	a = inner.substr(0, comma),
+							b = inner.substr(comma+1);
+				char	*endA = NULL,
+					*endB = NULL;
+				const double	va = std::strtod(a.c_str(), &endA),
+						vb = std::strtod(b.c_str(), &endB);
+
+				return !a.empty() && !b.empty() && *endA=='\0' && *endB=='\0' && va==static_cast<double>(width) && vb==static_cast<double>(height);
+			}
+		}
+
+		// Constant (const ivec2 name = ivec2(w, h);) :
+		for(std::string::const_iterator it=expr.begin(); it!=expr.end(); it++)
+		{
+			if(!std::isalnum(*it) && *it!='_')
+				return false;
+		}
+
+		for(int k=0; k<static_cast<int>(tokens.size()); k++)
+		{
+			if(tokens[k].kind!=Identifier || tokens[k].text!=expr)
+				continue;
+
+			const int	t = previousToken(tokens, k),
+					c = (t>=0) ? previousToken(tokens, t) : -1,
+					e = nextToken(tokens, k);
+
+			if(t>=0 && c>=0 && e>=0 && tokens[c].text=="const" && (tokens[t].text=="ivec2" || tokens[t].text=="vec2") && tokens[e].text=="=")
+			{
+				int end = e+1;
+				while(end<static_cast<int>(tokens.size()) && tokens[end].text!=";")
+					end++;
+
+				return (end<static_cast<int>(tokens.size())) && isSizeExpression(tokens, compact(tokens, e+1, end-1), samplerName, width, height);
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	\fn bool FilterFusion::isFragmentCoordinates(const std::vector<Token>& tokens, const std::string& expr, const std::string& samplerName, int width, int height, bool integer, int depth)
+	\brief Test if a compacted expression is the coordinates of the current fragment.
+	\param tokens The tokens of the source (to resolve the variables).
+	\param expr The expression.
+	\param samplerName The name of the sampler.
+	\param width The width of the texture.
+	\param height The height of the texture.
+	\param integer True for texel coordinates (texelFetch), false for normalized coordinates.
+	\param depth Depth of the resolution of the variables.
+	\return True if the expression is the coordinates of the current fragment.
+	**/
+	bool FilterFusion::isFragmentCoordinates(const std::vector<Token>& tokens, const std::string& expr, const std::string& samplerName, int width, int height, bool integer, int depth)
+	{
+		if(integer)
+		{
+			if(expr=="ivec2(gl_FragCoord.xy)" || expr=="ivec2(gl_FragCoord.x,gl_FragCoord.y)" || expr=="ivec2(floor(gl_FragCoord.xy))")
+				return true;
+		}
+		else
+		{
+			const std::string fragCoord = "gl_FragCoord.xy/";
+
+			if(expr=="gl_TexCoord[0].st" || expr=="gl_TexCoord[0].xy")
+				return true;
+			else if(expr.compare(0, fragCoord.size(), fragCoord)==0)
+				return isSizeExpression(tokens, expr.substr(fragCoord.size()), samplerName, width, height);
+		}
+
+		// Single-assignment local variable :
+		if(depth>0 || expr.empty())
+			return false;
+
+		for(std::string::const_iterator it=expr.begin(); it!=expr.end(); it++)
+		{
+			if(!std::isalnum(*it) && *it!='_')
+				return false;
+		}
+
+		const std::string type = integer ? "ivec2" : "vec2";
+		int declaration = -1;
+
+		for(int k=0; k<static_cast<int>(tokens.size()); k++)
+		{
+			if(tokens[k].kind!=Identifier || tokens[k].text!=expr)
+				continue;
+
+			const int 	p = previousToken(tokens, k),
+					n = nextToken(tokens, k);
+
+			if(p>=0 && tokens[p].text==".")
+				continue;
+
+			if(p>=0 && n>=0 && tokens[p].text==type && tokens[n].text=="=")
+			{
+				if(declaration>=0)
+					return false; // Declared twice.
+				declaration = k;
+			}
+			else
+			{
+				// Any other modification is rejected :
+				static const char* assignments[] = {"=", "+=", "-=", "*=", "/=", "%=", "++", "--", "["};
+				const char** assignmentsEnd = assignments + sizeof(assignments)/sizeof(assignments[0]);
+
+				if(n>=0 && std::find(assignmentsEnd - sizeof(assignments)/sizeof(assignments[0]), assignmentsEnd, tokens[n].text)!=assignmentsEnd)
+					return false;
+				if(p>=0 && (tokens[p].text=="++" || tokens[p].text=="--"))
+					return false;
+				if(n>=0 && tokens[n].text==".")
+				{
+					const int s = nextToken(tokens, n);
+					const int a = (s>=0) ? nextToken(tokens, s) : -1;
+					if(a>=0 && std::find(assignmentsEnd - sizeof(assignments)/sizeof(assignments[0]), assignmentsEnd, tokens[a].text)!=assignmentsEnd)
+						return false;
+				}
+
+				// Passed to a user function (possibly as an out parameter) :
+				if(p>=0 && n>=0 && (tokens[p].text=="(" || tokens[p].text==",") && (tokens[n].text==")" || tokens[n].text==","))
+				{
+					int level = 0,
+					    l = p;
+					for(; l>=0; l--)
+					{
+						if(tokens[l].text==")")
+							level++;
+						else if(tokens[l].text=="(")
+						{
+							if(level==0)
+								break;
+							level--;
+						}
+					}
+
+					const int f = (l>=0) ? previousToken(tokens, l) : -1;
+					if(f<0 || tokens[f].kind!=Identifier || !isReserved(tokens[f].text))
+						return false;
+				}
+			}
+		}
+
+		if(declaration<0)
+			return false;
+
+		// Read the initialization expression :
+		const int begin = nextToken(tokens, nextToken(tokens, declaration));
+		int 	end = begin,
+			level = 0;
+		for(; end>=0 && end<static_cast<int>(tokens.size()); end++)
+		{
+			if(tokens[end].text=="(")
+				level++;
+			else if(tokens[end].text==")")
+				level--;
+			else if(level==0 && (tokens[end].text=="," || tokens[end].text==";"))
+				break;
+		}
+
+		if(begin<0 || end>=static_cast<int>(tokens.size()))
+			return false;
+
+		return isFragmentCoordinates(tokens, compact(tokens, begin, end-1), samplerName, width, height, integer, depth+1);
+	}
+
+	/**
+	\fn bool FilterFusion::findSamplings(const std::vector<Token>& tokens, const std::string& samplerName, int width, int height, const std::string& value, std::vector<Replacement>& replacements, std::string& reason)
+	\brief Find all the uses of a sampler and test that they all are samplings at the current fragment (or size requests).
+	\param tokens The tokens of the source.
+	\param samplerName The name of the sampler.
+	\param width The width of the texture.
+	\param height The height of the texture.
+	\param value The expression replacing the samplings.
+	\param replacements The replacements of the calls (output).
+	\param reason The reason of the failure (output).
+	\return True if all the uses of the sampler can be replaced.
+	**/
+	bool FilterFusion::findSamplings(const std::vector<Token>& tokens, const std::string& samplerName, int width, int height, const std::string& value, std::vector<Replacement>& replacements, std::string& reason)
+	{
+		for(int k=0; k<static_cast<int>(tokens.size()); k++)
+		{
+			if(tokens[k].kind!=Identifier || tokens[k].text!=samplerName)
+				continue;
+
+			const int p = previousToken(tokens, k);
+
+			// Declaration (uniform sampler2D a, b, ...;) :
+			int s = p;
+			while(s>=0 && (tokens[s].kind==Identifier || tokens[s].text==",") && tokens[s].text!="uniform")
+				s = previousToken(tokens, s);
+			if(s>=0 && tokens[s].text=="uniform")
+				continue;
+
+			// Call :
+			const int f = (p>=0) ? previousToken(tokens, p) : -1;
+			if(p<0 || f<0 || tokens[p].text!="(" || tokens[f].kind!=Identifier)
+			{
+				reason = "the input " + samplerName + " is used outside of a sampling function";
+				return false;
+			}
+
+			const std::string fn = tokens[f].text;
+			const int close = matchingParenthesis(tokens, p);
+			if(close<0)
+			{
+				reason = "unbalanced parenthesis";
+				return false;
+			}
+
+			// Split the arguments :
+			std::vector<std::string> arguments;
+			int 	level = 0,
+				start = p+1;
+			for(int l=p+1; l<=close; l++)
+			{
+				if(tokens[l].text=="(" || tokens[l].text=="[")
+					level++;
+				else if((tokens[l].text==")" || tokens[l].text=="]") && l!=close)
+					level--;
+				else if((tokens[l].text=="," && level==0) || l==close)
+				{
+					arguments.push_back(compact(tokens, start, l-1));
+					start = l+1;
+				}
+			}
+
+			Replacement r;
+			r.begin	= f;
+			r.end	= close;
+
+			if(fn=="textureSize" && arguments.size()==2 && isZero(arguments[1]))
+				r.text = "ivec2(" + toString(width) + ", " + toString(height) + ")";
+			else if(((fn=="texture" || fn=="texture2D") && arguments.size()==2) || ((fn=="textureLod" || fn=="texture2DLod") && arguments.size()==3 && isZero(arguments[2])))
+			{
+				if(!isFragmentCoordinates(tokens, arguments[1], samplerName, width, height, false, 0))
+				{
+					reason = "the input " + samplerName + " is sampled at coordinates which are not the current fragment (" + arguments[1] + ")";
+					return false;
+				}
+				r.text = value;
+			}
+			else if(fn=="texelFetch" && arguments.size()==3 && isZero(arguments[2]))
+			{
+				if(!isFragmentCoordinates(tokens, arguments[1], samplerName, width, height, true, 0))
+				{
+					reason = "the input " + samplerName + " is fetched at coordinates which are not the current fragment (" + arguments[1] + ")";
+					return false;
+				}
+				r.text = value;
+			}
+			else
+			{
+				reason = "the input " + samplerName + " is used by " + fn + " with unsupported arguments";
+				return false;
+			}
+
+			replacements.push_back(r);
+		}
+
+		return true;
+	}
+
+	/**
+	\fn std::string FilterFusion::getConversion(const HdlAbstractTextureFormat& format, const std::string& value)
+	\brief Get the expression converting the output of a filter as it would be read from its texture.
+	\param format The format of the texture.
+	\param value The output variable.
+	\return The expression or an empty string if the format is not supported.
+	**/
+	std::string FilterFusion::getConversion(const HdlAbstractTextureFormat& format, const std::string& value)
+	{
+		std::string res;
+
+		switch(format.getFormatDescriptor().aliasMode)
+		{
+			case GL_RGBA :	res = value;					break;
+			case GL_RGB :	res = "vec4(" + value + ".rgb, 1.0)";		break;
+			case GL_RG :	res = "vec4(" + value + ".rg, 0.0, 1.0)";	break;
+			case GL_RED :	res = "vec4(" + value + ".r, 0.0, 0.0, 1.0)";	break;
+			default :	return "";
+		}
+
+		switch(format.getGLDepth())
+		{
+			case GL_FLOAT :
+			case GL_HALF_FLOAT :						break;
+			case GL_UNSIGNED_BYTE :
+			case GL_UNSIGNED_SHORT :	res = "clamp(" + res + ", 0.0, 1.0)";	break;
+			case GL_BYTE :
+			case GL_SHORT :			res = "clamp(" + res + ", -1.0, 1.0)";	break;
+			default :			return "";
+		}
+
+		return "(" + res + ")";
+	}
+
+	/**
+	\fn bool FilterFusion::isFusable(const AbstractFilterLayout& layout, std::string& reason)
+	\brief Test if a filter can be part of a fusion.
+	\param layout The layout of the filter.
+	\param reason The reason if the filter cannot be fused (output).
+	\return True if the filter can be fused.
+	**/
+	bool FilterFusion::isFusable(const AbstractFilterLayout& layout, std::string& reason)
+	{
+		#ifdef GLIP_USE_GL
+			const GLenum otherShaders[] = {GL_VERTEX_SHADER, GL_COMPUTE_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER, GL_GEOMETRY_SHADER};
+		#else
+			const GLenum otherShaders[] = {GL_VERTEX_SHADER, GL_COMPUTE_SHADER};
+		#endif
+
+		const ShaderSource* fragment = layout.getShaderSource(GL_FRAGMENT_SHADER);
+
+		if(fragment==NULL)
+		{
+			reason = "no fragment shader";
+			return false;
+		}
+
+		for(unsigned int k=0; k<sizeof(otherShaders)/sizeof(GLenum); k++)
+		{
+			if(layout.getShaderSource(otherShaders[k])!=NULL)
+			{
+				reason = "it has a " + getGLEnumNameSafe(otherShaders[k]);
+				return false;
+			}
+		}
+
+		if(!layout.isStandardGeometryModel())
+		{
+			reason = "it does not use the standard quad geometry";
+			return false;
+		}
+
+		if(fragment->requiresCompatibility() || fragment->getSource().find("gl_FragData")!=std::string::npos)
+		{
+			reason = "it writes to gl_FragColor/gl_FragData";
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	\fn bool FilterFusion::canFuse(const AbstractFilterLayout& producer, const AbstractFilterLayout& consumer, int consumerPort, std::string& reason)
+	\brief Test if a producer can be fused with the consumer reading its (single) output.
+	\param producer The layout of the producer.
+	\param consumer The layout of the consumer.
+	\param consumerPort The input port of the consumer connected to the output of the producer.
+	\param reason The reason if the filters cannot be fused (output).
+	\return True if the filters can be fused.
+	**/
+	bool FilterFusion::canFuse(const AbstractFilterLayout& producer, const AbstractFilterLayout& consumer, int consumerPort, std::string& reason)
+	{
+		if(!isFusable(producer, reason) || !isFusable(consumer, reason))
+			return false;
+
+		if(producer.getNumOutputPort()!=1)
+		{
+			reason = "the producer has several outputs";
+			return false;
+		}
+
+		if(producer.isBlendingEnabled() || producer.isDepthTestingEnabled())
+		{
+			reason = "the producer uses blending or depth testing";
+			return false;
+		}
+
+		if(producer.getWidth()!=consumer.getWidth() || producer.getHeight()!=consumer.getHeight())
+		{
+			reason = "the filters have different sizes";
+			return false;
+		}
+
+		if(getConversion(producer, "x").empty())
+		{
+			reason = "the output format of the producer is not supported (" + getGLEnumNameSafe(producer.getGLMode()) + ", " + getGLEnumNameSafe(producer.getGLDepth()) + ")";
+			return false;
+		}
+
+		std::vector<Token> tokens;
+		tokenize(producer.getShaderSource(GL_FRAGMENT_SHADER)->getSource(), tokens);
+		for(std::vector<Token>::const_iterator it=tokens.begin(); it!=tokens.end(); it++)
+		{
+			if(it->kind==Identifier && (it->text=="discard" || it->text=="layout"))
+			{
+				reason = "the producer uses " + it->text;
+				return false;
+			}
+		}
+
+		std::vector<Replacement> replacements;
+		tokenize(consumer.getShaderSource(GL_FRAGMENT_SHADER)->getSource(), tokens);
+		return findSamplings(tokens, consumer.getInputPortName(consumerPort), producer.getWidth(), producer.getHeight(), "x", replacements, reason);
+	}
+
+	/**
+	\fn ShaderSource FilterFusion::generate(const std::vector<const AbstractFilterLayout*>& chain, const std::vector<int>& fusedPorts, const std::vector<std::string>& prefixes)
+	\brief Generate the fragment shader of a chain of filters. Raise an exception if the chain cannot be fused (see FilterFusion::canFuse).
+	\param chain The layouts of the filters, in order.
+	\param fusedPorts For each filter, the input port reading the output of the previous filter (ignored for the first filter).
+	\param prefixes For each filter, the prefix added to all its identifiers.
+	\return The fused source. Its output ports are the outputs of the last filter and its input ports the remaining inputs of all the filters, prefixed.
+	**/
+	ShaderSource FilterFusion::generate(const std::vector<const AbstractFilterLayout*>& chain, const std::vector<int>& fusedPorts, const std::vector<std::string>& prefixes)
+	{
+		if(chain.size()<2 || fusedPorts.size()!=chain.size() || prefixes.size()!=chain.size())
+			throw Exception("FilterFusion::generate - Invalid chain description.", __FILE__, __LINE__, Exception::CoreException);
+
+		std::vector< std::vector<Token> > 	tokens(chain.size());
+		std::string	versionLine,
+				extensionLines,
+				body;
+		int 		version = -1;
+
+		// Tokenize :
+		for(unsigned int j=0; j<chain.size(); j++)
+		{
+			std::string reason;
+			if((j>0 && !canFuse(*chain[j-1], *chain[j], fusedPorts[j], reason)) || !isFusable(*chain[j], reason))
+				throw Exception("FilterFusion::generate - Cannot fuse " + chain[j]->getFullName() + " : " + reason + ".", __FILE__, __LINE__, Exception::CoreException);
+
+			const ShaderSource& source = *chain[j]->getShaderSource(GL_FRAGMENT_SHADER);
+			tokenize(source.getSource(), tokens[j]);
+
+			if(source.getVersion()>version)
+				version = source.getVersion();
+		}
+
+		#define RENAME( j, name ) (isReserved(name) ? (name) : (prefixes[j] + (name)))
+
+		for(unsigned int j=0; j<chain.size(); j++)
+		{
+			const std::vector<Token>& t = tokens[j];
+			std::map<int, Replacement> replacements;
+
+			// Samplings of the fused input and its declaration :
+			if(j>0)
+			{
+				const std::string 	samplerName	= chain[j]->getInputPortName(fusedPorts[j]),
+							producerOutput	= chain[j-1]->getOutputPortName(0);
+				std::vector<Replacement> list;
+				std::string reason;
+
+				if(!findSamplings(t, samplerName, chain[j-1]->getWidth(), chain[j-1]->getHeight(), getConversion(*chain[j-1], RENAME(j-1, producerOutput)), list, reason))
+					throw Exception("FilterFusion::generate - Cannot fuse " + chain[j]->getFullName() + " : " + reason + ".", __FILE__, __LINE__, Exception::CoreException);
+
+				for(int k=0; k<static_cast<int>(t.size()); k++)
+				{
+					if(t[k].kind!=Identifier || t[k].text!=samplerName)
+						continue;
+
+					// Find the declaration statement :
+					int s = previousToken(t, k);
+					while(s>=0 && (t[s].kind==Identifier || t[s].text==",") && t[s].text!="uniform")
+						s = previousToken(t, s);
+					if(s<0 || t[s].text!="uniform")
+						continue;
+
+					const int	p = previousToken(t, k),
+							n = nextToken(t, k);
+					Replacement r;
+					r.begin = k;
+					r.end 	= k;
+
+					if(n>=0 && t[n].text==",")
+						r.end = n;			// Remove "name,"
+					else if(p>=0 && t[p].text==",")
+						r.begin = p;			// Remove ", name"
+					else
+					{
+						r.begin = s;			// Remove the full statement.
+						r.end 	= n;
+					}
+					list.push_back(r);
+				}
+
+				for(std::vector<Replacement>::const_iterator it=list.begin(); it!=list.end(); it++)
+				{
+					std::map<int, Replacement>::iterator itR = replacements.find(it->begin);
+					if(itR==replacements.end() || itR->second.end<it->end)
+						replacements[it->begin] = *it;
+				}
+			}
+
+			// The output of the producers becomes a global variable :
+			if(j+1<chain.size())
+			{
+				const std::string outputName = chain[j]->getOutputPortName(0);
+
+				for(int k=0; k<static_cast<int>(t.size()); k++)
+				{
+					const int n = nextToken(t, k),
+						  m = (n>=0) ? nextToken(t, n) : -1;
+
+					if(t[k].text=="out" && n>=0 && m>=0 && t[m].text==outputName)
+					{
+						Replacement r;
+						r.begin	= k;
+						r.end	= k;
+						replacements[k] = r;
+					}
+				}
+			}
+
+			// Write the renamed source, the members (after a dot) and the fields declared in the structures keep their names :
+			bool	structureDeclaration = false,
+				structureBody = false;
+
+			body += "// Fusion : " + chain[j]->getLayoutName() + "\n";
+			for(int k=0; k<static_cast<int>(t.size()); k++)
+			{
+				if(t[k].text=="struct")
+					structureDeclaration = true;
+				else if(t[k].text=="{" && structureDeclaration)
+				{
+					structureDeclaration = false;
+					structureBody = true;
+				}
+				else if(t[k].text=="}")
+					structureBody = false;
+
+				std::map<int, Replacement>::const_iterator itR = replacements.find(k);
+
+				if(itR!=replacements.end())
+				{
+					body += itR->second.text;
+					k = itR->second.end;
+				}
+				else if(t[k].kind==Identifier)
+				{
+					const int	p = previousToken(t, k),
+							n = nextToken(t, k);
+					const bool	member = (p>=0 && t[p].text=="."),
+							field = structureBody && n>=0 && (t[n].text==";" || t[n].text=="," || t[n].text=="[");
+					body += (member || field) ? t[k].text : RENAME(j, t[k].text);
+				}
+				else if(t[k].kind==Directive)
+				{
+					std::vector<Token> directive;
+					tokenize(t[k].text.substr(1), directive);
+					const int d = nextToken(directive, -1);
+					const std::string keyword = (d>=0) ? directive[d].text : "";
+
+					if(keyword=="version")
+					{
+						if(versionLine.empty() || chain[j]->getShaderSource(GL_FRAGMENT_SHADER)->getVersion()==version)
+							versionLine = t[k].text;
+					}
+					else if(keyword=="extension")
+					{
+						if(extensionLines.find(t[k].text)==std::string::npos)
+							extensionLines += t[k].text + "\n";
+					}
+					else if(keyword=="define" || keyword=="undef" || keyword=="if" || keyword=="ifdef" || keyword=="ifndef" || keyword=="elif")
+					{
+						body += "#";
+						for(int l=0; l<static_cast<int>(directive.size()); l++)
+						{
+							const int p = previousToken(directive, l);
+							body += (l!=d && directive[l].kind==Identifier && directive[l].text!="defined" && !(p>=0 && directive[p].text==".")) ? RENAME(j, directive[l].text) : directive[l].text;
+						}
+					}
+					else if(keyword!="line")
+						body += t[k].text;
+				}
+				else
+					body += t[k].text;
+			}
+			body += "\n";
+		}
+
+		// Main function, the outputs of the producers are initialized first :
+		body += "void main()\n{\n";
+		for(unsigned int j=0; j<chain.size(); j++)
+		{
+			if(j+1<chain.size())
+				body += "\t" + RENAME(j, chain[j]->getOutputPortName(0)) + " = vec4(0.0, 0.0, 0.0, 0.0);\n";
+			body += "\t" + RENAME(j, std::string("main")) + "();\n";
+		}
+		body += "}\n";
+
+		#undef RENAME
+
+		std::string header;
+		if(!versionLine.empty())
+			header += versionLine + "\n";
+		header += extensionLines;
+
+		return ShaderSource(header + body, "<Fusion>");
+	}
+
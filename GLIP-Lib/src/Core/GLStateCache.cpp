@@ -0,0 +1,426 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : GLStateCache.cpp                                                                          */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Cache of the OpenGL state, filters redundant state changes.                               */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    GLStateCache.cpp
+ * \brief   Cache of the OpenGL state, filters redundant state changes.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#include "Core/GLStateCache.hpp"
+#include "Core/Exception.hpp"
+#include "devDebugTools.hpp"
+
+using namespace Glip::CoreGL;
+
+// GLStateCache
+	int				GLStateCache::scopeDepth		= 0;
+	bool				GLStateCache::programKnown		= false;
+	bool				GLStateCache::framebufferKnown		= false;
+	bool				GLStateCache::activeUnitKnown		= false;
+	bool				GLStateCache::blendingKnown		= false;
+	bool				GLStateCache::depthTestingKnown		= false;
+	bool				GLStateCache::viewportKnown		= false;
+	bool				GLStateCache::scissorKnown		= false;
+	bool				GLStateCache::clearColorKnown		= false;
+	GLuint				GLStateCache::program			= 0;
+	GLuint				GLStateCache::framebuffer		= 0;
+	GLenum				GLStateCache::activeUnit		= GL_TEXTURE0;
+	std::map<GLenum,GLuint>		GLStateCache::textures;
+	bool				GLStateCache::blending			= false;
+	bool				GLStateCache::depthTesting		= false;
+	bool				GLStateCache::scissorTest		= false;
+	GLenum				GLStateCache::sFactor			= GL_ONE;
+	GLenum				GLStateCache::dFactor			= GL_ZERO;
+	GLenum				GLStateCache::blendingEquation		= GL_FUNC_ADD;
+	GLenum				GLStateCache::depthTestingFunction	= GL_LESS;
+	GLint				GLStateCache::viewport[4]		= {0, 0, 0, 0};
+	GLint				GLStateCache::scissorBox[4]		= {0, 0, 0, 0};
+	GLfloat				GLStateCache::clearColor[4]		= {0.0f, 0.0f, 0.0f, 0.0f};
+	unsigned int			GLStateCache::numIssuedCalls		= 0;
+	unsigned int			GLStateCache::numSkippedCalls		= 0;
+
+	bool GLStateCache::count(bool issue)
+	{
+		if(issue)
+			numIssuedCalls++;
+		else
+			numSkippedCalls++;
+
+		return issue;
+	}
+
+	/**
+	\fn void GLStateCache::beginScope(void)
+	\brief Start tracking the state. The state is unknown at the beginning of the outermost scope.
+	**/
+	void GLStateCache::beginScope(void)
+	{
+		if(scopeDepth==0)
+			invalidate();
+
+		scopeDepth++;
+	}
+
+	/**
+	\fn void GLStateCache::endScope(void)
+	\brief Stop tracking the state. When leaving the outermost scope, the default bindings are restored.
+	**/
+	void GLStateCache::endScope(void)
+	{
+		if(scopeDepth<=0)
+			throw Exception("GLStateCache::endScope - No scope was started.", __FILE__, __LINE__, Exception::GLException);
+
+		if(scopeDepth==1)
+		{
+			useProgram(0);
+			bindFramebuffer(0);
+
+			for(std::map<GLenum,GLuint>::const_iterator it=textures.begin(); it!=textures.end(); it++)
+			{
+				if(it->second!=0)
+					bindTexture(it->first, 0);
+			}
+
+			setBlending(false);
+			setDepthTesting(false);
+			setScissor(false);
+
+			invalidate();
+		}
+
+		scopeDepth--;
+	}
+
+	/**
+	\fn bool GLStateCache::isActive(void)
+	\return True if the state is currently tracked (inside a scope).
+	**/
+	bool GLStateCache::isActive(void)
+	{
+		return scopeDepth>0;
+	}
+
+	/**
+	\fn void GLStateCache::invalidate(void)
+	\brief Forget the tracked state, the next calls will all be forwarded to OpenGL.
+	**/
+	void GLStateCache::invalidate(void)
+	{
+		programKnown		= false;
+		framebufferKnown	= false;
+		activeUnitKnown		= false;
+		blendingKnown		= false;
+		depthTestingKnown	= false;
+		viewportKnown		= false;
+		scissorKnown		= false;
+		clearColorKnown		= false;
+		textures.clear();
+	}
+
+	/**
+	\fn void GLStateCache::useProgram(GLuint _program)
+	\brief Use a program (glUseProgram).
+	\param _program Name of the program, 0 to stop using programs.
+	**/
+	void GLStateCache::useProgram(GLuint _program)
+	{
+		if(count(scopeDepth==0 || !programKnown || program!=_program))
+		{
+			glUseProgram(_program);
+
+			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+				OPENGL_ERROR_TRACKER("GLStateCache::useProgram", "glUseProgram()")
+			#endif
+
+			program		= _program;
+			programKnown	= (scopeDepth>0);
+		}
+	}
+
+	/**
+	\fn void GLStateCache::bindFramebuffer(GLuint _framebuffer)
+	\brief Bind a frame buffer (glBindFramebuffer on GL_FRAMEBUFFER).
+	\param _framebuffer Name of the frame buffer, 0 for the default frame buffer.
+	**/
+	void GLStateCache::bindFramebuffer(GLuint _framebuffer)
+	{
+		if(count(scopeDepth==0 || !framebufferKnown || framebuffer!=_framebuffer))
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+
+			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+				OPENGL_ERROR_TRACKER("GLStateCache::bindFramebuffer", "glBindFramebuffer()")
+			#endif
+
+			framebuffer		= _framebuffer;
+			framebufferKnown	= (scopeDepth>0);
+		}
+	}
+
+	/**
+	\fn void GLStateCache::activeTexture(GLenum unit)
+	\brief Select the active texture unit (glActiveTexture).
+	\param unit The unit (GL_TEXTURE0, GL_TEXTURE1, ...).
+	**/
+	void GLStateCache::activeTexture(GLenum unit)
+	{
+		#ifdef GLIP_USE_GL
+			if(count(scopeDepth==0 || !activeUnitKnown || activeUnit!=unit))
+			{
+				glActiveTextureARB(unit);
+
+				activeUnit	= unit;
+				activeUnitKnown	= (scopeDepth>0);
+			}
+		#else
+			UNUSED_PARAMETER(unit)
+		#endif
+	}
+
+	/**
+	\fn bool GLStateCache::bindTexture(GLenum unit, GLuint texture)
+	\brief Bind a texture to a unit (on GL_TEXTURE_2D). The active unit is changed accordingly.
+	\param unit The unit (GL_TEXTURE0, GL_TEXTURE1, ...).
+	\param texture The name of the texture, 0 to unbind.
+	\return True if the binding was issued, false if it was skipped.
+	**/
+	bool GLStateCache::bindTexture(GLenum unit, GLuint texture)
+	{
+		if(scopeDepth>0)
+		{
+			std::map<GLenum,GLuint>::const_iterator it = textures.find(unit);
+
+			if(it!=textures.end() && it->second==texture)
+				return count(false);
+		}
+
+		activeTexture(unit);
+		glBindTexture(GL_TEXTURE_2D, texture);
+
+		if(scopeDepth>0)
+			textures[unit] = texture;
+
+		return count(true);
+	}
+
+	/**
+	\fn void GLStateCache::bindTexture(GLuint texture)
+	\brief Bind a texture to the active unit (on GL_TEXTURE_2D).
+	\param texture The name of the texture, 0 to unbind.
+	**/
+	void GLStateCache::bindTexture(GLuint texture)
+	{
+		if(scopeDepth>0 && activeUnitKnown)
+			bindTexture(activeUnit, texture);
+		else
+		{
+			glBindTexture(GL_TEXTURE_2D, texture);
+			count(true);
+
+			// The unit is not known, all the bindings become unknown :
+			textures.clear();
+		}
+	}
+
+	/**
+	\fn void GLStateCache::setBlending(bool enabled, GLenum _sFactor, GLenum _dFactor, GLenum _blendingEquation)
+	\brief Enable or disable blending and set its parameters.
+	\param enabled True to enable blending.
+	\param _sFactor Source factor (glBlendFunc), ignored if blending is disabled.
+	\param _dFactor Destination factor (glBlendFunc), ignored if blending is disabled.
+	\param _blendingEquation Blending equation (glBlendEquation), ignored if blending is disabled.
+	**/
+	void GLStateCache::setBlending(bool enabled, GLenum _sFactor, GLenum _dFactor, GLenum _blendingEquation)
+	{
+		const bool same = blendingKnown && (blending==enabled) && (!enabled || (sFactor==_sFactor && dFactor==_dFactor && blendingEquation==_blendingEquation));
+
+		if(count(scopeDepth==0 || !same))
+		{
+			if(enabled)
+			{
+				glEnable(GL_BLEND);
+				glBlendFunc(_sFactor, _dFactor);
+				glBlendEquation(_blendingEquation);
+			}
+			else
+				glDisable(GL_BLEND);
+
+			blending		= enabled;
+			sFactor			= _sFactor;
+			dFactor			= _dFactor;
+			blendingEquation	= _blendingEquation;
+			blendingKnown		= (scopeDepth>0);
+		}
+	}
+
+	/**
+	\fn void GLStateCache::setDepthTesting(bool enabled, GLenum _depthTestingFunction)
+	\brief Enable or disable depth testing and set its function.
+	\param enabled True to enable depth testing.
+	\param _depthTestingFunction Depth function (glDepthFunc), ignored if depth testing is disabled.
+	**/
+	void GLStateCache::setDepthTesting(bool enabled, GLenum _depthTestingFunction)
+	{
+		const bool same = depthTestingKnown && (depthTesting==enabled) && (!enabled || depthTestingFunction==_depthTestingFunction);
+
+		if(count(scopeDepth==0 || !same))
+		{
+			if(enabled)
+			{
+				glEnable(GL_DEPTH_TEST);
+				glDepthFunc(_depthTestingFunction);
+			}
+			else
+				glDisable(GL_DEPTH_TEST);
+
+			depthTesting		= enabled;
+			depthTestingFunction	= _depthTestingFunction;
+			depthTestingKnown	= (scopeDepth>0);
+		}
+	}
+
+	/**
+	\fn void GLStateCache::setViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	\brief Set the viewport (glViewport).
+	\param x Left edge.
+	\param y Bottom edge.
+	\param width Width.
+	\param height Height.
+	**/
+	void GLStateCache::setViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		const bool same = viewportKnown && viewport[0]==x && viewport[1]==y && viewport[2]==width && viewport[3]==height;
+
+		if(count(scopeDepth==0 || !same))
+		{
+			glViewport(x, y, width, height);
+
+			viewport[0]	= x;
+			viewport[1]	= y;
+			viewport[2]	= width;
+			viewport[3]	= height;
+			viewportKnown	= (scopeDepth>0);
+		}
+	}
+
+	/**
+	\fn void GLStateCache::setScissor(bool enabled, GLint x, GLint y, GLsizei width, GLsizei height)
+	\brief Enable or disable the scissor test and set its box (glScissor).
+	\param enabled True to enable the scissor test.
+	\param x Left edge.
+	\param y Bottom edge.
+	\param width Width.
+	\param height Height.
+	**/
+	void GLStateCache::setScissor(bool enabled, GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		const bool same = scissorKnown && (scissorTest==enabled) && (!enabled || (scissorBox[0]==x && scissorBox[1]==y && scissorBox[2]==width && scissorBox[3]==height));
+
+		if(count(scopeDepth==0 || !same))
+		{
+			if(enabled)
+			{
+				glEnable(GL_SCISSOR_TEST);
+				glScissor(x, y, width, height);
+			}
+			else
+				glDisable(GL_SCISSOR_TEST);
+
+			scissorTest	= enabled;
+			scissorBox[0]	= x;
+			scissorBox[1]	= y;
+			scissorBox[2]	= width;
+			scissorBox[3]	= height;
+			scissorKnown	= (scopeDepth>0);
+		}
+	}
+
+	/**
+	\fn void GLStateCache::setClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+	\brief Set the clear color (glClearColor).
+	\param r Red component.
+	\param g Green component.
+	\param b Blue component.
+	\param a Alpha component.
+	**/
+	void GLStateCache::setClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+	{
+		const bool same = clearColorKnown && clearColor[0]==r && clearColor[1]==g && clearColor[2]==b && clearColor[3]==a;
+
+		if(count(scopeDepth==0 || !same))
+		{
+			glClearColor(r, g, b, a);
+
+			clearColor[0]	= r;
+			clearColor[1]	= g;
+			clearColor[2]	= b;
+			clearColor[3]	= a;
+			clearColorKnown	= (scopeDepth>0);
+		}
+	}
+
+	/**
+	\fn void GLStateCache::forgetProgram(GLuint _program)
+	\brief Must be called when a program is deleted (its name might be reused).
+	\param _program Name of the program.
+	\fn void GLStateCache::forgetFramebuffer(GLuint _framebuffer)
+	\brief Must be called when a frame buffer is deleted (its name might be reused).
+	\param _framebuffer Name of the frame buffer.
+	\fn void GLStateCache::forgetTexture(GLuint texture)
+	\brief Must be called when a texture is deleted (its name might be reused).
+	\param texture Name of the texture.
+	**/
+	void GLStateCache::forgetProgram(GLuint _program)
+	{
+		if(program==_program)
+			programKnown = false;
+	}
+
+	void GLStateCache::forgetFramebuffer(GLuint _framebuffer)
+	{
+		if(framebuffer==_framebuffer)
+			framebufferKnown = false;
+	}
+
+	void GLStateCache::forgetTexture(GLuint texture)
+	{
+		// Deleting a texture resets its bindings to 0 :
+		for(std::map<GLenum,GLuint>::iterator it=textures.begin(); it!=textures.end(); it++)
+		{
+			if(it->second==texture)
+				it->second = 0;
+		}
+	}
+
+	/**
+	\fn unsigned int GLStateCache::getNumIssuedCalls(void)
+	\return The number of state changes forwarded to OpenGL since the last call to GLStateCache::resetCounters.
+	\fn unsigned int GLStateCache::getNumSkippedCalls(void)
+	\return The number of redundant state changes skipped since the last call to GLStateCache::resetCounters.
+	\fn void GLStateCache::resetCounters(void)
+	\brief Reset the counters of issued and skipped state changes.
+	**/
+	unsigned int GLStateCache::getNumIssuedCalls(void)	{ return numIssuedCalls; }
+	unsigned int GLStateCache::getNumSkippedCalls(void)	{ return numSkippedCalls; }
+
+	void GLStateCache::resetCounters(void)
+	{
+		numIssuedCalls	= 0;
+		numSkippedCalls	= 0;
+	}
+
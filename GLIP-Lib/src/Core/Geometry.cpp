@@ -44,6 +44,7 @@
 	 :	vertices(),
 		texCoords(),
 		elements(),
+		numInstances(1),
 		type(_type), 
 		hasNormals(_hasNormals),		
 		hasTexCoords(_hasTexCoords),		
@@ -66,6 +67,7 @@
 		normals(mdl.normals),
 		texCoords(mdl.texCoords),
 		elements(mdl.elements),
+		numInstances(mdl.numInstances),
 		type(mdl.type),
 		hasNormals(mdl.hasNormals),
 		hasTexCoords(mdl.hasTexCoords),
@@ -943,6 +945,29 @@
 		return elements.empty() ? 0 : (elements.size() - numVerticesPerElement + elementStride) / elementStride;
 	}
 
+	/**
+	\fn unsigned int GeometryModel::getNumInstances(void) const
+	\brief Get the number of times the geometry is drawn (instancing).
+	\return The number of instances (1 for most geometries).
+	**/
+	unsigned int GeometryModel::getNumInstances(void) const
+	{
+		return numInstances;
+	}
+
+	/**
+	\fn void GeometryModel::setNumInstances(unsigned int n)
+	\brief Set the number of times the geometry is drawn (instancing). The vertex shader can read the index of the instance in gl_InstanceID.
+	\param n The number of instances (at least 1).
+	**/
+	void GeometryModel::setNumInstances(unsigned int n)
+	{
+		if(n<1)
+			throw Exception("GeometryModel::setNumInstances - The number of instances must be at least 1.", __FILE__, __LINE__, Exception::CoreException);
+
+		numInstances = n;
+	}
+
 	/**
 	\fn bool GeometryModel::testIndices(void) const
 	\brief Test if all the indices are valid.
@@ -976,6 +1001,7 @@
 			&&	(dim==mdl.dim)
 			&&	(numVerticesPerElement==mdl.numVerticesPerElement)
 			&&	(primitiveGL==mdl.primitiveGL)
+			&&	(numInstances==mdl.numInstances)
 			&& 	(std::equal(vertices.begin(), vertices.end(), mdl.vertices.begin()))
 			&& 	(std::equal(normals.begin(), normals.end(), mdl.normals.begin()))
 			&&	(std::equal(texCoords.begin(), texCoords.end(), mdl.texCoords.begin()))
@@ -1017,7 +1043,7 @@
 			texPtr = &texCoords.front();
 		}
 
-		return new HdlVBO(getNumVertices(), dim, freq, &vertices.front(), localNumElements, localNumVerticesPerEl, elementsPtr, primitiveGL, normalsPtr, localNumDimTexCoord, texPtr);
+		return new HdlVBO(getNumVertices(), dim, freq, &vertices.front(), localNumElements, localNumVerticesPerEl, elementsPtr, primitiveGL, normalsPtr, localNumDimTexCoord, texPtr, numInstances);
 	}
 	
 	/**
@@ -1351,6 +1377,39 @@
 			normalized(mdl.normalized)
 		{ }
 
+	// Instanced 2D Grid of points
+		/**
+		\fn InstancedPointsGrid2D::InstancedPointsGrid2D(int w, int h)
+		\brief InstancedPointsGrid2D constructor.
+		\param w Number of points along the X dimension (stored).
+		\param h Number of points along the Y dimension (instances).
+		**/
+		InstancedPointsGrid2D::InstancedPointsGrid2D(int w, int h)
+		 :	GeometryModel(GeometryModel::InstancedPointsGrid2D, 2, GL_POINTS, false, false),
+			width(w),
+			height(h)
+		{
+			if(w<1 || h<1)
+				throw Exception("InstancedPointsGrid2D::InstancedPointsGrid2D - Invalid size : " + toString(w) + "x" + toString(h) + ".", __FILE__, __LINE__, Exception::CoreException);
+
+			reserveVertices(w);
+			for(int j=0; j<w; j++)
+				addVertex2D(j, 0);
+
+			setNumInstances(h);
+		}
+
+		/**
+		\fn InstancedPointsGrid2D::InstancedPointsGrid2D(const InstancedPointsGrid2D& mdl)
+		\brief Copy constructor.
+		\param mdl Original model.
+		**/
+		InstancedPointsGrid2D::InstancedPointsGrid2D(const InstancedPointsGrid2D& mdl)
+		 : 	GeometryModel(mdl),
+			width(mdl.width),
+			height(mdl.height)
+		{ }
+
 	// Custom model : 
 		/**
 		\fn CustomModel::CustomModel(int _dim, GLenum _primitiveGL, bool _hasNormals, bool _hasTexCoords)
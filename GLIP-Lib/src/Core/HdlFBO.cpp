@@ -23,6 +23,7 @@
 
 #include "Core/HdlFBO.hpp"
 #include "Core/Exception.hpp"
+#include "Core/GLStateCache.hpp"
 
 using namespace Glip::CoreGL;
 
@@ -130,7 +131,8 @@ using namespace Glip::CoreGL;
 		fboID(0),
 		firstRendering(true),
 		depthBuffer(NULL),
-		depthBufferAttached(false)
+		depthBufferAttached(false),
+		scissorEnabled(false)
 	{
 		#ifdef GLIP_USE_GL
 		NEED_EXTENSION(GL_ARB_framebuffer_object)
@@ -149,7 +151,7 @@ using namespace Glip::CoreGL;
 			std::cout << "HdlFBO::HdlFBO - Disabling Depth buffer." << std::endl;
 		#endif
 
-		glDisable(GL_DEPTH_TEST);
+		GLStateCache::setDepthTesting(false);
 
 		glGenFramebuffers(1, &fboID);
 
@@ -170,7 +172,7 @@ using namespace Glip::CoreGL;
 			addTarget();
 
 		// check FBO status
-		glBindFramebuffer(GL_FRAMEBUFFER, 0); //unbind
+		GLStateCache::bindFramebuffer(0); //unbind
 	}
 
 	HdlFBO::~HdlFBO(void)
@@ -186,6 +188,7 @@ using namespace Glip::CoreGL;
 		#endif
 
 		glDeleteFramebuffers( 1, &fboID);
+		GLStateCache::forgetFramebuffer(fboID);
 
 		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
 			OPENGL_ERROR_TRACKER("HdlFBO::~HdlFBO", "glDeleteFramebuffers()")
@@ -203,7 +206,7 @@ using namespace Glip::CoreGL;
 		// Entering safe zone :
 		glGetError();
 
-		glBindFramebuffer(GL_FRAMEBUFFER, fboID);
+		GLStateCache::bindFramebuffer(fboID);
 
 		glFramebufferTexture2D(GL_FRAMEBUFFER, getAttachment(i), GL_TEXTURE_2D, targets[i]->getID(), 0);
 
@@ -214,7 +217,7 @@ using namespace Glip::CoreGL;
 
 	void HdlFBO::unbindTextureFromFBO(int i)
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, fboID);
+		GLStateCache::bindFramebuffer(fboID);
 
 		glFramebufferTexture2D(GL_FRAMEBUFFER, getAttachment(i), GL_TEXTURE_2D, 0, 0);
 
@@ -297,13 +300,19 @@ using namespace Glip::CoreGL;
 	}
 
 	/**
-	\fn void HdlFBO::beginRendering(int usedTarget, bool useExistingDepthBuffer)
+	\fn void HdlFBO::beginRendering(int usedTarget, bool useExistingDepthBuffer, int viewportWidth, int viewportHeight, int scissorX, int scissorY, int scissorWidth, int scissorHeight)
 	\param usedTarget The number of targets to be used. It must be greater or equal to 1 and less or equal to getAttachmentCount(). Default is 0 which means all targets.
 	\brief Prepare the FBO for rendering in it.
 	\param usedTarget Number of targets used in this FBO.
 	\param useExistingDepthBuffer If true and if a depth buffer is currently attached, it will be used (see HdlFBO::addDepthBuffer).
+	\param viewportWidth Width of the rendering area, starting from the left edge. It must be less or equal to the width of the FBO. Default is 0 which means the full width.
+	\param viewportHeight Height of the rendering area, starting from the bottom edge. It must be less or equal to the height of the FBO. Default is 0 which means the full height.
+	\param scissorX Left edge of the region actually written, inside the rendering area.
+	\param scissorY Bottom edge of the region actually written, inside the rendering area.
+	\param scissorWidth Width of the region actually written. Default is 0 which means the whole rendering area is written. The viewport is not changed by the region (the fragment coordinates stay the same), the pixels outside of it are neither drawn nor cleared (scissor test).
+	\param scissorHeight Height of the region actually written. Default is 0 which means the whole rendering area is written.
 	**/
-	void HdlFBO::beginRendering(int usedTarget, bool useExistingDepthBuffer)
+	void HdlFBO::beginRendering(int usedTarget, bool useExistingDepthBuffer, int viewportWidth, int viewportHeight, int scissorX, int scissorY, int scissorWidth, int scissorHeight)
 	{
 		static const GLenum attachmentsList[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4,
 							GL_COLOR_ATTACHMENT5, GL_COLOR_ATTACHMENT6, GL_COLOR_ATTACHMENT7, GL_COLOR_ATTACHMENT8, GL_COLOR_ATTACHMENT9,
@@ -316,6 +325,19 @@ using namespace Glip::CoreGL;
 		if(usedTarget>static_cast<int>(targets.size()))
 			throw Exception("HdlFBO::beginRendering - Can't render to " + toString(usedTarget) + " textures because the current number of targets is " + toString(targets.size()), __FILE__, __LINE__, Exception::GLException);
 
+		if(viewportWidth<=0)
+			viewportWidth = getWidth();
+		if(viewportHeight<=0)
+			viewportHeight = getHeight();
+
+		if(viewportWidth>getWidth() || viewportHeight>getHeight())
+			throw Exception("HdlFBO::beginRendering - The rendering area (" + toString(viewportWidth) + "x" + toString(viewportHeight) + ") is larger than the FBO (" + toString(getWidth()) + "x" + toString(getHeight()) + ").", __FILE__, __LINE__, Exception::GLException);
+
+		const bool useScissor = (scissorWidth>0 && scissorHeight>0) && (scissorX>0 || scissorY>0 || scissorWidth<viewportWidth || scissorHeight<viewportHeight);
+
+		if(useScissor && (scissorX<0 || scissorY<0 || scissorX+scissorWidth>viewportWidth || scissorY+scissorHeight>viewportHeight))
+			throw Exception("HdlFBO::beginRendering - The region (" + toString(scissorX) + ", " + toString(scissorY) + ", " + toString(scissorWidth) + "x" + toString(scissorHeight) + ") is not inside the rendering area (" + toString(viewportWidth) + "x" + toString(viewportHeight) + ").", __FILE__, __LINE__, Exception::GLException);
+
 		// First run test : 
 		if(firstRendering) 
 		{
@@ -326,7 +348,7 @@ using namespace Glip::CoreGL;
 			firstRendering = false;
 		}
 
-		glBindFramebuffer(GL_FRAMEBUFFER, fboID);
+		GLStateCache::bindFramebuffer(fboID);
 
 		// Attach a depth buffer (uncommon?) : 
 		if(depthBuffer!=NULL && useExistingDepthBuffer)
@@ -349,7 +371,18 @@ using namespace Glip::CoreGL;
 		//#endif
 
 		// Create a new viewport configuration
-		glViewport(0,0,getWidth(),getHeight());
+		GLStateCache::setViewport(0,0,viewportWidth,viewportHeight);
+
+		// Restrict the written region (outside of a GLStateCache scope, the scissor test is only changed if needed) :
+		if(useScissor)
+			GLStateCache::setScissor(true, scissorX, scissorY, scissorWidth, scissorHeight);
+		else if(GLStateCache::isActive())
+			GLStateCache::setScissor(false);
+		scissorEnabled = useScissor;
+
+		// The content of the targets is about to change (see HdlTexture::getGeneration) :
+		for(int k=0; k<usedTarget; k++)
+			targets[k]->touch();
 	}
 
 	/**
@@ -364,14 +397,18 @@ using namespace Glip::CoreGL;
 			depthBufferAttached = false;
 		}
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0); // unbind
+		// Inside a GLStateCache scope, the FBO stays bound until the next one is, unless its mipmaps need to be generated :
+		const bool generateMipmaps = (getMaxLevel()>0);
+
+		if(!GLStateCache::isActive() || generateMipmaps)
+			GLStateCache::bindFramebuffer(0); // unbind
 
 		// trigger mipmaps generation explicitly
-		for(std::vector<HdlTexture*>::iterator it=targets.begin(); it!=targets.end(); it++)
+		if(generateMipmaps)
 		{
-			if((*it)->getMaxLevel()>0)
+			for(std::vector<HdlTexture*>::iterator it=targets.begin(); it!=targets.end(); it++)
 			{
-				glBindTexture(GL_TEXTURE_2D, (*it)->getID());
+				GLStateCache::bindTexture((*it)->getID());
 
 				glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -379,8 +416,12 @@ using namespace Glip::CoreGL;
 					OPENGL_ERROR_TRACKER("HdlFBO::endRendering", "glGenerateMipmap()")
 				#endif
 			}
+			GLStateCache::bindTexture(0);
 		}
-		glBindTexture(GL_TEXTURE_2D, 0);
+
+		if(scissorEnabled && !GLStateCache::isActive())
+			GLStateCache::setScissor(false);
+		scissorEnabled = false;
 
 		// restore viewport setting (removed for GLES compatibility, impact?) :
 		//glPopAttrib();
@@ -410,7 +451,7 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlFBO::bind(void)
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, fboID);
+		GLStateCache::bindFramebuffer(fboID);
 	}
 
 	/**
@@ -494,6 +535,157 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlFBO::unbind(void)
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0); //unbind
+		GLStateCache::bindFramebuffer(0); //unbind
+	}
+
+
+// HdlFBOPool
+	std::list<HdlFBO*>	HdlFBOPool::idleList;
+	std::set<HdlFBO*>	HdlFBOPool::leasedSet;
+	size_t			HdlFBOPool::highWaterMark	= 0;
+	size_t			HdlFBOPool::idleMemory		= 0;
+	int			HdlFBOPool::numReused		= 0;
+
+	/**
+	\fn HdlFBO* HdlFBOPool::lease(const HdlAbstractTextureFormat& format, int numTargets)
+	\brief Get a FBO with the given format and number of targets, from the idle objects if possible.
+	\param format Format of the targets.
+	\param numTargets Number of targets.
+	\return Pointer to the FBO, it must be returned with HdlFBOPool::release and not deleted.
+	**/
+	HdlFBO* HdlFBOPool::lease(const HdlAbstractTextureFormat& format, int numTargets)
+	{
+		HdlFBO* fbo = NULL;
+
+		// Take the most recently returned match :
+		for(std::list<HdlFBO*>::reverse_iterator it=idleList.rbegin(); it!=idleList.rend(); it++)
+		{
+			if(**it==format && (*it)->getNumTargets()==numTargets)
+			{
+				fbo = *it;
+				idleMemory -= fbo->getSize();
+				idleList.erase(--(it.base()));
+				numReused++;
+				break;
+			}
+		}
+
+		if(fbo==NULL)
+			fbo = new HdlFBO(format, numTargets);
+		else
+		{
+			// Same initial state as a new object (its targets were filled with 0) :
+			fbo->beginRendering();
+			GLStateCache::setClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+			fbo->endRendering();
+		}
+
+		leasedSet.insert(fbo);
+
+		return fbo;
 	}
 
+	/**
+	\fn bool HdlFBOPool::release(HdlFBO* fbo)
+	\brief Return a FBO obtained with HdlFBOPool::lease. It is kept idle if the high-water mark allows it. This function does not raise exceptions, it can be called from destructors.
+	\param fbo Pointer to the FBO.
+	\return False if the FBO was not leased from this pool (it is then left untouched).
+	**/
+	bool HdlFBOPool::release(HdlFBO* fbo)
+	{
+		std::set<HdlFBO*>::iterator it = leasedSet.find(fbo);
+
+		if(it==leasedSet.end())
+			return false;
+
+		leasedSet.erase(it);
+
+		// Not kept, or not recycled if it cannot be reset :
+		if(fbo->getSize()>highWaterMark)
+		{
+			delete fbo;
+			return true;
+		}
+
+		try
+		{
+			// Back to the state of a new object, the pool is only indexed by the format of the FBO :
+			if(fbo->hasDepthBuffer())
+			{
+				fbo->removeDepthBuffer();
+				HdlFBO::unbind();
+			}
+			for(int k=0; k<fbo->getNumTargets(); k++)
+			{
+				HdlTexture* target = (*fbo)[k];
+
+				if(target->getMinFilter()!=fbo->getMinFilter())
+					target->setMinFilter(fbo->getMinFilter());
+				if(target->getMagFilter()!=fbo->getMagFilter())
+					target->setMagFilter(fbo->getMagFilter());
+				if(target->getSWrapping()!=fbo->getSWrapping())
+					target->setSWrapping(fbo->getSWrapping());
+				if(target->getTWrapping()!=fbo->getTWrapping())
+					target->setTWrapping(fbo->getTWrapping());
+			}
+
+			idleList.push_back(fbo);
+		}
+		catch(...)
+		{
+			delete fbo;
+			return true;
+		}
+
+		idleMemory += fbo->getSize();
+
+		trim(highWaterMark);
+
+		return true;
+	}
+
+	/**
+	\fn void HdlFBOPool::trim(size_t maxIdleMemory)
+	\brief Delete the least recently returned idle objects until the idle memory is below the limit.
+	\param maxIdleMemory Limit of the idle memory, in bytes. Default is 0, which deletes all the idle objects.
+	**/
+	void HdlFBOPool::trim(size_t maxIdleMemory)
+	{
+		while(idleMemory>maxIdleMemory && !idleList.empty())
+		{
+			idleMemory -= idleList.front()->getSize();
+			delete idleList.front();
+			idleList.pop_front();
+		}
+	}
+
+	/**
+	\fn void HdlFBOPool::setHighWaterMark(size_t bytes)
+	\brief Set the maximum memory kept by the idle objects (the current idle objects are trimmed accordingly).
+	\param bytes Limit, in bytes.
+	**/
+	void HdlFBOPool::setHighWaterMark(size_t bytes)
+	{
+		highWaterMark = bytes;
+		trim(highWaterMark);
+	}
+
+	/**
+	\fn size_t HdlFBOPool::getHighWaterMark(void)
+	\return The maximum memory kept by the idle objects, in bytes.
+	\fn int HdlFBOPool::getNumIdle(void)
+	\return The number of idle objects.
+	\fn size_t HdlFBOPool::getIdleMemory(void)
+	\return The memory of the idle objects, in bytes (not counting mipmaps and depth buffers).
+	\fn int HdlFBOPool::getNumLeased(void)
+	\return The number of objects currently leased.
+	\fn int HdlFBOPool::getNumReused(void)
+	\return The number of leases which were served by an idle object (instead of a new allocation), since the start of the program.
+	**/
+	size_t HdlFBOPool::getHighWaterMark(void)	{ return highWaterMark; }
+	int HdlFBOPool::getNumIdle(void)		{ return idleList.size(); }
+	size_t HdlFBOPool::getIdleMemory(void)		{ return idleMemory; }
+	int HdlFBOPool::getNumLeased(void)		{ return leasedSet.size(); }
+	int HdlFBOPool::getNumReused(void)		{ return numReused; }
+
@@ -0,0 +1,163 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : HdlFence.cpp                                                                              */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : OpenGL Sync Object Handle                                                                 */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    HdlFence.cpp
+ * \brief   OpenGL Sync Object Handle (fences)
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+#include "Core/Exception.hpp"
+#include "Core/HdlFence.hpp"
+
+using namespace Glip::CoreGL;
+
+// Functions
+	/**
+	\fn HdlFence::HdlFence(void)
+	\brief HdlFence constructor, the fence is not inserted.
+	**/
+	HdlFence::HdlFence(void)
+	 :	sync(NULL),
+		pending(false)
+	{ }
+
+	HdlFence::~HdlFence(void)
+	{
+		release();
+	}
+
+	/**
+	\fn void HdlFence::insert(void)
+	\brief Insert the fence after the commands issued so far (the previous position of the fence is forgotten).
+	**/
+	void HdlFence::insert(void)
+	{
+		release();
+
+		#if !defined(GLIP_USE_GLES) && !defined(GLIP_USE_GLES2)
+		if(isSupported())
+		{
+			sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+				OPENGL_ERROR_TRACKER("HdlFence::insert", "glFenceSync()")
+			#endif
+
+			if(sync==NULL)
+			{
+				GLenum err = glGetError();
+				throw Exception("HdlFence::insert - The fence can't be created. OpenGL error " + getGLEnumNameSafe(err) + " : " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException);
+			}
+		}
+		#endif
+
+		pending = true;
+	}
+
+	/**
+	\fn void HdlFence::release(void)
+	\brief Forget the fence, without waiting for it.
+	**/
+	void HdlFence::release(void)
+	{
+		#if !defined(GLIP_USE_GLES) && !defined(GLIP_USE_GLES2)
+		if(sync!=NULL)
+			glDeleteSync(sync);
+		#endif
+
+		sync	= NULL;
+		pending	= false;
+	}
+
+	/**
+	\fn bool HdlFence::isPending(void) const
+	\brief Test if the fence was inserted and was not yet seen signaled.
+	\return True if the fence is pending.
+	**/
+	bool HdlFence::isPending(void) const
+	{
+		return pending;
+	}
+
+	/**
+	\fn bool HdlFence::isSignaled(void)
+	\brief Poll the fence, without blocking (except for the glFinish fallback).
+	\return True if the commands issued before the fence are completed (or if the fence was never inserted).
+	**/
+	bool HdlFence::isSignaled(void)
+	{
+		return wait(0.0);
+	}
+
+	/**
+	\fn bool HdlFence::wait(double timeout)
+	\brief Wait for the fence to be signaled.
+	\param timeout Maximum time to wait, in milliseconds. Negative values wait until the fence is signaled (default).
+	\return True if the commands issued before the fence are completed (or if the fence was never inserted), false if the timeout expired first.
+	**/
+	bool HdlFence::wait(double timeout)
+	{
+		if(!pending)
+			return true;
+
+		#if !defined(GLIP_USE_GLES) && !defined(GLIP_USE_GLES2)
+		if(sync!=NULL)
+		{
+			// Wait by slices of one second if no timeout is given :
+			const GLuint64 slice = (timeout<0.0) ? static_cast<GLuint64>(1000000000) : static_cast<GLuint64>(timeout*1e6);
+			GLenum result = GL_TIMEOUT_EXPIRED;
+
+			do
+			{
+				// Flush, otherwise the fence might never reach the GPU :
+				result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, slice);
+			}
+			while(result==GL_TIMEOUT_EXPIRED && timeout<0.0);
+
+			if(result==GL_WAIT_FAILED)
+			{
+				GLenum err = glGetError();
+				throw Exception("HdlFence::wait - Failed to wait for the fence. OpenGL error " + getGLEnumNameSafe(err) + " : " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException);
+			}
+			else if(result==GL_TIMEOUT_EXPIRED)
+				return false;
+		}
+		else
+		#endif
+			glFinish();
+
+		release();
+		return true;
+	}
+
+	/**
+	\fn bool HdlFence::isSupported(void)
+	\brief Test if the sync objects are available (otherwise, the fences are emulated with glFinish).
+	\return True if the sync objects are available.
+	**/
+	bool HdlFence::isSupported(void)
+	{
+		#if defined(GLIP_USE_GL)
+			return GLEW_VERSION_3_2 || GLEW_ARB_sync;
+		#elif defined(GLIP_USE_GLES3)
+			return true;
+		#else
+			return false;
+		#endif
+	}
+
@@ -21,6 +21,7 @@
  * \date    February 6th 2011
 */
 
+#include <cstring>
 #include "Core/Exception.hpp"
 #include "Core/HdlGeBO.hpp"
 
@@ -32,15 +33,22 @@ using namespace Glip::CoreGL;
 
 // Functions
 	/**
-	\fn HdlGeBO::HdlGeBO(GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage)
+	\fn HdlGeBO::HdlGeBO(GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage, bool _persistent)
 	\brief HdlGeBO Construtor.
 	\param _size Size of the buffer, in bytes.
 	\param infoTarget Target kind, among GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER.
-	\param infoUsage Usage kind among GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY, GL_DYNAMIC_DRAW, GL_DYNAMIC_READ, GL_DYNAMIC_COPY, GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY.
+	\param infoUsage Usage kind among GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY, GL_DYNAMIC_DRAW, GL_DYNAMIC_READ, GL_DYNAMIC_COPY, GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY (ignored for persistent buffers).
+	\param _persistent If true, the storage is immutable and persistently mapped for reading and writing (see HdlGeBO::isPersistentMappingSupported).
 	**/
-	HdlGeBO::HdlGeBO(GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage)
-	 : size(_size)
+	HdlGeBO::HdlGeBO(GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage, bool _persistent)
+	 :	size(_size),
+		persistent(_persistent),
+		persistentPtr(NULL),
+		head(0)
 	{
+		if(persistent && !isPersistentMappingSupported())
+			throw Exception("HdlGeBO::HdlGeBO - Persistent mapping requires OpenGL 4.4 or GL_ARB_buffer_storage.", __FILE__, __LINE__, Exception::GLException);
+
 		#ifdef GLIP_USE_GL
 		NEED_EXTENSION(GLEW_VERSION_1_5)
 		NEED_EXTENSION(GLEW_ARB_pixel_buffer_object)
@@ -67,7 +75,25 @@ using namespace Glip::CoreGL;
 		glBindBuffer(infoTarget, bufferId);
 
 		// Allocate some space
-		glBufferData(infoTarget, size, NULL, infoUsage);
+		#ifdef GLIP_USE_GL
+		if(persistent)
+		{
+			const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			glBufferStorage(infoTarget, size, NULL, flags | GL_DYNAMIC_STORAGE_BIT);
+			persistentPtr = glMapBufferRange(infoTarget, 0, size, flags);
+
+			if(persistentPtr==NULL)
+			{
+				GLenum err = glGetError();
+				HdlGeBO::unbind(infoTarget);
+				glDeleteBuffers(1, &bufferId);
+				throw Exception("HdlGeBO::HdlGeBO - Persistent Buffer Object can't be mapped. OpenGL error " + getGLEnumNameSafe(err) + " : " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException);
+			}
+		}
+		else
+		#endif
+			glBufferData(infoTarget, size, NULL, infoUsage);
 
 		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
 			OPENGL_ERROR_TRACKER("HdlGeBO::HdlGeBO", "glBufferData()")
@@ -93,7 +119,10 @@ using namespace Glip::CoreGL;
 	\param infoUsage  Usage kind among GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY, GL_DYNAMIC_DRAW, GL_DYNAMIC_READ, GL_DYNAMIC_COPY, GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY.
 	**/
 	HdlGeBO::HdlGeBO(GLuint id, GLsizeiptr _size, GLenum infoTarget, GLenum infoUsage)
-	 : size(_size)
+	 :	size(_size),
+		persistent(false),
+		persistentPtr(NULL),
+		head(0)
 	{
 		#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
 			std::cerr << "HdlGeBO::HdlGeBO ERROR : a copy was made" << std::endl;
@@ -109,7 +138,11 @@ using namespace Glip::CoreGL;
 
 	HdlGeBO::~HdlGeBO(void)
 	{
-		// Delete the object
+		for(std::deque<Region>::iterator it=regions.begin(); it!=regions.end(); it++)
+			delete it->fence;
+		regions.clear();
+
+		// Delete the object (a persistent mapping is released with it)
 		glDeleteBuffers(1, &bufferId);
 
 		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
@@ -178,7 +211,7 @@ using namespace Glip::CoreGL;
 
 	/**
 	\fn void* HdlGeBO::map(GLenum target, GLenum access)
-	\brief Map the Buffer Object into the CPU memory.
+	\brief Map the Buffer Object into the CPU memory. For a persistent buffer, only bind it and return the persistent pointer (HdlGeBO::unmap is then not needed).
 	\param access Kind of access, among GL_READ_ONLY, GL_WRITE_ONLY, GL_READ_WRITE, default can be used is target is GL_PIXEL_UNPACK_BUFFER or GL_PIXEL_PACK_BUFFER (will use respectively GL_WRITE_ONLY or GL_READ_ONLY). Will raise an exception otherwise.
 	\param target Target mapping point, among GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER, default is the target specified for this object.
 	\return Pointer in CPU memory.
@@ -186,6 +219,14 @@ using namespace Glip::CoreGL;
 	void* HdlGeBO::map(GLenum access, GLenum target)
 	{
 		if(target==GL_NONE) target = getTarget();
+
+		// Already mapped :
+		if(persistent)
+		{
+			bind(target);
+			return persistentPtr;
+		}
+
 		if(access==GL_NONE)
 		{
 			if(target==GL_PIXEL_UNPACK_BUFFER)
@@ -232,10 +273,17 @@ using namespace Glip::CoreGL;
 	/**
 	\fn void HdlGeBO::write(const void* data)
 	\brief Write data to a Buffer Object with classical glBufferData method.
-	\param data The data to write (must be the same size than the GeBO).
+	\param data The data to write (must be the same size than the GeBO). If NULL, the storage is orphaned, except for persistent buffers (the call has then no effect).
 	**/
 	void HdlGeBO::write(const void* data)
 	{
+		if(persistent)
+		{
+			if(data!=NULL)
+				std::memcpy(persistentPtr, data, size);
+			return ;
+		}
+
 		bind();
 
 		glBufferData(getTarget(), static_cast<GLsizeiptr>(size), reinterpret_cast<const GLvoid *>(data), getUsage());
@@ -254,6 +302,12 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlGeBO::subWrite(const void* data, GLsizeiptr size, GLintptr offset)
 	{
+		if(persistent)
+		{
+			std::memcpy(reinterpret_cast<char*>(persistentPtr) + offset, data, size);
+			return ;
+		}
+
 		bind();
 
 		glBufferSubData(getTarget(), offset, size,  reinterpret_cast<const GLvoid *>(data));
@@ -263,6 +317,86 @@ using namespace Glip::CoreGL;
 		#endif
 	}
 
+	/**
+	\fn bool HdlGeBO::isPersistent(void) const
+	\brief Test if the buffer is persistently mapped.
+	\return True if the buffer is persistently mapped.
+	**/
+	bool HdlGeBO::isPersistent(void) const
+	{
+		return persistent;
+	}
+
+	/**
+	\fn void* HdlGeBO::getPersistentPointer(void)
+	\brief Get the pointer to the persistent mapping of the buffer.
+	\return The pointer to the first byte of the buffer, or NULL if the buffer is not persistently mapped.
+	**/
+	void* HdlGeBO::getPersistentPointer(void)
+	{
+		return persistentPtr;
+	}
+
+	/**
+	\fn GLintptr HdlGeBO::allocateRegion(GLsizeiptr regionSize, GLsizeiptr alignment)
+	\brief Sub-allocate a region of the buffer, the regions are allocated one after the other and wrap around the end of the buffer. If the GPU might still be using a part of the new region, the function waits for the fences protecting it (see HdlGeBO::fenceRegions).
+	\param regionSize Size of the region, in bytes.
+	\param alignment Alignment of the offset of the region, in bytes.
+	\return The offset of the region in the buffer.
+	**/
+	GLintptr HdlGeBO::allocateRegion(GLsizeiptr regionSize, GLsizeiptr alignment)
+	{
+		if(regionSize<=0 || regionSize>size)
+			throw Exception("HdlGeBO::allocateRegion - Invalid region size " + toString(regionSize) + " for a buffer of " + toString(size) + " bytes.", __FILE__, __LINE__, Exception::GLException);
+		if(alignment<1)
+			alignment = 1;
+
+		GLintptr offset = ((head + alignment - 1) / alignment) * alignment;
+		if(offset + regionSize > size)
+			offset = 0;
+
+		// Wait for the GPU to be done with the pending regions overlapping the new one :
+		for(std::deque<Region>::iterator it=regions.begin(); it!=regions.end(); )
+		{
+			if(it->offset < offset + regionSize && offset < it->offset + it->size)
+			{
+				// Regions not fenced yet are in use by commands issued after their allocation :
+				if(it->fence==NULL)
+					fenceRegions();
+
+				it->fence->wait();
+				delete it->fence;
+				it = regions.erase(it);
+			}
+			else
+				it++;
+		}
+
+		Region region;
+		region.offset	= offset;
+		region.size	= regionSize;
+		region.fence	= NULL;
+		regions.push_back(region);
+
+		head = offset + regionSize;
+		return offset;
+	}
+
+	/**
+	\fn void HdlGeBO::fenceRegions(void)
+	\brief Insert a fence protecting the regions allocated since the last call (see HdlGeBO::allocateRegion). It must be called after issuing the commands using these regions.
+	**/
+	void HdlGeBO::fenceRegions(void)
+	{
+		for(std::deque<Region>::iterator it=regions.begin(); it!=regions.end(); it++)
+		{
+			if(it->fence==NULL)
+			{
+				it->fence = new HdlFence;
+				it->fence->insert();
+			}
+		}
+	}
 
 // Static tools
 	int HdlGeBO::getIDTarget(GLenum target)
@@ -337,3 +471,17 @@ using namespace Glip::CoreGL;
 		return mapping[getIDTarget(target)];
 	}
 
+	/**
+	\fn bool HdlGeBO::isPersistentMappingSupported(void)
+	\brief Test if the buffers can be persistently mapped.
+	\return True if OpenGL 4.4 or GL_ARB_buffer_storage are available.
+	**/
+	bool HdlGeBO::isPersistentMappingSupported(void)
+	{
+		#ifdef GLIP_USE_GL
+			return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+		#else
+			return false;
+		#endif
+	}
+
@@ -28,7 +28,7 @@ using namespace Glip::CoreGL;
 
 // Tools
 	/**
-	\fn HdlPBO::HdlPBO(int _w, int _h, int _c, int _cs, GLenum aim, GLenum freq, int size)
+	\fn HdlPBO::HdlPBO(int _w, int _h, int _c, int _cs, GLenum aim, GLenum freq, int size, bool persistent)
 	\brief HdlPBO constructor.
 	\param _w The width of the buffer.
 	\param _h The height of the buffer.
@@ -37,20 +37,22 @@ using namespace Glip::CoreGL;
 	\param aim The target (GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER).
 	\param freq The frequency (GL_STATIC_DRAW_ARB, GL_STATIC_READ_ARB, GL_STATIC_COPY_ARB, GL_DYNAMIC_DRAW_ARB, GL_DYNAMIC_READ_ARB, GL_DYNAMIC_COPY_ARB, GL_STREAM_DRAW_ARB, GL_STREAM_READ_ARB, GL_STREAM_COPY_ARB).
 	\param size The size of the buffer, computed by default with previous parameters.
+	\param persistent If true, the buffer is persistently mapped (see HdlGeBO).
 	**/
-	HdlPBO::HdlPBO(int _w, int _h, int _c, int _cs, GLenum aim, GLenum freq, int size)
-	 : HdlGeBO((size<0)?(_w*_h*_c*_cs):size, aim, freq), w(_w), h(_h), c(_c), cs(_cs)
+	HdlPBO::HdlPBO(int _w, int _h, int _c, int _cs, GLenum aim, GLenum freq, int size, bool persistent)
+	 : HdlGeBO((size<0)?(_w*_h*_c*_cs):size, aim, freq, persistent), w(_w), h(_h), c(_c), cs(_cs)
 	{ }
 
 	/**
-	\fn HdlPBO::HdlPBO(const HdlAbstractTextureFormat& fmt, GLenum aim, GLenum freq)
+	\fn HdlPBO::HdlPBO(const HdlAbstractTextureFormat& fmt, GLenum aim, GLenum freq, bool persistent)
 	\brief HdlPBO constructor.
 	\param fmt The format to copy, this must an uncompressed format.
 	\param aim The target (GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER).
 	\param freq The frequency (GL_STATIC_DRAW_ARB, GL_STATIC_READ_ARB, GL_STATIC_COPY_ARB, GL_DYNAMIC_DRAW_ARB, GL_DYNAMIC_READ_ARB, GL_DYNAMIC_COPY_ARB, GL_STREAM_DRAW_ARB, GL_STREAM_READ_ARB, GL_STREAM_COPY_ARB).
+	\param persistent If true, the buffer is persistently mapped (see HdlGeBO).
 	**/
-	HdlPBO::HdlPBO(const HdlAbstractTextureFormat& fmt, GLenum aim, GLenum freq)
-	 : HdlGeBO(fmt.getSize(), aim, freq), w(fmt.getWidth()), h(fmt.getHeight()), c(fmt.getNumChannels()), cs(fmt.getChannelDepth())
+	HdlPBO::HdlPBO(const HdlAbstractTextureFormat& fmt, GLenum aim, GLenum freq, bool persistent)
+	 : HdlGeBO(fmt.getSize(), aim, freq, persistent), w(fmt.getWidth()), h(fmt.getHeight()), c(fmt.getNumChannels()), cs(fmt.getChannelDepth())
 	{
 		if(fmt.isCompressed())
 			throw Exception("HdlPBO::HdlPBO - Can not create a PBO on HdlAbstractTextureFormat object for a compressed texture (size can not be obtained).", __FILE__, __LINE__, Exception::GLException);
@@ -26,8 +26,11 @@
 #include <sstream>
 #include <cstring>
 #include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include "Core/Exception.hpp"
 #include "Core/HdlShader.hpp"
+#include "Core/GLStateCache.hpp"
 #include "devDebugTools.hpp"
 
 using namespace Glip::CoreGL;
@@ -196,6 +199,27 @@ using namespace Glip::CoreGL;
 		return type;
 	}
 
+// HdlProgram::UniformHandle :
+	/**
+	\fn HdlProgram::UniformHandle::UniformHandle(void)
+	\brief UniformHandle constructor, builds an invalid handle.
+	**/
+	HdlProgram::UniformHandle::UniformHandle(void)
+	 :	location(-1),
+		type(GL_NONE),
+		generation(0)
+	{ }
+
+	/**
+	\fn bool HdlProgram::UniformHandle::isValid(void) const
+	\brief Test if the handle was resolved.
+	\return True if the handle points to an existing variable.
+	**/
+	bool HdlProgram::UniformHandle::isValid(void) const
+	{
+		return location!=-1;
+	}
+
 // HdlProgram :
 	/**
 	\fn HdlProgram::HdlProgram(void)
@@ -203,7 +227,9 @@ using namespace Glip::CoreGL;
 	**/
 	HdlProgram::HdlProgram(void)
 	 : 	valid(false),
-		program(0)
+		program(0),
+		generation(0),
+		modifications(0)
 	{
 		std::memset(attachedShaders, 0, numShaderTypes*sizeof(GLuint));
 
@@ -236,6 +262,7 @@ using namespace Glip::CoreGL;
 		}
 
 		glDeleteProgram(program);
+		GLStateCache::forgetProgram(program);
 
 		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
 			OPENGL_ERROR_TRACKER("HdlProgram::~HdlProgram", "glDeleteProgram(program)")
@@ -296,6 +323,17 @@ using namespace Glip::CoreGL;
 	{
 		valid = false;
 
+		// Invalidate the locations and the handles :
+		locations.clear();
+		generation++;
+		modifications++;
+
+		// Keep the binary accessible for the cache :
+		#ifdef GLIP_USE_GL
+			if(HdlProgramCache::isEnabled() && HdlProgramCache::isSupported())
+				glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		#endif
+
 		// Link them
 		glLinkProgram(program);
 
@@ -341,40 +379,48 @@ using namespace Glip::CoreGL;
 		else
 		{
 			use();
+			updateActiveUniforms();
+			valid = true;
+		}
+	}
+
+	/**
+	\fn    void HdlProgram::updateActiveUniforms(void)
+	\brief Update the list of the active uniforms (of supported types) and their locations, after a successful link.
+	**/
+	void HdlProgram::updateActiveUniforms(void)
+	{
+		// Clean :
+		activeUniforms.clear();
+		activeTypes.clear();
 
-			// Clean :
-			activeUniforms.clear();
-			activeTypes.clear();
+		// Update available uniforms of the following types :
+		#ifdef GLIP_USE_GL
+		const GLenum interestTypes[] = {GL_FLOAT, GL_FLOAT_VEC2, GL_FLOAT_VEC3, GL_FLOAT_VEC4, GL_DOUBLE, GL_DOUBLE_VEC2, GL_DOUBLE_VEC3, GL_DOUBLE_VEC4, GL_INT, GL_INT_VEC2, GL_INT_VEC3, GL_INT_VEC4, GL_UNSIGNED_INT_VEC2, GL_UNSIGNED_INT_VEC3, GL_UNSIGNED_INT_VEC4, GL_BOOL, GL_BOOL_VEC2, GL_BOOL_VEC3, GL_BOOL_VEC4, GL_FLOAT_MAT2, GL_FLOAT_MAT3, GL_FLOAT_MAT4, /*GL_DOUBLE_MAT2, GL_DOUBLE_MAT3, GL_DOUBLE_MAT4,*/ GL_UNSIGNED_INT};
+		#else
+		const GLenum interestTypes[] = {GL_FLOAT, GL_FLOAT_VEC2, GL_FLOAT_VEC3, GL_FLOAT_VEC4, GL_INT, GL_INT_VEC2, GL_INT_VEC3, GL_INT_VEC4, GL_UNSIGNED_INT_VEC2, GL_UNSIGNED_INT_VEC3, GL_UNSIGNED_INT_VEC4, GL_BOOL, GL_BOOL_VEC2, GL_BOOL_VEC3, GL_BOOL_VEC4, GL_FLOAT_MAT2, GL_FLOAT_MAT3, GL_FLOAT_MAT4, GL_UNSIGNED_INT};
+		#endif
+		const int numAllowedTypes = sizeof(interestTypes) / sizeof(GLenum);
 
-			// Update available uniforms of the following types :
-			#ifdef GLIP_USE_GL
-			const GLenum interestTypes[] = {GL_FLOAT, GL_FLOAT_VEC2, GL_FLOAT_VEC3, GL_FLOAT_VEC4, GL_DOUBLE, GL_DOUBLE_VEC2, GL_DOUBLE_VEC3, GL_DOUBLE_VEC4, GL_INT, GL_INT_VEC2, GL_INT_VEC3, GL_INT_VEC4, GL_UNSIGNED_INT_VEC2, GL_UNSIGNED_INT_VEC3, GL_UNSIGNED_INT_VEC4, GL_BOOL, GL_BOOL_VEC2, GL_BOOL_VEC3, GL_BOOL_VEC4, GL_FLOAT_MAT2, GL_FLOAT_MAT3, GL_FLOAT_MAT4, /*GL_DOUBLE_MAT2, GL_DOUBLE_MAT3, GL_DOUBLE_MAT4,*/ GL_UNSIGNED_INT};
-			#else
-			const GLenum interestTypes[] = {GL_FLOAT, GL_FLOAT_VEC2, GL_FLOAT_VEC3, GL_FLOAT_VEC4, GL_INT, GL_INT_VEC2, GL_INT_VEC3, GL_INT_VEC4, GL_UNSIGNED_INT_VEC2, GL_UNSIGNED_INT_VEC3, GL_UNSIGNED_INT_VEC4, GL_BOOL, GL_BOOL_VEC2, GL_BOOL_VEC3, GL_BOOL_VEC4, GL_FLOAT_MAT2, GL_FLOAT_MAT3, GL_FLOAT_MAT4, GL_UNSIGNED_INT};
-			#endif
-			const int numAllowedTypes = sizeof(interestTypes) / sizeof(GLenum);
+		// Get number of uniforms :
+		GLint numUniforms = 0;
+		glGetProgramiv(	program, GL_ACTIVE_UNIFORMS, &numUniforms);
 
-			// Get number of uniforms :
-			GLint numUniforms = 0;
-			glGetProgramiv(	program, GL_ACTIVE_UNIFORMS, &numUniforms);
+		const int maxLength = 1024;
+		char buffer[maxLength];
+		GLenum type;
+		GLint actualSize, actualSizeName;
+		for(int k=0; k<numUniforms; k++)
+		{
+			glGetActiveUniform( program, k, maxLength-1, &actualSizeName, &actualSize, &type, buffer);
 
-			const int maxLength = 1024;
-			char buffer[maxLength];
-			GLenum type;
-			GLint actualSize, actualSizeName;
-			for(int k=0; k<numUniforms; k++)
+			if(std::find(interestTypes, interestTypes + numAllowedTypes, type)!=interestTypes + numAllowedTypes)
 			{
-				glGetActiveUniform( program, k, maxLength-1, &actualSizeName, &actualSize, &type, buffer);
-
-				if(std::find(interestTypes, interestTypes + numAllowedTypes, type)!=interestTypes + numAllowedTypes)
-				{
- 					activeUniforms.push_back(buffer);
-					activeTypes.push_back(type);
-				}
+				activeUniforms.push_back(buffer);
+				activeTypes.push_back(type);
+				locations[buffer] = glGetUniformLocation(program, buffer);
 			}
-
-			valid = true;
-		}		
+		}
 	}
 
 	/**
@@ -383,10 +429,112 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlProgram::use(void)
 	{
-		glUseProgram(program);
+		GLStateCache::useProgram(program);
+	}
+
+	/**
+	\fn    bool HdlProgram::getBinary(GLenum& format, std::vector<char>& binary) const
+	\brief Get the binary of the linked program (see glGetProgramBinary).
+	\param format The format of the binary (driver dependent).
+	\param binary The binary data.
+	\return True if the binary was retrieved, false otherwise (unsupported, program not linked, etc.).
+	**/
+	bool HdlProgram::getBinary(GLenum& format, std::vector<char>& binary) const
+	{
+		#ifdef GLIP_USE_GL
+			if(!isValid() || !HdlProgramCache::isSupported())
+				return false;
 
-		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
-			OPENGL_ERROR_TRACKER("HdlProgram::use", "glUseProgram()")
+			GLint length = 0;
+			glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+			if(length<=0)
+				return false;
+
+			GLsizei actualLength = 0;
+			binary.assign(length, 0);
+			glGetProgramBinary(program, length, &actualLength, &format, &binary[0]);
+
+			const GLenum err = glGetError();
+			if(err!=GL_NO_ERROR || actualLength<=0)
+			{
+				binary.clear();
+				return false;
+			}
+
+			binary.resize(actualLength);
+			return true;
+		#else
+			return false;
+		#endif
+	}
+
+	/**
+	\fn    bool HdlProgram::loadBinary(GLenum format, const std::vector<char>& binary)
+	\brief Load a binary previously obtained with HdlProgram::getBinary instead of linking the attached shaders (see glProgramBinary). The driver might reject the binary, in which case the program has to be linked from its shaders.
+	\param format The format of the binary.
+	\param binary The binary data.
+	\return True if the program was loaded and is valid, false otherwise.
+	**/
+	bool HdlProgram::loadBinary(GLenum format, const std::vector<char>& binary)
+	{
+		valid = false;
+		locations.clear();
+		generation++;
+		modifications++;
+
+		#ifdef GLIP_USE_GL
+			if(binary.empty() || !HdlProgramCache::isSupported())
+				return false;
+
+			glProgramBinary(program, format, &binary[0], binary.size());
+
+			// A rejected binary might raise an error, it is not reported :
+			glGetError();
+
+			GLint link_status = GL_FALSE;
+			glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+
+			if(link_status!=GL_TRUE)
+				return false;
+
+			use();
+			updateActiveUniforms();
+			valid = true;
+			return true;
+		#else
+			return false;
+		#endif
+	}
+
+	/**
+	\fn    bool HdlProgram::getWorkGroupSize(int& x, int& y, int& z) const
+	\brief Get the size of the work groups declared by the compute shader of the program (see GL_COMPUTE_WORK_GROUP_SIZE).
+	\param x Number of invocations along X (output).
+	\param y Number of invocations along Y (output).
+	\param z Number of invocations along Z (output).
+	\return True if the size was retrieved, false otherwise (no compute shader, program not linked, etc.).
+	**/
+	bool HdlProgram::getWorkGroupSize(int& x, int& y, int& z) const
+	{
+		x = y = z = 0;
+
+		#ifdef GLIP_USE_GL
+			if(!isValid() || !(GLEW_VERSION_4_3 || GLEW_ARB_compute_shader))
+				return false;
+
+			GLint size[3] = {0, 0, 0};
+			glGetProgramiv(program, GL_COMPUTE_WORK_GROUP_SIZE, size);
+
+			if(glGetError()!=GL_NO_ERROR)
+				return false;
+
+			x = size[0];
+			y = size[1];
+			z = size[2];
+			return (x>0 && y>0 && z>0);
+		#else
+			return false;
 		#endif
 	}
 
@@ -403,6 +551,16 @@ using namespace Glip::CoreGL;
 		return activeUniforms;
 	}
 
+	/**
+	\fn    unsigned int HdlProgram::getModificationsCount(void) const
+	\brief Get the number of modifications of the uniform variables (each call to HdlProgram::setVar and each link), which can be used to detect changes.
+	\return The modifications counter.
+	**/
+	unsigned int HdlProgram::getModificationsCount(void) const
+	{
+		return modifications;
+	}
+
 	/**
 	\fn    const std::vector<GLenum>& HdlProgram::getUniformsTypes(void) const
 	\brief Get access to the list of uniform variables types corresponding to the names provided by HdlProgram::getUniformsNames (GL based).
@@ -439,36 +597,327 @@ using namespace Glip::CoreGL;
 	}
 
 	/**
-	\fn    void HdlProgram::setVar(const std::string& varName, GLenum type, int v0, int v1=0, int v2=0, int v3=0)
+	\fn    void HdlProgram::checkHandle(const UniformHandle& handle) const
+	\brief Check that a handle can be used with the current link of the program. Raise an exception otherwise.
+	\param handle The handle to test.
+	**/
+	void HdlProgram::checkHandle(const UniformHandle& handle) const
+	{
+		if(!handle.isValid())
+			throw Exception("HdlProgram::setVar - Invalid handle for variable \"" + handle.name + "\".", __FILE__, __LINE__, Exception::GLException);
+		else if(handle.generation!=generation)
+			throw Exception("HdlProgram::setVar - The handle of variable \"" + handle.name + "\" was obtained before the last link of the program.", __FILE__, __LINE__, Exception::GLException);
+	}
+
+	#define UNIFORM_TYPE_MISMATCH(t) \
+		throw Exception("HdlProgram::setVar - Unknown variable type or type mismatch for \"" + getGLEnumNameSafe(t) + "\" when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
+
+	#define UNIFORM_CHECK_ERROR(t) \
+		{ \
+			const GLenum err = glGetError(); \
+			if(err!=GL_NO_ERROR) \
+				throw Exception("HdlProgram::setVar - An error occurred when loading data of type \"" + getGLEnumNameSafe(t) + "\" in variable \"" + varName + "\" : " + getGLEnumNameSafe(err) + " - " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException); \
+		}
+
+	/**
+	\fn    void HdlProgram::writeUniform(const std::string& varName, GLint loc, GLenum t, const GLint* v)
+	\brief Write integer values to a uniform variable, with glProgramUniform* if available (the program is not bound) or with glUniform* otherwise.
+	\param varName Name of the variable (for error reporting).
+	\param loc Location of the variable.
+	\param t Type of the variable. The samplers and the images take their unit.
+	\param v Pointer to the values to assign.
+	**/
+	void HdlProgram::writeUniform(const std::string& varName, GLint loc, GLenum t, const GLint* v)
+	{
+		modifications++;
+
+		#ifdef GLIP_USE_GL
+		if(isDirectUniformAccessAvailable())
+		{
+			switch(t)
+			{
+				case GL_INT :
+				case GL_BOOL :
+				case GL_SAMPLER_2D :
+				case GL_INT_SAMPLER_2D :
+				case GL_UNSIGNED_INT_SAMPLER_2D :
+				case GL_IMAGE_2D :
+				case GL_INT_IMAGE_2D :
+				case GL_UNSIGNED_INT_IMAGE_2D :	glProgramUniform1iv(program, loc, 1, v);	break;
+				case GL_INT_VEC2 :
+				case GL_BOOL_VEC2 :	glProgramUniform2iv(program, loc, 1, v);	break;
+				case GL_INT_VEC3 :
+				case GL_BOOL_VEC3 :	glProgramUniform3iv(program, loc, 1, v);	break;
+				case GL_INT_VEC4 :
+				case GL_BOOL_VEC4 :	glProgramUniform4iv(program, loc, 1, v);	break;
+				default :		UNIFORM_TYPE_MISMATCH(t)
+			}
+		}
+		else
+		#endif
+		{
+			use();
+			switch(t)
+			{
+				case GL_INT :
+				case GL_BOOL :
+				case GL_SAMPLER_2D :
+				#ifdef GLIP_USE_GL
+				case GL_INT_SAMPLER_2D :
+				case GL_UNSIGNED_INT_SAMPLER_2D :
+				case GL_IMAGE_2D :
+				case GL_INT_IMAGE_2D :
+				case GL_UNSIGNED_INT_IMAGE_2D :
+				#endif
+							glUniform1iv(loc, 1, v);	break;
+				case GL_INT_VEC2 :
+				case GL_BOOL_VEC2 :	glUniform2iv(loc, 1, v);	break;
+				case GL_INT_VEC3 :
+				case GL_BOOL_VEC3 :	glUniform3iv(loc, 1, v);	break;
+				case GL_INT_VEC4 :
+				case GL_BOOL_VEC4 :	glUniform4iv(loc, 1, v);	break;
+				default :		UNIFORM_TYPE_MISMATCH(t)
+			}
+		}
+
+		UNIFORM_CHECK_ERROR(t)
+	}
+
+	/**
+	\fn    void HdlProgram::writeUniform(const std::string& varName, GLint loc, GLenum t, const GLuint* v)
+	\brief Write unsigned integer values to a uniform variable, with glProgramUniform* if available (the program is not bound) or with glUniform* otherwise.
+	\param varName Name of the variable (for error reporting).
+	\param loc Location of the variable.
+	\param t Type of the variable.
+	\param v Pointer to the values to assign.
+	**/
+	void HdlProgram::writeUniform(const std::string& varName, GLint loc, GLenum t, const GLuint* v)
+	{
+		modifications++;
+
+		#ifdef GLIP_USE_GL
+		if(isDirectUniformAccessAvailable())
+		{
+			switch(t)
+			{
+				case GL_UNSIGNED_INT :		glProgramUniform1uiv(program, loc, 1, v);	break;
+				case GL_UNSIGNED_INT_VEC2 :	glProgramUniform2uiv(program, loc, 1, v);	break;
+				case GL_UNSIGNED_INT_VEC3 :	glProgramUniform3uiv(program, loc, 1, v);	break;
+				case GL_UNSIGNED_INT_VEC4 :	glProgramUniform4uiv(program, loc, 1, v);	break;
+				default :			UNIFORM_TYPE_MISMATCH(t)
+			}
+		}
+		else
+		#endif
+		{
+			use();
+			switch(t)
+			{
+				case GL_UNSIGNED_INT :		glUniform1uiv(loc, 1, v);	break;
+				case GL_UNSIGNED_INT_VEC2 :	glUniform2uiv(loc, 1, v);	break;
+				case GL_UNSIGNED_INT_VEC3 :	glUniform3uiv(loc, 1, v);	break;
+				case GL_UNSIGNED_INT_VEC4 :	glUniform4uiv(loc, 1, v);	break;
+				default :			UNIFORM_TYPE_MISMATCH(t)
+			}
+		}
+
+		UNIFORM_CHECK_ERROR(t)
+	}
+
+	/**
+	\fn    void HdlProgram::writeUniform(const std::string& varName, GLint loc, GLenum t, const GLfloat* v)
+	\brief Write floating point values (including matrices) to a uniform variable, with glProgramUniform* if available (the program is not bound) or with glUniform* otherwise.
+	\param varName Name of the variable (for error reporting).
+	\param loc Location of the variable.
+	\param t Type of the variable.
+	\param v Pointer to the values to assign.
+	**/
+	void HdlProgram::writeUniform(const std::string& varName, GLint loc, GLenum t, const GLfloat* v)
+	{
+		modifications++;
+
+		#ifdef GLIP_USE_GL
+		if(isDirectUniformAccessAvailable())
+		{
+			switch(t)
+			{
+				case GL_FLOAT : 	glProgramUniform1fv(program, loc, 1, v);			break;
+				case GL_FLOAT_VEC2 : 	glProgramUniform2fv(program, loc, 1, v);			break;
+				case GL_FLOAT_VEC3 : 	glProgramUniform3fv(program, loc, 1, v);			break;
+				case GL_FLOAT_VEC4 : 	glProgramUniform4fv(program, loc, 1, v);			break;
+				case GL_FLOAT_MAT2 :	glProgramUniformMatrix2fv(program, loc, 1, GL_FALSE, v);	break;
+				case GL_FLOAT_MAT3 :	glProgramUniformMatrix3fv(program, loc, 1, GL_FALSE, v);	break;
+				case GL_FLOAT_MAT4 :	glProgramUniformMatrix4fv(program, loc, 1, GL_FALSE, v);	break;
+				default :		UNIFORM_TYPE_MISMATCH(t)
+			}
+		}
+		else
+		#endif
+		{
+			use();
+			switch(t)
+			{
+				case GL_FLOAT : 	glUniform1fv(loc, 1, v);			break;
+				case GL_FLOAT_VEC2 : 	glUniform2fv(loc, 1, v);			break;
+				case GL_FLOAT_VEC3 : 	glUniform3fv(loc, 1, v);			break;
+				case GL_FLOAT_VEC4 : 	glUniform4fv(loc, 1, v);			break;
+				case GL_FLOAT_MAT2 :	glUniformMatrix2fv(loc, 1, GL_FALSE, v);	break;
+				case GL_FLOAT_MAT3 :	glUniformMatrix3fv(loc, 1, GL_FALSE, v);	break;
+				case GL_FLOAT_MAT4 :	glUniformMatrix4fv(loc, 1, GL_FALSE, v);	break;
+				default :		UNIFORM_TYPE_MISMATCH(t)
+			}
+		}
+
+		UNIFORM_CHECK_ERROR(t)
+	}
+
+	/**
+	\fn    void HdlProgram::writeUniform(const std::string& varName, GLint loc, const HdlDynamicData& data)
+	\brief Write the content of a dynamic object to a uniform variable.
+	\param varName Name of the variable (for error reporting).
+	\param loc Location of the variable.
+	\param data The dynamic object to be used as source.
+	**/
+	void HdlProgram::writeUniform(const std::string& varName, GLint loc, const HdlDynamicData& data)
+	{
+		switch(data.getGLType())
+		{
+			case GL_BYTE :
+			case GL_SHORT :
+			{
+				const GLint v = static_cast<GLint>(data.get(0));
+				writeUniform(varName, loc, GL_INT, &v);
+				break;
+			}
+			case GL_UNSIGNED_BYTE :
+			case GL_UNSIGNED_SHORT :
+			{
+				const GLuint v = static_cast<GLuint>(data.get(0));
+				writeUniform(varName, loc, GL_UNSIGNED_INT, &v);
+				break;
+			}
+			case GL_FLOAT :
+			case GL_FLOAT_VEC2 :
+			case GL_FLOAT_VEC3 :
+			case GL_FLOAT_VEC4 :
+			case GL_FLOAT_MAT2 :
+			case GL_FLOAT_MAT3 :
+			case GL_FLOAT_MAT4 :		writeUniform(varName, loc, data.getGLType(), reinterpret_cast<const GLfloat*>(data.getPtr()));	break;
+			#ifdef GLIP_USE_GL
+			case GL_DOUBLE :
+			case GL_DOUBLE_VEC2 :
+			case GL_DOUBLE_VEC3 :
+			case GL_DOUBLE_VEC4 :		throw Exception("HdlProgram::setVar - Double type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
+			#endif
+			case GL_INT :
+			case GL_INT_VEC2 :
+			case GL_INT_VEC3 :
+			case GL_INT_VEC4 :		writeUniform(varName, loc, data.getGLType(), reinterpret_cast<const GLint*>(data.getPtr()));	break;
+			case GL_UNSIGNED_INT :
+			case GL_UNSIGNED_INT_VEC2 :
+			case GL_UNSIGNED_INT_VEC3 :
+			case GL_UNSIGNED_INT_VEC4 :	writeUniform(varName, loc, data.getGLType(), reinterpret_cast<const GLuint*>(data.getPtr()));	break;
+			case GL_BOOL :
+			case GL_BOOL_VEC2 :
+			case GL_BOOL_VEC3 :
+			case GL_BOOL_VEC4 :		throw Exception("HdlProgram::setVar - Bool type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
+			default :			UNIFORM_TYPE_MISMATCH(data.getGLType())
+		}
+	}
+
+	#undef UNIFORM_TYPE_MISMATCH
+	#undef UNIFORM_CHECK_ERROR
+
+	/**
+	\fn    GLint HdlProgram::getUniformLocation(const std::string& varName)
+	\brief Get the location of a uniform variable. The location is only requested to the driver the first time, and cached until the next link.
+	\param varName The name of the uniform variable.
+	\return The location of the variable or -1 if it does not exist.
+	**/
+	GLint HdlProgram::getUniformLocation(const std::string& varName)
+	{
+		std::map<std::string, GLint>::const_iterator it = locations.find(varName);
+
+		if(it!=locations.end())
+			return it->second;
+		else if(program==0)
+			return -1;
+		else
+		{
+			const GLint loc = glGetUniformLocation(program, varName.c_str());
+			locations[varName] = loc;
+			return loc;
+		}
+	}
+
+	/**
+	\fn    HdlProgram::UniformHandle HdlProgram::getUniformHandle(const std::string& varName, GLenum type)
+	\brief Resolve a uniform variable once, the handle can then be used with the corresponding HdlProgram::setVar functions until the next link of the program. Raise an exception if the variable does not exist.
+	\param varName The name of the uniform variable.
+	\param type The type of the variable. If it is GL_NONE, the type reported by the driver is used (see HdlProgram::getUniformsTypes); it must be given for the variables which are not listed there (samplers for instance, GL_SAMPLER_2D, set with the index of their texture unit).
+	\return A handle on the variable.
+	**/
+	HdlProgram::UniformHandle HdlProgram::getUniformHandle(const std::string& varName, GLenum type)
+	{
+		UniformHandle handle;
+
+		handle.name		= varName;
+		handle.location		= getUniformLocation(varName);
+		handle.type		= type;
+		handle.generation	= generation;
+
+		if(handle.location==-1)
+			throw Exception("HdlProgram::getUniformHandle - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
+
+		if(handle.type==GL_NONE)
+		{
+			std::vector<std::string>::const_iterator it = std::find(activeUniforms.begin(), activeUniforms.end(), varName);
+
+			if(it==activeUniforms.end())
+				throw Exception("HdlProgram::getUniformHandle - The type of the variable \"" + varName + "\" is unknown and must be specified.", __FILE__, __LINE__, Exception::GLException);
+			else
+				handle.type = activeTypes[it - activeUniforms.begin()];
+		}
+
+		return handle;
+	}
+
+	#define GET_LOCATION(functionName) \
+		const GLint loc = getUniformLocation(varName); \
+		\
+		if(loc==-1) \
+			throw Exception("HdlProgram::" functionName " - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
+
+	/**
+	\fn    void HdlProgram::setVar(const std::string& varName, GLenum t, int v0, int v1, int v2, int v3)
 	\brief Change a uniform variable in a shader. Raise an exception if any error occur.
 	\param varName Name of the fragment output variable.
-	\param type    Kind of variable in, see http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml for possible types.
+	\param t       Kind of variable in, see http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml for possible types.
 	\param v0      Corresponding value to assign.
 	\param v1      Corresponding value to assign.
 	\param v2      Corresponding value to assign.
 	\param v3      Corresponding value to assign.
 	**/
 	/**
-	\fn    void HdlProgram::setVar(const std::string& varName, GLenum type, unsigned int v0, unsigned int v1=0, unsigned int v2=0, unsigned int v3=0)
+	\fn    void HdlProgram::setVar(const std::string& varName, GLenum t, unsigned int v0, unsigned int v1, unsigned int v2, unsigned int v3)
 	\brief Change a uniform variable in a shader. Raise an exception if any error occur.
 	\param varName Name of the fragment output variable.
-	\param type    Kind of variable in, see http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml for possible types.
+	\param t       Kind of variable in, see http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml for possible types.
 	\param v0      Corresponding value to assign.
 	\param v1      Corresponding value to assign.
 	\param v2      Corresponding value to assign.
 	\param v3      Corresponding value to assign.
 	**/
 	/**
-	\fn    void HdlProgram::setVar(const std::string& varName, GLenum type, float v0, float v1=0, float v2=0, float v3=0)
+	\fn    void HdlProgram::setVar(const std::string& varName, GLenum t, float v0, float v1, float v2, float v3)
 	\brief Change a uniform variable in a shader. Raise an exception if any error occur.
 	\param varName Name of the fragment output variable.
-	\param type    Kind of variable in, see http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml for possible types.
+	\param t       Kind of variable in, see http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml for possible types.
 	\param v0      Corresponding value to assign.
 	\param v1      Corresponding value to assign.
 	\param v2      Corresponding value to assign.
 	\param v3      Corresponding value to assign.
 	**/
-
 	/**
 	\fn    void HdlProgram::setVar(const std::string& varName, GLenum t, int* v)
 	\brief Change a uniform variable in a shader. Raise an exception if any error occur.
@@ -485,92 +934,90 @@ using namespace Glip::CoreGL;
 	**/
 	/**
 	\fn    void HdlProgram::setVar(const std::string& varName, GLenum t, float* v)
-	\brief Change a uniform variable in a shader. Raise an exception if any error occur.
+	\brief Change a uniform variable in a shader (including matrices). Raise an exception if any error occur.
 	\param varName Name of the fragment output variable.
 	\param t       Kind of variable in, see http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml for possible types.
 	\param v       Pointer to the values to assign.
 	**/
+	/**
+	\fn    void HdlProgram::setVar(const UniformHandle& handle, int v0, int v1, int v2, int v3)
+	\brief Change a uniform variable in a shader from its handle. Raise an exception if any error occur.
+	\param handle  Handle of the variable, see HdlProgram::getUniformHandle.
+	\param v0      Corresponding value to assign.
+	\param v1      Corresponding value to assign.
+	\param v2      Corresponding value to assign.
+	\param v3      Corresponding value to assign.
+	**/
+	/**
+	\fn    void HdlProgram::setVar(const UniformHandle& handle, unsigned int v0, unsigned int v1, unsigned int v2, unsigned int v3)
+	\brief Change a uniform variable in a shader from its handle. Raise an exception if any error occur.
+	\param handle  Handle of the variable, see HdlProgram::getUniformHandle.
+	\param v0      Corresponding value to assign.
+	\param v1      Corresponding value to assign.
+	\param v2      Corresponding value to assign.
+	\param v3      Corresponding value to assign.
+	**/
+	/**
+	\fn    void HdlProgram::setVar(const UniformHandle& handle, float v0, float v1, float v2, float v3)
+	\brief Change a uniform variable in a shader from its handle. Raise an exception if any error occur.
+	\param handle  Handle of the variable, see HdlProgram::getUniformHandle.
+	\param v0      Corresponding value to assign.
+	\param v1      Corresponding value to assign.
+	\param v2      Corresponding value to assign.
+	\param v3      Corresponding value to assign.
+	**/
+	/**
+	\fn    void HdlProgram::setVar(const UniformHandle& handle, const int* v)
+	\brief Change a uniform variable in a shader from its handle. Raise an exception if any error occur.
+	\param handle  Handle of the variable, see HdlProgram::getUniformHandle.
+	\param v       Pointer to the values to assign.
+	**/
+	/**
+	\fn    void HdlProgram::setVar(const UniformHandle& handle, const unsigned int* v)
+	\brief Change a uniform variable in a shader from its handle. Raise an exception if any error occur.
+	\param handle  Handle of the variable, see HdlProgram::getUniformHandle.
+	\param v       Pointer to the values to assign.
+	**/
+	/**
+	\fn    void HdlProgram::setVar(const UniformHandle& handle, const float* v)
+	\brief Change a uniform variable in a shader from its handle (including matrices). Raise an exception if any error occur.
+	\param handle  Handle of the variable, see HdlProgram::getUniformHandle.
+	\param v       Pointer to the values to assign.
+	**/
 
-	#define GENsetVarA( argT1, argT2, argT3)   \
+	#define GENsetVar( argT1, argT2 )   \
 		void HdlProgram::setVar(const std::string& varName, GLenum t, argT1 v0, argT1 v1, argT1 v2, argT1 v3) \
 		{ \
-			use(); \
-			GLint loc = glGetUniformLocation(program, varName.c_str()); \
-			\
-			if(loc==-1) \
-				throw Exception("HdlProgram::setVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException); \
-			\
-			switch(t) \
-			{ \
-				case GL_##argT2 : 		glUniform1##argT3 (loc, v0);			break; \
-				case GL_##argT2##_VEC2 : 	glUniform2##argT3 (loc, v0, v1);		break; \
-				case GL_##argT2##_VEC3 : 	glUniform3##argT3 (loc, v0, v1, v2);		break; \
-				case GL_##argT2##_VEC4 : 	glUniform4##argT3 (loc, v0, v1, v2, v3);	break; \
-				default :			throw Exception("HdlProgram::setVar - Unknown variable type or type mismatch for \"" + getGLEnumNameSafe(t) + "\" when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException); \
-			} \
-			\
-			const GLenum err = glGetError(); \
-			if(err!=GL_NO_ERROR) \
-				throw Exception("HdlProgram::setVar - An error occurred when loading data of type \"" + getGLEnumNameSafe(t) + "\" in variable \"" + varName + "\" : " + getGLEnumNameSafe(err) + " - " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException); \
+			GET_LOCATION("setVar") \
+			const argT2 v[4] = {v0, v1, v2, v3}; \
+			writeUniform(varName, loc, t, v); \
 		} \
-
-	#define GENsetVarB( argT1, argT2, argT3)   \
+		\
 		void HdlProgram::setVar(const std::string& varName, GLenum t, argT1* v) \
 		{ \
-			use(); \
-			GLint loc = glGetUniformLocation(program, varName.c_str()); \
-			\
-			if(loc==-1) \
-				throw Exception("HdlProgram::setVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException); \
-			\
-			switch(t) \
-			{ \
-				case GL_##argT2 : 		glUniform1##argT3##v(loc, 1, v);			break; \
-				case GL_##argT2##_VEC2 : 	glUniform2##argT3##v(loc, 1, v);			break; \
-				case GL_##argT2##_VEC3 : 	glUniform3##argT3##v(loc, 1, v);			break; \
-				case GL_##argT2##_VEC4 : 	glUniform4##argT3##v(loc, 1, v);			break; \
-				default :			throw Exception("HdlProgram::setVar - Unknown variable type or type mismatch for \"" + getGLEnumNameSafe(t) + "\" when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException); \
-			} \
-			\
-			const GLenum err = glGetError(); \
-			if(err!=GL_NO_ERROR) \
-				throw Exception("HdlProgram::setVar - An error occurred when loading data of type \"" + getGLEnumNameSafe(t) + "\" in variable \"" + varName + "\" : " + getGLEnumNameSafe(err) + " - " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException); \
+			GET_LOCATION("setVar") \
+			writeUniform(varName, loc, t, reinterpret_cast<const argT2*>(v)); \
+		} \
+		\
+		void HdlProgram::setVar(const UniformHandle& handle, argT1 v0, argT1 v1, argT1 v2, argT1 v3) \
+		{ \
+			checkHandle(handle); \
+			const argT2 v[4] = {v0, v1, v2, v3}; \
+			writeUniform(handle.name, handle.location, handle.type, v); \
+		} \
+		\
+		void HdlProgram::setVar(const UniformHandle& handle, const argT1* v) \
+		{ \
+			checkHandle(handle); \
+			writeUniform(handle.name, handle.location, handle.type, reinterpret_cast<const argT2*>(v)); \
 		}
 
-	GENsetVarA( int, INT, i)
-	GENsetVarB( int, INT, i)
-	GENsetVarA( unsigned int, UNSIGNED_INT, ui)
-	GENsetVarB( unsigned int, UNSIGNED_INT, ui)
-	GENsetVarA( float, FLOAT, f)
+	GENsetVar( int, GLint)
+	GENsetVar( unsigned int, GLuint)
+	GENsetVar( float, GLfloat)
 
 	#undef GENsetVar
 
-	// Last one, with matrices :
-	void HdlProgram::setVar(const std::string& varName, GLenum t, float* v)
-	{
-		use();
-		GLint loc = glGetUniformLocation(program, varName.c_str());
-
-		if(loc==-1)
-			throw Exception("HdlProgram::setVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
-
-		switch(t)
-		{
-			case GL_FLOAT : 	glUniform1fv(loc, 1, v);			break;
-			case GL_FLOAT_VEC2 : 	glUniform2fv(loc, 1, v);			break;
-			case GL_FLOAT_VEC3 : 	glUniform3fv(loc, 1, v);			break;
-			case GL_FLOAT_VEC4 : 	glUniform4fv(loc, 1, v);			break;
-			case GL_FLOAT_MAT2 :	glUniformMatrix2fv(loc, 1, GL_FALSE, v);	break;
-			case GL_FLOAT_MAT3 :	glUniformMatrix3fv(loc, 1, GL_FALSE, v);	break;
-			case GL_FLOAT_MAT4 :	glUniformMatrix4fv(loc, 1, GL_FALSE, v);	break;
-			default :		throw Exception("HdlProgram::setVar - Unknown variable type or type mismatch for \"" + getGLEnumNameSafe(t) + "\" when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-		}
-
-		const GLenum err = glGetError();
-		if(err!=GL_NO_ERROR)
-			throw Exception("HdlProgram::setVar - An error occurred when loading data of type \"" + getGLEnumNameSafe(t) + "\" in variable \"" + varName + "\" : " + getGLEnumNameSafe(err) + " - " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException);
-	}
-
 	/**
 	\fn void HdlProgram::setVar(const std::string& varName, const HdlDynamicData& data)
 	\brief Change a uniform variable in a shader. Raise an exception if any error occur.
@@ -579,49 +1026,20 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlProgram::setVar(const std::string& varName, const HdlDynamicData& data)
 	{
-		use();
-		GLint loc = glGetUniformLocation(program, varName.c_str());
-
-		if(loc==-1)
-			throw Exception("HdlProgram::setVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
-
-		switch(data.getGLType())
-		{
-			case GL_BYTE :			glUniform1i(loc, data.get(0));								break;
-			case GL_UNSIGNED_BYTE : 	glUniform1ui(loc, data.get(0));								break;
-			case GL_SHORT :			glUniform1i(loc, data.get(0));								break;
-			case GL_UNSIGNED_SHORT :	glUniform1ui(loc, data.get(0));								break;
-			case GL_FLOAT : 		glUniform1fv(loc, 1, reinterpret_cast<const GLfloat*>(data.getPtr()));			break;
-			case GL_FLOAT_VEC2 : 		glUniform2fv(loc, 1, reinterpret_cast<const GLfloat*>(data.getPtr()));			break;
-			case GL_FLOAT_VEC3 : 		glUniform3fv(loc, 1, reinterpret_cast<const GLfloat*>(data.getPtr()));			break;
-			case GL_FLOAT_VEC4 : 		glUniform4fv(loc, 1, reinterpret_cast<const GLfloat*>(data.getPtr()));			break;
-			#ifdef GLIP_USE_GL
-			case GL_DOUBLE :		throw Exception("HdlProgram::setVar - Double type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			case GL_DOUBLE_VEC2 :		throw Exception("HdlProgram::setVar - Double type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			case GL_DOUBLE_VEC3 :		throw Exception("HdlProgram::setVar - Double type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			case GL_DOUBLE_VEC4 :		throw Exception("HdlProgram::setVar - Double type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			#endif
-			case GL_INT :			glUniform1iv(loc, 1, reinterpret_cast<const GLint*>(data.getPtr()));			break;
-			case GL_INT_VEC2 :		glUniform2iv(loc, 1, reinterpret_cast<const GLint*>(data.getPtr()));			break;
-			case GL_INT_VEC3 :		glUniform3iv(loc, 1, reinterpret_cast<const GLint*>(data.getPtr()));			break;
-			case GL_INT_VEC4 :		glUniform4iv(loc, 1, reinterpret_cast<const GLint*>(data.getPtr()));			break;
-			case GL_UNSIGNED_INT :		glUniform1uiv(loc, 1, reinterpret_cast<const GLuint*>(data.getPtr()));			break;
-			case GL_UNSIGNED_INT_VEC2 :	glUniform1uiv(loc, 1, reinterpret_cast<const GLuint*>(data.getPtr()));			break;
-			case GL_UNSIGNED_INT_VEC3 :	glUniform1uiv(loc, 1, reinterpret_cast<const GLuint*>(data.getPtr()));			break;
-			case GL_UNSIGNED_INT_VEC4 :	glUniform1uiv(loc, 1, reinterpret_cast<const GLuint*>(data.getPtr()));			break;
-			case GL_BOOL :			throw Exception("HdlProgram::setVar - Bool type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			case GL_BOOL_VEC2 :		throw Exception("HdlProgram::setVar - Bool type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			case GL_BOOL_VEC3 :		throw Exception("HdlProgram::setVar - Bool type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			case GL_BOOL_VEC4 :		throw Exception("HdlProgram::setVar - Bool type not supported when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-			case GL_FLOAT_MAT2 :		glUniformMatrix2fv(loc, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(data.getPtr()));	break;
-			case GL_FLOAT_MAT3 :		glUniformMatrix3fv(loc, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(data.getPtr()));	break;
-			case GL_FLOAT_MAT4 :		glUniformMatrix4fv(loc, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(data.getPtr()));	break;
-			default :			throw Exception("HdlProgram::setVar - Unknown variable type or type mismatch for \"" + getGLEnumNameSafe(data.getGLType()) + "\" when modifying uniform variable \"" + varName + "\".", __FILE__, __LINE__, Exception::GLException);
-		}
+		GET_LOCATION("setVar")
+		writeUniform(varName, loc, data);
+	}
 
-		const GLenum err = glGetError();
-		if(err!=GL_NO_ERROR)
-			throw Exception("HdlProgram::setVar - An error occurred when loading data of type \"" + getGLEnumNameSafe(data.getGLType()) + "\" in variable \"" + varName + "\" : " + getGLEnumNameSafe(err) + " - " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException);
+	/**
+	\fn void HdlProgram::setVar(const UniformHandle& handle, const HdlDynamicData& data)
+	\brief Change a uniform variable in a shader from its handle. Raise an exception if any error occur. The type of the dynamic object is used (the type of the handle is ignored).
+	\param handle Handle of the variable, see HdlProgram::getUniformHandle.
+	\param data The dynamic object to be used as source.
+	**/
+	void HdlProgram::setVar(const UniformHandle& handle, const HdlDynamicData& data)
+	{
+		checkHandle(handle);
+		writeUniform(handle.name, handle.location, data);
 	}
 
 	/**
@@ -632,11 +1050,7 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlProgram::getVar(const std::string& varName, int* ptr)
 	{
-		use();
-		GLint loc = glGetUniformLocation(program, varName.c_str());
-
-		if(loc==-1)
-			throw Exception("HdlProgram::getVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
+		GET_LOCATION("getVar")
 
 		glGetUniformiv(program, loc, ptr);
 
@@ -653,11 +1067,7 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlProgram::getVar(const std::string& varName, unsigned int* ptr)
 	{
-		use();
-		GLint loc = glGetUniformLocation(program, varName.c_str());
-
-		if(loc==-1)
-			throw Exception("HdlProgram::getVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
+		GET_LOCATION("getVar")
 
 		glGetUniformuiv(program, loc, ptr);
 
@@ -674,10 +1084,7 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlProgram::getVar(const std::string& varName, float* ptr)
 	{
-		GLint loc = glGetUniformLocation(program, varName.c_str());
-
-		if (loc==-1)
-			throw Exception("HdlProgram::getVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
+		GET_LOCATION("getVar")
 
 		glGetUniformfv(program, loc, ptr);
 
@@ -694,10 +1101,7 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlProgram::getVar(const std::string& varName, HdlDynamicData& data)
 	{
-		GLint loc = glGetUniformLocation(program, varName.c_str());
-
-		if(loc==-1)
-			throw Exception("HdlProgram::getVar - Wrong location, does this var exist : \"" + varName + "\"? Is it used in the program? (May be the GLCompiler swapped it because it is unused).", __FILE__, __LINE__, Exception::GLException);
+		GET_LOCATION("getVar")
 
 		switch(data.getGLType())
 		{
@@ -746,11 +1150,74 @@ using namespace Glip::CoreGL;
 	**/
 	bool HdlProgram::isUniformVariableValid(const std::string& varName)
 	{
-		if(program==0)
-			return false;
-		else
-			return glGetUniformLocation(program, varName.c_str()) != -1;
-	}	
+		return getUniformLocation(varName) != -1;
+	}
+
+	#undef GET_LOCATION
+
+	/**
+	\fn    void HdlProgram::saveUniforms(std::vector<HdlDynamicData*>& state)
+	\brief Save the values of the uniform variables listed by HdlProgram::getUniformsNames (except the double precision types, which are left to NULL). The objects are allocated if needed and must be deleted by the user.
+	\param state The state, one element per variable.
+	**/
+	void HdlProgram::saveUniforms(std::vector<HdlDynamicData*>& state)
+	{
+		if(state.size()!=activeUniforms.size())
+		{
+			for(std::vector<HdlDynamicData*>::iterator it=state.begin(); it!=state.end(); it++)
+				delete *it;
+			state.assign(activeUniforms.size(), reinterpret_cast<HdlDynamicData*>(NULL));
+		}
+
+		for(unsigned int k=0; k<activeUniforms.size(); k++)
+		{
+			if(state[k]==NULL)
+			{
+				GLenum type = activeTypes[k];
+
+				// Booleans are read and written as integers :
+				switch(type)
+				{
+					case GL_BOOL :		type = GL_INT;		break;
+					case GL_BOOL_VEC2 :	type = GL_INT_VEC2;	break;
+					case GL_BOOL_VEC3 :	type = GL_INT_VEC3;	break;
+					case GL_BOOL_VEC4 :	type = GL_INT_VEC4;	break;
+					#ifdef GLIP_USE_GL
+					case GL_DOUBLE :
+					case GL_DOUBLE_VEC2 :
+					case GL_DOUBLE_VEC3 :
+					case GL_DOUBLE_VEC4 :	type = GL_NONE;		break;
+					#endif
+					default :
+						break;
+				}
+
+				if(type==GL_NONE || getUniformLocation(activeUniforms[k])==-1)
+					continue;
+
+				state[k] = HdlDynamicData::build(type);
+			}
+
+			getVar(activeUniforms[k], *state[k]);
+		}
+	}
+
+	/**
+	\fn    void HdlProgram::restoreUniforms(const std::vector<HdlDynamicData*>& state)
+	\brief Restore the values of the uniform variables saved with HdlProgram::saveUniforms.
+	\param state The state, one element per variable (the NULL elements are skipped).
+	**/
+	void HdlProgram::restoreUniforms(const std::vector<HdlDynamicData*>& state)
+	{
+		if(state.size()!=activeUniforms.size())
+			throw Exception("HdlProgram::restoreUniforms - The state does not match the uniform variables of the program.", __FILE__, __LINE__, Exception::GLException);
+
+		for(unsigned int k=0; k<activeUniforms.size(); k++)
+		{
+			if(state[k]!=NULL)
+				setVar(activeUniforms[k], *state[k]);
+		}
+	}
 
 // Static tools :
 	/**
@@ -781,6 +1248,486 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlProgram::stopProgram(void)
 	{
-		glUseProgram(0);
+		GLStateCache::useProgram(0);
+	}
+
+	/**
+	\fn    bool HdlProgram::isDirectUniformAccessAvailable(void)
+	\brief Test if the uniform variables can be written without binding the program (glProgramUniform*, OpenGL 4.1 or ARB_separate_shader_objects).
+	\return True if the direct access is available.
+	**/
+	bool HdlProgram::isDirectUniformAccessAvailable(void)
+	{
+		#ifdef GLIP_USE_GL
+			return GLEW_VERSION_4_1 || GLEW_ARB_separate_shader_objects;
+		#else
+			return false;
+		#endif
+	}
+
+// HdlProgramRegistry :
+	bool						HdlProgramRegistry::enabled	= false;
+	std::map<std::string, HdlProgram*>		HdlProgramRegistry::programs;
+	std::map<const HdlProgram*, HdlProgramRegistry::Entry>	HdlProgramRegistry::entries;
+	int						HdlProgramRegistry::numReused	= 0;
+
+	/**
+	\fn HdlProgramRegistry::Entry& HdlProgramRegistry::getEntry(const HdlProgram* program, const std::string& functionName)
+	\brief Get the entry of a registered program. Raise an exception if the program is not registered.
+	\param program The program.
+	\param functionName Name of the calling function (for error reporting).
+	\return The entry.
+	**/
+	HdlProgramRegistry::Entry& HdlProgramRegistry::getEntry(const HdlProgram* program, const std::string& functionName)
+	{
+		std::map<const HdlProgram*, Entry>::iterator it = entries.find(program);
+
+		if(it==entries.end())
+			throw Exception("HdlProgramRegistry::" + functionName + " - The program is not registered.", __FILE__, __LINE__, Exception::GLException);
+
+		return it->second;
+	}
+
+	/**
+	\fn void HdlProgramRegistry::setEnabled(bool _enabled)
+	\brief Enable or disable the sharing of the programs for the next filters.
+	\param _enabled True to enable the sharing.
+	**/
+	void HdlProgramRegistry::setEnabled(bool _enabled)
+	{
+		enabled = _enabled;
+	}
+
+	/**
+	\fn bool HdlProgramRegistry::isEnabled(void)
+	\brief Test if the sharing of the programs is enabled.
+	\return True if the sharing is enabled.
+	**/
+	bool HdlProgramRegistry::isEnabled(void)
+	{
+		return enabled;
+	}
+
+	/**
+	\fn HdlProgram* HdlProgramRegistry::acquire(const std::string& key)
+	\brief Get a registered program and add one user to it.
+	\param key The key of the program (the content of its sources).
+	\return A pointer to the program or NULL if no program was registered with this key. It must be returned with HdlProgramRegistry::release.
+	**/
+	HdlProgram* HdlProgramRegistry::acquire(const std::string& key)
+	{
+		std::map<std::string, HdlProgram*>::iterator it = programs.find(key);
+
+		if(it==programs.end())
+			return NULL;
+		else
+		{
+			entries[it->second].numUsers++;
+			numReused++;
+			return it->second;
+		}
+	}
+
+	/**
+	\fn void HdlProgramRegistry::add(const std::string& key, HdlProgram* program, const std::vector<HdlShader*>& shaders, const void* owner)
+	\brief Register a linked program. The registry takes the ownership of the program and of its shaders, the default values of the uniform variables are saved at this point.
+	\param key The key of the program (the content of its sources).
+	\param program The program.
+	\param shaders The shaders attached to the program.
+	\param owner The first user of the program.
+	**/
+	void HdlProgramRegistry::add(const std::string& key, HdlProgram* program, const std::vector<HdlShader*>& shaders, const void* owner)
+	{
+		if(program==NULL)
+			throw Exception("HdlProgramRegistry::add - The program is NULL.", __FILE__, __LINE__, Exception::GLException);
+		else if(programs.find(key)!=programs.end())
+			throw Exception("HdlProgramRegistry::add - A program is already registered with the same key.", __FILE__, __LINE__, Exception::GLException);
+		else if(entries.find(program)!=entries.end())
+			throw Exception("HdlProgramRegistry::add - The program is already registered.", __FILE__, __LINE__, Exception::GLException);
+
+		Entry& entry	= entries[program];
+		entry.key	= key;
+		entry.shaders	= shaders;
+		entry.numUsers	= 1;
+		entry.owner	= owner;
+		program->saveUniforms(entry.defaultState);
+
+		programs[key]	= program;
+	}
+
+	/**
+	\fn void HdlProgramRegistry::release(const HdlProgram* program, const void* user)
+	\brief Remove one user of the program. The program and its shaders are deleted when the last user is removed.
+	\param program The program.
+	\param user The user leaving (if it owns the program, the program is left without owner).
+	**/
+	void HdlProgramRegistry::release(const HdlProgram* program, const void* user)
+	{
+		Entry& entry = getEntry(program, "release");
+
+		entry.numUsers--;
+		if(entry.owner==user)
+			entry.owner = NULL;
+
+		if(entry.numUsers<=0)
+		{
+			for(std::vector<HdlDynamicData*>::iterator it=entry.defaultState.begin(); it!=entry.defaultState.end(); it++)
+				delete *it;
+
+			programs.erase(entry.key);
+			delete program;
+
+			for(std::vector<HdlShader*>::iterator it=entry.shaders.begin(); it!=entry.shaders.end(); it++)
+				delete *it;
+
+			entries.erase(program);
+		}
+	}
+
+	/**
+	\fn bool HdlProgramRegistry::isRegistered(const HdlProgram* program)
+	\brief Test if a program is managed by the registry.
+	\param program The program.
+	\return True if the program is registered.
+	**/
+	bool HdlProgramRegistry::isRegistered(const HdlProgram* program)
+	{
+		return entries.find(program)!=entries.end();
+	}
+
+	/**
+	\fn int HdlProgramRegistry::getNumUsers(const HdlProgram* program)
+	\brief Get the number of users of a program.
+	\param program The program.
+	\return The number of users, or 0 if the program is not registered.
+	**/
+	int HdlProgramRegistry::getNumUsers(const HdlProgram* program)
+	{
+		std::map<const HdlProgram*, Entry>::const_iterator it = entries.find(program);
+
+		if(it==entries.end())
+			return 0;
+		else
+			return it->second.numUsers;
+	}
+
+	/**
+	\fn const void* HdlProgramRegistry::getOwner(const HdlProgram* program)
+	\brief Get the user whose uniform variables are currently loaded in the program.
+	\param program The program.
+	\return The owner (NULL if the owner was released).
+	**/
+	const void* HdlProgramRegistry::getOwner(const HdlProgram* program)
+	{
+		return getEntry(program, "getOwner").owner;
+	}
+
+	/**
+	\fn void HdlProgramRegistry::setOwner(const HdlProgram* program, const void* owner)
+	\brief Set the user whose uniform variables are currently loaded in the program.
+	\param program The program.
+	\param owner The new owner.
+	**/
+	void HdlProgramRegistry::setOwner(const HdlProgram* program, const void* owner)
+	{
+		getEntry(program, "setOwner").owner = owner;
+	}
+
+	/**
+	\fn const std::vector<HdlDynamicData*>& HdlProgramRegistry::getDefaultState(const HdlProgram* program)
+	\brief Get the values of the uniform variables of the program after its link (the state a new user should start from).
+	\param program The program.
+	\return The default state (see HdlProgram::saveUniforms).
+	**/
+	const std::vector<HdlDynamicData*>& HdlProgramRegistry::getDefaultState(const HdlProgram* program)
+	{
+		return getEntry(program, "getDefaultState").defaultState;
+	}
+
+	/**
+	\fn int HdlProgramRegistry::getNumPrograms(void)
+	\brief Get the number of programs currently registered.
+	\return The number of programs.
+	**/
+	int HdlProgramRegistry::getNumPrograms(void)
+	{
+		return entries.size();
+	}
+
+	/**
+	\fn int HdlProgramRegistry::getNumReused(void)
+	\brief Get the number of times a registered program was given to a new user instead of being built.
+	\return The number of reuses.
+	**/
+	int HdlProgramRegistry::getNumReused(void)
+	{
+		return numReused;
+	}
+
+// HdlProgramCache :
+	std::string	HdlProgramCache::directory;
+	int		HdlProgramCache::numHits	= 0;
+	int		HdlProgramCache::numMisses	= 0;
+	int		HdlProgramCache::numRejected	= 0;
+	int		HdlProgramCache::numStored	= 0;
+
+	static const char	programCacheMagic[]	= "GLIPPRGM";
+	static const unsigned int	programCacheVersion	= 1;
+
+	/**
+	\fn std::string HdlProgramCache::getFullKey(const std::string& key)
+	\brief Complete a key with the description of the current context.
+	\param key The key given by the client (the sources of the shaders).
+	\return The complete key.
+	**/
+	std::string HdlProgramCache::getFullKey(const std::string& key)
+	{
+		return HandleOpenGL::getVendorName() + "\n" + HandleOpenGL::getRendererName() + "\n" + HandleOpenGL::getVersion() + "\n" + HandleOpenGL::getGLSLVersion() + "\n" + key;
+	}
+
+	/**
+	\fn std::string HdlProgramCache::getFilename(const std::string& fullKey)
+	\brief Get the name of the file containing the binary for the given key (FNV-1a and DJB2 hashes of the key).
+	\param fullKey The complete key.
+	\return The filename.
+	**/
+	std::string HdlProgramCache::getFilename(const std::string& fullKey)
+	{
+		unsigned int 	h1 = 2166136261U,
+				h2 = 5381U;
+
+		for(std::string::const_iterator it=fullKey.begin(); it!=fullKey.end(); it++)
+		{
+			const unsigned int c = static_cast<unsigned char>(*it);
+			h1 = (h1 ^ c) * 16777619U;
+			h2 = (h2 * 33U) ^ c;
+		}
+
+		std::ostringstream str;
+		str << directory << "/" << std::hex << std::setfill('0') << std::setw(8) << (h1 & 0xFFFFFFFFU) << std::setw(8) << (h2 & 0xFFFFFFFFU) << ".glipbin";
+		return str.str();
+	}
+
+	/**
+	\fn void HdlProgramCache::enable(const std::string& _directory)
+	\brief Enable the cache.
+	\param _directory The directory in which the binaries are stored (it must exist).
+	**/
+	void HdlProgramCache::enable(const std::string& _directory)
+	{
+		if(_directory.empty())
+			throw Exception("HdlProgramCache::enable - The directory cannot be empty.", __FILE__, __LINE__, Exception::GLException);
+
+		directory = _directory;
+	}
+
+	/**
+	\fn void HdlProgramCache::disable(void)
+	\brief Disable the cache (the files are not removed).
+	**/
+	void HdlProgramCache::disable(void)
+	{
+		directory.clear();
+	}
+
+	/**
+	\fn bool HdlProgramCache::isEnabled(void)
+	\brief Test if the cache is enabled.
+	\return True if the cache is enabled.
+	**/
+	bool HdlProgramCache::isEnabled(void)
+	{
+		return !directory.empty();
+	}
+
+	/**
+	\fn const std::string& HdlProgramCache::getDirectory(void)
+	\brief Get the directory of the cache.
+	\return The directory or an empty string if the cache is disabled.
+	**/
+	const std::string& HdlProgramCache::getDirectory(void)
+	{
+		return directory;
+	}
+
+	/**
+	\fn bool HdlProgramCache::isSupported(void)
+	\brief Test if the programs binaries are supported by the driver (OpenGL 4.1 or ARB_get_program_binary, with at least one binary format).
+	\return True if the binaries are supported.
+	**/
+	bool HdlProgramCache::isSupported(void)
+	{
+		#ifdef GLIP_USE_GL
+			if(!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary)
+				return false;
+
+			GLint numFormats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+			return numFormats>0;
+		#else
+			return false;
+		#endif
+	}
+
+	/**
+	\fn bool HdlProgramCache::load(const std::string& key, HdlProgram& program)
+	\brief Load a program from the cache.
+	\param key The key of the program (the sources of the shaders, the context description is added automatically).
+	\param program The program to be loaded (no shaders should be attached yet).
+	\return True if the program was found and accepted by the driver, false otherwise (the program must then be compiled and linked).
+	**/
+	bool HdlProgramCache::load(const std::string& key, HdlProgram& program)
+	{
+		if(!isEnabled() || !isSupported())
+			return false;
+
+		const std::string fullKey = getFullKey(key);
+		std::ifstream file(getFilename(fullKey).c_str(), std::ios::in | std::ios::binary);
+
+		char magic[sizeof(programCacheMagic)-1];
+		unsigned int	version = 0,
+				keyLength = 0,
+				format = 0,
+				binaryLength = 0;
+		std::string fileKey;
+		std::vector<char> binary;
+
+		if(file.is_open())
+		{
+			file.read(magic, sizeof(magic));
+			file.read(reinterpret_cast<char*>(&version), sizeof(version));
+			file.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength));
+
+			if(file.good() && std::equal(magic, magic+sizeof(magic), programCacheMagic) && version==programCacheVersion && keyLength==fullKey.size())
+			{
+				fileKey.assign(keyLength, 0);
+				file.read(&fileKey[0], keyLength);
+				file.read(reinterpret_cast<char*>(&format), sizeof(format));
+				file.read(reinterpret_cast<char*>(&binaryLength), sizeof(binaryLength));
+
+				if(file.good() && fileKey==fullKey && binaryLength>0)
+				{
+					binary.assign(binaryLength, 0);
+					file.read(&binary[0], binaryLength);
+					if(!file.good())
+						binary.clear();
+				}
+			}
+		}
+
+		if(binary.empty())
+		{
+			numMisses++;
+			return false;
+		}
+		else if(!program.loadBinary(static_cast<GLenum>(format), binary))
+		{
+			#ifdef __GLIPLIB_VERBOSE__
+				std::cout << "HdlProgramCache::load - The binary was rejected by the driver, the program will be compiled." << std::endl;
+			#endif
+			numRejected++;
+			numMisses++;
+			return false;
+		}
+		else
+		{
+			numHits++;
+			return true;
+		}
+	}
+
+	/**
+	\fn bool HdlProgramCache::store(const std::string& key, const HdlProgram& program)
+	\brief Save the binary of a program in the cache.
+	\param key The key of the program (the sources of the shaders, the context description is added automatically).
+	\param program The linked program.
+	\return True if the binary was saved, false otherwise (the cache is disabled, the binary is not available or the file cannot be written).
+	**/
+	bool HdlProgramCache::store(const std::string& key, const HdlProgram& program)
+	{
+		if(!isEnabled())
+			return false;
+
+		GLenum format = GL_NONE;
+		std::vector<char> binary;
+
+		if(!program.getBinary(format, binary))
+			return false;
+
+		const std::string fullKey = getFullKey(key);
+		std::ofstream file(getFilename(fullKey).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if(!file.is_open())
+			return false;
+
+		const unsigned int	keyLength = fullKey.size(),
+					binaryFormat = format,
+					binaryLength = binary.size();
+
+		file.write(programCacheMagic, sizeof(programCacheMagic)-1);
+		file.write(reinterpret_cast<const char*>(&programCacheVersion), sizeof(programCacheVersion));
+		file.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+		file.write(fullKey.c_str(), keyLength);
+		file.write(reinterpret_cast<const char*>(&binaryFormat), sizeof(binaryFormat));
+		file.write(reinterpret_cast<const char*>(&binaryLength), sizeof(binaryLength));
+		file.write(&binary[0], binaryLength);
+
+		if(!file.good())
+			return false;
+
+		numStored++;
+		return true;
+	}
+
+	/**
+	\fn int HdlProgramCache::getNumHits(void)
+	\brief Get the number of programs loaded from the cache.
+	\return The number of hits since the last reset.
+	**/
+	int HdlProgramCache::getNumHits(void)
+	{
+		return numHits;
+	}
+
+	/**
+	\fn int HdlProgramCache::getNumMisses(void)
+	\brief Get the number of programs which had to be compiled while the cache was enabled (including the rejected binaries).
+	\return The number of misses since the last reset.
+	**/
+	int HdlProgramCache::getNumMisses(void)
+	{
+		return numMisses;
+	}
+
+	/**
+	\fn int HdlProgramCache::getNumRejected(void)
+	\brief Get the number of binaries found in the cache but rejected by the driver.
+	\return The number of rejected binaries since the last reset.
+	**/
+	int HdlProgramCache::getNumRejected(void)
+	{
+		return numRejected;
+	}
+
+	/**
+	\fn int HdlProgramCache::getNumStored(void)
+	\brief Get the number of binaries written to the cache.
+	\return The number of binaries written since the last reset.
+	**/
+	int HdlProgramCache::getNumStored(void)
+	{
+		return numStored;
+	}
+
+	/**
+	\fn void HdlProgramCache::resetStatistics(void)
+	\brief Reset the hits, misses, rejected and stored counters.
+	**/
+	void HdlProgramCache::resetStatistics(void)
+	{
+		numHits		= 0;
+		numMisses	= 0;
+		numRejected	= 0;
+		numStored	= 0;
 	}
 
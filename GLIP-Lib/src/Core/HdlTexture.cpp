@@ -22,8 +22,12 @@
 **/
 
 #include <cstring>
+#include <algorithm>
+#include <vector>
 #include "Core/HdlTexture.hpp"
 #include "Core/Exception.hpp"
+#include "Core/GLStateCache.hpp"
+#include "Core/HdlGeBO.hpp"
 
 using namespace Glip::CoreGL;
 
@@ -550,7 +554,7 @@ using namespace Glip::CoreGL;
 				vSWrap		= GL_NONE, 
 				vTWrap		= GL_NONE;
 				 
-			glBindTexture(GL_TEXTURE_2D, texID);
+			GLStateCache::bindTexture(texID);
 			
 			// Test :
 			const GLenum err = glGetError();
@@ -592,7 +596,10 @@ using namespace Glip::CoreGL;
 	HdlTexture::HdlTexture(const HdlAbstractTextureFormat& fmt)
 	 : 	HdlAbstractTextureFormat(fmt), 
 		texID(0), 
-		proxy(false)
+		proxy(false),
+		immutable(false),
+		allocated(false),
+		generation(0)
 	{
 		if(!fmt.getFormatDescriptor().isSupported)
 			throw Exception("HdlTexture::HdlTexture - Format " + getGLEnumNameSafe(fmt.getGLMode()) + " is not supported.", __FILE__, __LINE__);
@@ -634,7 +641,7 @@ using namespace Glip::CoreGL;
 		}
 
 		// Set it up :
-		glBindTexture(GL_TEXTURE_2D,texID);
+		GLStateCache::bindTexture(texID);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, getMinFilter() );
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, getMagFilter() );
@@ -656,6 +663,27 @@ using namespace Glip::CoreGL;
 		if(err!=GL_NO_ERROR)
 			throw Exception("HdlTexture::HdlTexture - One or more texture parameter cannot be set among : MinFilter = " + getGLEnumNameSafe(getMinFilter()) + ", MagFilter = " + getGLEnumNameSafe(getMagFilter()) + ", SWrapping = " + getGLEnumNameSafe(getSWrapping()) + ", TWrapping = " + getGLEnumNameSafe(getTWrapping()) + ", BaseLevel = " + toString(getBaseLevel()) + ", MaxLevel = " + toString(getMaxLevel()) + ". Last OpenGL error : " + getGLEnumNameSafe(err) + " : " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException);
 
+		// Define the storage once, if possible :
+		#ifdef GLIP_USE_GL
+		const GLenum sizedMode = getSizedMode(getGLMode());
+		if((GLEW_VERSION_4_2 || GLEW_ARB_texture_storage) && sizedMode!=GL_NONE)
+		{
+			// The mipmaps chain stops at 1x1 :
+			int levels = 1;
+			while(levels<=getMaxLevel() && std::max(getWidth(), getHeight())>>levels>0)
+				levels++;
+
+			glTexStorage2D(GL_TEXTURE_2D, levels, sizedMode, getWidth(), getHeight());
+
+			err = glGetError();
+			if(err!=GL_NO_ERROR)
+				throw Exception("HdlTexture::HdlTexture - Unable to allocate the storage of the texture (glTexStorage2D, " + getGLEnumNameSafe(sizedMode) + ", " + toString(levels) + " level(s)). Last OpenGL error : " + getGLEnumNameSafe(err) + " : " + getGLErrorDescription(err), __FILE__, __LINE__, Exception::GLException);
+
+			immutable = true;
+			allocated = true;
+		}
+		#endif
+
 		HdlTexture::unbind();
 	}
 
@@ -670,7 +698,10 @@ using namespace Glip::CoreGL;
 	HdlTexture::HdlTexture(GLuint proxyTexID)
 	 :	HdlAbstractTextureFormat(HdlTextureFormat::getTextureFormat(proxyTexID)),
 		texID(proxyTexID), 
-		proxy(true)
+		proxy(true),
+		immutable(false),
+		allocated(true),
+		generation(0)
 	{
 		if(!getFormatDescriptor().isSupported)
 			throw Exception("HdlTexture::HdlTexture - Format " + getGLEnumNameSafe(getGLMode()) + " is not supported.", __FILE__, __LINE__);
@@ -717,6 +748,7 @@ using namespace Glip::CoreGL;
 		{
 			// delete the texture :
 			glDeleteTextures( 1, &texID);
+			GLStateCache::forgetTexture(texID);
 
 			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
 				OPENGL_ERROR_TRACKER("HdlTexture::~HdlTexture", "glDeleteTextures()")
@@ -745,6 +777,68 @@ using namespace Glip::CoreGL;
 		return proxy;
 	}
 
+	/**
+	\fn bool HdlTexture::isImmutable(void) const
+	\brief Test if the storage of the texture was allocated with glTexStorage2D (see HdlTexture::getSizedMode).
+	\return True if the storage of the texture is immutable.
+	**/
+	bool HdlTexture::isImmutable(void) const
+	{
+		return immutable;
+	}
+
+	/**
+	\fn bool HdlTexture::isAllocated(void) const
+	\brief Test if the storage of the texture is defined (immutable storage, first call to HdlTexture::write or HdlTexture::allocate, or proxy texture).
+	\return True if the storage of the texture is defined.
+	**/
+	bool HdlTexture::isAllocated(void) const
+	{
+		return allocated;
+	}
+
+	/**
+	\fn void HdlTexture::allocate(void)
+	\brief Define the storage of the texture, without content, if it is not yet defined. No pixel unpack buffer must be bound.
+	**/
+	void HdlTexture::allocate(void)
+	{
+		if(allocated)
+			return ;
+
+		GLStateCache::bindTexture(texID);
+
+		if(isCompressed())
+			glTexImage2D(GL_TEXTURE_2D, 0, mode, width, height, 0, getFormatDescriptor().uncompressedMode, depth, NULL);
+		else
+			glTexImage2D(GL_TEXTURE_2D, 0, mode, width, height, 0, getFormatDescriptor().aliasMode, depth, NULL);
+
+		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+			OPENGL_ERROR_TRACKER("HdlTexture::allocate", "glTexImage2D()")
+		#endif
+
+		allocated = true;
+	}
+
+	/**
+	\fn unsigned int HdlTexture::getGeneration(void) const
+	\brief Get the generation of the content of the texture. It is incremented each time the texture is written (HdlTexture::write, HdlTexture::fill, rendering through HdlFBO, ...) or its sampling parameters are changed, and can be used to detect modifications.
+	\return The generation counter.
+	**/
+	unsigned int HdlTexture::getGeneration(void) const
+	{
+		return generation;
+	}
+
+	/**
+	\fn void HdlTexture::touch(void)
+	\brief Declare that the content of the texture was modified outside of this object (direct OpenGL calls, proxy textures, ...). Increments the generation counter (see HdlTexture::getGeneration).
+	**/
+	void HdlTexture::touch(void)
+	{
+		generation++;
+	}
+
 	/**
 	\fn void HdlTexture::getSizeOnGPU(int m)
 	\brief Returns the size of the texture in bytes for mipmap m.
@@ -795,17 +889,14 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlTexture::bind(GLenum unit)
 	{
-		#ifdef GLIP_USE_GL
-		glActiveTextureARB(unit);
-		#else
-		UNUSED_PARAMETER(unit)
-		#endif
-		glBindTexture(GL_TEXTURE_2D, texID);
-
-		#ifdef GLIP_USE_GL
-		glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE_EXT);
-		glTexEnvf(GL_TEXTURE_ENV, GL_COMBINE_RGB_EXT,  GL_REPLACE);
-		#endif
+		// The texture environment is kept while the binding is unchanged :
+		if(GLStateCache::bindTexture(unit, texID))
+		{
+			#ifdef GLIP_USE_GL
+			glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE_EXT);
+			glTexEnvf(GL_TEXTURE_ENV, GL_COMBINE_RGB_EXT,  GL_REPLACE);
+			#endif
+		}
 	}
 
 	/**
@@ -832,10 +923,10 @@ using namespace Glip::CoreGL;
 	\brief Sets the texture's T wrapping parameter. WARNING : no error checking is performed within this function.
 	\param m The new T wrapping parameter (e.g. GL_CLAMP, GL_CLAMP_TO_BORDER, GL_CLAMP_TO_EDGE, GL_REPEAT, GL_MIRRORED_REPEAT)
 	**/
-	void HdlTexture::setMinFilter(GLenum mf)	{ minFilter = mf; bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, getMinFilter() );}
-	void HdlTexture::setMagFilter(GLenum mf)	{ magFilter = mf; bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, getMagFilter() );}
-	void HdlTexture::setSWrapping(GLenum m)		{ wraps     = m;  bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     getSWrapping() );}
-	void HdlTexture::setTWrapping(GLenum m)		{ wrapt     = m;  bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     getTWrapping() );}
+	void HdlTexture::setMinFilter(GLenum mf)	{ minFilter = mf; bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, getMinFilter() ); generation++;}
+	void HdlTexture::setMagFilter(GLenum mf)	{ magFilter = mf; bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, getMagFilter() ); generation++;}
+	void HdlTexture::setSWrapping(GLenum m)		{ wraps     = m;  bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     getSWrapping() ); generation++;}
+	void HdlTexture::setTWrapping(GLenum m)		{ wrapt     = m;  bind(); glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     getTWrapping() ); generation++;}
 
 	/**
 	\fn void HdlTexture::setSetting(GLenum param, unsigned int value)
@@ -907,20 +998,28 @@ using namespace Glip::CoreGL;
 		pixelFormat = HdlTextureFormatDescriptorsList::get(pixelFormat).aliasMode;
 
 		// Bind it :
-		glBindTexture(GL_TEXTURE_2D, texID);
+		GLStateCache::bindTexture(texID);
 
 		// Save the current packing alignment, and replace it with the desired value :
 		GLint originalAlignment = 0;
 		glGetIntegerv(GL_UNPACK_ALIGNMENT, &originalAlignment);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, _alignment);
 
-		// Write :
-		glTexImage2D(GL_TEXTURE_2D, 0, mode, width, height, 0, pixelFormat, pixelDepth, texData);
+		// Write, in the existing storage if it is immutable :
+		if(immutable)
+		{
+			if(texData!=NULL || HdlGeBO::isBound(GL_PIXEL_UNPACK_BUFFER))
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, pixelFormat, pixelDepth, texData);
+		}
+		else
+			glTexImage2D(GL_TEXTURE_2D, 0, mode, width, height, 0, pixelFormat, pixelDepth, texData);
 
 		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
 			OPENGL_ERROR_TRACKER("HdlTexture::write", "glTexImage2D()")
 		#endif
 
+		allocated = true;
+
 		if( getMaxLevel()>0 )
 		{
 			glGenerateMipmap(GL_TEXTURE_2D);
@@ -932,6 +1031,8 @@ using namespace Glip::CoreGL;
 
 		// Restore :
 		glPixelStorei(GL_UNPACK_ALIGNMENT, originalAlignment);
+
+		generation++;
 	}
 
 	/**
@@ -955,7 +1056,7 @@ using namespace Glip::CoreGL;
 			_alignment = getAlignment();
 
 		// Bind it
-		glBindTexture(GL_TEXTURE_2D, texID);
+		GLStateCache::bindTexture(texID);
 
 		glPixelStorei(GL_UNPACK_ALIGNMENT, _alignment);
 
@@ -966,6 +1067,8 @@ using namespace Glip::CoreGL;
 			OPENGL_ERROR_TRACKER("HdlTexture::writeCompressed", "glCompressedTexImage2D()")
 		#endif
 
+		allocated = true;
+
 		if( getMaxLevel()>0 )
 		{
 			glGenerateMipmap(GL_TEXTURE_2D);
@@ -974,18 +1077,137 @@ using namespace Glip::CoreGL;
 				OPENGL_ERROR_TRACKER("HdlTexture::writeCompressed", "glGenerateMipmap()")
 			#endif
 		}
+
+		generation++;
+	}
+
+	/**
+	\fn void HdlTexture::checkRegion(const std::string& caller, int x, int y, int w, int h, int level) const
+	\brief Raise an exception if the region is not inside the mipmap level.
+	**/
+	void HdlTexture::checkRegion(const std::string& caller, int x, int y, int w, int h, int level) const
+	{
+		if(level<0 || level>getMaxLevel())
+			throw Exception("HdlTexture::" + caller + " - Invalid mipmap level " + toString(level) + " (maximum level : " + toString(getMaxLevel()) + ").", __FILE__, __LINE__, Exception::GLException);
+
+		const int	levelWidth	= std::max(width >> level, 1),
+				levelHeight	= std::max(height >> level, 1);
+
+		if(x<0 || y<0 || w<=0 || h<=0 || x+w>levelWidth || y+h>levelHeight)
+			throw Exception("HdlTexture::" + caller + " - The region (" + toString(x) + ", " + toString(y) + ", " + toString(w) + ", " + toString(h) + ") is not inside the level " + toString(level) + " of the texture (" + toString(levelWidth) + "x" + toString(levelHeight) + ").", __FILE__, __LINE__, Exception::GLException);
+	}
+
+	/**
+	\fn void HdlTexture::writeRegion(const GLvoid *texData, int x, int y, int w, int h, int level, GLenum pixelFormat, GLenum pixelDepth, int _alignment)
+	\brief Write data to a rectangle of a mipmap level of the texture, in its existing storage (glTexSubImage2D). The storage is allocated first if needed (see HdlTexture::allocate).
+	\param texData The pointer to the data (or the offset in the pixel unpack buffer currently bound).
+	\param x Left edge of the rectangle, in pixels of the level.
+	\param y Bottom edge of the rectangle, in pixels of the level.
+	\param w Width of the rectangle.
+	\param h Height of the rectangle.
+	\param level The mipmap level (default is 0, the original image). The mipmaps are regenerated after an update of the level 0.
+	\param pixelFormat The pixel format of the input data (considered the same as the texture layout if not provided).
+	\param pixelDepth The depth of the input data (considered the same as the texture layout if not provided).
+	\param _alignment Byte alignment of the input data.
+	**/
+	void HdlTexture::writeRegion(const GLvoid *texData, int x, int y, int w, int h, int level, GLenum pixelFormat, GLenum pixelDepth, int _alignment)
+	{
+		checkRegion("writeRegion", x, y, w, h, level);
+
+		if(isCompressed())
+			throw Exception("HdlTexture::writeRegion - Cannot be called on a compressed texture.", __FILE__, __LINE__, Exception::GLException);
+
+		if(pixelFormat==GL_ZERO)
+			pixelFormat = mode;
+
+		if(pixelDepth==GL_ZERO)
+			pixelDepth = depth;
+
+		if(_alignment<0)
+			_alignment = getAlignment();
+
+		pixelFormat = HdlTextureFormatDescriptorsList::get(pixelFormat).aliasMode;
+
+		if(!allocated)
+		{
+			if(HdlGeBO::isBound(GL_PIXEL_UNPACK_BUFFER))
+				throw Exception("HdlTexture::writeRegion - The storage of the texture must be allocated before binding a pixel unpack buffer (see HdlTexture::allocate).", __FILE__, __LINE__, Exception::GLException);
+			allocate();
+		}
+
+		GLStateCache::bindTexture(texID);
+
+		// Save the current packing alignment, and replace it with the desired value :
+		GLint originalAlignment = 0;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &originalAlignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, _alignment);
+
+		glTexSubImage2D(GL_TEXTURE_2D, level, x, y, w, h, pixelFormat, pixelDepth, texData);
+
+		#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+			OPENGL_ERROR_TRACKER("HdlTexture::writeRegion", "glTexSubImage2D()")
+		#endif
+
+		if(level==0 && getMaxLevel()>0)
+		{
+			glGenerateMipmap(GL_TEXTURE_2D);
+
+			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+				OPENGL_ERROR_TRACKER("HdlTexture::writeRegion", "glGenerateMipmap()")
+			#endif
+		}
+
+		// Restore :
+		glPixelStorei(GL_UNPACK_ALIGNMENT, originalAlignment);
+
+		generation++;
 	}
 
 	/**
 	\fn void HdlTexture::fill(char dataByte)
 	\brief Fill a texture will a gray level.
-	\param dataByte The gray level to apply.
+	\param dataByte The gray level to apply (each byte of the texture is set to this value).
+
+	The texture is cleared on the GPU (glClearTexImage) when OpenGL 4.4 or GL_ARB_clear_texture are available, and from a host buffer of the size of the texture otherwise.
 	**/
 	void HdlTexture::fill(char dataByte)
 	{
 		/*if(isCompressed())
 			throw Exception("HdlTexture::fill - Cannot be called on a compressed texture.", __FILE__, __LINE__);*/
 
+		#ifdef GLIP_USE_GL
+		if((GLEW_VERSION_4_4 || GLEW_ARB_clear_texture) && !isCompressed() && !HdlGeBO::isBound(GL_PIXEL_UNPACK_BUFFER))
+		{
+			allocate();
+
+			// One pixel of the pattern, all the levels are filled as mipmaps of a uniform image would be. Only the levels of the immutable storage exist (the chain stops at 1x1), a mutable storage only defines the level 0 and its mipmaps are generated :
+			const std::vector<char> pixel(getPixelSize(), dataByte);
+			int levels = 1;
+			while(immutable && levels<=getMaxLevel() && std::max(getWidth(), getHeight())>>levels>0)
+				levels++;
+
+			for(int l=0; l<levels; l++)
+				glClearTexImage(texID, l, getFormatDescriptor().aliasMode, depth, &pixel[0]);
+
+			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+				OPENGL_ERROR_TRACKER("HdlTexture::fill", "glClearTexImage()")
+			#endif
+
+			if(!immutable && getMaxLevel()>0)
+			{
+				bind();
+				glGenerateMipmap(GL_TEXTURE_2D);
+
+				#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+					OPENGL_ERROR_TRACKER("HdlTexture::fill", "glGenerateMipmap()")
+				#endif
+			}
+
+			generation++;
+			return ;
+		}
+		#endif
+
 		bind();
 
 		const size_t imgSize = getSize();
@@ -1025,7 +1247,7 @@ using namespace Glip::CoreGL;
 			pixelFormat = HdlTextureFormatDescriptorsList::get(pixelFormat).aliasMode;
 
 			// Bind it :
-			glBindTexture(GL_TEXTURE_2D, texID);
+			GLStateCache::bindTexture(texID);
 
 			glPixelStorei(GL_PACK_ALIGNMENT, _alignment);
 
@@ -1043,6 +1265,103 @@ using namespace Glip::CoreGL;
 		#endif
 	}
 
+	/**
+	\fn void HdlTexture::readRegion(GLvoid *data, int x, int y, int w, int h, int level, GLenum pixelFormat, GLenum pixelDepth, int _alignment)
+	\brief Read a rectangle of a mipmap level of the texture.
+	\param data The pointer to the data (or the offset in the pixel pack buffer currently bound).
+	\param x Left edge of the rectangle, in pixels of the level.
+	\param y Bottom edge of the rectangle, in pixels of the level.
+	\param w Width of the rectangle.
+	\param h Height of the rectangle.
+	\param level The mipmap level (default is 0, the original image).
+	\param pixelFormat The pixel format of the output data (considered the same as the texture layout if not provided).
+	\param pixelDepth The depth of the output data (considered the same as the texture layout if not provided).
+	\param _alignment Byte alignment of the output data.
+
+	The rectangle is read directly with glGetTextureSubImage when OpenGL 4.5 or GL_ARB_get_texture_sub_image are available. Otherwise, the whole level is read and the rectangle is extracted on the host (a pixel pack buffer can only be used for whole levels in this case).
+
+	Warnings :
+	- No data will be written if the library is built against any version of GLES.
+	**/
+	void HdlTexture::readRegion(GLvoid *data, int x, int y, int w, int h, int level, GLenum pixelFormat, GLenum pixelDepth, int _alignment)
+	{
+		#ifdef GLIP_USE_GL
+			checkRegion("readRegion", x, y, w, h, level);
+
+			if(pixelFormat==GL_ZERO)
+				pixelFormat = mode;
+
+			if(pixelDepth==GL_ZERO)
+				pixelDepth = depth;
+
+			if(_alignment<0)
+				_alignment = getAlignment();
+
+			pixelFormat = HdlTextureFormatDescriptorsList::get(pixelFormat).aliasMode;
+
+			const int	levelWidth	= std::max(width >> level, 1),
+					levelHeight	= std::max(height >> level, 1);
+			const bool	wholeLevel	= (x==0 && y==0 && w==levelWidth && h==levelHeight);
+			const size_t	pixelSize	= HdlTextureFormatDescriptorsList::get(pixelFormat).getPixelSize(pixelDepth),
+					align		= static_cast<size_t>(_alignment),
+					rowSize		= (w*pixelSize + align - 1) & ~(align - 1);
+
+			if(!wholeLevel && !(GLEW_VERSION_4_5 || GLEW_ARB_get_texture_sub_image) && HdlGeBO::isBound(GL_PIXEL_PACK_BUFFER))
+				throw Exception("HdlTexture::readRegion - Reading a part of a level into a pixel pack buffer requires OpenGL 4.5 or GL_ARB_get_texture_sub_image.", __FILE__, __LINE__, Exception::GLException);
+
+			// Save the current packing alignment, and replace it with the desired value :
+			GLint originalAlignment = 0;
+			glGetIntegerv(GL_PACK_ALIGNMENT, &originalAlignment);
+			glPixelStorei(GL_PACK_ALIGNMENT, _alignment);
+
+			if(!wholeLevel && (GLEW_VERSION_4_5 || GLEW_ARB_get_texture_sub_image))
+			{
+				glGetTextureSubImage(texID, level, x, y, 0, w, h, 1, pixelFormat, pixelDepth, static_cast<GLsizei>(rowSize*h), data);
+
+				#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+					OPENGL_ERROR_TRACKER("HdlTexture::readRegion", "glGetTextureSubImage()")
+				#endif
+			}
+			else if(wholeLevel)
+			{
+				GLStateCache::bindTexture(texID);
+				glGetTexImage(GL_TEXTURE_2D, level, pixelFormat, pixelDepth, data);
+
+				#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+					OPENGL_ERROR_TRACKER("HdlTexture::readRegion", "glGetTexImage()")
+				#endif
+			}
+			else
+			{
+				const size_t levelRowSize = (levelWidth*pixelSize + align - 1) & ~(align - 1);
+				std::vector<char> tmp(levelRowSize*levelHeight);
+
+				GLStateCache::bindTexture(texID);
+				glGetTexImage(GL_TEXTURE_2D, level, pixelFormat, pixelDepth, &tmp[0]);
+
+				#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+					OPENGL_ERROR_TRACKER("HdlTexture::readRegion", "glGetTexImage()")
+				#endif
+
+				for(int r=0; r<h; r++)
+					std::memcpy(reinterpret_cast<char*>(data) + r*rowSize, &tmp[(y+r)*levelRowSize + x*pixelSize], w*pixelSize);
+			}
+
+			// Restore :
+			glPixelStorei(GL_PACK_ALIGNMENT, originalAlignment);
+		#else
+			UNUSED_PARAMETER(data)
+			UNUSED_PARAMETER(x)
+			UNUSED_PARAMETER(y)
+			UNUSED_PARAMETER(w)
+			UNUSED_PARAMETER(h)
+			UNUSED_PARAMETER(level)
+			UNUSED_PARAMETER(pixelFormat)
+			UNUSED_PARAMETER(pixelDepth)
+			UNUSED_PARAMETER(_alignment)
+		#endif
+	}
+
 	/**
 	\fn GLenum HdlTexture::getInternalMode(void)
 	\brief Get the internal format of the texture. 
@@ -1182,12 +1501,7 @@ using namespace Glip::CoreGL;
 	**/
 	void HdlTexture::unbind(GLenum unit)
 	{
-		#ifdef GLIP_USE_GL
-		glActiveTextureARB(unit);
-		#else
-		UNUSED_PARAMETER(unit)
-		#endif
-		glBindTexture(GL_TEXTURE_2D, 0); //unBind
+		GLStateCache::bindTexture(unit, 0); //unBind
 	}
 
 	/**
@@ -1213,3 +1527,87 @@ using namespace Glip::CoreGL;
 		return maxTextureImageUnits;
 	}
 
+	/**
+	\fn GLenum HdlTexture::getSizedMode(GLenum mode)
+	\brief Get the sized internal format used to allocate an immutable storage for a mode.
+	\param mode The mode of the texture.
+	\return The sized internal format (GL_RGBA8 for GL_RGBA, as the drivers do for unsized formats) or GL_NONE if no immutable storage can be used for this mode (luminance, alpha, compressed formats...).
+	**/
+	GLenum HdlTexture::getSizedMode(GLenum mode)
+	{
+		const HdlTextureFormatDescriptor& descriptor = HdlTextureFormatDescriptorsList::get(mode);
+
+		if(descriptor.isCompressed || (descriptor.aliasMode!=GL_RED && descriptor.aliasMode!=GL_RG && descriptor.aliasMode!=GL_RGB && descriptor.aliasMode!=GL_RGBA))
+			return GL_NONE;
+		else if(descriptor.channelsSizeInBits[0]>0)
+			return mode;	// Already sized.
+
+		switch(descriptor.aliasMode)
+		{
+			case GL_RED :	return GL_R8;
+			case GL_RG :	return GL_RG8;
+			case GL_RGB :	return GL_RGB8;
+			case GL_RGBA :	return GL_RGBA8;
+			default :	return GL_NONE;
+		}
+	}
+
+	/**
+	\fn GLenum HdlTexture::getImageFormat(GLenum mode)
+	\brief Get the format used to bind a texture of the given mode to an image unit (glBindImageTexture).
+	\param mode The mode of the texture.
+	\return The sized format (see HdlTexture::getSizedMode) or GL_NONE if it is not supported by the image load/store operations (three channels formats, luminance, compressed formats...).
+	**/
+	GLenum HdlTexture::getImageFormat(GLenum mode)
+	{
+		const GLenum sizedMode = getSizedMode(mode);
+
+		switch(sizedMode)
+		{
+			case GL_RGBA32F :
+			case GL_RGBA16F :
+			case GL_RG32F :
+			case GL_RG16F :
+			case GL_R32F :
+			case GL_R16F :
+			case GL_RGBA32UI :
+			case GL_RGBA16UI :
+			case GL_RGBA8UI :
+			case GL_RG32UI :
+			case GL_RG16UI :
+			case GL_RG8UI :
+			case GL_R32UI :
+			case GL_R16UI :
+			case GL_R8UI :
+			case GL_RGBA32I :
+			case GL_RGBA16I :
+			case GL_RGBA8I :
+			case GL_RG32I :
+			case GL_RG16I :
+			case GL_RG8I :
+			case GL_R32I :
+			case GL_R16I :
+			case GL_R8I :
+			case GL_RGBA8 :
+			case GL_RG8 :
+			case GL_R8 :
+			case GL_RGBA8_SNORM :
+			case GL_RG8_SNORM :
+			case GL_R8_SNORM :
+		#ifdef GLIP_USE_GL
+			case GL_R11F_G11F_B10F :
+			case GL_RGB10_A2UI :
+			case GL_RGB10_A2 :
+			case GL_RGBA16 :
+			case GL_RG16 :
+			case GL_R16 :
+			case GL_RGBA16_SNORM :
+			case GL_RG16_SNORM :
+			case GL_R16_SNORM :
+		#endif
+				return sizedMode;
+			default :
+				return GL_NONE;
+		}
+	}
+
@@ -29,7 +29,7 @@ using namespace Glip::CoreGL;
 
 // Tools
 	/**
-	\fn HdlVBO::HdlVBO(int _nVert, int _dim, GLenum freq, const GLfloat* _vertices, int _nElements, int _nIndPerElement, const GLuint* _elements, GLenum _type, const GLfloat* _normals, int _dimTexCoords, const GLfloat* _texcoords)
+	\fn HdlVBO::HdlVBO(int _nVert, int _dim, GLenum freq, const GLfloat* _vertices, int _nElements, int _nIndPerElement, const GLuint* _elements, GLenum _type, const GLfloat* _normals, int _dimTexCoords, const GLfloat* _texcoords, int _nInstances)
 	\brief HdlVBO constructor.
 	\param _nVert Number of vertices.
 	\param _dim Dimension of the space containing the vertices (2 or 3).
@@ -42,13 +42,15 @@ using namespace Glip::CoreGL;
 	\param _normals Pointer to the normals data (of the same dimension as the vertices).
 	\param _dimTexCoords Dimension per texel (2 or 3).
 	\param _texcoords Pointer to the texel coordiantes data.	
+	\param _nInstances Number of times the data is drawn (instancing, requires OpenGL 3.1).
 	**/
-	HdlVBO::HdlVBO(int _nVert, int _dim, GLenum freq, const GLfloat* _vertices, int _nElements, int _nIndPerElement, const GLuint* _elements, GLenum _type, const GLfloat* _normals, int _dimTexCoords, const GLfloat* _texcoords)
+	HdlVBO::HdlVBO(int _nVert, int _dim, GLenum freq, const GLfloat* _vertices, int _nElements, int _nIndPerElement, const GLuint* _elements, GLenum _type, const GLfloat* _normals, int _dimTexCoords, const GLfloat* _texcoords, int _nInstances)
 	 :	nVert(_nVert),
 		nElements(_nElements),
 		dim(_dim),
 		nIndPerElement(_nIndPerElement),
 		dimTexCoords(_dimTexCoords),
+		nInstances(_nInstances),
 		hasNormals(_normals!=NULL),
 		vertices(NULL),
 		elements(NULL),
@@ -60,6 +62,14 @@ using namespace Glip::CoreGL;
 		if(dimTexCoords!=0 && _texcoords==NULL)
 			throw Exception("HdlVBO::HdlVBO - attempt to create texcoords without any data", __FILE__, __LINE__, Exception::GLException);
 
+		if(nInstances<1)
+			throw Exception("HdlVBO::HdlVBO - The number of instances must be at least 1.", __FILE__, __LINE__, Exception::GLException);
+
+		#ifdef GLIP_USE_GL
+		if(nInstances>1 && !GLEW_VERSION_3_1 && !GLEW_ARB_draw_instanced)
+			throw Exception("HdlVBO::HdlVBO - Instanced drawing is not supported (OpenGL 3.1 or ARB_draw_instanced are required).", __FILE__, __LINE__, Exception::GLException);
+		#endif
+
 		// For the vertices and the texcoords :
 		const GLsizeiptr size = nVert*(dim + (_texcoords!=NULL ? dimTexCoords : 0) + (_normals!=NULL ? dim : 0))*sizeof(GLfloat);
 		vertices = new HdlGeBO(size, GL_ARRAY_BUFFER, freq);
@@ -106,12 +116,15 @@ using namespace Glip::CoreGL;
 	\return The dimension of the space.
 	\fn int HdlVBO::getElementsCount(void)
 	\return The number of elements.
+	\fn int HdlVBO::getInstancesCount(void)
+	\return The number of instances.
 	\fn GLenum HdlVBO::getType(void)
 	\return The type of the elements.
 	**/
 	int HdlVBO::getVerticesCount(void)  { return nVert; }
 	int HdlVBO::getShapeDimension(void) { return dim; }
 	int HdlVBO::getElementsCount(void)  { return nElements; }
+	int HdlVBO::getInstancesCount(void) { return nInstances; }
 	GLenum HdlVBO::getType(void)        { return type; }
 
 	/**
@@ -138,8 +151,12 @@ using namespace Glip::CoreGL;
 				glEnableClientState(GL_TEXTURE_COORD_ARRAY);
 			if(hasNormals)
 				glEnableClientState(GL_NORMAL_ARRAY);
-			if(elements==NULL)
+			if(elements==NULL && nInstances>1)
+				glDrawArraysInstanced(GL_POINTS, 0, nVert, nInstances);
+			else if(elements==NULL)
 				glDrawArrays(GL_POINTS, 0, nVert);
+			else if(nInstances>1)
+				glDrawElementsInstanced(type, nElements*nIndPerElement, GL_UNSIGNED_INT, 0, nInstances);
 			else
 				glDrawElements(type, nElements*nIndPerElement, GL_UNSIGNED_INT, 0);
 
@@ -23,11 +23,18 @@
 
 #include <limits>
 #include <map>
+#include <cmath>
+#include <algorithm>
+#include <iterator>
 #include "Core/Exception.hpp"
 #include "Core/Pipeline.hpp"
 #include "Core/Component.hpp"
 #include "Core/HdlFBO.hpp"
+#include "Core/GLStateCache.hpp"
 #include "Core/ShaderSource.hpp"
+#include "Core/HdlShader.hpp"
+#include "Core/HdlDynamicData.hpp"
+#include "Core/FilterFusion.hpp"
 #include "devDebugTools.hpp"
 
 	using namespace Glip::CoreGL;
@@ -868,17 +875,70 @@
 		outputCounts.push_back(count);
 	}
 
+// Pipeline::Region
+	Pipeline::Region::Region(int _x, int _y, int _width, int _height)
+	 :	x(_x),
+		y(_y),
+		width(_width),
+		height(_height)
+	{ }
+
+	bool Pipeline::Region::contains(const Region& r) const
+	{
+		return (r.width==0 || r.height==0) || (width>0 && height>0 && x<=r.x && y<=r.y && x+width>=r.x+r.width && y+height>=r.y+r.height);
+	}
+
+	void Pipeline::Region::merge(const Region& r)
+	{
+		if(r.width==0 || r.height==0)
+			return ;
+		else if(width==0 || height==0)
+			(*this) = r;
+		else
+		{
+			const int	right	= std::max(x + width, r.x + r.width),
+					top	= std::max(y + height, r.y + r.height);
+
+			x	= std::min(x, r.x);
+			y	= std::min(y, r.y);
+			width	= right - x;
+			height	= top - y;
+		}
+	}
+
+	Pipeline::Region Pipeline::Region::fromNormalized(double left, double bottom, double right, double top, int fullWidth, int fullHeight, int margin)
+	{
+		// Cover all the pixels touched by the normalized rectangle, at least one :
+		const int	x0 = std::max(static_cast<int>(std::floor(left * fullWidth)) - margin, 0),
+				y0 = std::max(static_cast<int>(std::floor(bottom * fullHeight)) - margin, 0),
+				x1 = std::min(static_cast<int>(std::ceil(right * fullWidth)) + margin, fullWidth),
+				y1 = std::min(static_cast<int>(std::ceil(top * fullHeight)) + margin, fullHeight);
+
+		return Region(std::min(x0, fullWidth-1), std::min(y0, fullHeight-1), std::max(x1 - x0, 1), std::max(y1 - y0, 1));
+	}
+
+// Pipeline::FrameToken
+	/**
+	\fn Pipeline::FrameToken::FrameToken(void)
+	\brief Build an invalid token.
+	**/
+	Pipeline::FrameToken::FrameToken(void)
+	 :	frame(0),
+		cellID(0)
+	{ }
+
 // Pipeline::BuffersCell
 	Pipeline::BuffersCell::BuffersCell(const BufferFormatsCell& bufferFormats)
+	 :	frame(0)
 	{
 		for(unsigned int k=0; k<bufferFormats.formats.size(); k++)
-			buffersList.push_back( new HdlFBO(bufferFormats.formats[k], bufferFormats.outputCounts[k]) );
+			buffersList.push_back( HdlFBOPool::lease(bufferFormats.formats[k], bufferFormats.outputCounts[k]) );
 	}
 
 	Pipeline::BuffersCell::~BuffersCell(void)
 	{
 		for(std::vector<HdlFBO*>::iterator it = buffersList.begin(); it!=buffersList.end(); it++)
-			delete (*it);
+			HdlFBOPool::release(*it);
 		buffersList.clear();
 	}
 
@@ -892,25 +952,44 @@
 		AbstractPipelineLayout(p), 
 		Component(p, "(Intermediate : " + name + ")"), 
 		currentCell(NULL),
+		activeActions(NULL),
+		regionOfInterestEnabled(false),
+		allocationFlags(0),
+		intermediateMemoryPeak(0),
+		framesPosition(0),
+		framesCounter(0),
 		perfsMonitoring(false), 	
-		queryObject(0)
+		perfsFramesDepth(0),
+		perfsCurrentFrame(0),
+		numProcessedActions(0)
 	{
 		UNUSED_PARAMETER(fake)
 	}
 
 	/**
-	\fn Pipeline::Pipeline(const AbstractPipelineLayout& p, const std::string& name)
+	\fn Pipeline::Pipeline(const AbstractPipelineLayout& p, const std::string& name, int _allocationFlags)
 	\brief Pipeline constructor.
 	\param p Pipeline layout.
 	\param name Name of the pipeline.
+	\param _allocationFlags Options for the allocation of the intermediate buffers (combination of Pipeline::AllocationFlag, default is none).
+
+	The intermediate buffers are shared between the filters whose outputs are never needed at the same time (see Pipeline::getIntermediateMemory and Pipeline::getIntermediateMemoryPeak).
 	**/
-	Pipeline::Pipeline(const AbstractPipelineLayout& p, const std::string& name)
+	Pipeline::Pipeline(const AbstractPipelineLayout& p, const std::string& name, int _allocationFlags)
 	 :	AbstractComponentLayout(p), 
 		AbstractPipelineLayout(p), 
 		Component(p, name),
 		currentCell(NULL), 
+		activeActions(NULL),
+		regionOfInterestEnabled(false),
+		allocationFlags(_allocationFlags),
+		intermediateMemoryPeak(0),
+		framesPosition(0),
+		framesCounter(0),
 		perfsMonitoring(false), 
-		queryObject(0) 
+		perfsFramesDepth(0),
+		perfsCurrentFrame(0),
+		numProcessedActions(0)
 	{
 		cleanInput();
 
@@ -922,6 +1001,10 @@
 			std::vector<Connection> connections;
 			int idx = THIS_PIPELINE;
 			build(idx, filtersList, filtersGlobalIDsList, connections, *this);
+
+			if((allocationFlags & FusePointwiseFilters)!=0)
+				fuseFilters(idx, connections);
+
 			allocateBuffers(connections);
 		}
 		catch(Exception& e)
@@ -947,12 +1030,21 @@
 		}		
 		cells.clear();
 
+		for(std::map<int, FusionHub>::iterator it=fusionsList.begin(); it!=fusionsList.end(); it++)
+		{
+			for(std::vector< std::vector<HdlDynamicData*> >::iterator itS=it->second.states.begin(); itS!=it->second.states.end(); itS++)
+			{
+				for(std::vector<HdlDynamicData*>::iterator itD=itS->begin(); itD!=itS->end(); itD++)
+					delete *itD;
+			}
+		}
+		fusionsList.clear();
+
 		for(std::vector<Filter*>::iterator it = filtersList.begin(); it!=filtersList.end(); it++)
 			delete (*it);
 		filtersList.clear();
 
-		if(queryObject>0)
-			glDeleteQueries(1, &queryObject);
+		releaseQueries();
 	}
 
 	/**
@@ -1148,6 +1240,231 @@
 		#endif
 	}
 
+	/**
+	\fn void Pipeline::fuseFilters(int& currentIdx, std::vector<Connection>& connections)
+	\brief Replace the chains of pointwise filters by fused filters (see Pipeline::FusePointwiseFilters). The original filters are kept in the list but are not scheduled.
+	\param currentIdx The next free global ID.
+	\param connections The connections list, rewritten to the fused filters.
+	**/
+	void Pipeline::fuseFilters(int& currentIdx, std::vector<Connection>& connections)
+	{
+		const int numFilters = filtersList.size();
+		std::vector<int>	outgoing(numFilters, 0),
+					next(numFilters, -1),
+					previous(numFilters, -1),
+					previousPort(numFilters, -1);
+
+		fusedInto.assign(numFilters, -1);
+		fusionReport.clear();
+
+		for(std::vector<Connection>::const_iterator it=connections.begin(); it!=connections.end(); it++)
+		{
+			if(it->idOut!=THIS_PIPELINE)
+				outgoing[ filtersGlobalIDsList[it->idOut] ]++;
+		}
+
+		// Find the edges which can be fused, a producer has a single reader and a consumer is fused with at most one producer :
+		for(std::vector<Connection>::const_iterator it=connections.begin(); it!=connections.end(); it++)
+		{
+			if(it->idOut==THIS_PIPELINE || it->idIn==THIS_PIPELINE)
+				continue;
+
+			const int 	p = filtersGlobalIDsList[it->idOut],
+					c = filtersGlobalIDsList[it->idIn];
+			std::string	reason;
+
+			if(outgoing[p]!=1)
+				continue;
+			else if(previous[c]>=0)
+				reason = "the consumer is already fused with " + filtersList[previous[c]]->getFullName();
+			else if(FilterFusion::canFuse(*filtersList[p], *filtersList[c], it->portIn, reason))
+			{
+				next[p]		= c;
+				previous[c]	= p;
+				previousPort[c]	= it->portIn;
+				continue;
+			}
+
+			fusionReport += "Not fused : " + filtersList[p]->getFullName() + " -> " + filtersList[c]->getFullName() + " : " + reason + ".\n";
+		}
+
+		// Build the chains :
+		for(int k=0; k<numFilters; k++)
+		{
+			if(previous[k]>=0 || next[k]<0)
+				continue;
+
+			FusionHub				fusion;
+			std::vector<const AbstractFilterLayout*>	chain;
+			std::vector<int>				ports;
+			std::string					names;
+
+			for(int m=k; m>=0; m=next[m])
+			{
+				fusion.prefixes.push_back("f" + toString(fusion.membersIdx.size()) + "_");
+				fusion.membersIdx.push_back(m);
+				chain.push_back(filtersList[m]);
+				ports.push_back(previousPort[m]);
+				names += (names.empty() ? "" : "+") + filtersList[m]->getName();
+			}
+
+			const Filter& last = *filtersList[fusion.membersIdx.back()];
+			Filter* fused = NULL;
+
+			try
+			{
+				FilterLayout layout("Fusion(" + names + ")", last, FilterFusion::generate(chain, ports, fusion.prefixes));
+
+				if(last.isClearingEnabled())
+					layout.enableClearing();
+				else
+					layout.disableClearing();
+
+				if(last.isBlendingEnabled())
+					layout.enableBlending(last.getSFactor(), last.getDFactor(), last.getBlendingEquation());
+
+				if(last.isDepthTestingEnabled())
+					layout.enableDepthTesting(last.getDepthTestingFunction());
+
+				// The members are pointwise along the chain, the halo is the largest of the constant ones :
+				int halo = 0;
+				for(std::vector<const AbstractFilterLayout*>::const_iterator it=chain.begin(); it!=chain.end() && halo>=0; it++)
+					halo = ((*it)->getHalo()<0) ? -1 : std::max(halo, (*it)->getHalo());
+				layout.setHalo(halo);
+
+				fused = new Filter(layout, names);
+
+				// Test the ports mapping before changing the connections :
+				for(unsigned int j=0; j<fusion.membersIdx.size(); j++)
+				{
+					const Filter& member = *filtersList[fusion.membersIdx[j]];
+
+					for(int l=0; l<member.getNumInputPort(); l++)
+					{
+						if(j==0 || l!=ports[j])
+							fused->getInputPortID(fusion.prefixes[j] + member.getInputPortName(l));
+					}
+				}
+
+				for(int l=0; l<last.getNumOutputPort(); l++)
+					fused->getOutputPortID(fusion.prefixes.back() + last.getOutputPortName(l));
+
+				// Test that all the uniform variables of the members can be forwarded (the fused program might still optimize out some of them) :
+				const std::string& fusedSource = layout.getShaderSource(GL_FRAGMENT_SHADER)->getSource();
+				for(unsigned int j=0; j<fusion.membersIdx.size(); j++)
+				{
+					Filter& member = *filtersList[fusion.membersIdx[j]];
+					const std::vector<std::string>& uniforms = member.program().getUniformsNames();
+
+					for(std::vector<std::string>::const_iterator it=uniforms.begin(); it!=uniforms.end(); it++)
+					{
+						// Arrays and structures, the base name is declared :
+						const std::string name = fusion.prefixes[j] + it->substr(0, it->find_first_of(".["));
+						bool declared = false;
+
+						for(size_t pos=fusedSource.find(name); pos!=std::string::npos && !declared; pos=fusedSource.find(name, pos+1))
+						{
+							const size_t end = pos + name.size();
+							declared = (pos==0 || !(std::isalnum(fusedSource[pos-1]) || fusedSource[pos-1]=='_')) && (end>=fusedSource.size() || !(std::isalnum(fusedSource[end]) || fusedSource[end]=='_'));
+						}
+
+						if(!declared)
+							throw Exception("The uniform variable \"" + (*it) + "\" of " + member.getFullName() + " is not declared in the fused filter.", __FILE__, __LINE__, Exception::CoreException);
+					}
+				}
+			}
+			catch(Exception& e)
+			{
+				delete fused;
+				fusionReport += "Not fused : " + names + " : " + e.what() + "\n";
+				continue;
+			}
+
+			const int fusedIdx = filtersList.size();
+
+			filtersList.push_back(fused);
+			filtersGlobalIDsList[currentIdx] = fusedIdx;
+			fusion.states.resize(fusion.membersIdx.size());
+			fusion.versions.assign(fusion.membersIdx.size(), 0);
+
+			// Rewrite the connections :
+			for(std::vector<Connection>::iterator it=connections.begin(); it!=connections.end(); )
+			{
+				const int	fidOut	= (it->idOut==THIS_PIPELINE) ? -1 : filtersGlobalIDsList[it->idOut],
+						fidIn	= (it->idIn==THIS_PIPELINE) ? -1 : filtersGlobalIDsList[it->idIn];
+				const std::vector<int>::const_iterator	itOut	= std::find(fusion.membersIdx.begin(), fusion.membersIdx.end(), fidOut),
+									itIn	= std::find(fusion.membersIdx.begin(), fusion.membersIdx.end(), fidIn);
+
+				if(itOut!=fusion.membersIdx.end() && itIn!=fusion.membersIdx.end())
+				{
+					// Internal connection :
+					it = connections.erase(it);
+					continue;
+				}
+
+				if(itIn!=fusion.membersIdx.end())
+				{
+					it->portIn	= fused->getInputPortID(fusion.prefixes[itIn - fusion.membersIdx.begin()] + filtersList[fidIn]->getInputPortName(it->portIn));
+					it->idIn	= currentIdx;
+				}
+
+				if(itOut!=fusion.membersIdx.end())
+				{
+					it->portOut	= fused->getOutputPortID(fusion.prefixes.back() + last.getOutputPortName(it->portOut));
+					it->idOut	= currentIdx;
+				}
+
+				it++;
+			}
+
+			for(std::vector<int>::const_iterator it=fusion.membersIdx.begin(); it!=fusion.membersIdx.end(); it++)
+				fusedInto[*it] = fusedIdx;
+
+			fusionsList[fusedIdx] = fusion;
+			fusionReport += "Fused : " + names + ".\n";
+			currentIdx++;
+		}
+
+		fusedInto.resize(filtersList.size(), -1);
+	}
+
+	/**
+	\fn void Pipeline::forwardUniforms(FusionHub& fusion, Filter& fused)
+	\brief Copy the uniform variables of the original filters to the fused filter, if they were modified since the last copy.
+	\param fusion The fusion description.
+	\param fused The fused filter.
+	**/
+	void Pipeline::forwardUniforms(FusionHub& fusion, Filter& fused)
+	{
+		for(unsigned int j=0; j<fusion.membersIdx.size(); j++)
+		{
+			Filter& member = *filtersList[fusion.membersIdx[j]];
+			const unsigned int version = member.getUniformsVersion();
+
+			if(!fusion.states[j].empty() && version==fusion.versions[j])
+				continue;
+
+			HdlProgram& memberProgram = member.program();
+			const std::vector<std::string>& names = memberProgram.getUniformsNames();
+
+			memberProgram.saveUniforms(fusion.states[j]);
+			fusion.versions[j] = member.getUniformsVersion();
+
+			for(unsigned int l=0; l<names.size(); l++)
+			{
+				// The samplers are managed by the fused filter :
+				if(fusion.states[j][l]==NULL || member.doesInputPortExist(names[l]))
+					continue;
+
+				// The declarations were tested when the fusion was built (see Pipeline::fuseFilters), a variable without location was optimized out of the fused program :
+				const GLint location = fused.program().getUniformLocation(fusion.prefixes[j] + names[l]);
+
+				if(location!=-1)
+					fused.program().setVar(fusion.prefixes[j] + names[l], *fusion.states[j][l]);
+			}
+		}
+	}
+
 	void Pipeline::allocateBuffers(std::vector<Connection>& connections)
 	{
 		#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
@@ -1193,223 +1510,309 @@
 		try
 		{
 			// The input is a list of all the connections, untangle, where the ID -1 is reserved for this pipeline.
-			std::vector<Connection> 	remainingConnections = connections;	// The remaining (not processed) connections.
-			std::vector<int>		requestedInputConnections;		// The number of connections not satisfied for this filter.
-			std::vector<int>		bufferOccupancy;			// The number of filter which will use the buffer as inputs.
-			std::vector<ActionHub>		tmpActions;				// The temporary actions list.
-			bool allProcessed = false;
+			// The allocation is done in three steps : 
+			// 0 - Eliminate the filters which do not contribute to any output of the pipeline (including the filters replaced by a fusion).
+			// 1 - Schedule the actions (topological order, favoring the actions which release the most memory).
+			// 2 - Compute the liveness interval of the outputs of each action, in this order.
+			// 3 - Assign the buffers by interval coloring : an action reuses the best fitting buffer which is not live anymore.
+			const int 			numFilters = filtersList.size();
+			int				numActions = 0;
+			std::vector<int>		requestedInputConnections(numFilters, 0);	// The number of connections not satisfied for this filter.
+			std::vector<int>		remainingReaders(numFilters, 0);		// The number of filters not scheduled yet which are reading the outputs of this filter.
+			std::vector<bool>		feedsOutput(numFilters, false);			// True if one of the outputs of the filter is an output of the pipeline.
+			std::vector<bool>		contributes(numFilters, false);			// True if the filter contributes to at least one output of the pipeline.
+			std::vector<ActionHub>		tmpActions;					// The temporary actions list, inputBufferIdx contains first the index of the producing filter.
+			std::vector<int>		order;						// The scheduled filters.
 
 			// Initialize the outputs :
 			OutputHub blankOutput;
 			blankOutput.bufferIdx = -1;
 			blankOutput.outputIdx = -1;
+			blankOutput.actionIdx = -1;
 			outputsList.assign( getNumOutputPort(), blankOutput );
 
 			// Setup the requirements counters :
-			for(unsigned int k=0; k<filtersList.size(); k++)
+			fusedInto.resize(numFilters, -1);
+			for(int k=0; k<numFilters; k++)
 			{
 				ActionHub hub;
 
 				hub.inputBufferIdx.assign( filtersList[k]->getNumInputPort(), -1);
 				hub.inputArgumentIdx.assign( filtersList[k]->getNumInputPort(), -1);
+				hub.inputActionIdx.assign( filtersList[k]->getNumInputPort(), THIS_PIPELINE);
 				hub.bufferIdx		= -1;
 				hub.filterIdx 		= k;
 
 				tmpActions.push_back(hub);
 
 				// Set the number of inputs not satisfied to be equal to the number of inputs :
-				requestedInputConnections.push_back( filtersList[k]->getNumInputPort() );
+				requestedInputConnections[k] = filtersList[k]->getNumInputPort();
 			}
 
-			// Initialize by decrementing the connections to this pipeline inputs :
-			for(unsigned int k=0; k<remainingConnections.size(); k++)
+			// Set up the links, by filter :
+			std::vector<int> outputsProducers(getNumOutputPort(), -1);
+			for(std::vector<Connection>::const_iterator it=connections.begin(); it!=connections.end(); it++)
 			{
-				if(remainingConnections[k].idOut==THIS_PIPELINE)
+				const int fidOut = (it->idOut==THIS_PIPELINE) ? THIS_PIPELINE : filtersGlobalIDsList[it->idOut];
+
+				if(it->idIn==THIS_PIPELINE)
+				{
+					if(fidOut==THIS_PIPELINE)
+						throw Exception("An input of the pipeline cannot be directly connected to one of its outputs.", __FILE__, __LINE__, Exception::CoreException);
+
+					outputsProducers[it->portIn]		= fidOut;
+					outputsList[it->portIn].outputIdx	= it->portOut;
+					feedsOutput[fidOut]			= true;
+				}
+				else
 				{
-					// Set up the links :
-					const int fid = filtersGlobalIDsList[remainingConnections[k].idIn];
+					const int fidIn = filtersGlobalIDsList[it->idIn];
 
-					tmpActions[fid].inputBufferIdx[ remainingConnections[k].portIn ] 	= THIS_PIPELINE;
-					tmpActions[fid].inputArgumentIdx[ remainingConnections[k].portIn ]	= remainingConnections[k].portOut;
-					requestedInputConnections[fid]--;
+					tmpActions[fidIn].inputBufferIdx[it->portIn]	= fidOut;
+					tmpActions[fidIn].inputArgumentIdx[it->portIn]	= it->portOut;
 
-					// Remove :
-					remainingConnections.erase( remainingConnections.begin() + k );
-					k--;
+					// The inputs of the pipeline are immediately available, the unconnected inputs are never satisfied :
+					if(fidOut==THIS_PIPELINE)
+						requestedInputConnections[fidIn]--;
+					else
+						remainingReaders[fidOut]++;
 				}
 			}
 
-			// Generate the final actions list and buffers :
-			do
+			// Step 0 : walk back from the outputs, the other filters are never scheduled (and their inputs may be left unconnected) :
+			std::vector<int> stack;
+			for(int k=0; k<getNumOutputPort(); k++)
 			{
+				if(outputsProducers[k]>=0 && !contributes[outputsProducers[k]])
+				{
+					contributes[outputsProducers[k]] = true;
+					stack.push_back(outputsProducers[k]);
+				}
+			}
 
-				#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
-					std::cout << "    Finding candidates : " << std::endl;
-				#endif
-				// Explore the list to find the possibles solutions :
-				std::vector<int> candidatesIdx;
-				for(unsigned int k=0; k<requestedInputConnections.size(); k++)
+			while(!stack.empty())
+			{
+				const int fIdx = stack.back();
+				stack.pop_back();
+
+				for(unsigned int l=0; l<tmpActions[fIdx].inputBufferIdx.size(); l++)
 				{
-					if(requestedInputConnections[k]==0)
+					const int fidOut = tmpActions[fIdx].inputBufferIdx[l];
+
+					if(fidOut>=0 && !contributes[fidOut])
 					{
-						candidatesIdx.push_back(k);
-						#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
-							std::cout << "        Adding : " << filtersList[k]->getFullName() << std::endl;
-						#endif
+						contributes[fidOut] = true;
+						stack.push_back(fidOut);
 					}
 				}
+			}
+
+			for(int k=0; k<numFilters; k++)
+			{
+				if(contributes[k])
+				{
+					numActions++;
+					continue;
+				}
 
-				if(candidatesIdx.empty())
-					throw Exception("No available filter matches input conditions.", __FILE__, __LINE__, Exception::CoreException);
+				#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
+					if(fusedInto[k]<0)
+						std::cout << "    Eliminating : " << filtersList[k]->getFullName() << " (does not contribute to any output)" << std::endl;
+				#endif
+
+				requestedInputConnections[k] = -1;
+				for(unsigned int l=0; l<tmpActions[k].inputBufferIdx.size(); l++)
+				{
+					if(tmpActions[k].inputBufferIdx[l]>=0)
+						remainingReaders[ tmpActions[k].inputBufferIdx[l] ]--;
+				}
+			}
 
-				// Find best candidate along the priority order (from highest to lowest) :
-				// 1 - A filter that has exactly the same format as a buffer which is currently unused, this buffer must as large as possible.
-				// 2 - A filter that has the largest format which is not allocated yet.
-				// 3 - A filter that has the smallest format already allocated (but not available).
-				// 4 - (reserved)
-				// 5 - No decision.
+			// Step 1 : schedule the actions.
+			while(static_cast<int>(order.size())<numActions)
+			{
+				#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
+					std::cout << "    Finding candidates : " << std::endl;
+				#endif
 
-				HdlTextureFormat fmt(0,0,GL_RGB,GL_UNSIGNED_BYTE);	// A format (in case we need to create one).
-				int fIdx = -1;						// The index of the filter chosen.
-				int bIdx = -1;						// The buffer index (if one already exists).
-				int currentDecision = 5;				// No decision.
+				// Among the available filters, find the one releasing the largest amount of memory (the first one in case of equality) :
+				int 	fIdx = -1;
+				double	bestGain = 0.0;
 
-				for(unsigned int k=0; k<candidatesIdx.size(); k++)
+				for(int k=0; k<numFilters; k++)
 				{
-					// Try to find a match in the buffers :
-					bool noMatch = true;
-					for(int l=0; l<bufferFormats.size(); l++)
+					if(requestedInputConnections[k]!=0)
+						continue;
+
+					#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
+						std::cout << "        Adding : " << filtersList[k]->getFullName() << std::endl;
+					#endif
+
+					// Count the readings of this filter per producer :
+					std::map<int, int> readings;
+					for(unsigned int l=0; l<tmpActions[k].inputBufferIdx.size(); l++)
 					{
-						// If this buffer is a match :
-						if( *filtersList[ candidatesIdx[k] ] == bufferFormats.formats[l] )
-						{
-							noMatch = false;
+						if(tmpActions[k].inputBufferIdx[l]>=0)
+							readings[tmpActions[k].inputBufferIdx[l]]++;
+					}
 
-							// If this buffer is free :
-							if(bufferOccupancy[l]==0)
-							{
-								// If the current choice is lower in priority or larger in buffer size :
-								if( currentDecision>1 || ((currentDecision==1) && fmt.getSize()<bufferFormats.formats[l].getSize()) )
-								{
-									fIdx = candidatesIdx[k];
-									bIdx = l;
-									currentDecision = 1;
-									fmt = bufferFormats.formats[l];
-								}
-							}
-							else // The buffer is not free :
-							{
-								// If no other choices were made :
-								if(currentDecision>3 || ( (currentDecision==3) && (fmt.getSize()<bufferFormats.formats[l].getSize()) ) )
-								{
-									fIdx = candidatesIdx[k];
-									bIdx = -1;
-									currentDecision = 3;
-									fmt = bufferFormats.formats[l];
-								}
-							}
-						}
+					double gain = -static_cast<double>(filtersList[k]->getSize() * filtersList[k]->getNumOutputPort());
+					for(std::map<int, int>::const_iterator it=readings.begin(); it!=readings.end(); it++)
+					{
+						if(it->second==remainingReaders[it->first] && !feedsOutput[it->first])
+							gain += static_cast<double>(filtersList[it->first]->getSize() * filtersList[it->first]->getNumOutputPort());
 					}
 
-					if(noMatch && currentDecision>=2 && filtersList[ candidatesIdx[k] ]->getSize() > fmt.getSize())
+					if(fIdx<0 || gain>bestGain)
 					{
-						fIdx = candidatesIdx[k];
-						bIdx = -1;
-						currentDecision = 2;
-						fmt = *filtersList[ candidatesIdx[k] ];
+						fIdx = k;
+						bestGain = gain;
 					}
 				}
 
+				if(fIdx<0)
+					throw Exception("The pipeline building process is stuck as some elements remains but cannot be integrated as they lack input.", __FILE__, __LINE__, Exception::CoreException);
+
 				#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
-					std::cout << "    Decision : " << currentDecision << std::endl;
 					std::cout << "    Filter   : " << filtersList[fIdx]->getFullName() << std::endl;
-					std::cout << "    Buffer   : " << bIdx << std::endl;
 				#endif
 
-				if(currentDecision>=5)
-					throw Exception("No correct decision was made.", __FILE__, __LINE__, Exception::CoreException);
+				// Lock down this filter as "done" :
+				order.push_back(fIdx);
+				requestedInputConnections[fIdx] = -1;
 
-				// Create the action :
-				if(currentDecision==1)
+				for(unsigned int l=0; l<tmpActions[fIdx].inputBufferIdx.size(); l++)
 				{
-					tmpActions[ fIdx ].bufferIdx = bIdx;
-
-					// Push :
-					actionsList.push_back( tmpActions[ fIdx ] );
+					if(tmpActions[fIdx].inputBufferIdx[l]>=0)
+						remainingReaders[ tmpActions[fIdx].inputBufferIdx[l] ]--;
 				}
-				else if(currentDecision==2 || currentDecision==3)
+
+				// Decrease the number of requests of the readers :
+				for(int k=0; k<numFilters; k++)
 				{
-					// Create a new buffer :
-					bufferFormats.append( fmt, filtersList[ fIdx ]->getNumOutputPort() );
-					bufferOccupancy.push_back(0);
+					for(unsigned int l=0; l<tmpActions[k].inputBufferIdx.size(); l++)
+					{
+						if(tmpActions[k].inputBufferIdx[l]==fIdx)
+							requestedInputConnections[k]--;
+					}
+				}
+			}
 
-					bIdx = bufferFormats.size()-1;
-					tmpActions[ fIdx ].bufferIdx = bIdx;
+			// Step 2 : liveness interval of the outputs of each filter, from its position in the order to its last reading :
+			std::vector<int> lastUse(numFilters, -1);
 
-					// Push :
-					actionsList.push_back( tmpActions[ fIdx ] );
-				}
-				else
-					throw Exception("Internal error : Unkown action decision (" + toString(currentDecision) + ").", __FILE__, __LINE__, Exception::CoreException);
+			// The results are kept between the runs in incremental mode, they are never released :
+			for(int t=0; t<numActions; t++)
+				lastUse[order[t]] = (feedsOutput[order[t]] || (allocationFlags & IncrementalProcessing)!=0) ? std::numeric_limits<int>::max() : t;
 
-				// Find all the buffers read by the current actions and decrease their occupancy :
-				for(unsigned int k=0; k<actionsList.back().inputBufferIdx.size(); k++)
+			for(int t=0; t<numActions; t++)
+			{
+				for(unsigned int l=0; l<tmpActions[order[t]].inputBufferIdx.size(); l++)
 				{
-					if( actionsList.back().inputBufferIdx[k]!=THIS_PIPELINE )
-						bufferOccupancy[ actionsList.back().inputBufferIdx[k] ]--;
+					const int fidOut = tmpActions[order[t]].inputBufferIdx[l];
+
+					if(fidOut>=0)
+						lastUse[fidOut] = std::max(lastUse[fidOut], t);
 				}
+			}
 
-				// Lock down this filter as "done" :
-				requestedInputConnections[fIdx] = -1;
+			// Step 3 : assign the buffers, a buffer is free for the action t if its last reading happened before t (it cannot be read and written by the same action) :
+			std::vector<int> 	bufferEnd,						// End of the liveness interval of the current content of the buffer.
+						filterBuffer(numFilters, -1);				// Buffer assigned to the filter.
+			std::vector<size_t>	liveMemory(numActions, 0);				// Memory of the live buffers at each step.
+			intermediateMemoryPeak = 0;
+
+			for(int t=0; t<numActions; t++)
+			{
+				const int 	fIdx		= order[t];
+				const Filter&	f		= *filtersList[fIdx];
+				const bool	allowSubRect	= ((allocationFlags & AllowSubRectangleReuse)!=0) && !feedsOutput[fIdx] && f.getBaseLevel()==0 && f.getMaxLevel()==0;
+				int 		bIdx 		= -1;
+				bool		exactMatch	= false;
 
-				// Update the buffer occupancy to the new number of output and at the same time decrease the number of requests :
-				for(unsigned int k=0; k<remainingConnections.size(); k++)
+				for(int l=0; l<bufferFormats.size(); l++)
 				{
-					if(filtersGlobalIDsList[remainingConnections[k].idOut]==fIdx)
+					const HdlTextureFormat& bf = bufferFormats.formats[l];
+
+					if(bufferEnd[l]>=t || bufferFormats.outputCounts[l]<f.getNumOutputPort())
+						continue;
+
+					if(f==bf)
 					{
-						if(remainingConnections[k].idIn==THIS_PIPELINE)
-						{
-							outputsList[ remainingConnections[k].portIn ].bufferIdx 	= bIdx;
-							outputsList[ remainingConnections[k].portIn ].outputIdx		= remainingConnections[k].portOut;
+						// Prefer an exact match, with the least number of extra targets :
+						if(!exactMatch || bufferFormats.outputCounts[l]<bufferFormats.outputCounts[bIdx])
+							bIdx = l;
+						exactMatch = true;
+					}
+					else if(!exactMatch && allowSubRect && bf.getWidth()>=f.getWidth() && bf.getHeight()>=f.getHeight() && bf.getGLMode()==f.getGLMode() && bf.getGLDepth()==f.getGLDepth()
+						&& bf.getMinFilter()==f.getMinFilter() && bf.getMagFilter()==f.getMagFilter() && bf.getSWrapping()==f.getSWrapping() && bf.getTWrapping()==f.getTWrapping()
+						&& bf.getBaseLevel()==0 && bf.getMaxLevel()==0)
+					{
+						// Best fit among the larger buffers :
+						if(bIdx<0 || bf.getSize()*bufferFormats.outputCounts[l]<bufferFormats.formats[bIdx].getSize()*bufferFormats.outputCounts[bIdx])
+							bIdx = l;
+					}
+				}
 
-							bufferOccupancy[bIdx] = std::numeric_limits<int>::max();
-						}
-						else
-						{
-							// Set up the links :
-							const int fid = filtersGlobalIDsList[remainingConnections[k].idIn];
+				if(bIdx<0)
+				{
+					// Create a new buffer :
+					bufferFormats.append( f, f.getNumOutputPort() );
+					bufferEnd.push_back(-1);
+					bIdx = bufferFormats.size()-1;
+				}
 
-							tmpActions[fid].inputBufferIdx[ remainingConnections[k].portIn ] 	= bIdx;
-							tmpActions[fid].inputArgumentIdx[ remainingConnections[k].portIn ]	= remainingConnections[k].portOut;
-							requestedInputConnections[fid]--;
+				#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
+					std::cout << "    Action " << t << " : " << f.getFullName() << " on buffer " << bIdx << " (live until " << lastUse[fIdx] << ")" << std::endl;
+				#endif
 
-							// Remove :
-							remainingConnections.erase( remainingConnections.begin() + k );
-							k--;
+				bufferEnd[bIdx]		= lastUse[fIdx];
+				filterBuffer[fIdx]	= bIdx;
 
-							bufferOccupancy[bIdx]++;
-						}
+				const size_t bufferSize = bufferFormats.formats[bIdx].getSize() * bufferFormats.outputCounts[bIdx];
+				const int end = std::min(lastUse[fIdx], numActions-1);
+				for(int u=t; u<=end; u++)
+					liveMemory[u] += bufferSize;
+			}
+
+			for(int t=0; t<numActions; t++)
+				intermediateMemoryPeak = std::max(intermediateMemoryPeak, liveMemory[t]);
+
+			// Build the final actions list, with the buffers indices :
+			std::vector<int> filterAction(numFilters, -1);
+			for(int t=0; t<numActions; t++)
+				filterAction[order[t]] = t;
+
+			for(int t=0; t<numActions; t++)
+			{
+				ActionHub action = tmpActions[order[t]];
+
+				action.bufferIdx = filterBuffer[action.filterIdx];
+				for(unsigned int l=0; l<action.inputBufferIdx.size(); l++)
+				{
+					if(action.inputBufferIdx[l]!=THIS_PIPELINE)
+					{
+						action.inputActionIdx[l] = filterAction[action.inputBufferIdx[l]];
+						action.inputBufferIdx[l] = filterBuffer[action.inputBufferIdx[l]];
 					}
 				}
 
-				// Test if all were processed :
-				allProcessed 	= true;
-				bool noNextStep = true;
-				for(unsigned int k=0; k<requestedInputConnections.size(); k++)
+				actionsList.push_back(action);
+			}
+
+			for(int k=0; k<getNumOutputPort(); k++)
+			{
+				if(outputsProducers[k]>=0)
 				{
-					if(requestedInputConnections[k]>=0)
-						allProcessed = false;
-					if(requestedInputConnections[k]==0)
-						noNextStep = false;
+					outputsList[k].bufferIdx = filterBuffer[outputsProducers[k]];
+					outputsList[k].actionIdx = filterAction[outputsProducers[k]];
 				}
-
-				if(noNextStep && !allProcessed)
-					throw Exception("The pipeline building process is stuck as some elements remains but cannot be integrated as they lack input.", __FILE__, __LINE__, Exception::CoreException);
 			}
-			while(!allProcessed);
+
+			setAllOutputsActive();
 
 			// Final tests :
-			if(filtersList.size()!=actionsList.size())
+			if(static_cast<int>(actionsList.size())!=numActions)
 				throw Exception("Some filters were omitted because their connections scheme does not allow usage.", __FILE__, __LINE__, Exception::CoreException);
 
 		}
@@ -1487,45 +1890,493 @@
 	}
 
 	/**
-	\fn void Pipeline::process(void)
-	\brief Apply the pipeline.
+	\fn int Pipeline::getNumBuffers(void) const
+	\brief Get the number of intermediate buffers (FBO) in each cell.
+	\return Number of buffers per cell.
 	**/
-	void Pipeline::process(void)
+	int Pipeline::getNumBuffers(void) const
 	{
-		clock_t 	timing 		= 0,
-				totalTiming 	= 0;
+		return bufferFormats.size();
+	}
 
-		if(currentCell==NULL)
-			throw Exception("Pipeline::process - No BufferCell was assigned.", __FILE__, __LINE__, Exception::CoreException);
+	/**
+	\fn size_t Pipeline::getIntermediateMemory(void) const
+	\brief Get the total memory allocated for the intermediate buffers of one cell (not counting mipmaps and depth buffers).
+	\return Size in bytes.
+	**/
+	size_t Pipeline::getIntermediateMemory(void) const
+	{
+		size_t size = 0;
 
-		#ifdef GLIP_USE_GL
-		if(!GLEW_VERSION_3_3 && perfsMonitoring)
-		#else
-		if(perfsMonitoring)
-		#endif
-		{
-			totalTiming = clock();
-			timing = clock();
-		}
+		for(int k=0; k<bufferFormats.size(); k++)
+			size += bufferFormats.formats[k].getSize() * bufferFormats.outputCounts[k];
 
-		#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
-			std::cout << "Pipeline::process - Processing : " << getFullName() << std::endl;
-		#endif
+		return size;
+	}
+
+	/**
+	\fn size_t Pipeline::getIntermediateMemoryPeak(void) const
+	\brief Get the peak memory of the intermediate buffers of one cell which are live at the same time during processing (not counting mipmaps and depth buffers).
+	\return Size in bytes.
+	**/
+	size_t Pipeline::getIntermediateMemoryPeak(void) const
+	{
+		return intermediateMemoryPeak;
+	}
+
+	/**
+	\fn void Pipeline::updateActiveActions(void)
+	\brief Find the actions needed by the active outputs. The lists are computed once per mask of active outputs.
+	**/
+	void Pipeline::updateActiveActions(void)
+	{
+		std::map<std::vector<bool>, std::vector<int> >::iterator it = activeActionsCache.find(activeOutputs);
 
-		for(unsigned int k=0; k<actionsList.size(); k++)
+		if(it==activeActionsCache.end())
 		{
-			ActionHub* 	action 	= &actionsList[k];
-			Filter* 	f 	= filtersList[ action->filterIdx ];
-			HdlFBO* 	t 	= currentCell->buffersList[ action->bufferIdx ];
+			std::vector<bool> needed(actionsList.size(), false);
 
-			#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
-				std::cout << "    applying filter : " << f->getFullName() << "..." << std::endl;
-			#endif
+			for(unsigned int k=0; k<outputsList.size(); k++)
+			{
+				if(activeOutputs[k] && outputsList[k].actionIdx>=0)
+					needed[outputsList[k].actionIdx] = true;
+			}
 
-			for(int l=0; l<f->getNumInputPort(); l++)
+			// The actions are in topological order, the producers always come first :
+			for(int k=static_cast<int>(actionsList.size())-1; k>=0; k--)
 			{
-				int bufferID 	= action->inputBufferIdx[l];
-				int portID 	= action->inputArgumentIdx[l];
+				if(!needed[k])
+					continue;
+
+				for(unsigned int l=0; l<actionsList[k].inputActionIdx.size(); l++)
+				{
+					if(actionsList[k].inputActionIdx[l]!=THIS_PIPELINE)
+						needed[ actionsList[k].inputActionIdx[l] ] = true;
+				}
+			}
+
+			it = activeActionsCache.insert(std::pair<std::vector<bool>, std::vector<int> >(activeOutputs, std::vector<int>())).first;
+			for(unsigned int k=0; k<actionsList.size(); k++)
+			{
+				if(needed[k])
+					it->second.push_back(k);
+			}
+		}
+
+		activeActions = &it->second;
+	}
+
+	/**
+	\fn void Pipeline::setActiveOutputs(const std::vector<int>& outputs)
+	\brief Declare the outputs which are needed by the next runs of the pipeline. Only the actions these outputs depend on will be processed, until the next call to this function (or to Pipeline::setAllOutputsActive). The content of the other outputs is undefined (they usually keep the result of a previous run).
+	\param outputs The indices of the needed outputs.
+	**/
+	void Pipeline::setActiveOutputs(const std::vector<int>& outputs)
+	{
+		std::vector<bool> mask(getNumOutputPort(), false);
+
+		for(std::vector<int>::const_iterator it=outputs.begin(); it!=outputs.end(); it++)
+		{
+			checkOutputPort(*it);
+			mask[*it] = true;
+		}
+
+		activeOutputs = mask;
+		updateActiveActions();
+	}
+
+	/**
+	\fn void Pipeline::setActiveOutputs(const std::vector<std::string>& portNames)
+	\brief Declare the outputs which are needed by the next runs of the pipeline (see Pipeline::setActiveOutputs(const std::vector<int>&)).
+	\param portNames The names of the needed outputs.
+	**/
+	void Pipeline::setActiveOutputs(const std::vector<std::string>& portNames)
+	{
+		std::vector<int> outputs;
+
+		for(std::vector<std::string>::const_iterator it=portNames.begin(); it!=portNames.end(); it++)
+			outputs.push_back(getOutputPortID(*it));
+
+		setActiveOutputs(outputs);
+	}
+
+	/**
+	\fn void Pipeline::setAllOutputsActive(void)
+	\brief Process all the outputs during the next runs (default behavior).
+	**/
+	void Pipeline::setAllOutputsActive(void)
+	{
+		activeOutputs.assign(getNumOutputPort(), true);
+		updateActiveActions();
+	}
+
+	/**
+	\fn bool Pipeline::isOutputActive(int i) const
+	\brief Test if an output is computed during the runs (see Pipeline::setActiveOutputs).
+	\param i The index of the output.
+	\return True if the output is computed.
+	**/
+	bool Pipeline::isOutputActive(int i) const
+	{
+		checkOutputPort(i);
+		return activeOutputs[i];
+	}
+
+	/**
+	\fn int Pipeline::getNumActiveActions(void) const
+	\brief Get the number of actions processed for the active outputs (see Pipeline::setActiveOutputs).
+	\return The number of actions processed, at most Pipeline::getNumActions.
+	**/
+	int Pipeline::getNumActiveActions(void) const
+	{
+		return (activeActions==NULL) ? 0 : activeActions->size();
+	}
+
+	/**
+	\fn void Pipeline::setRegionOfInterest(int x, int y, int width, int height, int output)
+	\brief Declare the rectangle of the outputs which is needed by the next runs of the pipeline. The region is mapped to the other outputs through normalized coordinates and propagated backward to the inputs of each filter, expanded by their halo (see AbstractFilterLayout::getHalo). Each filter only renders the part of its outputs needed, the content of the outputs outside of the region is undefined.
+	\param x Left edge of the region, in pixels of the output.
+	\param y Bottom edge of the region, in pixels of the output.
+	\param width Width of the region.
+	\param height Height of the region.
+	\param output The index of the output in which the region is given.
+	**/
+	void Pipeline::setRegionOfInterest(int x, int y, int width, int height, int output)
+	{
+		checkOutputPort(output);
+
+		const int action = outputsList[output].actionIdx;
+
+		if(action<0)
+			throw Exception("Pipeline::setRegionOfInterest - The output " + getOutputPortName(output) + " of " + getFullName() + " is not produced by a filter.", __FILE__, __LINE__, Exception::CoreException);
+
+		const Filter& f = *filtersList[ actionsList[action].filterIdx ];
+
+		if(width<=0 || height<=0 || x<0 || y<0 || x+width>f.getWidth() || y+height>f.getHeight())
+			throw Exception("Pipeline::setRegionOfInterest - The region (" + toString(x) + ", " + toString(y) + ", " + toString(width) + "x" + toString(height) + ") is empty or is not inside the output " + getOutputPortName(output) + " (" + toString(f.getWidth()) + "x" + toString(f.getHeight()) + ") of " + getFullName() + ".", __FILE__, __LINE__, Exception::CoreException);
+
+		regionOfInterest[0]	= static_cast<double>(x) / static_cast<double>(f.getWidth());
+		regionOfInterest[1]	= static_cast<double>(y) / static_cast<double>(f.getHeight());
+		regionOfInterest[2]	= static_cast<double>(x + width) / static_cast<double>(f.getWidth());
+		regionOfInterest[3]	= static_cast<double>(y + height) / static_cast<double>(f.getHeight());
+		regionOfInterestEnabled	= true;
+	}
+
+	/**
+	\fn void Pipeline::clearRegionOfInterest(void)
+	\brief Render the whole outputs during the next runs (default behavior).
+	**/
+	void Pipeline::clearRegionOfInterest(void)
+	{
+		regionOfInterestEnabled = false;
+		actionsRegions.clear();
+	}
+
+	/**
+	\fn bool Pipeline::hasRegionOfInterest(void) const
+	\return True if a region of interest is currently declared (see Pipeline::setRegionOfInterest).
+	**/
+	bool Pipeline::hasRegionOfInterest(void) const
+	{
+		return regionOfInterestEnabled;
+	}
+
+	/**
+	\fn int Pipeline::getHalo(void)
+	\brief Get the halo of the pipeline : the distance, in pixels of the inputs, around an output pixel outside of which the inputs are not read by the active actions. It is the largest sum of the halos of the filters (see AbstractFilterLayout::getHalo) along a path from an input to an active output, assuming that all the filters have the size of the inputs.
+	\return The halo, or -1 if one of the filters involved did not declare it.
+	**/
+	int Pipeline::getHalo(void)
+	{
+		std::vector<int> accumulated(actionsList.size(), 0);
+		int result = 0;
+
+		for(std::vector<int>::const_iterator it=activeActions->begin(); it!=activeActions->end(); it++)
+		{
+			const ActionHub&	action	= actionsList[*it];
+			const int		own	= filtersList[action.filterIdx]->getCurrentHalo();
+			int			halo	= own;
+
+			for(unsigned int l=0; l<action.inputActionIdx.size() && halo>=0; l++)
+			{
+				if(action.inputActionIdx[l]!=THIS_PIPELINE)
+					halo = (accumulated[action.inputActionIdx[l]]<0) ? -1 : std::max(halo, own + accumulated[action.inputActionIdx[l]]);
+			}
+
+			accumulated[*it] = halo;
+		}
+
+		for(unsigned int k=0; k<outputsList.size() && result>=0; k++)
+		{
+			if(activeOutputs[k] && outputsList[k].actionIdx>=0)
+				result = (accumulated[outputsList[k].actionIdx]<0) ? -1 : std::max(result, accumulated[outputsList[k].actionIdx]);
+		}
+
+		return result;
+	}
+
+	/**
+	\fn void Pipeline::updateRegions(void)
+	\brief Propagate the region of interest from the active outputs to the inputs of the actions. The halos are read before each run, as they can be given by uniform variables.
+	**/
+	void Pipeline::updateRegions(void)
+	{
+		actionsRegions.assign(actionsList.size(), Region());
+
+		for(unsigned int k=0; k<outputsList.size(); k++)
+		{
+			const int action = outputsList[k].actionIdx;
+
+			if(activeOutputs[k] && action>=0)
+			{
+				const Filter& f = *filtersList[ actionsList[action].filterIdx ];
+				actionsRegions[action].merge( Region::fromNormalized(regionOfInterest[0], regionOfInterest[1], regionOfInterest[2], regionOfInterest[3], f.getWidth(), f.getHeight()) );
+			}
+		}
+
+		// The actions are in topological order, the consumers come last :
+		for(std::vector<int>::const_reverse_iterator it=activeActions->rbegin(); it!=activeActions->rend(); it++)
+		{
+			const ActionHub&	action	= actionsList[*it];
+			const Region		region	= actionsRegions[*it];
+
+			if(region.width==0)
+				continue;
+
+			Filter&		f	= *filtersList[action.filterIdx];
+			const int	halo	= f.getCurrentHalo();
+
+			for(unsigned int l=0; l<action.inputActionIdx.size(); l++)
+			{
+				if(action.inputActionIdx[l]==THIS_PIPELINE)
+					continue;
+
+				const Filter& producer = *filtersList[ actionsList[action.inputActionIdx[l]].filterIdx ];
+
+				if(halo<0)
+					actionsRegions[action.inputActionIdx[l]].merge( Region(0, 0, producer.getWidth(), producer.getHeight()) );
+				else
+					actionsRegions[action.inputActionIdx[l]].merge( Region::fromNormalized(	static_cast<double>(region.x) / f.getWidth(),
+														static_cast<double>(region.y) / f.getHeight(),
+														static_cast<double>(region.x + region.width) / f.getWidth(),
+														static_cast<double>(region.y + region.height) / f.getHeight(),
+														producer.getWidth(), producer.getHeight(), halo) );
+			}
+		}
+	}
+
+	/**
+	\fn bool Pipeline::isActionUpToDate(int k, const Region& region)
+	\brief Test if the result of an action in the current cell is still valid : its filter, its inputs and the actions producing them did not change since it was processed and the region rendered then contains the one needed (see Pipeline::IncrementalProcessing).
+	\param k The index of the action.
+	\param region The region of the outputs needed.
+	\return True if the action can be skipped.
+	**/
+	bool Pipeline::isActionUpToDate(int k, const Region& region)
+	{
+		const ActionHub&	action	= actionsList[k];
+		Filter&			f	= *filtersList[action.filterIdx];
+
+		// Never processed in this cell, or depending on the previous content of the buffer :
+		if(currentCell->actionsVersions[k]==0 || f.isBlendingEnabled() || f.isDepthTestingEnabled() || (!f.isClearingEnabled() && !f.isStandardGeometryModel()))
+			return false;
+
+		if(currentCell->uniformsVersions[k]!=f.getUniformsVersion() || !currentCell->renderedRegions[k].contains(region))
+			return false;
+
+		for(unsigned int l=0; l<action.inputBufferIdx.size(); l++)
+		{
+			if(action.inputBufferIdx[l]==THIS_PIPELINE)
+			{
+				const HdlTexture* input = inputsList[ action.inputArgumentIdx[l] ];
+
+				if(currentCell->inputsTextures[k][l]!=input || currentCell->inputsVersions[k][l]!=input->getGeneration())
+					return false;
+			}
+			else if(currentCell->inputsVersions[k][l]!=currentCell->actionsVersions[ action.inputActionIdx[l] ])
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	\fn void Pipeline::recordAction(int k, const Region& region)
+	\brief Record the state of the inputs of an action which was just processed in the current cell (see Pipeline::isActionUpToDate).
+	\param k The index of the action.
+	\param region The region of the outputs rendered.
+	**/
+	void Pipeline::recordAction(int k, const Region& region)
+	{
+		const ActionHub& action = actionsList[k];
+
+		currentCell->actionsVersions[k]++;
+		currentCell->renderedRegions[k] = region;
+		currentCell->uniformsVersions[k] = filtersList[action.filterIdx]->getUniformsVersion();
+		currentCell->inputsTextures[k].assign(action.inputBufferIdx.size(), reinterpret_cast<const HdlTexture*>(NULL));
+		currentCell->inputsVersions[k].assign(action.inputBufferIdx.size(), 0);
+
+		for(unsigned int l=0; l<action.inputBufferIdx.size(); l++)
+		{
+			if(action.inputBufferIdx[l]==THIS_PIPELINE)
+			{
+				currentCell->inputsTextures[k][l] = inputsList[ action.inputArgumentIdx[l] ];
+				currentCell->inputsVersions[k][l] = inputsList[ action.inputArgumentIdx[l] ]->getGeneration();
+			}
+			else
+				currentCell->inputsVersions[k][l] = currentCell->actionsVersions[ action.inputActionIdx[l] ];
+		}
+	}
+
+	/**
+	\fn int Pipeline::getNumProcessedActions(void) const
+	\brief Get the number of actions which were processed during the last run (see Pipeline::setActiveOutputs and Pipeline::IncrementalProcessing).
+	\return The number of actions processed.
+	**/
+	int Pipeline::getNumProcessedActions(void) const
+	{
+		return numProcessedActions;
+	}
+
+	/**
+	\fn void Pipeline::invalidate(void)
+	\brief Force all the actions to be processed during the next runs, in all the buffers cells (see Pipeline::IncrementalProcessing). This is needed if the inputs were modified without changing their generation (see HdlTexture::touch).
+	**/
+	void Pipeline::invalidate(void)
+	{
+		for(std::map<int, BuffersCell*>::iterator it=cells.begin(); it!=cells.end(); it++)
+			it->second->actionsVersions.clear();
+	}
+
+	/**
+	\fn const std::string& Pipeline::getFusionReport(void) const
+	\brief Get the report of the fusion of the pointwise filters (see Pipeline::FusePointwiseFilters).
+	\return A string listing the fused chains and, for each rejected candidate, the reason. Empty if the fusion was not requested.
+	**/
+	const std::string& Pipeline::getFusionReport(void) const
+	{
+		return fusionReport;
+	}
+
+	/**
+	\fn void Pipeline::process(void)
+	\brief Apply the pipeline.
+	**/
+	void Pipeline::process(void)
+	{
+		clock_t 	timing 		= 0,
+				totalTiming 	= 0;
+
+		// Frames in flight, move to the next cell of the ring :
+		if(!framesCells.empty())
+		{
+			framesPosition	= (framesPosition + 1) % framesCells.size();
+			currentCell	= cells[ framesCells[framesPosition] ];
+		}
+
+		if(currentCell==NULL)
+			throw Exception("Pipeline::process - No BufferCell was assigned.", __FILE__, __LINE__, Exception::CoreException);
+
+		#ifdef GLIP_USE_GL
+		if(!GLEW_VERSION_3_3 && perfsMonitoring)
+		#else
+		if(perfsMonitoring)
+		#endif
+		{
+			totalTiming = clock();
+			timing = clock();
+		}
+
+		// The halos can depend on the uniform variables, the regions are propagated before each run :
+		if(regionOfInterestEnabled)
+			updateRegions();
+
+		// Only the state changes between consecutive actions will be issued :
+		GLStateCache::beginScope();
+
+		#ifdef GLIP_USE_GL
+		// If the ring is full, the slot about to be reused holds the oldest frame, wait for it :
+		if(GLEW_VERSION_3_3 && perfsMonitoring && pendingFrames[perfsCurrentFrame])
+			collectPerfs(true);
+		#endif
+
+		#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
+			std::cout << "Pipeline::process - Processing : " << getFullName() << std::endl;
+		#endif
+
+		const bool incremental = ((allocationFlags & IncrementalProcessing)!=0);
+
+		if(incremental && currentCell->actionsVersions.size()!=actionsList.size())
+		{
+			currentCell->actionsVersions.assign(actionsList.size(), 0);
+			currentCell->uniformsVersions.assign(actionsList.size(), 0);
+			currentCell->inputsTextures.resize(actionsList.size());
+			currentCell->inputsVersions.resize(actionsList.size());
+			currentCell->renderedRegions.assign(actionsList.size(), Region());
+		}
+
+		if(perfsMonitoring)
+		{
+			#ifdef GLIP_USE_GL
+			if(GLEW_VERSION_3_3)
+				framesActions[perfsCurrentFrame].clear();
+			else
+			#endif
+				perfs.assign(actionsList.size(), 0.0);
+		}
+
+		numProcessedActions = 0;
+
+		// The buffers written by compute filters (image stores) since the last memory barrier :
+		std::vector<bool>	imageWrites(currentCell->buffersList.size(), false);
+		bool			pendingImageWrites = false;
+
+		for(std::vector<int>::const_iterator itAction=activeActions->begin(); itAction!=activeActions->end(); itAction++)
+		{
+			const int	k	= *itAction;
+			ActionHub* 	action 	= &actionsList[k];
+			Filter* 	f 	= filtersList[ action->filterIdx ];
+			HdlFBO* 	t 	= currentCell->buffersList[ action->bufferIdx ];
+
+			// The uniform variables of the fused filters are forwarded first, as they are part of the state of the action :
+			std::map<int, FusionHub>::iterator itFusion = fusionsList.find(action->filterIdx);
+			if(itFusion!=fusionsList.end())
+			{
+				try
+				{
+					forwardUniforms(itFusion->second, *f);
+				}
+				catch(Exception& e)
+				{
+					GLStateCache::endScope();
+					throw;
+				}
+			}
+
+			// Restrict the rendering to the region of interest :
+			const Region region = regionOfInterestEnabled ? actionsRegions[k] : Region(0, 0, f->getWidth(), f->getHeight());
+
+			if(region.width==0)
+				continue;
+
+			f->setRegionForNextRendering(region.x, region.y, region.width, region.height);
+
+			if(incremental && isActionUpToDate(k, region))
+			{
+				#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
+					std::cout << "    skipping filter (up to date) : " << f->getFullName() << std::endl;
+				#endif
+				continue;
+			}
+
+			#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
+				std::cout << "    applying filter : " << f->getFullName() << "..." << std::endl;
+			#endif
+
+			for(int l=0; l<f->getNumInputPort(); l++)
+			{
+				int bufferID 	= action->inputBufferIdx[l];
+				int portID 	= action->inputArgumentIdx[l];
 
 				#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
 					std::cout << "        conecting buffer " << bufferID << " on port " << portID << std::endl;
@@ -1541,11 +2392,31 @@
 				std::cout << "        Processing using buffer " << action->bufferIdx << "..." << std::endl;
 			#endif
 
+			// Make the image stores of the previous compute filters visible, if this action reads or overwrites their results :
+			if(pendingImageWrites)
+			{
+				bool dependent = imageWrites[action->bufferIdx];
+				for(unsigned int l=0; l<action->inputBufferIdx.size() && !dependent; l++)
+					dependent = (action->inputBufferIdx[l]!=THIS_PIPELINE && imageWrites[action->inputBufferIdx[l]]);
+
+				if(dependent)
+				{
+					#ifdef GLIP_USE_GL
+						glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+					#endif
+					imageWrites.assign(imageWrites.size(), false);
+					pendingImageWrites = false;
+				}
+			}
+
 			if(perfsMonitoring)
 			{
 				#ifdef GLIP_USE_GL
 				if(GLEW_VERSION_3_3)
-					glBeginQuery(GL_TIME_ELAPSED, queryObject);
+				{
+					glBeginQuery(GL_TIME_ELAPSED, queryObjects[perfsCurrentFrame*actionsList.size() + k]);
+					framesActions[perfsCurrentFrame].push_back(k);
+				}
 				else
 				#endif
 					timing = clock();
@@ -1553,13 +2424,21 @@
 				//glFlush();
 			}
 
-			if(firstRun)
+			try
 			{
-				try
-				{
-					f->process(*t);
-				}
-				catch(Exception& e)
+				f->process(*t);
+			}
+			catch(Exception& e)
+			{
+				// Close the timer query, the next one could not begin otherwise (the slot of this frame is not submitted) :
+				#ifdef GLIP_USE_GL
+				if(perfsMonitoring && GLEW_VERSION_3_3)
+					glEndQuery(GL_TIME_ELAPSED);
+				#endif
+
+				GLStateCache::endScope();
+
+				if(firstRun)
 				{
 					firstRun	= false;
 					broken 		= true;
@@ -1567,9 +2446,9 @@
 					m << e;
 					throw m;
 				}
+				else
+					throw;
 			}
-			else
-				f->process(*t);
 
 			if(perfsMonitoring)
 			{
@@ -1577,12 +2456,7 @@
 
 				#ifdef GLIP_USE_GL
 				if(GLEW_VERSION_3_3)
-				{
-					GLuint64 querytime;
 					glEndQuery(GL_TIME_ELAPSED);
-					glGetQueryObjectui64v(queryObject, GL_QUERY_RESULT, &querytime);
-					perfs[k] = static_cast<double>(querytime)/1e6;
-				}
 				else
 				#endif
 				{
@@ -1591,19 +2465,50 @@
 				}
 			}
 
+			if(f->isCompute())
+			{
+				imageWrites[action->bufferIdx]	= true;
+				pendingImageWrites		= true;
+			}
+
+			if(incremental)
+				recordAction(k, region);
+			numProcessedActions++;
+
 			#ifdef __GLIPLIB_DEVELOPMENT_VERBOSE__
 				std::cout << "        Done." << std::endl;
 			#endif
 		}
 
+		// The outputs might be read by any mean after the run (texture fetches, transfers, etc.) :
+		#ifdef GLIP_USE_GL
+		if(pendingImageWrites)
+			glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+		#endif
+
+		// Restore the default bindings :
+		GLStateCache::endScope();
+
+		// The results can be read once this fence is signaled :
+		if(!framesCells.empty())
+		{
+			framesCounter++;
+			currentCell->frame = framesCounter;
+			currentCell->fence.insert();
+
+			lastFrame.frame		= framesCounter;
+			lastFrame.cellID	= framesCells[framesPosition];
+		}
+
 		if(perfsMonitoring)
 		{
 			#ifdef GLIP_USE_GL
 			if(GLEW_VERSION_3_3)
 			{
-				totalPerf = 0;
-				for(unsigned int i=0; i<perfs.size(); i++)
-					totalPerf += perfs[i];
+				// The results of this frame will be read later, only grab what is already available :
+				pendingFrames[perfsCurrentFrame] = true;
+				perfsCurrentFrame = (perfsCurrentFrame + 1) % perfsFramesDepth;
+				collectPerfs(false);
 			}
 			else
 			#endif
@@ -1875,6 +2780,14 @@
 		{
 			if(currentCell==it->second)
 				currentCell = NULL;
+
+			std::vector<int>::iterator itRing = std::find(framesCells.begin(), framesCells.end(), cellID);
+			if(itRing!=framesCells.end())
+			{
+				if(std::distance(framesCells.begin(), itRing)<=framesPosition && framesPosition>0)
+					framesPosition--;
+				framesCells.erase(itRing);
+			}
 			
 			delete it->second;
 			it->second = NULL;
@@ -1884,24 +2797,221 @@
 	}
 
 	/**
-	\fn void Pipeline::enablePerfsMonitoring(void)
+	\fn void Pipeline::enableFramesInFlight(int numFrames)
+	\brief Rotate automatically through a ring of buffers cells, with a fence after each run.
+	\param numFrames Number of cells in the ring (the number of runs whose results can be read while the next ones are being processed, at least 1).
+
+	The current cell is the first cell of the ring and the missing cells are created. Each Pipeline::Process renders in the next cell of the ring, which then becomes the current cell (Pipeline::out without cell ID returns the results of the last run). Use Pipeline::getLastFrame to get the token of a run and Pipeline::isFrameReady or Pipeline::waitFrame before reading its results on the CPU. The results of a run are kept until numFrames other runs are processed.
+
+	Calling this function again changes the size of the ring (see Pipeline::disableFramesInFlight).
+	**/
+	void Pipeline::enableFramesInFlight(int numFrames)
+	{
+		if(numFrames<1)
+			throw Exception("Pipeline::enableFramesInFlight - The number of frames must be at least 1 (current : " + toString(numFrames) + ").", __FILE__, __LINE__, Exception::CoreException);
+
+		disableFramesInFlight();
+
+		if(currentCell==NULL)
+			changeTargetBuffersCell(createBuffersCell());
+
+		framesCells.push_back(getCurrentCellID());
+		while(static_cast<int>(framesCells.size())<numFrames)
+			framesCells.push_back(createBuffersCell());
+
+		// The first run will render in the second cell, the current one still holds the results of the previous run :
+		framesPosition = 0;
+	}
+
+	/**
+	\fn void Pipeline::disableFramesInFlight(void)
+	\brief Stop the rotation of the buffers cells. Do nothing if Pipeline::enableFramesInFlight was not called.
+
+	The current cell is kept, the other cells of the ring are removed (their tokens become invalid).
+	**/
+	void Pipeline::disableFramesInFlight(void)
+	{
+		const int currentCellID = getCurrentCellID();
+		const std::vector<int> ring = framesCells;
+
+		framesCells.clear();
+		framesPosition = 0;
+
+		for(std::vector<int>::const_iterator it=ring.begin(); it!=ring.end(); it++)
+		{
+			if(*it!=currentCellID && isBuffersCellValid(*it))
+				removeBuffersCell(*it);
+		}
+	}
+
+	/**
+	\fn int Pipeline::getNumFramesInFlight(void) const
+	\brief Get the number of cells in the ring.
+	\return The number of cells of the ring, 0 if Pipeline::enableFramesInFlight was not called.
+	**/
+	int Pipeline::getNumFramesInFlight(void) const
+	{
+		return framesCells.size();
+	}
+
+	/**
+	\fn Pipeline::FrameToken Pipeline::getLastFrame(void) const
+	\brief Get the token of the last run, in the frames in flight mode.
+	\return The token of the last run, or an invalid token if no run was processed in this mode.
+	**/
+	Pipeline::FrameToken Pipeline::getLastFrame(void) const
+	{
+		return lastFrame;
+	}
+
+	/**
+	\fn bool Pipeline::isFrameValid(const FrameToken& token) const
+	\brief Test if the results of a run are still available.
+	\param token The token of the run.
+	\return True if the cell of the run was not overwritten by a newer run nor removed.
+	**/
+	bool Pipeline::isFrameValid(const FrameToken& token) const
+	{
+		std::map<int, BuffersCell*>::const_iterator it = cells.find(token.cellID);
+
+		return token.frame!=0 && it!=cells.end() && it->second->frame==token.frame;
+	}
+
+	/**
+	\fn bool Pipeline::isFrameReady(const FrameToken& token)
+	\brief Test, without blocking, if the GPU completed a run.
+	\param token The token of the run.
+	\return True if the results of the run can be read without stalling, or raise an exception if the token is not valid anymore.
+	**/
+	bool Pipeline::isFrameReady(const FrameToken& token)
+	{
+		return waitFrame(token, 0.0);
+	}
+
+	/**
+	\fn bool Pipeline::waitFrame(const FrameToken& token, double timeout)
+	\brief Wait for the GPU to complete a run.
+	\param token The token of the run.
+	\param timeout Maximum time to wait, in milliseconds. Negative values wait until the run is completed (default).
+	\return True if the results of the run can be read without stalling, false if the timeout expired first, or raise an exception if the token is not valid anymore.
+	**/
+	bool Pipeline::waitFrame(const FrameToken& token, double timeout)
+	{
+		if(!isFrameValid(token))
+			throw Exception("Pipeline::waitFrame - The frame " + toString(token.frame) + " of the cell " + toString(token.cellID) + " is not available anymore in " + getFullName() + ".", __FILE__, __LINE__, Exception::CoreException);
+
+		return cells[token.cellID]->fence.wait(timeout);
+	}
+
+	/**
+	\fn void Pipeline::collectPerfs(bool waitOldest)
+	\brief Read the results of the timer queries of the pending frames, from the oldest to the most recent one.
+	\param waitOldest If true, block until the results of the oldest pending frame are available. Otherwise, stop at the first frame which is not completed yet.
+	**/
+	void Pipeline::collectPerfs(bool waitOldest)
+	{
+		#ifdef GLIP_USE_GL
+		const int numActions = actionsList.size();
+
+		if(numActions==0 || queryObjects.empty())
+			return ;
+
+		for(int i=0; i<perfsFramesDepth; i++)
+		{
+			// perfsCurrentFrame is the next slot to be written, thus the oldest one :
+			const int frame = (perfsCurrentFrame + i) % perfsFramesDepth;
+
+			if(!pendingFrames[frame])
+				continue;
+
+			const std::vector<int>& executed = framesActions[frame];
+
+			if(!waitOldest && !executed.empty())
+			{
+				// The queries are completed in order, testing the last one of the frame is enough :
+				GLint available = GL_FALSE;
+				glGetQueryObjectiv(queryObjects[frame*numActions + executed.back()], GL_QUERY_RESULT_AVAILABLE, &available);
+
+				#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+					OPENGL_ERROR_TRACKER("Pipeline::collectPerfs", "glGetQueryObjectiv()")
+				#endif
+
+				if(available==GL_FALSE)
+					break;
+			}
+
+			// The actions which were not executed (see Pipeline::setActiveOutputs) report a null time :
+			perfs.assign(numActions, 0.0);
+			totalPerf = 0.0;
+			for(std::vector<int>::const_iterator it=executed.begin(); it!=executed.end(); it++)
+			{
+				const int k = *it;
+				GLuint64 querytime = 0;
+				glGetQueryObjectui64v(queryObjects[frame*numActions + k], GL_QUERY_RESULT, &querytime);
+				perfs[k] = static_cast<double>(querytime)/1e6;
+				totalPerf += perfs[k];
+			}
+
+			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+				OPENGL_ERROR_TRACKER("Pipeline::collectPerfs", "glGetQueryObjectui64v()")
+			#endif
+
+			pendingFrames[frame] = false;
+			waitOldest = false; // Only the oldest can be waited for.
+		}
+		#else
+			UNUSED_PARAMETER(waitOldest)
+		#endif
+	}
+
+	/**
+	\fn void Pipeline::releaseQueries(void)
+	\brief Release the timer queries of the ring.
+	**/
+	void Pipeline::releaseQueries(void)
+	{
+		#ifdef GLIP_USE_GL
+		if(!queryObjects.empty())
+			glDeleteQueries(queryObjects.size(), &queryObjects[0]);
+		#endif
+
+		queryObjects.clear();
+		pendingFrames.clear();
+		perfsFramesDepth = 0;
+		perfsCurrentFrame = 0;
+	}
+
+	/**
+	\fn void Pipeline::enablePerfsMonitoring(int numFrames)
 	\brief Enable performances monitoring.
+	\param numFrames Depth of the ring of timer queries (number of frames which can be in flight before the results of the oldest one are required, at least 1).
 
 	Any following process on this instance will record time to perform the pipeline (time per element and total time). Calling this function twice will not reset previous results.
+
+	When timer queries are available (OpenGL 3.3), the GPU time of each action is measured without stalling : the results of a frame are collected during the following calls to Pipeline::process, once the GPU has completed it. Pipeline::getTiming and Pipeline::getTotalTiming then report the latest completed frame, which lags by up to numFrames runs. The CPU only waits if numFrames runs are still in flight.
 	**/
-	void Pipeline::enablePerfsMonitoring(void)
+	void Pipeline::enablePerfsMonitoring(int numFrames)
 	{
+		if(numFrames<1)
+			throw Exception("Pipeline::enablePerfsMonitoring - The number of frames must be at least 1 (current : " + toString(numFrames) + ").", __FILE__, __LINE__, Exception::CoreException);
+
 		if(!perfsMonitoring)
 		{
 			perfsMonitoring = true;
-			perfs.assign(filtersList.size(),0.0f);
+			perfs.assign(actionsList.size(),0.0f);
 			totalPerf = 0.0f;
 
 			#ifdef GLIP_USE_GL
 			if(GLEW_VERSION_3_3)
 			{
-				if(queryObject==0)
-					glGenQueries(1, &queryObject);
+				perfsFramesDepth	= numFrames;
+				perfsCurrentFrame	= 0;
+				queryObjects.assign(numFrames*actionsList.size(), 0);
+				pendingFrames.assign(numFrames, false);
+				framesActions.assign(numFrames, std::vector<int>());
+
+				if(!queryObjects.empty())
+					glGenQueries(queryObjects.size(), &queryObjects[0]);
 			}
 			#endif
 		}
@@ -1911,7 +3021,7 @@
 	\fn void Pipeline::disablePerfsMonitoring(void)
 	\brief Disable performances monitoring.
 
-	Stops a monitoring session on this instance. Do nothing if no session was started.
+	Stops a monitoring session on this instance. Do nothing if no session was started. The results of the frames still in flight are discarded.
 	**/
 	void Pipeline::disablePerfsMonitoring(void)
 	{
@@ -1920,6 +3030,7 @@
 			perfsMonitoring = false;
 			perfs.clear();
 			totalPerf = 0.0;
+			releaseQueries();
 		}
 	}
 
@@ -1927,12 +3038,27 @@
 	\fn double Pipeline::getTiming(int filterID)
 	\brief Get last result of performance monitoring IF it is still enabled.
 	\param filterID The ID of the filter.
-	\return Time in milliseconds needed to apply the filter (not counting binding operation).
+	\return Time in milliseconds needed to apply the filter (not counting binding operation), for the latest completed frame.
 	**/
 	double Pipeline::getTiming(int filterID)
 	{
 		if(perfsMonitoring)
-			return perfs[ filtersGlobalIDsList[filterID] ];
+		{
+			std::map<int, int>::const_iterator it = filtersGlobalIDsList.find(filterID);
+
+			if(it==filtersGlobalIDsList.end())
+				throw Exception("Pipeline::getTiming - Filter ID " + toString(filterID) + " is not valid.", __FILE__, __LINE__, Exception::CoreException);
+
+			// The timings are stored per action (the filters replaced by a fusion report the time of the fused filter) :
+			const int fIdx = (fusedInto[it->second]>=0) ? fusedInto[it->second] : it->second;
+			for(unsigned int k=0; k<actionsList.size(); k++)
+			{
+				if(actionsList[k].filterIdx==fIdx)
+					return perfs[k];
+			}
+
+			throw Exception("Pipeline::getTiming - No action is associated to the filter ID " + toString(filterID) + ".", __FILE__, __LINE__, Exception::CoreException);
+		}
 		else
 			throw Exception("Pipeline::getTiming - Monitoring is disabled.", __FILE__, __LINE__, Exception::CoreException);
 	}
@@ -1942,7 +3068,7 @@
 	\brief Get last result of performance monitoring IF it is still enabled.
 	\param action The ID of the filter.
 	\param filterName A reference string that will contain the name of the filter indexed by action at the end of the function.
-	\return Time in milliseconds needed to apply the filter (not counting binding operation).
+	\return Time in milliseconds needed to apply the filter (not counting binding operation), for the latest completed frame.
 	**/
 	double Pipeline::getTiming(int action, std::string& filterName)
 	{
@@ -1964,7 +3090,7 @@
 	/**
 	\fn double Pipeline::getTotalTiming(void)
 	\brief Get total time elapsed for last run.
-	\return Time in milliseconds needed to apply the whole pipeline (counting everything and flushing after each filter).
+	\return Time in milliseconds needed to apply the whole pipeline, for the latest completed frame (sum of the GPU time of each action when timer queries are available, CPU time otherwise).
 	**/
 	double Pipeline::getTotalTiming(void)
 	{
@@ -66,6 +66,8 @@ using namespace Glip::CoreGL;
 		uniformVars(ss.uniformVars),
 		uniformVarsType(ss.uniformVarsType),
 		outFragments(ss.outFragments),
+		inImages2D(ss.inImages2D),
+		outImages2D(ss.outImages2D),
 		compatibilityRequest(ss.compatibilityRequest),
 		versionNumber(ss.versionNumber),
 		startLine(ss.startLine),
@@ -287,6 +289,11 @@ using namespace Glip::CoreGL;
 		//else if(str	== "sampler2DRect")	typeCode = GL_SAMPLER_2D;
 		//else if(str	== "usampler2DRect")	typeCode = GL_SAMPLER_2D;
 		//else if(str	== "isampler2DRect")	typeCode = GL_SAMPLER_2D;
+		#ifdef GLIP_USE_GL
+		else if(str	== "image2D")			typeCode = GL_IMAGE_2D;
+		else if(str	== "iimage2D")			typeCode = GL_IMAGE_2D;
+		else if(str	== "uimage2D")			typeCode = GL_IMAGE_2D;
+		#endif
 		else if(str	== "unsigned" && cpl=="int")	typeCode = GL_UNSIGNED_INT;
  		else
 			throw Exception("ShaderSource::parseUniformLine - Unknown or unsupported uniform type \"" + str + "\".", __FILE__, __LINE__, Exception::GLException);
@@ -338,6 +345,8 @@ using namespace Glip::CoreGL;
 		uniformVars.clear();
 		uniformVarsType.clear();
 		outFragments.clear();
+		inImages2D.clear();
+		outImages2D.clear();
 
 		// Parse the lines :
 		parseLines();
@@ -365,7 +374,8 @@ using namespace Glip::CoreGL;
 			previousWasUniform 	= false,
 			previousWasOut		= false,
 			readingVarNames		= false,
-			waitComa		= false;
+			waitComa		= false,
+			readOnly		= false;
 		GLenum typeCode;
 		for(unsigned int k=0; k<split.size(); k++)
 		{
@@ -376,7 +386,10 @@ using namespace Glip::CoreGL;
 				previousWasOut		= false;
 				readingVarNames		= false;
 				waitComa		= false;
+				readOnly		= false;
 			}
+			else if(split[k]=="readonly" || split[k]=="writeonly" || split[k]=="coherent" || split[k]=="volatile" || split[k]=="restrict")
+				readOnly = readOnly || (split[k]=="readonly"); // Memory qualifiers of the images.
 			else if(split[k]=="=")
 				waitComa=true;
 			else if(split[k]==",")
@@ -399,13 +412,19 @@ using namespace Glip::CoreGL;
 			}
 			else if(!waitComa && previousWasUniform && readingVarNames)
 			{
-				if(typeCode != GL_SAMPLER_2D)
+				if(typeCode == GL_SAMPLER_2D)
+					inSamplers2D.push_back(split[k]);
+				#ifdef GLIP_USE_GL
+				else if(typeCode == GL_IMAGE_2D && readOnly)
+					inImages2D.push_back(split[k]);
+				else if(typeCode == GL_IMAGE_2D)
+					outImages2D.push_back(split[k]);
+				#endif
+				else
 				{
 					uniformVars.push_back(split[k]);
 					uniformVarsType.push_back(typeCode);
 				}
-				else
-					inSamplers2D.push_back(split[k]);
 			}
 			else if(previousWasOut && !readingVarNames && k<(split.size()-1))
 			{
@@ -447,6 +466,8 @@ using namespace Glip::CoreGL;
 		uniformVars 		= c.uniformVars;
 		uniformVarsType 	= c.uniformVarsType;
 		outFragments 		= c.outFragments;
+		inImages2D		= c.inImages2D;
+		outImages2D		= c.outImages2D;
 		compatibilityRequest 	= c.compatibilityRequest;
 		versionNumber 		= c.versionNumber;
 		startLine		= c.startLine;
@@ -699,3 +720,23 @@ using namespace Glip::CoreGL;
 		return uniformVarsType;
 	}
 
+	/**
+	\fn const std::vector<std::string>& ShaderSource::getInputImages(void) const
+	\brief Return a vector containing the name of all the input images (uniform readonly image2D, iimage2D or uimage2D).
+	\return A vector of standard string.
+	**/
+	const std::vector<std::string>& ShaderSource::getInputImages(void) const
+	{
+		return inImages2D;
+	}
+
+	/**
+	\fn const std::vector<std::string>& ShaderSource::getOutputImages(void) const
+	\brief Return a vector containing the name of all the output images (uniform image2D, iimage2D or uimage2D not declared readonly).
+	\return A vector of standard string.
+	**/
+	const std::vector<std::string>& ShaderSource::getOutputImages(void) const
+	{
+		return outImages2D;
+	}
+
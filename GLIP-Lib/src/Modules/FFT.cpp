@@ -23,6 +23,7 @@
 
 	// Includes
 	#include <cmath>
+	#include <algorithm>
 	#include "Core/Exception.hpp"
 	#include "Modules/FFT.hpp"
 	#include "devDebugTools.hpp"
@@ -58,11 +59,322 @@ namespace Glip
 				TEST("ZeroPadding",		"ZERO_PADDING",		ZeroPadding);
 				TEST("CompatibilityMode",	"COMPATIBILITY_MODE",	CompatibilityMode);
 				TEST("NoInput",			"NO_INPUT",		NoInput);
+				TEST("Radix2",			"RADIX_2",		Radix2);
+				TEST("Radix4",			"RADIX_4",		Radix4);
+				TEST("Radix8",			"RADIX_8",		Radix8);
+				TEST("RealInput",		"REAL_INPUT",		RealInput);
+				TEST("RealOutput",		"REAL_OUTPUT",		RealOutput);
+				TEST("Batched",			"BATCHED",		Batched);
+				TEST("TwiddleTexture",		"TWIDDLE_TEXTURE",	TwiddleTexture);
+				TEST("DoublePrecision",		"DOUBLE_PRECISION",	DoublePrecision);
 
 				#undef TEST
 		
 				throw Exception("GenerateFFT1DPipeline::getFlag - Unknown flag name : \"" + str + "\".", __FILE__, __LINE__, Exception::ModuleException);
 			}
+
+			/**
+			\fn Glip::Modules::FFTModules::Pass::Pass(const std::string& _name, PassKind _kind, int _radix, int _span, int _length, int _width, int _height, bool _horizontal)
+			\brief Pass constructor.
+			\param _name Name of the filter performing the pass.
+			\param _kind Kind of pass.
+			\param _radix Number of values gathered for each output texel.
+			\param _span Size of the sub-transforms computed by the previous passes.
+			\param _length Size of the transform.
+			\param _width Width of the output texture.
+			\param _height Height of the output texture.
+			\param _horizontal True if the pass transforms the rows.
+			**/
+			Pass::Pass(const std::string& _name, PassKind _kind, int _radix, int _span, int _length, int _width, int _height, bool _horizontal)
+			 :	name(_name),
+				kind(_kind),
+				horizontal(_horizontal),
+				radix(_radix),
+				span(_span),
+				length(_length),
+				width(_width),
+				height(_height)
+			{ }
+
+			/**
+			\fn bool Glip::Modules::FFTModules::isMixedRadixSize(int size)
+			\brief Test if a transform can be split in radix-2, radix-3, radix-5 and radix-7 passes.
+			\param size Size of the transform.
+			\return True if the size only has the prime factors 2, 3, 5 and 7.
+			**/
+			bool isMixedRadixSize(int size)
+			{
+				if(size<2)
+					return false;
+
+				const int primes[] = {2, 3, 5, 7};
+				for(int k=0; k<4; k++)
+				{
+					while(size%primes[k]==0)
+						size /= primes[k];
+				}
+
+				return (size==1);
+			}
+
+			/**
+			\fn std::vector<int> Glip::Modules::FFTModules::getRadices(int size, int flags)
+			\brief Get the radices of the passes used for a transform along one dimension.
+			\param size Size of the transform (its prime factors must be 2, 3, 5 or 7).
+			\param flags Flags of the transform (see Glip::Modules::FFTModules::Flag).
+			\return The radix of each pass, in the order of the passes.
+
+			The power of 2 part of the size is split according to the flags Radix2, Radix4 or Radix8. Without any of these flags, the decomposition with the fewest passes is chosen, and the smallest radices among them (for instance 4x4 instead of 8x2). The other factors get a radix-3, radix-5 or radix-7 pass each.
+			**/
+			std::vector<int> getRadices(int size, int flags)
+			{
+				const int radixFlags = flags & (Radix2 | Radix4 | Radix8);
+
+				if(radixFlags!=0 && radixFlags!=Radix2 && radixFlags!=Radix4 && radixFlags!=Radix8)
+					throw Exception("FFTModules::getRadices - Only one of the flags Radix2, Radix4 and Radix8 can be used.", __FILE__, __LINE__, Exception::ModuleException);
+
+				if(!isMixedRadixSize(size))
+					throw Exception("FFTModules::getRadices - Size must only have the prime factors 2, 3, 5 and 7 (current size : " + toString(size) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+				int levels = 0,
+				    remainder = size;
+				for(; remainder%2==0; remainder/=2)
+					levels++;
+
+				if(radixFlags==Radix2 && remainder!=1)
+					throw Exception("FFTModules::getRadices - Size must be a power of 2 with the flag Radix2 (current size : " + toString(size) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+				// The leftover radix goes first :
+				std::vector<int> radices;
+				if(radixFlags==Radix2)
+					radices.assign(levels, 2);
+				else if(radixFlags==Radix4)
+				{
+					if(levels%2==1)
+						radices.push_back(2);
+					radices.insert(radices.end(), levels/2, 4);
+				}
+				else if(radixFlags==Radix8 || levels%3!=1 || levels<4)
+				{
+					if(levels%3==1)
+						radices.push_back(2);
+					else if(levels%3==2)
+						radices.push_back(4);
+					radices.insert(radices.end(), levels/3, 8);
+				}
+				else // Automatic, trade one radix-8 and one radix-2 passes for two radix-4 passes :
+				{
+					radices.push_back(4);
+					radices.push_back(4);
+					radices.insert(radices.end(), (levels-4)/3, 8);
+				}
+
+				// Odd factors :
+				const int primes[] = {3, 5, 7};
+				for(int k=0; k<3; k++)
+				{
+					for(; remainder%primes[k]==0; remainder/=primes[k])
+						radices.push_back(primes[k]);
+				}
+
+				return radices;
+			}
+
+			/**
+			\fn int Glip::Modules::FFTModules::getBluesteinLength(int size, int flags)
+			\brief Get the size of the transforms used by the Bluestein algorithm.
+			\param size Size of the signal.
+			\param flags Flags of the transform (see Glip::Modules::FFTModules::Flag).
+			\return The size of the transforms used to compute the convolution or 0 if the size can be split in radix-2, radix-3, radix-5 and radix-7 passes (see isMixedRadixSize).
+
+			The Bluestein algorithm computes the transform of a signal of any size as a convolution with a chirp, the convolution is computed with transforms of size at least 2*size-1. Among these sizes (up to the next power of 2), the one with the lowest number of values gathered by all its passes is chosen.
+			**/
+			int getBluesteinLength(int size, int flags)
+			{
+				if(size<2)
+					throw Exception("FFTModules::getBluesteinLength - Size must be at least 2 (current size : " + toString(size) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+				if(isMixedRadixSize(size))
+					return 0;
+
+				const int minimum = 2*size-1;
+				int maximum = 1;
+				while(maximum<minimum)
+					maximum *= 2;
+
+				int 	length = maximum;
+				long	lowestCost = -1;
+				for(int l=((flags & Radix2)!=0) ? maximum : minimum; l<=maximum; l++)
+				{
+					if(!isMixedRadixSize(l))
+						continue;
+
+					const std::vector<int> radices = getRadices(l, flags);
+					long cost = 0;
+					for(std::vector<int>::const_iterator it=radices.begin(); it!=radices.end(); it++)
+						cost += static_cast<long>(l) * (*it);
+
+					if(lowestCost<0 || cost<lowestCost)
+					{
+						length = l;
+						lowestCost = cost;
+					}
+				}
+
+				return length;
+			}
+
+			/**
+			\fn std::vector<Pass> Glip::Modules::FFTModules::getPasses(int size, int flags)
+			\brief Get the passes of a transform along one dimension.
+			\param size Size of the signal.
+			\param flags Flags of the transform (see Glip::Modules::FFTModules::Flag).
+			\return The passes of the transform, as a single row.
+
+			If the size can be split in radix-2, radix-3, radix-5 and radix-7 passes, these are returned (see getRadices). Otherwise, the passes of the Bluestein algorithm are returned : the transform of the chirp filter first, then the transform of the modulated signal and finally the reciprocal transform of their product. The names of the passes are suffixes, completed by GenerateFFT1DPipeline::getPlan and GenerateFFT2DPipeline::getPlan.
+			**/
+			std::vector<Pass> getPasses(int size, int flags)
+			{
+				std::vector<Pass> passes;
+				const int length = getBluesteinLength(size, flags);
+
+				if(length==0)
+				{
+					const std::vector<int> radices = getRadices(size, flags);
+					int span = 1;
+					for(unsigned int k=0; k<radices.size(); k++)
+					{
+						passes.push_back(Pass(toString(k) + "Radix" + toString(radices[k]), MixedRadix, radices[k], span, size, size, 1));
+						span *= radices[k];
+					}
+				}
+				else
+				{
+					const std::vector<int> radices = getRadices(length, flags);
+					const PassKind kinds[] = {BluesteinChirp, BluesteinSignal, BluesteinConvolution};
+					const std::string names[] = {"Chirp", "Signal", "Convolution"};
+
+					for(int s=0; s<3; s++)
+					{
+						int span = 1;
+						for(unsigned int k=0; k<radices.size(); k++)
+						{
+							// The last pass of the convolution only keeps the first 'size' values :
+							const bool last = (kinds[s]==BluesteinConvolution) && (k+1)==radices.size();
+							passes.push_back(Pass(names[s] + toString(k) + "Radix" + toString(radices[k]), kinds[s], radices[k], span, length, last ? size : length, 1));
+							span *= radices[k];
+						}
+					}
+				}
+
+				return passes;
+			}
+
+			/**
+			\fn std::string Glip::Modules::FFTModules::getPlanDescription(const std::vector<Pass>& plan)
+			\brief Describe the passes of a transform.
+			\param plan The passes of the transform (see GenerateFFT1DPipeline::getPlan and GenerateFFT2DPipeline::getPlan).
+			\return A description of each pass (kind, radix and output size) and the total number of values gathered, which gives an estimate of the cost of the transform.
+			**/
+			std::string getPlanDescription(const std::vector<Pass>& plan)
+			{
+				std::string str;
+				long 	numTexels = 0,
+					numValues = 0;
+
+				for(std::vector<Pass>::const_iterator it=plan.begin(); it!=plan.end(); it++)
+				{
+					std::string kind;
+					switch(it->kind)
+					{
+						case Radix2Butterfly :		kind = "radix-2 butterflies";	break;
+						case Radix2Shuffle :		kind = "bit reversal";		break;
+						case MixedRadix :		kind = "mixed radix";		break;
+						case Unpack :			kind = "half-spectrum";		break;
+						case BluesteinChirp :		kind = "Bluestein chirp";	break;
+						case BluesteinSignal :		kind = "Bluestein signal";	break;
+						case BluesteinConvolution :	kind = "Bluestein convolution";	break;
+						default :
+							throw Exception("FFTModules::getPlanDescription - Unknown pass kind (" + toString(it->kind) + ").", __FILE__, __LINE__, Exception::ModuleException);
+					}
+
+					str += it->name + " : " + kind + ", radix " + toString(it->radix) + ", length " + toString(it->length) + (it->horizontal ? " (rows)" : " (columns)") + ", output " + toString(it->width) + "x" + toString(it->height) + ".\n";
+					numTexels += static_cast<long>(it->width) * it->height;
+					numValues += static_cast<long>(it->width) * it->height * it->radix;
+				}
+
+				str += "Total : " + toString(plan.size()) + " passes, " + toString(numTexels) + " texels written, " + toString(numValues) + " values gathered.\n";
+				return str;
+			}
+
+			/**
+			\fn std::vector<int> Glip::Modules::FFTModules::getTwiddleOrders(int size, int flags)
+			\brief Get the orders of the roots of unity used by the twiddle factors of a transform along one dimension.
+			\param size Size of the signal (the full width of the real signal with the flags RealInput and RealOutput).
+			\param flags Flags of the transform (see Glip::Modules::FFTModules::Flag).
+			\return Three orders, one per row of the twiddle table (see getTwiddleTable) : the butterflies (size of the transform), the packing of the real signals (0 without the flags RealInput and RealOutput) and the Bluestein chirp (0 if the Bluestein algorithm is not used).
+			**/
+			std::vector<int> getTwiddleOrders(int size, int flags)
+			{
+				const bool	real = (flags & (RealInput | RealOutput))!=0;
+				const int	complexSize = real ? size/2 : size,
+						length = getBluesteinLength(complexSize, flags);
+
+				std::vector<int> orders;
+				orders.push_back((length==0) ? complexSize : length);
+				orders.push_back(real ? size : 0);
+				orders.push_back((length==0) ? 0 : (2*complexSize));
+				return orders;
+			}
+
+			/**
+			\fn std::vector<float> Glip::Modules::FFTModules::getTwiddleTable(const std::vector<int>& orders)
+			\brief Compute a table of twiddle factors.
+			\param orders Order of the roots of unity of each row of the table (see getTwiddleOrders).
+			\return The content of a texture in the GL_RGBA32F format, with one row per order and as many columns as the largest order.
+
+			The texel k of the row of order N holds exp(-2i*pi*k/N), computed in double precision : the red and green channels contain the real and imaginary parts rounded to single precision and the blue and alpha channels contain the rounding errors (used with the flag DoublePrecision).
+			**/
+			std::vector<float> getTwiddleTable(const std::vector<int>& orders)
+			{
+				int width = 1;
+				for(std::vector<int>::const_iterator it=orders.begin(); it!=orders.end(); it++)
+					width = std::max(width, *it);
+
+				const double twoPi = 6.283185307179586476925286766559;
+				std::vector<float> table(4*width*orders.size(), 0.0f);
+
+				for(unsigned int r=0; r<orders.size(); r++)
+				{
+					for(int k=0; k<orders[r]; k++)
+					{
+						const double	c = std::cos(-twoPi*k/orders[r]),
+								s = std::sin(-twoPi*k/orders[r]);
+						float* t = &table[4*(r*width+k)];
+
+						t[0] = static_cast<float>(c);
+						t[1] = static_cast<float>(s);
+						t[2] = static_cast<float>(c - t[0]);
+						t[3] = static_cast<float>(s - t[1]);
+					}
+				}
+
+				return table;
+			}
+
+			/**
+			\fn bool Glip::Modules::FFTModules::isDoublePrecisionAvailable(void)
+			\brief Test if the transforms can be computed with the flag DoublePrecision.
+			\return True if the double precision arithmetic is available in the shaders (OpenGL 4.0 or GL_ARB_gpu_shader_fp64).
+			**/
+			bool isDoublePrecisionAvailable(void)
+			{
+				#if defined(GLIP_USE_GL)
+					return GLEW_VERSION_4_0 || GLEW_ARB_gpu_shader_fp64;
+				#else
+					return false;
+				#endif
+			}
 		}
 	}
 }
@@ -79,10 +391,10 @@ namespace Glip
 					"DESCRIPTION{Generate the 1D FFT Pipeline transformation.}"
 					"ARGUMENT:width{Width, can be either a numeral or the name of an existing format.}"
 					"ARGUMENT:name{Name of the new pipeline.}"
-					"ARGUMENT:options...{Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT.}"
+					"ARGUMENT:options...{Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT, RADIX_2, RADIX_4, RADIX_8, REAL_INPUT, REAL_OUTPUT, BATCHED, TWIDDLE_TEXTURE, DOUBLE_PRECISION.}"
 					"BODY_DESCRIPTION{PRE{...} block contains a filtering function to be applied before the FFT. It must define a function vec4 pre(in vec4 colorFromTexture, in float x). POST{...} block contains a filtering function to be applied after the FFT. It must implement a function vec4 post(in vec4 colorAfterFFT, in float x). Both of these block can declare their own uniform variables.}",
 					2,
-					7, //2 base + 5 arguments
+					12, //2 base + 10 arguments (a single radix flag and a single real flag)
 					0)
 	{ }
 
@@ -96,6 +408,16 @@ namespace Glip
 		return "outputTexture";
 	}
 
+	const std::string GenerateFFT1DPipeline::getChirpPortName(void)
+	{
+		return "chirpTexture";
+	}
+
+	const std::string GenerateFFT1DPipeline::getTwiddlePortName(void)
+	{
+		return "twiddleTexture";
+	}
+
 	ShaderSource GenerateFFT1DPipeline::generateRadix2Code(int width, int currentLevel, int flags, const ShaderSource& pre)
 	{
 		// with		: the width of the texture.
@@ -306,418 +628,1551 @@ namespace Glip
 		return ShaderSource(str, "<GenerateFFT1DPipeline::generate(" + toString(width) +")>", 1, linesInfo);
 	}
 
-	/**
-	\fn PipelineLayout GenerateFFT1DPipeline::generate(int width, int flags, const std::string& pre, const std::string& post)
-	\brief Construct a pipeline performing a 1D FFT.
-	\param width Width of the signal.
-	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
-	\param pre Add a filtering function before the transform.
-	\param post Add a filtering function after the transform.
-	\return A complete pipeline layout.
-
-	The <b>pre-function</b> will be inserted before the transform. It should be a block of code declaring the function <i>pre</i> as in the following example : 
-	\code
-	vec4 pre(in vec4 colorFromTexture, in float x)
-	{
-		return modifiedColor;
-	}
-	\endcode
-
-	The <b>post-function</b> will be inserted after the transform. It should be a block of code declaring the function <i>post</i> as in the following example : 
-	\code
-	vec4 post(in vec4 colorAfterFFT, in float x)
+	ShaderSource GenerateFFT1DPipeline::generateMixedRadixCode(int width, const FFTModules::Pass& pass, int flags, const ShaderSource& pre, const ShaderSource& post)
 	{
-		return modifiedColor;
-	}
-	\endcode
+		// width	: the width of the signal.
+		// pass.radix	: the radix of the current pass.
+		// pass.span	: the size of the sub-transforms already computed by the previous passes (1 for the first pass).
+		// pass.length	: the size of the transform.
 
-	Each time, the position is normalized from 0.0 to 1.0. You are allowed to declare uniform variables in these filters.
-	**/
-	PipelineLayout GenerateFFT1DPipeline::generate(int width, int flags, const ShaderSource& pre, const ShaderSource& post)
-	{
-		double 	test1 = std::log(width)/std::log(2),
-			test2 = std::floor(test1);
+		// Stockham formulation, each output o gathers 'radix' values from the previous pass :
+		// t = o % (span*radix), j = (o/(span*radix))*span + o % span
+		// out[o] = sum_{m=0}^{radix-1} in[j + m*n/radix] * exp(-2i*pi*m*t/(span*radix))
+		// The results are in natural order after the last pass.
 
-		if(test1!=test2)
-			throw Exception("Size must be a power of 2 (current size : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
-		if(width<4)
-			throw Exception("Size must be at least 4 (current size : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
+		// With RealInput, the even and odd samples are packed in a complex signal of size n = width/2 by the first pass (see generateUnpackCode for the last step).
+		// With RealOutput, the first pass packs the half-spectrum and the last pass interleaves the real and imaginary parts of the result.
 
-		if((flags & NoInput)!=0 && pre.empty())
-			throw Exception("A PRE-function must be provided when using the flag NoInput.", __FILE__, __LINE__, Exception::ModuleException);
+		// Bluestein algorithm, for a signal of size ns which cannot be split in radix-2, 3, 5 and 7 passes, with the chirp c[k] = exp(-i*pi*k^2/ns) :
+		// X[k] = c[k] * sum_x (x[x]*c[x]) * c*[k-x], the convolution is computed with transforms of size n >= 2*ns-1 :
+		// the chirp filter b (b[x] = c*[x] for x<ns and c*[n-x] for x>n-ns, 0 otherwise) and the modulated signal x[x]*c[x] are transformed,
+		// their product is transformed back (as FFT(P*)*/n) and the last pass demodulates the first ns values.
 
-		if(!pre.getOutputVars().empty() && !pre.requiresCompatibility())
-			throw Exception("A PRE-function cannot have an output (its own output port(s)).", __FILE__, __LINE__, Exception::ModuleException);
+		// With Batched, the complex values are vec4 holding two signals (red-green and blue-alpha), each value is multiplied by the twiddle factors with 'mul'.
 
-		HdlTextureFormat format(width, 1, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
-		HdlTextureFormat halfFormat(width/2, 1, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
-		PipelineLayout pipelineLayout("FFT1D" + toString(width) + "Pipeline");
+		// All the twiddle factors are roots of unity exp(-2i*pi*k/order), given by 'twiddle' : computed in the shader or read from the table (see FFTModules::getTwiddleOrders for the rows).
+		// With DoublePrecision, the sum of each pass is accumulated in double precision and the factors are completed with the residuals of the table.
 
-		if((flags & NoInput)==0)
-			pipelineLayout.addInput(getInputPortName());
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
 
-		pipelineLayout.addOutput(getOutputPortName());
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+		const bool	realInput = (flags & RealInput)!=0,
+				realOutput = (flags & RealOutput)!=0,
+				chirp = (pass.kind==BluesteinChirp),
+				bluestein = chirp || (pass.kind==BluesteinSignal) || (pass.kind==BluesteinConvolution),
+				batched = (flags & Batched)!=0 && !chirp, // The chirp filter is a single signal.
+				twiddleTexture = (flags & TwiddleTexture)!=0,
+				doublePrecision = (flags & DoublePrecision)!=0;
+		const int	size = (realInput || realOutput) ? width/2 : width;
+		const std::string	type = batched ? "vec4" : "vec2",
+					channels = batched ? "" : ".rg",
+					conjugate = batched ? "vec4(1.0, -1.0, 1.0, -1.0)" : "vec2(1.0, -1.0)",
+					accumulator = doublePrecision ? (batched ? "dvec4" : "dvec2") : type;
+		const bool	first = (pass.kind==MixedRadix || pass.kind==BluesteinSignal) && (pass.span==1),
+				lastInDirection = (pass.kind==MixedRadix || pass.kind==BluesteinConvolution) && (pass.span*pass.radix==pass.length),
+				last = lastInDirection && !realInput;
+
+		if(doublePrecision)
+		{
+			str += "#version 150 \n";												PUSH_LINE_INFO
+			str += "#extension GL_ARB_gpu_shader_fp64 : require \n";								PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "#version 130 \n";												PUSH_LINE_INFO
+		}
 
-		std::string 	previousName = "",
-				firstFilterName = "";
+		str += "const float twoPi = 6.28318530718; \n";											PUSH_LINE_INFO
+		str += "const int w = " + toString(width) + ", \n";										PUSH_LINE_INFO
+		str += "          ns = " + toString(size) + ", \n";										PUSH_LINE_INFO
+		str += "          n = " + toString(pass.length) + "; \n";									PUSH_LINE_INFO
 
-		for(int l=width; l>1; l/=2)
+		if(!(chirp && pass.span==1) && (!first || (flags & NoInput)==0)) // Not First pass or has an input
 		{
-			ShaderSource shader = generateRadix2Code(width, l, flags, pre);
-			std::string name = "Filter"+ toString(l);
-			FilterLayout filterLayout(name, halfFormat, shader);
-			pipelineLayout.add(filterLayout,name);
+			str += "uniform sampler2D " + getInputPortName() + "; \n";								PUSH_LINE_INFO
+		}
 
-			if(previousName.empty()) // First element
-			{
-				if((flags & NoInput)==0)
-					pipelineLayout.connectToInput(getInputPortName(), name, getInputPortName());
+		if(pass.kind==BluesteinConvolution && pass.span==1)
+		{
+			str += "uniform sampler2D " + getChirpPortName() + "; \n";								PUSH_LINE_INFO
+		}
 
-				if(!pre.empty())
-				{
-					// Add the ports declared in PRE :
-					for(std::vector<std::string>::const_iterator it=pre.getInputVars().begin(); it!=pre.getInputVars().end(); it++)
-					{
-						if((*it)==getInputPortName() && (flags & NoInput)==0)
-							throw Exception("The PRE function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
-						else
-						{
-							pipelineLayout.addInput(*it);
-							pipelineLayout.connectToInput(*it, name, *it);
-						}
-					}
-				}
+		if(twiddleTexture)
+		{
+			str += "uniform sampler2D " + getTwiddlePortName() + "; \n";								PUSH_LINE_INFO
+		}
 
-				firstFilterName = name;
-			}
-			else
-				pipelineLayout.connect(previousName, getOutputPortName(), name, getInputPortName());
-			
-			previousName = name;
+		if((flags & CompatibilityMode)==0)
+		{
+			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "vec4 " + getOutputPortName() + "; \n";										PUSH_LINE_INFO
 		}
 
-		// Last : 
-		const std::string shuffleFilterName = "FilterShuffle";
-		ShaderSource shader = generateLastShuffleCode(width, flags, post);
-		FilterLayout filterLayout(shuffleFilterName, format, shader);
-		pipelineLayout.add(filterLayout,shuffleFilterName);
-		pipelineLayout.connect(previousName, getOutputPortName(), shuffleFilterName, getInputPortName());
-		
-		// Add the ports declared in post : 
-		if(!post.empty())
+		if(first && !pre.empty())
 		{
-			for(std::vector<std::string>::const_iterator it=post.getInputVars().begin(); it!=post.getInputVars().end(); it++)
-			{
-				if((*it)==getInputPortName() && (flags & NoInput)==0)
-					throw Exception("The POST function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
-				else
-				{
-					pipelineLayout.addInput(*it);
-					pipelineLayout.connectToInput(*it, shuffleFilterName, *it);
-				}
-			}
+			str += pre.getSource();
+			for(int k=0; k<pre.getNumLines(); k++)
+				linesInfo[lineCounter+k] = pre.getLineInfo(k+1);
 
-			for(std::vector<std::string>::const_iterator it=post.getOutputVars().begin(); it!=post.getOutputVars().end(); it++)
-			{
-				if((*it)==getOutputPortName() && !post.requiresCompatibility())
-					throw Exception("The POST function cannot declare the output port \"" + getOutputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
-				else if((*it)!=getOutputPortName())
-				{
-					pipelineLayout.addOutput(*it);
-					pipelineLayout.connectToOutput(shuffleFilterName, *it, *it);
-				}
-			}
+			lineCounter += pre.getNumLines();
 		}
 
-		// Connect to output :
-		pipelineLayout.connectToOutput(shuffleFilterName, getOutputPortName(), getOutputPortName());
+		if(last && !post.empty())
+		{
+			str += post.getSource();
+			for(int k=0; k<post.getNumLines(); k++)
+				linesInfo[lineCounter+k] = post.getLineInfo(k+1);
 
-		return pipelineLayout;
-	}
-	
-	void GenerateFFT1DPipeline::apply(LAYOUT_LOADER_ARGUMENTS_LIST)
-	{
-		UNUSED_PARAMETER(currentPath)
-		UNUSED_PARAMETER(dynamicPaths)
-		UNUSED_PARAMETER(formatList)
-		UNUSED_PARAMETER(sourceList)
-		UNUSED_PARAMETER(geometryList)
-		UNUSED_PARAMETER(filterList)
-		UNUSED_PARAMETER(mainPipelineName)
-		UNUSED_PARAMETER(staticPaths)
-		UNUSED_PARAMETER(requiredFormatList)
-		UNUSED_PARAMETER(requiredSourceList)
-		UNUSED_PARAMETER(requiredGeometryList)
-		UNUSED_PARAMETER(requiredPipelineList)
-		UNUSED_PARAMETER(moduleList)
-		UNUSED_PARAMETER(startLine)
-		UNUSED_PARAMETER(executionSource)		
-		UNUSED_PARAMETER(executionSourceName)
-		UNUSED_PARAMETER(executionStartLine)
-	
-		PIPELINE_MUST_NOT_EXIST( arguments[1] )
+			lineCounter += post.getNumLines();
+		}
 
-		int width = 0;
-		CONST_ITERATOR_TO_FORMAT( itFormat, arguments.front() )
-		if(VALID_ITERATOR_TO_FORMAT( itFormat ))
-			width = itFormat->second.getWidth();
-		else
+		str += "\n";															PUSH_LINE_INFO
+		str += "vec2 mul(in vec2 a, in vec2 e) \n";											PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    return vec2(a.x*e.x - a.y*e.y, a.x*e.y + a.y*e.x); \n";							PUSH_LINE_INFO
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
+
+		if(batched)
 		{
-			CAST_ARGUMENT(0, int, _width)
-			width = _width;
+			str += "vec4 mul(in vec4 a, in vec2 e) \n";										PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    return vec4(mul(a.xy, e), mul(a.zw, e)); \n";								PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
 		}
 
-		// Read the flags : 
-		int flags = 0;
-		for(unsigned int k=2; k<arguments.size(); k++)
+		// exp(-2i*pi*k/order), the row of the table has this order :
+		str += "vec2 twiddle(in int k, in int order, in int row) \n";									PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+
+		if(twiddleTexture)
 		{
-			FFTModules::Flag f = FFTModules::getFlag(arguments[k]);
-			flags = flags | static_cast<int>(f);
+			str += "    return texelFetch(" + getTwiddlePortName() + ", ivec2(k, row), 0).rg; \n";					PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    float p = -twoPi*float(k)/float(order); \n";								PUSH_LINE_INFO
+			str += "    return vec2(cos(p), sin(p)); \n";										PUSH_LINE_INFO
 		}
 
-		// Read PRE and POST functions : 
-		ShaderSource pre(""), post("");
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
 
-		if(!body.empty())
+		if(doublePrecision)
 		{
-			VanillaParser parser(body, sourceName, bodyLine);
-			bool 	preAlreadySet = false,
-				postAlreadySet = false;
+			str += "dvec2 mul(in dvec2 a, in dvec2 e) \n";										PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    return dvec2(a.x*e.x - a.y*e.y, a.x*e.y + a.y*e.x); \n";						PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
 
-			for(std::vector<Element>::iterator it=parser.elements.begin(); it!=parser.elements.end(); it++)
+			if(batched)
 			{
-				if(it->strKeyword=="PRE")
-				{
-					if(preAlreadySet)
-						throw Exception("PRE code already set.", it->sourceName, it->startLine, Exception::ClientScriptException);
-				
-					if(it->arguments.size()==1 && it->noBody)
-					{
-						SOURCE_MUST_EXIST( it->arguments.front() )
-						CONST_ITERATOR_TO_SOURCE( its, it->arguments.front() )
-						pre = its->second;
-					}
-					else if(it->noArgument && !it->body.empty())
-					{
-						ShaderSource src(it->body, it->sourceName, it->bodyLine);
-						pre = src;
-					}
-					else 
-						throw Exception("The PRE code can have either one argument or one body.", it->sourceName, it->startLine, Exception::ClientScriptException);
+				str += "dvec4 mul(in dvec4 a, in dvec2 e) \n";									PUSH_LINE_INFO
+				str += "{ \n";													PUSH_LINE_INFO
+				str += "    return dvec4(mul(a.xy, e), mul(a.zw, e)); \n";							PUSH_LINE_INFO
+				str += "} \n";													PUSH_LINE_INFO
+				str += "\n";													PUSH_LINE_INFO
+			}
 
-					preAlreadySet = true;
+			// The table also holds the rounding errors of the factors :
+			str += "dvec2 preciseTwiddle(in int k, in int order, in int row) \n";							PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+
+			if(twiddleTexture)
+			{
+				str += "    vec4 c = texelFetch(" + getTwiddlePortName() + ", ivec2(k, row), 0); \n";				PUSH_LINE_INFO
+				str += "    return dvec2(c.rg) + dvec2(c.ba); \n";								PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    return dvec2(twiddle(k, order, row)); \n";							PUSH_LINE_INFO
+			}
+
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		if(bluestein)
+		{
+			// c[k] = exp(-i*pi*k^2/ns), the phase is reduced with integers :
+			str += "vec2 modulation(in int k) \n";											PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    return twiddle((k*k) % (2*ns), 2*ns, 2); \n";								PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		if(first)
+		{
+			// Read the input at the position x of a texture of size s :
+			str += "vec4 read(in int x, in int s) \n";										PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+
+			if((flags & NoInput)==0)
+			{
+				str += "    vec4 c = texture(" + getInputPortName() + ", vec2((float(x)+0.5)/float(s), 0.5)); \n";		PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    vec4 c = vec4(0.0, 0.0, 0.0, 0.0); \n";								PUSH_LINE_INFO
+			}
+
+			// Apply the pre-function, if given :
+			if(!pre.empty())
+			{
+				str += "    c = pre(c, (float(x)+0.5)/float(s)); \n";								PUSH_LINE_INFO
+			}
+
+			str += "    return c; \n";												PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+
+			// With the Bluestein algorithm, the signal is read by 'source' and modulated by 'fetch' :
+			str += type + ((pass.kind==BluesteinSignal) ? " source(in int x) \n" : " fetch(in int x) \n");				PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+
+			if(realInput)
+			{
+				str += "    vec4 a = read(2*x, w), \n";										PUSH_LINE_INFO
+				str += "         b = read(2*x+1, w); \n";									PUSH_LINE_INFO
+				str += std::string(batched ? "    return vec4(a.r, b.r, a.b, b.b); \n" : "    return vec2(a.r, b.r); \n");		PUSH_LINE_INFO
+			}
+			else if(realOutput)
+			{
+				// Z = E + iO with E = (X[x] + X*[ns-x])/2 and O = (X[x] - X*[ns-x])*exp(2i*pi*x/w)/2, conjugated for the reciprocal transform :
+				str += "    " + type + " a = read(x, ns+1)" + channels + ", \n";							PUSH_LINE_INFO
+				str += "         b = read(ns-x, ns+1)" + channels + " * " + conjugate + ", \n";					PUSH_LINE_INFO
+				str += "         e = (a + b)*0.5, \n";										PUSH_LINE_INFO
+				str += "         d = (a - b)*0.5, \n";										PUSH_LINE_INFO
+				str += "         o = mul(d, twiddle((w-x) % w, w, 1)); \n";							PUSH_LINE_INFO
+				str += "    return (e + mul(o, vec2(0.0, 1.0))) * " + conjugate + "; \n";						PUSH_LINE_INFO
+			}
+			else
+			{
+				if((flags & Shifted)!=0 && (flags & Inversed)!=0)
+				{
+					str += "    x = (x + w/2) % w; \n";									PUSH_LINE_INFO
 				}
-				else if(it->strKeyword=="POST")
+
+				str += "    vec4 c = read(x, w); \n";										PUSH_LINE_INFO
+
+				if((flags & Inversed)!=0)
 				{
-					if(postAlreadySet)
-						throw Exception("POST code already set.", it->sourceName, it->startLine, Exception::ClientScriptException);
-				
-					if(it->arguments.size()==1 && it->noBody)
-					{
-						SOURCE_MUST_EXIST( it->arguments.front() )
-						CONST_ITERATOR_TO_SOURCE( its, it->arguments.front() )
-						post = its->second;
-					}
-					else if(it->noArgument && !it->body.empty())
-					{
-						ShaderSource src(it->body, it->sourceName, it->bodyLine);
-						post = src;
-					}
-					else 
-						throw Exception("The PRE code can have either one argument or one body.", it->sourceName, it->startLine, Exception::ClientScriptException);
+					str += "    c = c * vec4(1.0, -1.0, 1.0, -1.0); \n";						PUSH_LINE_INFO
+				}
 
-					preAlreadySet = true;
-				}				
+				str += "    return c" + channels + "; \n";									PUSH_LINE_INFO
+			}
+
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		if(!first || pass.kind==BluesteinSignal)
+		{
+			str += type + " fetch(in int x) \n";										PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+
+			if(first) // Modulated signal, padded with zeros :
+			{
+				str += "    if(x>=ns) return " + type + "(0.0); \n";							PUSH_LINE_INFO
+				str += "    return mul(source(x), modulation(x)); \n";							PUSH_LINE_INFO
+			}
+			else if(chirp && pass.span==1) // Chirp filter :
+			{
+				str += "    if(x<ns) return modulation(x) * vec2(1.0, -1.0); \n";						PUSH_LINE_INFO
+				str += "    else if(x>n-ns) return modulation(n-x) * vec2(1.0, -1.0); \n";					PUSH_LINE_INFO
+				str += "    else return vec2(0.0, 0.0); \n";								PUSH_LINE_INFO
+			}
+			else if(pass.kind==BluesteinConvolution && pass.span==1) // Conjugate of the product of the transforms :
+			{
+				str += "    " + type + " a = texelFetch(" + getInputPortName() + ", ivec2(x, 0), 0)" + channels + "; \n";		PUSH_LINE_INFO
+				str += "    vec2 b = texelFetch(" + getChirpPortName() + ", ivec2(x, 0), 0).rg; \n";				PUSH_LINE_INFO
+				str += "    return mul(a, b) * " + conjugate + "; \n";								PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    return texelFetch(" + getInputPortName() + ", ivec2(x, 0), 0)" + channels + "; \n";		PUSH_LINE_INFO
+			}
+
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		str += "void main() \n";													PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    const int r = " + toString(pass.radix) + ", \n";								PUSH_LINE_INFO
+		str += "              s = " + toString(pass.span) + ", \n";								PUSH_LINE_INFO
+		str += "              l = " + toString(pass.span*pass.radix) + "; \n";							PUSH_LINE_INFO
+		str += "    int o = int(gl_FragCoord.x); \n";											PUSH_LINE_INFO
+
+		if(last && realOutput)
+		{
+			// Two consecutive outputs share the same complex value :
+			str += "    int u = o % 2; \n";												PUSH_LINE_INFO
+			str += "    o = o/2; \n";												PUSH_LINE_INFO
+		}
+		else if(last && (flags & Shifted)!=0 && (flags & Inversed)==0)
+		{
+			str += "    o = (o + (ns+1)/2) % ns; \n";										PUSH_LINE_INFO
+		}
+
+		str += "    int t = o % l, \n";												PUSH_LINE_INFO
+		str += "        j = (o/l)*s + o % s; \n";											PUSH_LINE_INFO
+		if(doublePrecision)
+		{
+			str += "    " + accumulator + " sum = " + accumulator + "(0.0); \n";							PUSH_LINE_INFO
+			str += "    for(int m=0; m<r; m++) \n";										PUSH_LINE_INFO
+			str += "        sum += mul(" + accumulator + "(fetch(j + m*(n/r))), preciseTwiddle(((m*t) % l)*(n/l), n, 0)); \n";	PUSH_LINE_INFO
+			str += "    " + type + " v = " + type + "(sum); \n";								PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    " + type + " v = " + type + "(0.0); \n";								PUSH_LINE_INFO
+			str += "    for(int m=0; m<r; m++) \n";										PUSH_LINE_INFO
+			str += "        v += mul(fetch(j + m*(n/r)), twiddle(((m*t) % l)*(n/l), n, 0)); \n";				PUSH_LINE_INFO
+		}
+
+		if(lastInDirection && pass.kind==BluesteinConvolution)
+		{
+			// Reciprocal transform and demodulation :
+			str += "    v = mul(v * " + conjugate + "/float(n), modulation(o)); \n";							PUSH_LINE_INFO
+		}
+
+		if(last)
+		{
+			if(realOutput)
+			{
+				str += "    v = v * " + conjugate + "/float(ns); \n";								PUSH_LINE_INFO
+
+				if(batched)
+				{
+					str += "    vec2 x = (u==0) ? v.xz : v.yw; \n";							PUSH_LINE_INFO
+					str += "    vec4 A = vec4(x.x, 0.0, x.y, 0.0); \n";							PUSH_LINE_INFO
+				}
 				else
-					throw Exception("Unknown keyword \"" + it->strKeyword + "\". Expected PRE or POST.", it->sourceName, it->startLine, Exception::ClientScriptException);
+				{
+					str += "    float x = (u==0) ? v.x : v.y; \n";								PUSH_LINE_INFO
+					str += "    vec4 A = vec4(x, 0.0, abs(x), 1.0); \n";							PUSH_LINE_INFO
+				}
+			}
+			else
+			{
+				if((flags & Inversed)!=0)
+				{
+					str += "    v = v * " + conjugate + "/float(w); \n";							PUSH_LINE_INFO
+				}
+
+				str += std::string(batched ? "    vec4 A = v; \n" : "    vec4 A = vec4(v, length(v), 1.0); \n");		PUSH_LINE_INFO
 			}
+
+			// Apply the post-function, if given :
+			if(!post.empty())
+			{
+				str += "    A = post(A, gl_FragCoord.x/float(w)); \n";							PUSH_LINE_INFO
+			}
+
+			str += "    " + getOutputPortName() + " = A; \n";									PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    " + getOutputPortName() + " = " + std::string(batched ? "v" : "vec4(v, 0.0, 0.0)") + "; \n";			PUSH_LINE_INFO
 		}
-			
-		APPEND_NEW_PIPELINE(arguments[1], generate(width, flags, pre, post))
-	}
 
-// GenerateFFT2DPipeline :
-	/**
-	\fn GenerateFFT2DPipeline::GenerateFFT2DPipeline(void)
-	\brief Module constructor.
+		if((flags & CompatibilityMode)!=0)
+		{
+			str += "    gl_FragColor = " + getOutputPortName() + "; \n";								PUSH_LINE_INFO
+		}
 
-	This object can be added to a LayoutLoader via LayoutLoader::addModule().
-	**/
-	GenerateFFT2DPipeline::GenerateFFT2DPipeline(void)
-	 :	LayoutLoaderModule(	"GENERATE_FFT2D_PIPELINE", 
-					"DESCRIPTION{Generate the 2D FFT Pipeline transformation.}"
-					"ARGUMENT:width{Width, can be either a numeral or the name of an existing format.}"
-					"ARGUMENT:height{Height, can be either a numeral or the name of an existing format.}"
-					"ARGUMENT:name{Name of the new pipeline.}"
-					"ARGUMENT:options...{Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT.}"
-					"BODY_DESCRIPTION{PRE{...} block contains a filtering function to be applied before the FFT. It must define a function vec4 pre(in vec4 colorFromTexture, in vec2 x). POST{...} block contains a filtering function to be applied after the FFT. It must implement a function vec4 post(in vec4 colorAfterFFT, in vec2 x). Both of these block can declare their own uniform variables.}",
-					2,
-					8, //3 base + 5 arguments
-					0)
-	{ }
+		str += "} \n";															PUSH_LINE_INFO
 
-	const std::string GenerateFFT2DPipeline::getInputPortName(void)
-	{
-		return "inputTexture";
-	}
+		#undef PUSH_LINE_INFO
 
-	const std::string GenerateFFT2DPipeline::getOutputPortName(void)
-	{
-		return "outputTexture";
+		return ShaderSource(str, "<GenerateFFT1DPipeline::generate(" + toString(width) +")>", 1, linesInfo);
 	}
 
-	ShaderSource GenerateFFT2DPipeline::generateRadix2Code(int width, int oppositeWidth, int currentLevel, int flags, bool horizontal, const ShaderSource& pre)
+	ShaderSource GenerateFFT1DPipeline::generateUnpackCode(int width, int flags, const ShaderSource& post)
 	{
-		// Note that 'width' is generic here, it can be either the width or the height. 'oppositeWidth' is given as the other dimension.
-		// Horizontal must be first.
+		// Last pass of the RealInput transform, the input is the transform Z of size n = width/2 of the even and odd samples packed in complex values.
+		// X[k] = E[k] + exp(-2i*pi*k/width)*O[k], with E[k] = (Z[k] + Z*[n-k])/2 and O[k] = (Z[k] - Z*[n-k])/(2i), for k in [0, n].
 
 		int lineCounter = 1;
 		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
 
 		std::string str;
 		std::map<int,ShaderSource::LineInfo> linesInfo;
+		const bool		batched = (flags & Batched)!=0,
+					twiddleTexture = (flags & TwiddleTexture)!=0;
+		const std::string	type = batched ? "vec4" : "vec2",
+					channels = batched ? "" : ".rg",
+					conjugate = batched ? "vec4(1.0, -1.0, 1.0, -1.0)" : "vec2(1.0, -1.0)";
 
-		str +="#version 130 \n";													PUSH_LINE_INFO
+		str += "#version 130 \n";													PUSH_LINE_INFO
 		str += "const float twoPi = 6.28318530718; \n";											PUSH_LINE_INFO
-		
-		if(!horizontal || width!=currentLevel || (flags & NoInput)==0) // Not First pass or has an input
+		str += "uniform sampler2D " + getInputPortName() + "; \n";									PUSH_LINE_INFO
+
+		if(twiddleTexture)
+		{
+			str += "uniform sampler2D " + getTwiddlePortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		if((flags & CompatibilityMode)==0)
+		{
+			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "vec4 " + getOutputPortName() + "; \n";										PUSH_LINE_INFO
+		}
+
+		if(!post.empty())
+		{
+			str += post.getSource();
+			for(int k=0; k<post.getNumLines(); k++)
+				linesInfo[lineCounter+k] = post.getLineInfo(k+1);
+
+			lineCounter += post.getNumLines();
+		}
+
+		str += "\n";															PUSH_LINE_INFO
+		str += "vec2 mul(in vec2 a, in vec2 e) \n";											PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    return vec2(a.x*e.x - a.y*e.y, a.x*e.y + a.y*e.x); \n";							PUSH_LINE_INFO
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
+
+		if(batched)
+		{
+			str += "vec4 mul(in vec4 a, in vec2 e) \n";										PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    return vec4(mul(a.xy, e), mul(a.zw, e)); \n";								PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		// exp(-2i*pi*k/w), from the row of the packing of the real signals in the table (see FFTModules::getTwiddleOrders) :
+		str += "vec2 twiddle(in int k) \n";												PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+
+		if(twiddleTexture)
+		{
+			str += "    return texelFetch(" + getTwiddlePortName() + ", ivec2(k, 1), 0).rg; \n";					PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    float p = -twoPi*float(k)/" + toString(width) + ".0; \n";							PUSH_LINE_INFO
+			str += "    return vec2(cos(p), sin(p)); \n";										PUSH_LINE_INFO
+		}
+
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
+
+		str += "void main() \n";													PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    const int w = " + toString(width) + ", \n";										PUSH_LINE_INFO
+		str += "              n = " + toString(width/2) + "; \n";									PUSH_LINE_INFO
+		str += "    int k = int(gl_FragCoord.x); \n";											PUSH_LINE_INFO
+		str += "    " + type + " a = texelFetch(" + getInputPortName() + ", ivec2(k % n, 0), 0)" + channels + ", \n";			PUSH_LINE_INFO
+		str += "         b = texelFetch(" + getInputPortName() + ", ivec2((n-k) % n, 0), 0)" + channels + " * " + conjugate + ", \n";	PUSH_LINE_INFO
+		str += "         e = (a + b)*0.5, \n";												PUSH_LINE_INFO
+		str += "         o = mul((a - b)*0.5, vec2(0.0, -1.0)), \n";									PUSH_LINE_INFO
+		str += "         v = e + mul(o, twiddle(k)); \n";										PUSH_LINE_INFO
+		str += std::string(batched ? "    vec4 A = v; \n" : "    vec4 A = vec4(v, length(v), 1.0); \n");				PUSH_LINE_INFO
+
+		// Apply the post-function, if given :
+		if(!post.empty())
+		{
+			str += "    A = post(A, gl_FragCoord.x/float(n+1)); \n";								PUSH_LINE_INFO
+		}
+
+		str += "    " + getOutputPortName() + " = A; \n";										PUSH_LINE_INFO
+
+		if((flags & CompatibilityMode)!=0)
+		{
+			str += "    gl_FragColor = " + getOutputPortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		str += "} \n";															PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+
+		return ShaderSource(str, "<GenerateFFT1DPipeline::generate(" + toString(width) +")>", 1, linesInfo);
+	}
+
+	/**
+	\fn std::vector<FFTModules::Pass> GenerateFFT1DPipeline::getPlan(int width, int flags)
+	\brief Get the passes performed by the pipeline returned by GenerateFFT1DPipeline::generate.
+	\param width Width of the signal.
+	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
+	\return The passes of the transform, in order. The description can be printed with Glip::Modules::FFTModules::getPlanDescription.
+
+	With the Bluestein algorithm, the passes transforming the chirp filter form a separate branch of the pipeline.
+	**/
+	std::vector<FFTModules::Pass> GenerateFFT1DPipeline::getPlan(int width, int flags)
+	{
+		if(width<4)
+			throw Exception("Size must be at least 4 (current size : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+		if((flags & RealInput)!=0 && (flags & RealOutput)!=0)
+			throw Exception("The flags RealInput and RealOutput cannot be used together.", __FILE__, __LINE__, Exception::ModuleException);
+
+		const bool real = (flags & (RealInput | RealOutput))!=0;
+
+		if(real && (flags & Radix2)!=0)
+			throw Exception("The flags RealInput and RealOutput cannot be used with the flag Radix2.", __FILE__, __LINE__, Exception::ModuleException);
+		if(real && (flags & Shifted)!=0)
+			throw Exception("The flags RealInput and RealOutput cannot be used with the flag Shifted in 1D (the half-spectrum is not centered).", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & RealInput)!=0 && (flags & Inversed)!=0)
+			throw Exception("The flag RealInput cannot be used with the flag Inversed (see RealOutput).", __FILE__, __LINE__, Exception::ModuleException);
+		if(real && width%2!=0)
+			throw Exception("Size must be even with the flags RealInput and RealOutput (current size : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & Batched)!=0 && (flags & Radix2)!=0)
+			throw Exception("The flag Batched cannot be used with the flag Radix2.", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & (TwiddleTexture | DoublePrecision))!=0 && (flags & Radix2)!=0)
+			throw Exception("The flags TwiddleTexture and DoublePrecision cannot be used with the flag Radix2.", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & DoublePrecision)!=0 && (flags & CompatibilityMode)!=0)
+			throw Exception("The flag DoublePrecision cannot be used with the flag CompatibilityMode.", __FILE__, __LINE__, Exception::ModuleException);
+
+		std::vector<Pass> plan;
+
+		if((flags & Radix2)!=0)
+		{
+			double 	test1 = std::log(width)/std::log(2),
+				test2 = std::floor(test1);
+
+			if(test1!=test2)
+				throw Exception("Size must be a power of 2 with the flag Radix2 (current size : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+			for(int l=width; l>1; l/=2)
+				plan.push_back(Pass("Filter" + toString(l), Radix2Butterfly, 2, l, width, width/2, 1));
+
+			plan.push_back(Pass("FilterShuffle", Radix2Shuffle, 1, 1, width, width, 1));
+		}
+		else
+		{
+			// The complex transform has half the size of the real signal :
+			plan = getPasses(real ? width/2 : width, flags);
+
+			for(std::vector<Pass>::iterator it=plan.begin(); it!=plan.end(); it++)
+				it->name = "Filter" + it->name;
+
+			if((flags & RealOutput)!=0)
+				plan.back().width = width;
+			else if((flags & RealInput)!=0) // Last, extract the half-spectrum :
+				plan.push_back(Pass("FilterUnpack", Unpack, 2, 1, width/2, width/2+1, 1));
+		}
+
+		return plan;
+	}
+
+	/**
+	\fn HdlTextureFormat GenerateFFT1DPipeline::getTwiddleFormat(int width, int flags)
+	\brief Get the format of the texture expected by the port <i>twiddleTexture</i> with the flag TwiddleTexture.
+	\param width Width of the signal.
+	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
+	\return The format of the table of twiddle factors (GL_RGBA32F, three rows).
+	**/
+	HdlTextureFormat GenerateFFT1DPipeline::getTwiddleFormat(int width, int flags)
+	{
+		getPlan(width, flags); // Check the flags.
+
+		const std::vector<int> orders = getTwiddleOrders(width, flags);
+		const int tableWidth = *std::max_element(orders.begin(), orders.end());
+
+		return HdlTextureFormat(tableWidth, orders.size(), GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+	}
+
+	/**
+	\fn std::vector<float> GenerateFFT1DPipeline::getTwiddles(int width, int flags)
+	\brief Compute the table of twiddle factors expected by the port <i>twiddleTexture</i> with the flag TwiddleTexture.
+	\param width Width of the signal.
+	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
+	\return The content of the texture, of format GenerateFFT1DPipeline::getTwiddleFormat (see Glip::Modules::FFTModules::getTwiddleTable).
+	**/
+	std::vector<float> GenerateFFT1DPipeline::getTwiddles(int width, int flags)
+	{
+		getPlan(width, flags); // Check the flags.
+		return getTwiddleTable(getTwiddleOrders(width, flags));
+	}
+
+	/**
+	\fn PipelineLayout GenerateFFT1DPipeline::generate(int width, int flags, const std::string& pre, const std::string& post)
+	\brief Construct a pipeline performing a 1D FFT.
+	\param width Width of the signal.
+	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
+	\param pre Add a filtering function before the transform.
+	\param post Add a filtering function after the transform.
+	\return A complete pipeline layout.
+
+	The <b>pre-function</b> will be inserted before the transform. It should be a block of code declaring the function <i>pre</i> as in the following example : 
+	\code
+	vec4 pre(in vec4 colorFromTexture, in float x)
+	{
+		return modifiedColor;
+	}
+	\endcode
+
+	The <b>post-function</b> will be inserted after the transform. It should be a block of code declaring the function <i>post</i> as in the following example : 
+	\code
+	vec4 post(in vec4 colorAfterFFT, in float x)
+	{
+		return modifiedColor;
+	}
+	\endcode
+
+	Each time, the position is normalized from 0.0 to 1.0. You are allowed to declare uniform variables in these filters.
+	**/
+	PipelineLayout GenerateFFT1DPipeline::generate(int width, int flags, const ShaderSource& pre, const ShaderSource& post)
+	{
+		const std::vector<Pass> plan = getPlan(width, flags);
+
+		if((flags & NoInput)!=0 && pre.empty())
+			throw Exception("A PRE-function must be provided when using the flag NoInput.", __FILE__, __LINE__, Exception::ModuleException);
+
+		if(!pre.getOutputVars().empty() && !pre.requiresCompatibility())
+			throw Exception("A PRE-function cannot have an output (its own output port(s)).", __FILE__, __LINE__, Exception::ModuleException);
+
+		PipelineLayout pipelineLayout("FFT1D" + toString(width) + "Pipeline");
+
+		if((flags & NoInput)==0)
+			pipelineLayout.addInput(getInputPortName());
+
+		if((flags & TwiddleTexture)!=0)
+			pipelineLayout.addInput(getTwiddlePortName());
+
+		pipelineLayout.addOutput(getOutputPortName());
+
+		std::string 	previousName = "",
+				chirpName = "",
+				firstFilterName = "",
+				lastFilterName = "";
+
+		for(std::vector<Pass>::const_iterator it=plan.begin(); it!=plan.end(); it++)
+		{
+			ShaderSource shader("");
+			if(it->kind==Radix2Butterfly)
+				shader = generateRadix2Code(width, it->span, flags, pre);
+			else if(it->kind==Radix2Shuffle)
+				shader = generateLastShuffleCode(width, flags, post);
+			else if(it->kind==Unpack)
+				shader = generateUnpackCode(width, flags, post);
+			else
+				shader = generateMixedRadixCode(width, *it, flags, pre, post);
+
+			// The last pass, the radix-2 butterflies and the batched passes have four channels :
+			const bool last = (it+1)==plan.end();
+			HdlTextureFormat format(it->width, it->height, (last || it->kind==Radix2Butterfly || ((flags & Batched)!=0 && it->kind!=BluesteinChirp)) ? GL_RGBA32F : GL_RG32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+			FilterLayout filterLayout(it->name, format, shader);
+			pipelineLayout.add(filterLayout, it->name);
+
+			if((flags & TwiddleTexture)!=0)
+				pipelineLayout.connectToInput(getTwiddlePortName(), it->name, getTwiddlePortName());
+
+			if(it->kind==BluesteinChirp) // Separate branch, without input :
+			{
+				if(it->span>1)
+					pipelineLayout.connect(chirpName, getOutputPortName(), it->name, getInputPortName());
+
+				chirpName = it->name;
+			}
+			else
+			{
+				if(previousName.empty()) // First element
+					firstFilterName = it->name;
+				else
+					pipelineLayout.connect(previousName, getOutputPortName(), it->name, getInputPortName());
+
+				if(it->kind==BluesteinConvolution && it->span==1)
+					pipelineLayout.connect(chirpName, getOutputPortName(), it->name, getChirpPortName());
+
+				previousName = it->name;
+			}
+		}
+
+		lastFilterName = previousName;
+
+		if((flags & NoInput)==0)
+			pipelineLayout.connectToInput(getInputPortName(), firstFilterName, getInputPortName());
+
+		if(!pre.empty())
+		{
+			// Add the ports declared in PRE :
+			for(std::vector<std::string>::const_iterator it=pre.getInputVars().begin(); it!=pre.getInputVars().end(); it++)
+			{
+				if((*it)==getInputPortName() && (flags & NoInput)==0)
+					throw Exception("The PRE function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
+				else
+				{
+					pipelineLayout.addInput(*it);
+					pipelineLayout.connectToInput(*it, firstFilterName, *it);
+				}
+			}
+		}
+		
+		// Add the ports declared in post : 
+		if(!post.empty())
+		{
+			for(std::vector<std::string>::const_iterator it=post.getInputVars().begin(); it!=post.getInputVars().end(); it++)
+			{
+				if((*it)==getInputPortName() && (flags & NoInput)==0)
+					throw Exception("The POST function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
+				else
+				{
+					pipelineLayout.addInput(*it);
+					pipelineLayout.connectToInput(*it, lastFilterName, *it);
+				}
+			}
+
+			for(std::vector<std::string>::const_iterator it=post.getOutputVars().begin(); it!=post.getOutputVars().end(); it++)
+			{
+				if((*it)==getOutputPortName() && !post.requiresCompatibility())
+					throw Exception("The POST function cannot declare the output port \"" + getOutputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
+				else if((*it)!=getOutputPortName())
+				{
+					pipelineLayout.addOutput(*it);
+					pipelineLayout.connectToOutput(lastFilterName, *it, *it);
+				}
+			}
+		}
+
+		// Connect to output :
+		pipelineLayout.connectToOutput(lastFilterName, getOutputPortName(), getOutputPortName());
+
+		return pipelineLayout;
+	}
+	
+	void GenerateFFT1DPipeline::apply(LAYOUT_LOADER_ARGUMENTS_LIST)
+	{
+		UNUSED_PARAMETER(currentPath)
+		UNUSED_PARAMETER(dynamicPaths)
+		UNUSED_PARAMETER(formatList)
+		UNUSED_PARAMETER(sourceList)
+		UNUSED_PARAMETER(geometryList)
+		UNUSED_PARAMETER(filterList)
+		UNUSED_PARAMETER(mainPipelineName)
+		UNUSED_PARAMETER(staticPaths)
+		UNUSED_PARAMETER(requiredFormatList)
+		UNUSED_PARAMETER(requiredSourceList)
+		UNUSED_PARAMETER(requiredGeometryList)
+		UNUSED_PARAMETER(requiredPipelineList)
+		UNUSED_PARAMETER(moduleList)
+		UNUSED_PARAMETER(startLine)
+		UNUSED_PARAMETER(executionSource)		
+		UNUSED_PARAMETER(executionSourceName)
+		UNUSED_PARAMETER(executionStartLine)
+	
+		PIPELINE_MUST_NOT_EXIST( arguments[1] )
+
+		int width = 0;
+		CONST_ITERATOR_TO_FORMAT( itFormat, arguments.front() )
+		if(VALID_ITERATOR_TO_FORMAT( itFormat ))
+			width = itFormat->second.getWidth();
+		else
+		{
+			CAST_ARGUMENT(0, int, _width)
+			width = _width;
+		}
+
+		// Read the flags : 
+		int flags = 0;
+		for(unsigned int k=2; k<arguments.size(); k++)
+		{
+			FFTModules::Flag f = FFTModules::getFlag(arguments[k]);
+			flags = flags | static_cast<int>(f);
+		}
+
+		// Read PRE and POST functions : 
+		ShaderSource pre(""), post("");
+
+		if(!body.empty())
+		{
+			VanillaParser parser(body, sourceName, bodyLine);
+			bool 	preAlreadySet = false,
+				postAlreadySet = false;
+
+			for(std::vector<Element>::iterator it=parser.elements.begin(); it!=parser.elements.end(); it++)
+			{
+				if(it->strKeyword=="PRE")
+				{
+					if(preAlreadySet)
+						throw Exception("PRE code already set.", it->sourceName, it->startLine, Exception::ClientScriptException);
+				
+					if(it->arguments.size()==1 && it->noBody)
+					{
+						SOURCE_MUST_EXIST( it->arguments.front() )
+						CONST_ITERATOR_TO_SOURCE( its, it->arguments.front() )
+						pre = its->second;
+					}
+					else if(it->noArgument && !it->body.empty())
+					{
+						ShaderSource src(it->body, it->sourceName, it->bodyLine);
+						pre = src;
+					}
+					else 
+						throw Exception("The PRE code can have either one argument or one body.", it->sourceName, it->startLine, Exception::ClientScriptException);
+
+					preAlreadySet = true;
+				}
+				else if(it->strKeyword=="POST")
+				{
+					if(postAlreadySet)
+						throw Exception("POST code already set.", it->sourceName, it->startLine, Exception::ClientScriptException);
+				
+					if(it->arguments.size()==1 && it->noBody)
+					{
+						SOURCE_MUST_EXIST( it->arguments.front() )
+						CONST_ITERATOR_TO_SOURCE( its, it->arguments.front() )
+						post = its->second;
+					}
+					else if(it->noArgument && !it->body.empty())
+					{
+						ShaderSource src(it->body, it->sourceName, it->bodyLine);
+						post = src;
+					}
+					else 
+						throw Exception("The PRE code can have either one argument or one body.", it->sourceName, it->startLine, Exception::ClientScriptException);
+
+					preAlreadySet = true;
+				}				
+				else
+					throw Exception("Unknown keyword \"" + it->strKeyword + "\". Expected PRE or POST.", it->sourceName, it->startLine, Exception::ClientScriptException);
+			}
+		}
+			
+		APPEND_NEW_PIPELINE(arguments[1], generate(width, flags, pre, post))
+	}
+
+// GenerateFFT2DPipeline :
+	/**
+	\fn GenerateFFT2DPipeline::GenerateFFT2DPipeline(void)
+	\brief Module constructor.
+
+	This object can be added to a LayoutLoader via LayoutLoader::addModule().
+	**/
+	GenerateFFT2DPipeline::GenerateFFT2DPipeline(void)
+	 :	LayoutLoaderModule(	"GENERATE_FFT2D_PIPELINE", 
+					"DESCRIPTION{Generate the 2D FFT Pipeline transformation.}"
+					"ARGUMENT:width{Width, can be either a numeral or the name of an existing format.}"
+					"ARGUMENT:height{Height, can be either a numeral or the name of an existing format.}"
+					"ARGUMENT:name{Name of the new pipeline.}"
+					"ARGUMENT:options...{Options to be used by the FFT process : SHIFTED, INVERSED, ZERO_PADDING, COMPATIBILITY_MODE, NO_INPUT, RADIX_2, RADIX_4, RADIX_8, REAL_INPUT, REAL_OUTPUT, BATCHED, TWIDDLE_TEXTURE, DOUBLE_PRECISION and the number of slices stacked vertically in the texture (1 by default).}"
+					"BODY_DESCRIPTION{PRE{...} block contains a filtering function to be applied before the FFT. It must define a function vec4 pre(in vec4 colorFromTexture, in vec2 x). POST{...} block contains a filtering function to be applied after the FFT. It must implement a function vec4 post(in vec4 colorAfterFFT, in vec2 x). Both of these block can declare their own uniform variables.}",
+					2,
+					14, //3 base + 11 arguments (a single radix flag, a single real flag and the number of slices)
+					0)
+	{ }
+
+	const std::string GenerateFFT2DPipeline::getInputPortName(void)
+	{
+		return "inputTexture";
+	}
+
+	const std::string GenerateFFT2DPipeline::getOutputPortName(void)
+	{
+		return "outputTexture";
+	}
+
+	const std::string GenerateFFT2DPipeline::getChirpPortName(void)
+	{
+		return "chirpTexture";
+	}
+
+	const std::string GenerateFFT2DPipeline::getTwiddlePortName(void)
+	{
+		return "twiddleTexture";
+	}
+
+	ShaderSource GenerateFFT2DPipeline::generateRadix2Code(int width, int oppositeWidth, int currentLevel, int flags, bool horizontal, const ShaderSource& pre)
+	{
+		// Note that 'width' is generic here, it can be either the width or the height. 'oppositeWidth' is given as the other dimension.
+		// Horizontal must be first.
+
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+
+		str +="#version 130 \n";													PUSH_LINE_INFO
+		str += "const float twoPi = 6.28318530718; \n";											PUSH_LINE_INFO
+		
+		if(!horizontal || width!=currentLevel || (flags & NoInput)==0) // Not First pass or has an input
+		{
+			str += "uniform sampler2D " + getInputPortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		if((flags & CompatibilityMode)==0)
+		{
+			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "vec4 " + getOutputPortName() + "; \n";										PUSH_LINE_INFO
+		}
+
+		if(horizontal && width==currentLevel && !pre.empty()) // First pass and pre-function
+		{
+			str += pre.getSource();
+			for(int k=0; k<pre.getNumLines(); k++)
+				linesInfo[lineCounter+k] = pre.getLineInfo(k+1);
+
+			lineCounter += pre.getNumLines();
+		}
+
+		str += "\n";															PUSH_LINE_INFO
+		str += "void main() \n";													PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    const int w = " + toString(width) + ", \n";										PUSH_LINE_INFO
+		str += "              h = " + toString(oppositeWidth) + ", \n";									PUSH_LINE_INFO
+		str += "              l = " + toString(currentLevel) + "; \n";									PUSH_LINE_INFO
+		str += "    ivec2 pos = ivec2(gl_FragCoord.xy); \n";										PUSH_LINE_INFO
+
+		if(!horizontal)
+		{
+			str += "    pos.xy = pos.yx; \n";											PUSH_LINE_INFO
+		}
+
+		str += "    int posB = int(mod((mod(pos.x, l) - l/2), l) + int(pos.x/l)*l); \n";						PUSH_LINE_INFO
+
+		if(width==currentLevel) // First pass in the current direction
+		{
+			str += "    float p = floor((2*mod(pos.x+w/2,w))/w)*floor(mod(pos.x+w/2, w/2)); \n";					PUSH_LINE_INFO
+
+			if((flags & Shifted)!=0 && (flags & Inversed)!=0)
+			{
+				str += "    pos.x = int(mod(pos.x + w/2, w)); \n";								PUSH_LINE_INFO
+				str += "    posB = int(mod(posB + w/2, w)); \n";								PUSH_LINE_INFO
+			}
+			
+			if(horizontal)
+			{
+				// Also real first pass :
+				str += "    vec2 ivA = vec2((float(pos.x)+0.5)/float(w),(float(pos.y)+0.5)/float(h)), \n";			PUSH_LINE_INFO
+				str += "         ivB = vec2((float(posB)+0.5)/float(w),(float(pos.y)+0.5)/float(h)); \n";			PUSH_LINE_INFO
+
+				if((flags & NoInput)==0)
+				{
+					str += "    vec4 A = texture(" + getInputPortName() + ", ivA); \n";					PUSH_LINE_INFO
+					str += "    vec4 B = texture(" + getInputPortName() + ", ivB); \n";					PUSH_LINE_INFO
+				}
+				else
+				{
+					str += "    vec4 A = vec4(0.0, 0.0, 0.0, 0.0); \n";							PUSH_LINE_INFO
+					str += "    vec4 B = vec4(0.0, 0.0, 0.0, 0.0); \n";							PUSH_LINE_INFO
+				}
+
+				// Apply the pre-function, if given : 
+				if(!pre.empty())
+				{
+					str += "    A = pre(A, ivA); \n";									PUSH_LINE_INFO
+					str += "    B = pre(B, ivB); \n";									PUSH_LINE_INFO
+				}
+			}
+			else
+			{
+				// Second pass, read from first horizontal pass compressed format :
+				if((flags & Shifted)!=0 && (flags & Inversed)==0)
+				{
+					str += "    pos.y = int(mod(pos.y + w/2, w)); \n";							PUSH_LINE_INFO
+				}
+
+				str += "    int a = 0; \n";											PUSH_LINE_INFO
+				str += "    for(int k=w/2; k>=1; k=k/2) a = a + int(mod(int(pos.y/k),2))*(w/(2*k)); \n"; 			PUSH_LINE_INFO
+				str += "    pos.y = int(mod(a, w/2));  \n";									PUSH_LINE_INFO
+
+				// Read : 
+				str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.y,pos.x), 0); \n";			PUSH_LINE_INFO
+				str += "    vec4 B = texelFetch(" + getInputPortName() + ", ivec2(pos.y,posB), 0); \n";				PUSH_LINE_INFO
+
+				// read from first horizontal pass, second part : 
+				str += "    if(pos.y<a) { A.rg = A.ba; B.rg = B.ba; } \n";							PUSH_LINE_INFO
+
+				if((flags & Inversed)!=0)
+				{
+					str += "    A.rg = A.rg * vec2(1.0, -1.0)/h; \n";							PUSH_LINE_INFO
+					str += "    B.rg = B.rg * vec2(1.0, -1.0)/h; \n";							PUSH_LINE_INFO
+				}
+			}
+		}		
+		else
+		{
+			str += "    float p = floor((2*mod(pos.x,l))/l)*floor(mod(pos.x, l/2))*(w/l); \n";					PUSH_LINE_INFO
+
+			if(horizontal)
+			{
+				str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.x,pos.y), 0); \n";			PUSH_LINE_INFO
+				str += "    vec4 B = texelFetch(" + getInputPortName() + ", ivec2(posB,pos.y), 0); \n";				PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.y,pos.x), 0); \n";			PUSH_LINE_INFO
+				str += "    vec4 B = texelFetch(" + getInputPortName() + ", ivec2(pos.y,posB), 0); \n";				PUSH_LINE_INFO
+			}
+		}
+
+		str += "    float c = cos(-twoPi*p/float(w)), \n";										PUSH_LINE_INFO
+		str += "          s = sin(-twoPi*p/float(w)); \n"; 										PUSH_LINE_INFO
+		
+
+		if(width==currentLevel) // First pass
+		{
+			if((flags & Inversed)!=0)
+			{
+				str += "    A.g = -A.g; \n"; /* real */										PUSH_LINE_INFO
+				str += "    B.g = -B.g; \n"; /* imaginary */									PUSH_LINE_INFO
+			}
+
+			str += "    " + getOutputPortName() + ".r  = A.r + B.r; \n"; /* real */							PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + ".g  = A.g + B.g; \n"; /* imaginary */						PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + ".b  = (A.r - B.r)*c - (A.g - B.g)*s; \n"; /* real */				PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + ".a  = (A.r - B.r)*s + (A.g - B.g)*c; \n"; /* imaginary */			PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    float g = float(posB>pos.x)*2.0 - 1.0; \n";									PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + ".r  = (g*A.r + B.r)*c - (g*A.g + B.g)*s; \n"; /* real */				PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + ".g  = (g*A.r + B.r)*s + (g*A.g + B.g)*c; \n"; /* imaginary */			PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + ".b  = (g*A.b + B.b)*c - (g*A.a + B.a)*s; \n"; /* real */				PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + ".a  = (g*A.b + B.b)*s + (g*A.a + B.a)*c; \n"; /* imaginary */			PUSH_LINE_INFO
+		}
+
+		if((flags & CompatibilityMode)!=0)
+		{
+			str += "    gl_FragColor = " + getOutputPortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		str += "} \n";
+
+		#undef PUSH_LINE_INFO
+
+		//std::cout << "GenerateFFT2DPipeline::generateStepCode(" << width << ", " << currentLevel << ")" << std::endl;
+		//std::cout << str << std::endl;
+
+		return ShaderSource(str, "<GenerateFFT1DPipeline::generate(" + toString(width) +")>", 1, linesInfo);
+	}
+
+	ShaderSource GenerateFFT2DPipeline::generateLastShuffleCode(int width, int oppositeWidth, int flags, bool horizontal, const ShaderSource& post)
+	{
+		// Note that 'width' is generic here, it can be either the width or the height. 'oppositeWidth' is given as the other dimension.
+		// Horizontal must be first.
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		str += "#version 130 \n";													PUSH_LINE_INFO
+		str += "uniform sampler2D " + getInputPortName() + "; \n";									PUSH_LINE_INFO
+
+		if((flags & CompatibilityMode)==0)
+		{
+			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
+		}		
+		else
+		{
+			str += "vec4 " + getOutputPortName() + "; \n";										PUSH_LINE_INFO
+		}
+
+		if(!horizontal && !post.empty())
+		{
+			str += post.getSource();
+			for(int k=0; k<post.getNumLines(); k++)
+				linesInfo[lineCounter+k] = post.getLineInfo(k+1);
+
+			lineCounter += post.getNumLines();
+		}
+
+		str += "\n";															PUSH_LINE_INFO
+		str += "void main() \n";													PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    const int w = " + toString(width) + ", \n";										PUSH_LINE_INFO
+		str += "              h = " + toString(oppositeWidth) + "; \n";									PUSH_LINE_INFO
+		str += "    ivec2 pos = ivec2(gl_FragCoord.xy); \n";										PUSH_LINE_INFO
+
+		if(!horizontal)
+		{
+			str += "    pos.xy = pos.yx; \n";											PUSH_LINE_INFO
+		}
+
+		if((flags & Shifted)!=0 && (flags & Inversed)==0)
+		{
+			str += "    pos.x = int(mod(pos.x + w/2, w)); \n";									PUSH_LINE_INFO
+		}
+
+		str += "    int a = 0; \n";													PUSH_LINE_INFO
+		str += "    for(int k=w/2; k>=1; k=k/2) a = a + int(mod(int(pos.x/k),2))*(w/(2*k)); \n"; /* Bit reversal */			PUSH_LINE_INFO
+		str += "    int p = int(mod(a, w/2));  \n";											PUSH_LINE_INFO
+
+		if(horizontal)
+		{
+			str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(p,pos.y), 0); \n";					PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.y,p), 0); \n";					PUSH_LINE_INFO
+		}
+
+		str += "    if(p<a) A.rg = A.ba; \n";												PUSH_LINE_INFO
+	
+		if((flags & Inversed)!=0)
+		{
+			str += "    A.rg = A.rg * vec2(1.0, -1.0)/w; \n";									PUSH_LINE_INFO
+		}
+
+		str += "    A.ba = vec2(length(A.rg), 1.0); \n";										PUSH_LINE_INFO
+
+		// Apply the post-function, if given : 
+		if(!horizontal && !post.empty())
+		{
+			str += "    A = post(A, gl_FragCoord.xy/vec2(h, w)); \n";								PUSH_LINE_INFO
+		}
+
+		str += "    " + getOutputPortName() + " = A; \n";										PUSH_LINE_INFO
+
+		if((flags & CompatibilityMode)!=0)
+		{
+			str += "    gl_FragColor = " + getOutputPortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		str += "} \n";															PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+
+		//std::cout << "GenerateFFT2DPipeline::generateLastShuffleCode(" << width << ")" << std::endl;
+		//std::cout << str << std::endl;
+
+		return ShaderSource(str, "<GenerateFFT1DPipeline::generate(" + toString(width) +")>", 1, linesInfo);
+	}
+
+	ShaderSource GenerateFFT2DPipeline::generateMixedRadixCode(int width, int height, int numSlices, const FFTModules::Pass& pass, int flags, const ShaderSource& pre, const ShaderSource& post)
+	{
+		// Same as GenerateFFT1DPipeline::generateMixedRadixCode, along the rows (horizontal) or along the columns.
+		// The rows are transformed first, the first pass applies the PRE function and the last vertical pass the POST function.
+
+		// With RealInput, the even and odd columns are packed in a complex image of width hw = width/2 by the first horizontal pass and the first vertical pass extracts the half-spectrum (hw+1 columns) before transforming the columns.
+		// With RealOutput, the columns of the half-spectrum are transformed first, then the first horizontal pass packs the rows and the last horizontal pass interleaves the real and imaginary parts of the result.
+
+		// With the Bluestein algorithm (see GenerateFFT1DPipeline::generateMixedRadixCode), the first pass of the modulated signal reads the data as the first pass of a direction would
+		// and the last pass of the convolution ends the direction. The chirp filter is a single row, shared by all the rows or columns.
+
+		// With Batched, the complex values are vec4 holding two signals (red-green and blue-alpha), see GenerateFFT1DPipeline::generateMixedRadixCode.
+		// With several slices, the images are stacked vertically : the position is split in a slice index and a position in the slice (which is used by fetch, source and read).
+
+		// The twiddle factors and DoublePrecision are handled as in GenerateFFT1DPipeline::generateMixedRadixCode, the table has three rows per direction (see GenerateFFT2DPipeline::getTwiddles).
+
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+		const bool	realInput = (flags & RealInput)!=0,
+				realOutput = (flags & RealOutput)!=0,
+				inversed = (flags & Inversed)!=0 || realOutput,
+				horizontal = pass.horizontal,
+				chirp = (pass.kind==BluesteinChirp),
+				bluestein = chirp || (pass.kind==BluesteinSignal) || (pass.kind==BluesteinConvolution),
+				rows = horizontal || chirp,
+				batched = (flags & Batched)!=0 && !chirp, // The chirp filter is a single signal.
+				twiddleTexture = (flags & TwiddleTexture)!=0,
+				doublePrecision = (flags & DoublePrecision)!=0;
+		const int	halfWidth = (realInput || realOutput) ? width/2 : width,
+				size = horizontal ? halfWidth : height,
+				outputWidth = realInput ? (halfWidth+1) : width,
+				twiddleRow = horizontal ? 0 : 3; // First row of the direction in the twiddle table.
+		const bool	firstInDirection = (pass.kind==MixedRadix || pass.kind==BluesteinSignal) && (pass.span==1),
+				lastInDirection = (pass.kind==MixedRadix || pass.kind==BluesteinConvolution) && (pass.span*pass.radix==pass.length),
+				first = firstInDirection && (horizontal!=realOutput),
+				last = lastInDirection && (horizontal==realOutput);
+		// Number of rows of each slice in the input and output textures (different for the columns transformed with the Bluestein algorithm) :
+		const int	inputRows = (!rows && bluestein && !firstInDirection) ? pass.length : height,
+				outputRows = (!rows && bluestein && !lastInDirection) ? pass.length : height;
+		const std::string	type = batched ? "vec4" : "vec2",
+					channels = batched ? "" : ".rg",
+					conjugate = batched ? "vec4(1.0, -1.0, 1.0, -1.0)" : "vec2(1.0, -1.0)",
+					accumulator = doublePrecision ? (batched ? "dvec4" : "dvec2") : type;
+
+		if(doublePrecision)
+		{
+			str += "#version 150 \n";												PUSH_LINE_INFO
+			str += "#extension GL_ARB_gpu_shader_fp64 : require \n";								PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "#version 130 \n";												PUSH_LINE_INFO
+		}
+
+		str += "const float twoPi = 6.28318530718; \n";											PUSH_LINE_INFO
+		str += "const int w = " + toString(width) + ", \n";										PUSH_LINE_INFO
+		str += "          h = " + toString(height) + ", \n";										PUSH_LINE_INFO
+		str += "          hw = " + toString(halfWidth) + ", \n";									PUSH_LINE_INFO
+		str += "          ns = " + toString(size) + ", \n";										PUSH_LINE_INFO
+		str += "          n = " + toString(pass.length) + ", \n";									PUSH_LINE_INFO
+		str += "          numSlices = " + toString(numSlices) + ", \n";								PUSH_LINE_INFO
+		str += "          si = " + toString(inputRows) + ", \n";									PUSH_LINE_INFO
+		str += "          so = " + toString(outputRows) + "; \n";									PUSH_LINE_INFO
+		str += "int slice = 0; \n";													PUSH_LINE_INFO
+
+		if(!(chirp && pass.span==1) && (!first || (flags & NoInput)==0)) // Not First pass or has an input
+		{
+			str += "uniform sampler2D " + getInputPortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		if(pass.kind==BluesteinConvolution && pass.span==1)
+		{
+			str += "uniform sampler2D " + getChirpPortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		if(twiddleTexture)
+		{
+			str += "uniform sampler2D " + getTwiddlePortName() + "; \n";								PUSH_LINE_INFO
+		}
+
+		if((flags & CompatibilityMode)==0)
+		{
+			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "vec4 " + getOutputPortName() + "; \n";										PUSH_LINE_INFO
+		}
+
+		if(first && !pre.empty())
+		{
+			str += pre.getSource();
+			for(int k=0; k<pre.getNumLines(); k++)
+				linesInfo[lineCounter+k] = pre.getLineInfo(k+1);
+
+			lineCounter += pre.getNumLines();
+		}
+
+		if(last && !post.empty())
+		{
+			str += post.getSource();
+			for(int k=0; k<post.getNumLines(); k++)
+				linesInfo[lineCounter+k] = post.getLineInfo(k+1);
+
+			lineCounter += post.getNumLines();
+		}
+
+		str += "\n";															PUSH_LINE_INFO
+		str += "vec2 mul(in vec2 a, in vec2 e) \n";											PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    return vec2(a.x*e.x - a.y*e.y, a.x*e.y + a.y*e.x); \n";							PUSH_LINE_INFO
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
+
+		if(batched)
+		{
+			str += "vec4 mul(in vec4 a, in vec2 e) \n";										PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    return vec4(mul(a.xy, e), mul(a.zw, e)); \n";								PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		// exp(-2i*pi*k/order), the row of the table has this order :
+		str += "vec2 twiddle(in int k, in int order, in int row) \n";									PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+
+		if(twiddleTexture)
+		{
+			str += "    return texelFetch(" + getTwiddlePortName() + ", ivec2(k, row), 0).rg; \n";					PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    float p = -twoPi*float(k)/float(order); \n";								PUSH_LINE_INFO
+			str += "    return vec2(cos(p), sin(p)); \n";										PUSH_LINE_INFO
+		}
+
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
+
+		if(doublePrecision)
+		{
+			str += "dvec2 mul(in dvec2 a, in dvec2 e) \n";										PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    return dvec2(a.x*e.x - a.y*e.y, a.x*e.y + a.y*e.x); \n";						PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+
+			if(batched)
+			{
+				str += "dvec4 mul(in dvec4 a, in dvec2 e) \n";									PUSH_LINE_INFO
+				str += "{ \n";													PUSH_LINE_INFO
+				str += "    return dvec4(mul(a.xy, e), mul(a.zw, e)); \n";							PUSH_LINE_INFO
+				str += "} \n";													PUSH_LINE_INFO
+				str += "\n";													PUSH_LINE_INFO
+			}
+
+			// The table also holds the rounding errors of the factors :
+			str += "dvec2 preciseTwiddle(in int k, in int order, in int row) \n";							PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+
+			if(twiddleTexture)
+			{
+				str += "    vec4 c = texelFetch(" + getTwiddlePortName() + ", ivec2(k, row), 0); \n";				PUSH_LINE_INFO
+				str += "    return dvec2(c.rg) + dvec2(c.ba); \n";								PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    return dvec2(twiddle(k, order, row)); \n";							PUSH_LINE_INFO
+			}
+
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		if(bluestein)
+		{
+			// c[k] = exp(-i*pi*k^2/ns), the phase is reduced with integers :
+			str += "vec2 modulation(in int k) \n";											PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    return twiddle((k*k) % (2*ns), 2*ns, " + toString(twiddleRow+2) + "); \n";					PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		if(first)
+		{
+			// Read the input at the position (x, y) of the current slice, of size s :
+			str += "vec4 read(in int x, in int y, in ivec2 s) \n";									PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+			str += "    vec2 iv = (vec2(x, y)+vec2(0.5))/vec2(s); \n";								PUSH_LINE_INFO
+
+			if((flags & NoInput)==0)
+			{
+				str += "    vec4 c = texture(" + getInputPortName() + ", (vec2(x, y + slice*s.y)+vec2(0.5))/vec2(s.x, s.y*numSlices)); \n";	PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    vec4 c = vec4(0.0, 0.0, 0.0, 0.0); \n";								PUSH_LINE_INFO
+			}
+
+			// Apply the pre-function, if given :
+			if(!pre.empty())
+			{
+				str += "    c = pre(c, iv); \n";										PUSH_LINE_INFO
+			}
+
+			str += "    return c; \n";												PUSH_LINE_INFO
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		if(firstInDirection)
+		{
+			// With the Bluestein algorithm, the data is read by 'source' and modulated by 'fetch' :
+			str += type + ((pass.kind==BluesteinSignal) ? " source(in int x, in int y) \n" : " fetch(in int x, in int y) \n");		PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+
+			if(first && realInput)
+			{
+				str += "    vec4 a = read(2*x, y, ivec2(w, h)), \n";								PUSH_LINE_INFO
+				str += "         b = read(2*x+1, y, ivec2(w, h)); \n";								PUSH_LINE_INFO
+				str += std::string(batched ? "    return vec4(a.r, b.r, a.b, b.b); \n" : "    return vec2(a.r, b.r); \n");		PUSH_LINE_INFO
+			}
+			else if(first)
+			{
+				if((flags & Shifted)!=0 && inversed)
+				{
+					if(!realOutput)
+					{
+						str += "    x = (x + w/2) % w; \n";								PUSH_LINE_INFO
+					}
+					str += "    y = (y + h/2) % h; \n";									PUSH_LINE_INFO
+				}
+
+				str += "    vec4 c = read(x, y, ivec2(" + std::string(realOutput ? "hw+1" : "w") + ", h)); \n";			PUSH_LINE_INFO
+
+				if(inversed)
+				{
+					str += "    c = c * vec4(1.0, -1.0, 1.0, -1.0); \n";						PUSH_LINE_INFO
+				}
+
+				str += "    return c" + channels + "; \n";									PUSH_LINE_INFO
+			}
+			else if(!horizontal && realInput)
+			{
+				// X[x] = E[x] + exp(-2i*pi*x/w)*O[x], with E = (Z[x] + Z*[hw-x])/2 and O = (Z[x] - Z*[hw-x])/(2i) :
+				str += "    " + type + " a = texelFetch(" + getInputPortName() + ", ivec2(x % hw, y + slice*si), 0)" + channels + ", \n";	PUSH_LINE_INFO
+				str += "         b = texelFetch(" + getInputPortName() + ", ivec2((hw-x) % hw, y + slice*si), 0)" + channels + " * " + conjugate + ", \n";	PUSH_LINE_INFO
+				str += "         e = (a + b)*0.5, \n";										PUSH_LINE_INFO
+				str += "         o = mul((a - b)*0.5, vec2(0.0, -1.0)); \n";							PUSH_LINE_INFO
+				str += "    return e + mul(o, twiddle(x, w, 1)); \n";							PUSH_LINE_INFO
+			}
+			else if(horizontal && realOutput)
+			{
+				// Z = E + iO with E = (X[x] + X*[hw-x])/2 and O = (X[x] - X*[hw-x])*exp(2i*pi*x/w)/2, conjugated for the reciprocal transform :
+				str += "    " + type + " a = texelFetch(" + getInputPortName() + ", ivec2(x, y + slice*si), 0)" + channels + ", \n";		PUSH_LINE_INFO
+				str += "         b = texelFetch(" + getInputPortName() + ", ivec2(hw-x, y + slice*si), 0)" + channels + " * " + conjugate + ", \n";	PUSH_LINE_INFO
+				str += "         e = (a + b)*0.5, \n";										PUSH_LINE_INFO
+				str += "         d = (a - b)*0.5, \n";										PUSH_LINE_INFO
+				str += "         o = mul(d, twiddle((w-x) % w, w, 1)); \n";							PUSH_LINE_INFO
+				str += "    return (e + mul(o, vec2(0.0, 1.0))) * " + conjugate + "; \n";						PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    return texelFetch(" + getInputPortName() + ", ivec2(x, y + slice*si), 0)" + channels + "; \n";		PUSH_LINE_INFO
+			}
+
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		if(!firstInDirection || pass.kind==BluesteinSignal)
+		{
+			// Fetch the input of the butterfly, the index k is along the transform :
+			str += type + " fetch(in int x, in int y) \n";									PUSH_LINE_INFO
+			str += "{ \n";														PUSH_LINE_INFO
+
+			if(firstInDirection || pass.span==1)
+			{
+				str += std::string(rows ? "    int k = x; \n" : "    int k = y; \n");					PUSH_LINE_INFO
+			}
+
+			if(firstInDirection) // Modulated signal, padded with zeros :
+			{
+				str += "    if(k>=ns) return " + type + "(0.0); \n";							PUSH_LINE_INFO
+				str += "    return mul(source(x, y), modulation(k)); \n";							PUSH_LINE_INFO
+			}
+			else if(chirp && pass.span==1) // Chirp filter :
+			{
+				str += "    if(k<ns) return modulation(k) * vec2(1.0, -1.0); \n";						PUSH_LINE_INFO
+				str += "    else if(k>n-ns) return modulation(n-k) * vec2(1.0, -1.0); \n";					PUSH_LINE_INFO
+				str += "    else return vec2(0.0, 0.0); \n";								PUSH_LINE_INFO
+			}
+			else if(pass.kind==BluesteinConvolution && pass.span==1) // Conjugate of the product of the transforms :
+			{
+				str += "    " + type + " a = texelFetch(" + getInputPortName() + ", ivec2(x, y + slice*si), 0)" + channels + "; \n";	PUSH_LINE_INFO
+				str += "    vec2 b = texelFetch(" + getChirpPortName() + ", ivec2(k, 0), 0).rg; \n";				PUSH_LINE_INFO
+				str += "    return mul(a, b) * " + conjugate + "; \n";								PUSH_LINE_INFO
+			}
+			else
+			{
+				str += "    return texelFetch(" + getInputPortName() + ", ivec2(x, y + slice*si), 0)" + channels + "; \n";		PUSH_LINE_INFO
+			}
+
+			str += "} \n";														PUSH_LINE_INFO
+			str += "\n";														PUSH_LINE_INFO
+		}
+
+		str += "void main() \n";													PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    const int r = " + toString(pass.radix) + ", \n";								PUSH_LINE_INFO
+		str += "              s = " + toString(pass.span) + ", \n";								PUSH_LINE_INFO
+		str += "              l = " + toString(pass.span*pass.radix) + "; \n";							PUSH_LINE_INFO
+		str += "    ivec2 pos = ivec2(gl_FragCoord.xy); \n";										PUSH_LINE_INFO
+
+		if(!chirp)
+		{
+			str += "    slice = pos.y / so; \n";											PUSH_LINE_INFO
+			str += "    pos.y = pos.y % so; \n";										PUSH_LINE_INFO
+		}
+
+		if(!rows)
+		{
+			str += "    pos.xy = pos.yx; \n";											PUSH_LINE_INFO
+		}
+
+		if(last && realOutput)
+		{
+			// Two consecutive outputs share the same complex value :
+			str += "    int u = pos.x % 2; \n";											PUSH_LINE_INFO
+			str += "    pos.x = pos.x/2; \n";											PUSH_LINE_INFO
+		}
+		else if(lastInDirection && (flags & Shifted)!=0 && !inversed && (!horizontal || !realInput)) // The half-spectrum is not shifted horizontally.
 		{
-			str += "uniform sampler2D " + getInputPortName() + "; \n";								PUSH_LINE_INFO
+			str += "    pos.x = (pos.x + (ns+1)/2) % ns; \n";									PUSH_LINE_INFO
 		}
 
-		if((flags & CompatibilityMode)==0)
+		str += "    int t = pos.x % l, \n";												PUSH_LINE_INFO
+		str += "        j = (pos.x/l)*s + pos.x % s; \n";										PUSH_LINE_INFO
+		str += "    " + accumulator + " " + std::string(doublePrecision ? "sum" : "v") + " = " + accumulator + "(0.0); \n";		PUSH_LINE_INFO
+		str += "    for(int m=0; m<r; m++) \n";											PUSH_LINE_INFO
+		str += "    { \n";														PUSH_LINE_INFO
+
+		if(rows)
 		{
-			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
+			str += "        " + type + " a = fetch(j + m*(n/r), pos.y); \n";							PUSH_LINE_INFO
 		}
 		else
 		{
-			str += "vec4 " + getOutputPortName() + "; \n";										PUSH_LINE_INFO
+			str += "        " + type + " a = fetch(pos.y, j + m*(n/r)); \n";							PUSH_LINE_INFO
 		}
 
-		if(horizontal && width==currentLevel && !pre.empty()) // First pass and pre-function
+		if(doublePrecision)
 		{
-			str += pre.getSource();
-			for(int k=0; k<pre.getNumLines(); k++)
-				linesInfo[lineCounter+k] = pre.getLineInfo(k+1);
-
-			lineCounter += pre.getNumLines();
+			str += "        sum += mul(" + accumulator + "(a), preciseTwiddle(((m*t) % l)*(n/l), n, " + toString(twiddleRow) + ")); \n";	PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "        v += mul(a, twiddle(((m*t) % l)*(n/l), n, " + toString(twiddleRow) + ")); \n";			PUSH_LINE_INFO
 		}
 
-		str += "\n";															PUSH_LINE_INFO
-		str += "void main() \n";													PUSH_LINE_INFO
-		str += "{ \n";															PUSH_LINE_INFO
-		str += "    const int w = " + toString(width) + ", \n";										PUSH_LINE_INFO
-		str += "              h = " + toString(oppositeWidth) + ", \n";									PUSH_LINE_INFO
-		str += "              l = " + toString(currentLevel) + "; \n";									PUSH_LINE_INFO
-		str += "    ivec2 pos = ivec2(gl_FragCoord.xy); \n";										PUSH_LINE_INFO
+		str += "    } \n";														PUSH_LINE_INFO
 
-		if(!horizontal)
+		if(doublePrecision)
 		{
-			str += "    pos.xy = pos.yx; \n";											PUSH_LINE_INFO
+			str += "    " + type + " v = " + type + "(sum); \n";								PUSH_LINE_INFO
 		}
 
-		str += "    int posB = int(mod((mod(pos.x, l) - l/2), l) + int(pos.x/l)*l); \n";						PUSH_LINE_INFO
-
-		if(width==currentLevel) // First pass in the current direction
+		if(lastInDirection && pass.kind==BluesteinConvolution)
 		{
-			str += "    float p = floor((2*mod(pos.x+w/2,w))/w)*floor(mod(pos.x+w/2, w/2)); \n";					PUSH_LINE_INFO
+			// Reciprocal transform and demodulation :
+			str += "    v = mul(v * " + conjugate + "/float(n), modulation(pos.x)); \n";						PUSH_LINE_INFO
+		}
 
-			if((flags & Shifted)!=0 && (flags & Inversed)!=0)
-			{
-				str += "    pos.x = int(mod(pos.x + w/2, w)); \n";								PUSH_LINE_INFO
-				str += "    posB = int(mod(posB + w/2, w)); \n";								PUSH_LINE_INFO
-			}
-			
-			if(horizontal)
+		if(last)
+		{
+			if(realOutput)
 			{
-				// Also real first pass :
-				str += "    vec2 ivA = vec2((float(pos.x)+0.5)/float(w),(float(pos.y)+0.5)/float(h)), \n";			PUSH_LINE_INFO
-				str += "         ivB = vec2((float(posB)+0.5)/float(w),(float(pos.y)+0.5)/float(h)); \n";			PUSH_LINE_INFO
+				str += "    v = v * " + conjugate + "/float(hw); \n";								PUSH_LINE_INFO
 
-				if((flags & NoInput)==0)
+				if(batched)
 				{
-					str += "    vec4 A = texture(" + getInputPortName() + ", ivA); \n";					PUSH_LINE_INFO
-					str += "    vec4 B = texture(" + getInputPortName() + ", ivB); \n";					PUSH_LINE_INFO
+					str += "    vec2 x = (u==0) ? v.xz : v.yw; \n";							PUSH_LINE_INFO
+					str += "    vec4 A = vec4(x.x, 0.0, x.y, 0.0); \n";							PUSH_LINE_INFO
 				}
 				else
 				{
-					str += "    vec4 A = vec4(0.0, 0.0, 0.0, 0.0); \n";							PUSH_LINE_INFO
-					str += "    vec4 B = vec4(0.0, 0.0, 0.0, 0.0); \n";							PUSH_LINE_INFO
-				}
-
-				// Apply the pre-function, if given : 
-				if(!pre.empty())
-				{
-					str += "    A = pre(A, ivA); \n";									PUSH_LINE_INFO
-					str += "    B = pre(B, ivB); \n";									PUSH_LINE_INFO
+					str += "    float x = (u==0) ? v.x : v.y; \n";								PUSH_LINE_INFO
+					str += "    vec4 A = vec4(x, 0.0, abs(x), 1.0); \n";							PUSH_LINE_INFO
 				}
 			}
 			else
 			{
-				// Second pass, read from first horizontal pass compressed format :
-				if((flags & Shifted)!=0 && (flags & Inversed)==0)
+				if(inversed)
 				{
-					str += "    pos.y = int(mod(pos.y + w/2, w)); \n";							PUSH_LINE_INFO
+					str += "    v = v * " + conjugate + "/(float(w)*float(h)); \n";						PUSH_LINE_INFO
 				}
 
-				str += "    int a = 0; \n";											PUSH_LINE_INFO
-				str += "    for(int k=w/2; k>=1; k=k/2) a = a + int(mod(int(pos.y/k),2))*(w/(2*k)); \n"; 			PUSH_LINE_INFO
-				str += "    pos.y = int(mod(a, w/2));  \n";									PUSH_LINE_INFO
-
-				// Read : 
-				str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.y,pos.x), 0); \n";			PUSH_LINE_INFO
-				str += "    vec4 B = texelFetch(" + getInputPortName() + ", ivec2(pos.y,posB), 0); \n";				PUSH_LINE_INFO
-
-				// read from first horizontal pass, second part : 
-				str += "    if(pos.y<a) { A.rg = A.ba; B.rg = B.ba; } \n";							PUSH_LINE_INFO
-
-				if((flags & Inversed)!=0)
-				{
-					str += "    A.rg = A.rg * vec2(1.0, -1.0)/h; \n";							PUSH_LINE_INFO
-					str += "    B.rg = B.rg * vec2(1.0, -1.0)/h; \n";							PUSH_LINE_INFO
-				}
+				str += std::string(batched ? "    vec4 A = v; \n" : "    vec4 A = vec4(v, length(v), 1.0); \n");		PUSH_LINE_INFO
 			}
-		}		
-		else
-		{
-			str += "    float p = floor((2*mod(pos.x,l))/l)*floor(mod(pos.x, l/2))*(w/l); \n";					PUSH_LINE_INFO
 
-			if(horizontal)
-			{
-				str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.x,pos.y), 0); \n";			PUSH_LINE_INFO
-				str += "    vec4 B = texelFetch(" + getInputPortName() + ", ivec2(posB,pos.y), 0); \n";				PUSH_LINE_INFO
-			}
-			else
+			// Apply the post-function, if given :
+			if(!post.empty())
 			{
-				str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.y,pos.x), 0); \n";			PUSH_LINE_INFO
-				str += "    vec4 B = texelFetch(" + getInputPortName() + ", ivec2(pos.y,posB), 0); \n";				PUSH_LINE_INFO
+				str += "    A = post(A, vec2(gl_FragCoord.x, mod(gl_FragCoord.y, float(h)))/vec2(" + toString(outputWidth) + ", h)); \n";	PUSH_LINE_INFO
 			}
-		}
-
-		str += "    float c = cos(-twoPi*p/float(w)), \n";										PUSH_LINE_INFO
-		str += "          s = sin(-twoPi*p/float(w)); \n"; 										PUSH_LINE_INFO
-		
 
-		if(width==currentLevel) // First pass
+			str += "    " + getOutputPortName() + " = A; \n";									PUSH_LINE_INFO
+		}
+		else
 		{
-			if((flags & Inversed)!=0)
+			if(realOutput && lastInDirection) // End of the reciprocal transform of the columns.
 			{
-				str += "    A.g = -A.g; \n"; /* real */										PUSH_LINE_INFO
-				str += "    B.g = -B.g; \n"; /* imaginary */									PUSH_LINE_INFO
+				str += "    v = v * " + conjugate + "/float(h); \n";								PUSH_LINE_INFO
 			}
 
-			str += "    " + getOutputPortName() + ".r  = A.r + B.r; \n"; /* real */							PUSH_LINE_INFO
-			str += "    " + getOutputPortName() + ".g  = A.g + B.g; \n"; /* imaginary */						PUSH_LINE_INFO
-			str += "    " + getOutputPortName() + ".b  = (A.r - B.r)*c - (A.g - B.g)*s; \n"; /* real */				PUSH_LINE_INFO
-			str += "    " + getOutputPortName() + ".a  = (A.r - B.r)*s + (A.g - B.g)*c; \n"; /* imaginary */			PUSH_LINE_INFO
-		}
-		else
-		{
-			str += "    float g = float(posB>pos.x)*2.0 - 1.0; \n";									PUSH_LINE_INFO
-			str += "    " + getOutputPortName() + ".r  = (g*A.r + B.r)*c - (g*A.g + B.g)*s; \n"; /* real */				PUSH_LINE_INFO
-			str += "    " + getOutputPortName() + ".g  = (g*A.r + B.r)*s + (g*A.g + B.g)*c; \n"; /* imaginary */			PUSH_LINE_INFO
-			str += "    " + getOutputPortName() + ".b  = (g*A.b + B.b)*c - (g*A.a + B.a)*s; \n"; /* real */				PUSH_LINE_INFO
-			str += "    " + getOutputPortName() + ".a  = (g*A.b + B.b)*s + (g*A.a + B.a)*c; \n"; /* imaginary */			PUSH_LINE_INFO
+			str += "    " + getOutputPortName() + " = " + std::string(batched ? "v" : "vec4(v, 0.0, 0.0)") + "; \n";			PUSH_LINE_INFO
 		}
 
 		if((flags & CompatibilityMode)!=0)
@@ -725,118 +2180,160 @@ namespace Glip
 			str += "    gl_FragColor = " + getOutputPortName() + "; \n";								PUSH_LINE_INFO
 		}
 
-		str += "} \n";
+		str += "} \n";															PUSH_LINE_INFO
 
 		#undef PUSH_LINE_INFO
 
-		//std::cout << "GenerateFFT2DPipeline::generateStepCode(" << width << ", " << currentLevel << ")" << std::endl;
-		//std::cout << str << std::endl;
-
-		return ShaderSource(str, "<GenerateFFT1DPipeline::generate(" + toString(width) +")>", 1, linesInfo);
+		return ShaderSource(str, "<GenerateFFT2DPipeline::generate(" + toString(width) + ", " + toString(height) + ")>", 1, linesInfo);
 	}
 
-	ShaderSource GenerateFFT2DPipeline::generateLastShuffleCode(int width, int oppositeWidth, int flags, bool horizontal, const ShaderSource& post)
-	{
-		// Note that 'width' is generic here, it can be either the width or the height. 'oppositeWidth' is given as the other dimension.
-		// Horizontal must be first.
-
-		std::string str;
-		std::map<int,ShaderSource::LineInfo> linesInfo;
-
-		int lineCounter = 1;
-		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
-
-		str += "#version 130 \n";													PUSH_LINE_INFO
-		str += "uniform sampler2D " + getInputPortName() + "; \n";									PUSH_LINE_INFO
+	/**
+	\fn std::vector<FFTModules::Pass> GenerateFFT2DPipeline::getPlan(int width, int height, int flags, int numSlices)
+	\brief Get the passes performed by the pipeline returned by GenerateFFT2DPipeline::generate.
+	\param width Width of the signal.
+	\param height Height of the signal.
+	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
+	\param numSlices Number of signals stacked vertically in the texture.
+	\return The passes of the transform, in order. The description can be printed with Glip::Modules::FFTModules::getPlanDescription.
 
-		if((flags & CompatibilityMode)==0)
-		{
-			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
-		}		
-		else
-		{
-			str += "vec4 " + getOutputPortName() + "; \n";										PUSH_LINE_INFO
-		}
+	With the Bluestein algorithm, the passes transforming the chirp filter form a separate branch of the pipeline, their output is a single row.
+	**/
+	std::vector<FFTModules::Pass> GenerateFFT2DPipeline::getPlan(int width, int height, int flags, int numSlices)
+	{
+		if(width<4)
+			throw Exception("Width must be at least 4 (current value : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
+		if(height<4)
+			throw Exception("Height must be at least 4 (current value : " + toString(height) + ").", __FILE__, __LINE__, Exception::ModuleException);
 
-		if(!horizontal && !post.empty())
+		if((flags & RealInput)!=0 && (flags & RealOutput)!=0)
+			throw Exception("The flags RealInput and RealOutput cannot be used together.", __FILE__, __LINE__, Exception::ModuleException);
+
+		const bool real = (flags & (RealInput | RealOutput))!=0;
+
+		if(real && (flags & Radix2)!=0)
+			throw Exception("The flags RealInput and RealOutput cannot be used with the flag Radix2.", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & RealInput)!=0 && (flags & Inversed)!=0)
+			throw Exception("The flag RealInput cannot be used with the flag Inversed (see RealOutput).", __FILE__, __LINE__, Exception::ModuleException);
+		if(real && width%2!=0)
+			throw Exception("Width must be even with the flags RealInput and RealOutput (current value : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & Batched)!=0 && (flags & Radix2)!=0)
+			throw Exception("The flag Batched cannot be used with the flag Radix2.", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & (TwiddleTexture | DoublePrecision))!=0 && (flags & Radix2)!=0)
+			throw Exception("The flags TwiddleTexture and DoublePrecision cannot be used with the flag Radix2.", __FILE__, __LINE__, Exception::ModuleException);
+		if((flags & DoublePrecision)!=0 && (flags & CompatibilityMode)!=0)
+			throw Exception("The flag DoublePrecision cannot be used with the flag CompatibilityMode.", __FILE__, __LINE__, Exception::ModuleException);
+		if(numSlices<1)
+			throw Exception("The number of slices must be at least 1 (current value : " + toString(numSlices) + ").", __FILE__, __LINE__, Exception::ModuleException);
+		if(numSlices>1 && (flags & Radix2)!=0)
+			throw Exception("The flag Radix2 cannot be used with several slices.", __FILE__, __LINE__, Exception::ModuleException);
+
+		std::vector<Pass> plan;
+
+		if((flags & Radix2)!=0)
 		{
-			str += post.getSource();
-			for(int k=0; k<post.getNumLines(); k++)
-				linesInfo[lineCounter+k] = post.getLineInfo(k+1);
-
-			lineCounter += post.getNumLines();
-		}
-
-		str += "\n";															PUSH_LINE_INFO
-		str += "void main() \n";													PUSH_LINE_INFO
-		str += "{ \n";															PUSH_LINE_INFO
-		str += "    const int w = " + toString(width) + ", \n";										PUSH_LINE_INFO
-		str += "              h = " + toString(oppositeWidth) + "; \n";									PUSH_LINE_INFO
-		str += "    ivec2 pos = ivec2(gl_FragCoord.xy); \n";										PUSH_LINE_INFO
+			double 	test1w = std::log(width)/std::log(2),
+				test2w = std::floor(test1w),
+				test1h = std::log(height)/std::log(2),
+				test2h = std::floor(test1h);
 
-		if(!horizontal)
-		{
-			str += "    pos.xy = pos.yx; \n";											PUSH_LINE_INFO
-		}
+			if(test1w!=test2w)
+				throw Exception("Width must be a power of 2 with the flag Radix2 (current value : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
+			if(test1h!=test2h)
+				throw Exception("Height must be a power of 2 with the flag Radix2 (current value : " + toString(height) + ").", __FILE__, __LINE__, Exception::ModuleException);
 
-		if((flags & Shifted)!=0 && (flags & Inversed)==0)
-		{
-			str += "    pos.x = int(mod(pos.x + w/2, w)); \n";									PUSH_LINE_INFO
-		}
+			for(int l=width; l>1; l/=2)
+				plan.push_back(Pass("FilterH" + toString(l), Radix2Butterfly, 2, l, width, width/2, height, true));
 
-		str += "    int a = 0; \n";													PUSH_LINE_INFO
-		str += "    for(int k=w/2; k>=1; k=k/2) a = a + int(mod(int(pos.x/k),2))*(w/(2*k)); \n"; /* Bit reversal */			PUSH_LINE_INFO
-		str += "    int p = int(mod(a, w/2));  \n";											PUSH_LINE_INFO
+			for(int l=height; l>1; l/=2)
+				plan.push_back(Pass("FilterV" + toString(l), Radix2Butterfly, 2, l, height, width, height/2, false));
 
-		if(horizontal)
-		{
-			str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(p,pos.y), 0); \n";					PUSH_LINE_INFO
+			plan.push_back(Pass("FilterFinalShuffle", Radix2Shuffle, 1, 1, height, width, height, false));
 		}
 		else
 		{
-			str += "    vec4 A = texelFetch(" + getInputPortName() + ", ivec2(pos.y,p), 0); \n";					PUSH_LINE_INFO
-		}
+			// With the real flags, the rows are transformed as complex signals of half the width and the columns of the half-spectrum (width/2+1 columns).
+			// The reciprocal transform to a real signal starts with the columns :
+			const int 	halfWidth = real ? width/2 : width,
+					numColumns = real ? (halfWidth+1) : width;
 
-		str += "    if(p<a) A.rg = A.ba; \n";												PUSH_LINE_INFO
-	
-		if((flags & Inversed)!=0)
-		{
-			str += "    A.rg = A.rg * vec2(1.0, -1.0)/w; \n";									PUSH_LINE_INFO
-		}
+			for(int d=0; d<2; d++)
+			{
+				const bool horizontal = ((d==0)!=((flags & RealOutput)!=0));
+				std::vector<Pass> passes = getPasses(horizontal ? halfWidth : height, flags);
 
-		str += "    A.ba = vec2(length(A.rg), 1.0); \n";										PUSH_LINE_INFO
+				for(std::vector<Pass>::iterator it=passes.begin(); it!=passes.end(); it++)
+				{
+					it->name = std::string(horizontal ? "FilterH" : "FilterV") + it->name;
+					it->horizontal = horizontal;
+
+					if(it->kind==BluesteinChirp) // Single row.
+						continue;
+					else if(horizontal)
+						it->height = height * numSlices;
+					else
+					{
+						it->height = it->width * numSlices;
+						it->width = numColumns;
+					}
+				}
 
-		// Apply the post-function, if given : 
-		if(!horizontal && !post.empty())
-		{
-			str += "    A = post(A, gl_FragCoord.xy/vec2(h, w)); \n";								PUSH_LINE_INFO
+				plan.insert(plan.end(), passes.begin(), passes.end());
+			}
+
+			if((flags & RealOutput)!=0)
+				plan.back().width = width;
 		}
 
-		str += "    " + getOutputPortName() + " = A; \n";										PUSH_LINE_INFO
+		return plan;
+	}
 
-		if((flags & CompatibilityMode)!=0)
-		{
-			str += "    gl_FragColor = " + getOutputPortName() + "; \n";								PUSH_LINE_INFO
-		}
+	/**
+	\fn HdlTextureFormat GenerateFFT2DPipeline::getTwiddleFormat(int width, int height, int flags)
+	\brief Get the format of the texture expected by the port <i>twiddleTexture</i> with the flag TwiddleTexture.
+	\param width Width of the signal.
+	\param height Height of the signal.
+	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
+	\return The format of the table of twiddle factors (GL_RGBA32F, six rows).
+	**/
+	HdlTextureFormat GenerateFFT2DPipeline::getTwiddleFormat(int width, int height, int flags)
+	{
+		getPlan(width, height, flags); // Check the flags.
 
-		str += "} \n";															PUSH_LINE_INFO
+		const std::vector<int> 	horizontalOrders = getTwiddleOrders(width, flags),
+					verticalOrders = getTwiddleOrders(height, flags & ~(RealInput | RealOutput));
+		const int tableWidth = std::max(*std::max_element(horizontalOrders.begin(), horizontalOrders.end()), *std::max_element(verticalOrders.begin(), verticalOrders.end()));
 
-		#undef PUSH_LINE_INFO
+		return HdlTextureFormat(tableWidth, 6, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+	}
 
-		//std::cout << "GenerateFFT2DPipeline::generateLastShuffleCode(" << width << ")" << std::endl;
-		//std::cout << str << std::endl;
+	/**
+	\fn std::vector<float> GenerateFFT2DPipeline::getTwiddles(int width, int height, int flags)
+	\brief Compute the table of twiddle factors expected by the port <i>twiddleTexture</i> with the flag TwiddleTexture.
+	\param width Width of the signal.
+	\param height Height of the signal.
+	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
+	\return The content of the texture, of format GenerateFFT2DPipeline::getTwiddleFormat : the three rows of the horizontal direction followed by the three rows of the vertical direction (see Glip::Modules::FFTModules::getTwiddleTable).
+	**/
+	std::vector<float> GenerateFFT2DPipeline::getTwiddles(int width, int height, int flags)
+	{
+		getPlan(width, height, flags); // Check the flags.
 
-		return ShaderSource(str, "<GenerateFFT1DPipeline::generate(" + toString(width) +")>", 1, linesInfo);
+		std::vector<int> 	orders = getTwiddleOrders(width, flags),
+					verticalOrders = getTwiddleOrders(height, flags & ~(RealInput | RealOutput));
+		orders.insert(orders.end(), verticalOrders.begin(), verticalOrders.end());
+
+		return getTwiddleTable(orders);
 	}
 
 	/**
-	\fn PipelineLayout GenerateFFT2DPipeline::generate(int width, int height, int flags)
+	\fn PipelineLayout GenerateFFT2DPipeline::generate(int width, int height, int flags, const ShaderSource& pre, const ShaderSource& post, int numSlices)
 	\brief Construct a pipeline performing a 2D FFT.
 	\param width Width of the signal.
 	\param height Height of the signal.
 	\param flags Possible flags associated to the transformation (see Glip::Modules::FFTModules::Flag).
 	\param pre Add a filtering function before the transform.
 	\param post Add a filtering function after the transform.
+	\param numSlices Number of signals stacked vertically in the texture (its size is then width x height*numSlices).
 	\return A complete pipeline layout.
 
 	The <b>pre-function</b> will be inserted before the transform. It should be a block of code declaring the function <i>pre</i> as in the following example : 
@@ -857,22 +2354,9 @@ namespace Glip
 
 	Each time, the position is normalized from 0.0 to 1.0. You are allowed to declare uniform variables in these filters.
 	**/
-	PipelineLayout GenerateFFT2DPipeline::generate(int width, int height, int flags, const ShaderSource& pre, const ShaderSource& post)
+	PipelineLayout GenerateFFT2DPipeline::generate(int width, int height, int flags, const ShaderSource& pre, const ShaderSource& post, int numSlices)
 	{
-		double 	test1w = std::log(width)/std::log(2),
-			test2w = std::floor(test1w),
-			test1h = std::log(height)/std::log(2),
-			test2h = std::floor(test1h);
-
-		if(test1w!=test2w)
-			throw Exception("Width must be a power of 2 (current value : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
-		if(width<4)
-			throw Exception("Width must be at least 4 (current value : " + toString(width) + ").", __FILE__, __LINE__, Exception::ModuleException);
-
-		if(test1h!=test2h)
-			throw Exception("Height must be a power of 2 (current value : " + toString(height) + ").", __FILE__, __LINE__, Exception::ModuleException);
-		if(height<4)
-			throw Exception("Height must be at least 4 (current value : " + toString(height) + ").", __FILE__, __LINE__, Exception::ModuleException);
+		const std::vector<Pass> plan = getPlan(width, height, flags, numSlices);
 
 		if((flags & NoInput)!=0 && pre.empty())
 			throw Exception("A PRE-function must be provided when using the flag NoInput.", __FILE__, __LINE__, Exception::ModuleException);
@@ -880,82 +2364,81 @@ namespace Glip
 		if(!pre.getOutputVars().empty() && !pre.requiresCompatibility())
 			throw Exception("A PRE-function cannot have an output (its own output port(s)).", __FILE__, __LINE__, Exception::ModuleException);
 
-		HdlTextureFormat format(width, height, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
-		HdlTextureFormat halfWidthFormat(width/2, height, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
-		HdlTextureFormat halfHeightFormat(width, height/2, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
-		PipelineLayout pipelineLayout("FFT2D" + toString(width) + "x" + toString(height) + "Pipeline");
+		PipelineLayout pipelineLayout("FFT2D" + toString(width) + "x" + toString(height) + ((numSlices>1) ? ("x" + toString(numSlices)) : "") + "Pipeline");
 
 		if((flags & NoInput)==0)
 			pipelineLayout.addInput(getInputPortName());
 
+		if((flags & TwiddleTexture)!=0)
+			pipelineLayout.addInput(getTwiddlePortName());
+
 		pipelineLayout.addOutput(getOutputPortName());
 
 		std::string 	previousName = "",
-				firstFilterName = "";
+				chirpName = "",
+				firstFilterName = "",
+				lastFilterName = "";
 
-		// Horizontal : 
-		for(int l=width; l>1; l/=2)
+		for(std::vector<Pass>::const_iterator it=plan.begin(); it!=plan.end(); it++)
 		{
-			ShaderSource shader = generateRadix2Code(width, height, l, flags, true, pre);
-			std::string name = "FilterH"+ toString(l);
-			FilterLayout filterLayout(name, halfWidthFormat, shader);
-			pipelineLayout.add(filterLayout,name);
+			ShaderSource shader("");
+			if(it->kind==Radix2Butterfly)
+				shader = it->horizontal ? generateRadix2Code(width, height, it->span, flags, true, pre) : generateRadix2Code(height, width, it->span, flags, false, pre);
+			else if(it->kind==Radix2Shuffle)
+				shader = generateLastShuffleCode(height, width, flags, false, post);
+			else
+				shader = generateMixedRadixCode(width, height, numSlices, *it, flags, pre, post);
 
-			if(previousName.empty())
-			{
-				if((flags & NoInput)==0)
-					pipelineLayout.connectToInput(getInputPortName(), name, getInputPortName());
+			// The last pass, the radix-2 butterflies and the batched passes have four channels :
+			const bool last = (it+1)==plan.end();
+			HdlTextureFormat format(it->width, it->height, (last || it->kind==Radix2Butterfly || ((flags & Batched)!=0 && it->kind!=BluesteinChirp)) ? GL_RGBA32F : GL_RG32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+			FilterLayout filterLayout(it->name, format, shader);
+			pipelineLayout.add(filterLayout, it->name);
 
-				if(!pre.empty())
-				{
-					// Add the ports declared in PRE :
-					for(std::vector<std::string>::const_iterator it=pre.getInputVars().begin(); it!=pre.getInputVars().end(); it++)
-					{
-						if((*it)==getInputPortName() && (flags & NoInput)==0)
-							throw Exception("The PRE function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
-						else
-						{
-							pipelineLayout.addInput(*it);
-							pipelineLayout.connectToInput(*it, name, *it);
-						}
-					}
-				}
+			if((flags & TwiddleTexture)!=0)
+				pipelineLayout.connectToInput(getTwiddlePortName(), it->name, getTwiddlePortName());
 
-				firstFilterName = name;
+			if(it->kind==BluesteinChirp) // Separate branch, without input :
+			{
+				if(it->span>1)
+					pipelineLayout.connect(chirpName, getOutputPortName(), it->name, getInputPortName());
+
+				chirpName = it->name;
 			}
 			else
-				pipelineLayout.connect(previousName, getOutputPortName(), name, getInputPortName());
-			
-			previousName = name;
+			{
+				if(previousName.empty()) // First element
+					firstFilterName = it->name;
+				else
+					pipelineLayout.connect(previousName, getOutputPortName(), it->name, getInputPortName());
+
+				if(it->kind==BluesteinConvolution && it->span==1)
+					pipelineLayout.connect(chirpName, getOutputPortName(), it->name, getChirpPortName());
+
+				previousName = it->name;
+			}
 		}
 
-		// Intermediate shuffle (not needed anymore) : 
-		/*const std::string intermediateShuffleFilterName = "FilterIntermediateShuffle";
-		ShaderSource intermediateShader = generateLastShuffleCode(width, height, flags, true, post);
-		FilterLayout intermediateFilterLayout(intermediateShuffleFilterName, format, intermediateShader);
-		pipelineLayout.add(intermediateFilterLayout,intermediateShuffleFilterName);
-		pipelineLayout.connect(previousName, getOutputPortName(), intermediateShuffleFilterName, inputPortName);
-		previousName = intermediateShuffleFilterName;*/
+		lastFilterName = previousName;
 
-		// Vertical : 
-		for(int l=height; l>1; l/=2)
-		{
-			ShaderSource shader = generateRadix2Code(height, width, l, flags, false, pre);
-			std::string name = "FilterV"+ toString(l);
-			FilterLayout filterLayout(name, halfHeightFormat, shader);
-			pipelineLayout.add(filterLayout,name);
+		if((flags & NoInput)==0)
+			pipelineLayout.connectToInput(getInputPortName(), firstFilterName, getInputPortName());
 
-			pipelineLayout.connect(previousName, getOutputPortName(), name, getInputPortName());
-			previousName = name;
+		if(!pre.empty())
+		{
+			// Add the ports declared in PRE :
+			for(std::vector<std::string>::const_iterator it=pre.getInputVars().begin(); it!=pre.getInputVars().end(); it++)
+			{
+				if((*it)==getInputPortName() && (flags & NoInput)==0)
+					throw Exception("The PRE function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
+				else
+				{
+					pipelineLayout.addInput(*it);
+					pipelineLayout.connectToInput(*it, firstFilterName, *it);
+				}
+			}
 		}
 
-		// Last : 
-		const std::string finalShuffleFilterName = "FilterFinalShuffle";
-		ShaderSource finalShader = generateLastShuffleCode(height, width, flags, false, post);
-		FilterLayout finalFilterLayout(finalShuffleFilterName, format, finalShader);
-		pipelineLayout.add(finalFilterLayout, finalShuffleFilterName);
-		pipelineLayout.connect(previousName, getOutputPortName(), finalShuffleFilterName, getInputPortName());
-
 		// Add the ports declared in post : 
 		if(!post.empty())
 		{
@@ -966,7 +2449,7 @@ namespace Glip
 				else
 				{
 					pipelineLayout.addInput(*it);
-					pipelineLayout.connectToInput(*it, finalShuffleFilterName, *it);
+					pipelineLayout.connectToInput(*it, lastFilterName, *it);
 				}
 			}
 
@@ -977,13 +2460,13 @@ namespace Glip
 				else if((*it)!=getOutputPortName())
 				{
 					pipelineLayout.addOutput(*it);
-					pipelineLayout.connectToOutput(finalShuffleFilterName, *it, *it);
+					pipelineLayout.connectToOutput(lastFilterName, *it, *it);
 				}
 			}
 		}
 
 		// Connect to output :
-		pipelineLayout.connectToOutput(finalShuffleFilterName, getOutputPortName(), getOutputPortName());
+		pipelineLayout.connectToOutput(lastFilterName, getOutputPortName(), getOutputPortName());
 
 		return pipelineLayout;
 	}
@@ -1033,10 +2516,18 @@ namespace Glip
 			height = _height;
 		}
 
-		// Read the flags : 
-		int flags = 0;
+		// Read the flags and the number of slices : 
+		int 	flags = 0,
+			numSlices = 1;
 		for(unsigned int k=3; k<arguments.size(); k++)
 		{
+			int n = 0;
+			if(fromString(arguments[k], n))
+			{
+				numSlices = n;
+				continue;
+			}
+
 			FFTModules::Flag f = FFTModules::getFlag(arguments[k]);
 			flags = flags | static_cast<int>(f);
 		}
@@ -1099,6 +2590,6 @@ namespace Glip
 			}
 		}
 
-		APPEND_NEW_PIPELINE(arguments[2], generate(width, height, flags, pre, post))
+		APPEND_NEW_PIPELINE(arguments[2], generate(width, height, flags, pre, post, numSlices))
 	}
 
@@ -0,0 +1,516 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : Histogram.cpp                                                                             */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Histogram pipeline generator.                                                             */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    Histogram.cpp
+ * \brief   Histogram pipeline generator.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+	// Includes
+	#include <algorithm>
+	#include "Core/Exception.hpp"
+	#include "Modules/Histogram.hpp"
+	#include "Core/ShaderSource.hpp"
+	#include "Core/HdlShader.hpp"
+	#include "Core/Geometry.hpp"
+
+	using namespace Glip;
+	using namespace Glip::CoreGL;
+	using namespace Glip::CorePipeline;
+	using namespace Glip::Modules;
+	using namespace Glip::Modules::HistogramModules;
+	using namespace Glip::Modules::VanillaParserSpace;
+
+// HistogramModules :
+namespace Glip
+{
+	namespace Modules
+	{
+		namespace HistogramModules
+		{
+			/**
+			\fn Flag Glip::Modules::HistogramModules::getFlag(const std::string& str)
+			\brief Get the flag corresponding to a string.
+			\param str Name of the flag.
+			\return The flag corresponding to the string or raise an Exception otherwise.
+			**/
+			Flag getFlag(const std::string& str)
+			{
+				#define TEST(a, b, c) if(str== a || str== b) return c ;
+
+				TEST("Normalized",	"NORMALIZED",	Normalized);
+				TEST("NoCompute",	"NO_COMPUTE",	NoCompute);
+
+				#undef TEST
+
+				throw Exception("GenerateHistogramPipeline::getFlag - Unknown flag name : \"" + str + "\".", __FILE__, __LINE__, Exception::ModuleException);
+			}
+		}
+	}
+}
+
+// GenerateHistogramPipeline :
+	/**
+	\fn GenerateHistogramPipeline::GenerateHistogramPipeline(void)
+	\brief Module constructor.
+
+	This object can be added to a LayoutLoader via LayoutLoader::addModule().
+	**/
+	GenerateHistogramPipeline::GenerateHistogramPipeline(void)
+	 :	LayoutLoaderModule(	"GENERATE_HISTOGRAM_PIPELINE",
+					"DESCRIPTION{Generate a Pipeline computing the histograms of the channels of a texture, over all its pixels.}"
+					"ARGUMENT:format{Name of the format of the input texture.}"
+					"ARGUMENT:name{Name of the new pipeline.}"
+					"ARGUMENT:numBins{Number of bins of the histograms, the width of the output texture.}"
+					"ARGUMENT:channels{Channels to be binned, among RGBA (default : RGB).}"
+					"ARGUMENT:minimum{Lower bound of the first bin (default : 0.0).}"
+					"ARGUMENT:maximum{Upper bound of the last bin (default : 1.0).}"
+					"ARGUMENT:options...{Options to be used by the histogram : NORMALIZED, NO_COMPUTE.}"
+					"BODY_DESCRIPTION{PRE{...} block contains a filtering function to be applied before the binning. It must define a function vec4 pre(in vec4 colorFromTexture, in vec2 x). It can declare its own uniform variables.}",
+					3,
+					8, //3 base + channels, minimum, maximum + 2 options
+					0)
+	{ }
+
+	const std::string GenerateHistogramPipeline::getInputPortName(void)
+	{
+		return "inputTexture";
+	}
+
+	const std::string GenerateHistogramPipeline::getOutputPortName(void)
+	{
+		return "outputTexture";
+	}
+
+	/**
+	\fn bool GenerateHistogramPipeline::isComputeAvailable(void)
+	\brief Test if the histograms can be computed with compute shaders.
+	\return True if the compute shaders are available.
+	**/
+	bool GenerateHistogramPipeline::isComputeAvailable(void)
+	{
+		#if defined(GLIP_USE_GL)
+			return GLEW_VERSION_4_3 || GLEW_ARB_compute_shader;
+		#else
+			return false;
+		#endif
+	}
+
+	std::vector<int> GenerateHistogramPipeline::getChannels(const std::string& channels)
+	{
+		const std::string names = "RGBA";
+		std::vector<int> result;
+
+		if(channels.empty())
+			throw Exception("GenerateHistogramPipeline::getChannels - No channel was given.", __FILE__, __LINE__, Exception::ModuleException);
+
+		for(unsigned int k=0; k<channels.size(); k++)
+		{
+			const size_t c = names.find(channels[k]);
+
+			if(c==std::string::npos)
+				throw Exception("GenerateHistogramPipeline::getChannels - Unknown channel \"" + channels.substr(k, 1) + "\" in \"" + channels + "\" (expected R, G, B or A).", __FILE__, __LINE__, Exception::ModuleException);
+
+			for(std::vector<int>::const_iterator it=result.begin(); it!=result.end(); it++)
+			{
+				if((*it)==static_cast<int>(c))
+					throw Exception("GenerateHistogramPipeline::getChannels - The channel \"" + channels.substr(k, 1) + "\" appears more than once in \"" + channels + "\".", __FILE__, __LINE__, Exception::ModuleException);
+			}
+
+			result.push_back(static_cast<int>(c));
+		}
+
+		return result;
+	}
+
+	void GenerateHistogramPipeline::generateBinningCode(std::string& str, std::map<int,ShaderSource::LineInfo>& linesInfo, int& lineCounter, int numBins, const std::vector<int>& channels, float minimum, float maximum, const ShaderSource& pre)
+	{
+		// Declares the constants, the function fetch (input texel with the PRE function applied) and the function getBin (-1 if the value is out of range).
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string channelsList;
+		for(std::vector<int>::const_iterator it=channels.begin(); it!=channels.end(); it++)
+			channelsList += std::string((it==channels.begin()) ? "" : ", ") + toString(*it);
+
+		str += "uniform sampler2D " + getInputPortName() + "; \n";										PUSH_LINE_INFO
+		str += "const int numBins = " + toString(numBins) + "; \n";										PUSH_LINE_INFO
+		str += "const int channels[" + toString(channels.size()) + "] = int[" + toString(channels.size()) + "](" + channelsList + "); \n";		PUSH_LINE_INFO
+		str += "const float minimum = float(" + toString(minimum) + "), \n";									PUSH_LINE_INFO
+		str += "            maximum = float(" + toString(maximum) + "); \n";									PUSH_LINE_INFO
+
+		if(!pre.empty())
+		{
+			str += pre.getSource();
+			for(int k=0; k<pre.getNumLines(); k++)
+				linesInfo[lineCounter+k] = pre.getLineInfo(k+1);
+
+			lineCounter += pre.getNumLines();
+		}
+
+		str += "\n";																PUSH_LINE_INFO
+		str += "vec4 fetch(in ivec2 p) \n";													PUSH_LINE_INFO
+		str += "{ \n";																PUSH_LINE_INFO
+		str += "    vec4 c = texelFetch(" + getInputPortName() + ", p, 0); \n";								PUSH_LINE_INFO
+
+		if(!pre.empty())
+		{
+			str += "    c = pre(c, (vec2(p)+vec2(0.5))/vec2(textureSize(" + getInputPortName() + ", 0))); \n";				PUSH_LINE_INFO
+		}
+
+		str += "    return c; \n";														PUSH_LINE_INFO
+		str += "} \n";																PUSH_LINE_INFO
+		str += "\n";																PUSH_LINE_INFO
+		str += "int getBin(in float v) \n";													PUSH_LINE_INFO
+		str += "{ \n";																PUSH_LINE_INFO
+		str += "    if(!(v>=minimum && v<=maximum)) return -1; // Also reject NaN. \n";							PUSH_LINE_INFO
+		str += "    return min(int(floor((v-minimum)*(float(numBins)/(maximum-minimum)))), numBins-1); \n";				PUSH_LINE_INFO
+		str += "} \n";																PUSH_LINE_INFO
+		str += "\n";																PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+	}
+
+	ShaderSource GenerateHistogramPipeline::generateCountCode(int width, int height, int numBins, int bandHeight, const std::vector<int>& channels, float minimum, float maximum, const ShaderSource& pre)
+	{
+		// Each work group counts a band of bandHeight rows in shared memory and writes its counts in one row of the output.
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+		const char names[] = {'r', 'g', 'b', 'a'};
+		const int localSize = std::max(numBins, 256);
+
+		str += "#version 430 \n";														PUSH_LINE_INFO
+		str += "layout(local_size_x = " + toString(localSize) + ") in; \n";									PUSH_LINE_INFO
+		str += "layout(rgba32f) writeonly uniform image2D " + getOutputPortName() + "; \n";							PUSH_LINE_INFO
+		str += "uniform ivec2 " + ComputeFilterLayout::regionOriginName + "; \n";										PUSH_LINE_INFO
+		generateBinningCode(str, linesInfo, lineCounter, numBins, channels, minimum, maximum, pre);
+		str += "shared uint counts[" + toString(channels.size()*numBins) + "]; \n";								PUSH_LINE_INFO
+		str += "\n";																PUSH_LINE_INFO
+		str += "void main() \n";														PUSH_LINE_INFO
+		str += "{ \n";																PUSH_LINE_INFO
+		str += "    const int w = " + toString(width) + "; \n";											PUSH_LINE_INFO
+		str += "    int l = int(gl_LocalInvocationIndex), \n";										PUSH_LINE_INFO
+		str += "        band = " + ComputeFilterLayout::regionOriginName + ".y + int(gl_WorkGroupID.y), \n";					PUSH_LINE_INFO
+		str += "        y0 = band*" + toString(bandHeight) + ", \n";										PUSH_LINE_INFO
+		str += "        n = (min(y0+" + toString(bandHeight) + ", " + toString(height) + ")-y0)*w; \n";					PUSH_LINE_INFO
+		str += "    for(int i=l; i<" + toString(channels.size()*numBins) + "; i+=" + toString(localSize) + ") \n";			PUSH_LINE_INFO
+		str += "        counts[i] = 0u; \n";												PUSH_LINE_INFO
+		str += "    memoryBarrierShared(); \n";												PUSH_LINE_INFO
+		str += "    barrier(); \n";														PUSH_LINE_INFO
+		str += "    for(int i=l; i<n; i+=" + toString(localSize) + ") \n";								PUSH_LINE_INFO
+		str += "    { \n";															PUSH_LINE_INFO
+		str += "        vec4 c = fetch(ivec2(i%w, y0+i/w)); \n";										PUSH_LINE_INFO
+		str += "        int b; \n";														PUSH_LINE_INFO
+		for(unsigned int k=0; k<channels.size(); k++)
+		{
+			str += std::string("        b = getBin(c.") + names[channels[k]] + "); \n";							PUSH_LINE_INFO
+			str += "        if(b>=0) atomicAdd(counts[" + toString(k*numBins) + "+b], 1u); \n";					PUSH_LINE_INFO
+		}
+		str += "    } \n";															PUSH_LINE_INFO
+		str += "    memoryBarrierShared(); \n";												PUSH_LINE_INFO
+		str += "    barrier(); \n";														PUSH_LINE_INFO
+		str += "    if(l>=numBins) return; \n";												PUSH_LINE_INFO
+		str += "    vec4 r = vec4(0.0); \n";													PUSH_LINE_INFO
+		for(unsigned int k=0; k<channels.size(); k++)
+		{
+			str += std::string("    r.") + names[channels[k]] + " = float(counts[" + toString(k*numBins) + "+l]); \n";		PUSH_LINE_INFO
+		}
+		str += "    imageStore(" + getOutputPortName() + ", ivec2(l, band), r); \n";						PUSH_LINE_INFO
+		str += "} \n";																PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+
+		return ShaderSource(str, "<GenerateHistogramPipeline::generate(" + toString(width) + ", " + toString(height) + ")>", 1, linesInfo);
+	}
+
+	ShaderSource GenerateHistogramPipeline::generateSumCode(int numBands, int numPixels, int flags)
+	{
+		// Sum the counts of all the bands (the rows of the input).
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+
+		str += "#version 130 \n";														PUSH_LINE_INFO
+		str += "uniform sampler2D " + getInputPortName() + "; \n";										PUSH_LINE_INFO
+		str += "out vec4 " + getOutputPortName() + "; \n";											PUSH_LINE_INFO
+		str += "\n";																PUSH_LINE_INFO
+		str += "void main() \n";														PUSH_LINE_INFO
+		str += "{ \n";																PUSH_LINE_INFO
+		str += "    int x = int(gl_FragCoord.x); \n";												PUSH_LINE_INFO
+		str += "    vec4 r = vec4(0.0); \n";													PUSH_LINE_INFO
+		str += "    for(int j=0; j<" + toString(numBands) + "; j++) \n";									PUSH_LINE_INFO
+		str += "        r += texelFetch(" + getInputPortName() + ", ivec2(x, j), 0); \n";						PUSH_LINE_INFO
+
+		if((flags & Normalized)!=0)
+		{
+			str += "    r = r/float(" + toString(numPixels) + "); \n";									PUSH_LINE_INFO
+		}
+
+		str += "    " + getOutputPortName() + " = r; \n";											PUSH_LINE_INFO
+		str += "} \n";																PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+
+		return ShaderSource(str, "<GenerateHistogramPipeline::generate(" + toString(numBands) + " bands)>", 1, linesInfo);
+	}
+
+	ShaderSource GenerateHistogramPipeline::generateScatterCode(int width, int height, int numBins, const std::vector<int>& channels, float minimum, float maximum, int flags, const ShaderSource& pre)
+	{
+		// Vertex shader : the vertex gl_VertexID of the instance gl_InstanceID is the pixel (gl_VertexID, gl_InstanceID % height) for the channel number gl_InstanceID / height.
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+		const std::string scale = ((flags & Normalized)!=0) ? ("1.0/float(" + toString(width*height) + ")") : std::string("1.0");
+
+		str += "#version 330 \n";														PUSH_LINE_INFO
+		str += "flat out vec4 mask; \n";													PUSH_LINE_INFO
+		generateBinningCode(str, linesInfo, lineCounter, numBins, channels, minimum, maximum, pre);
+		str += "void main() \n";														PUSH_LINE_INFO
+		str += "{ \n";																PUSH_LINE_INFO
+		str += "    const int h = " + toString(height) + "; \n";										PUSH_LINE_INFO
+		str += "    int k = channels[gl_InstanceID/h]; \n";											PUSH_LINE_INFO
+		str += "    vec4 c = fetch(ivec2(gl_VertexID, gl_InstanceID%h)); \n";								PUSH_LINE_INFO
+		str += "    int b = getBin(c[k]); \n";													PUSH_LINE_INFO
+		str += "    mask = vec4(0.0); \n";													PUSH_LINE_INFO
+		str += "    mask[k] = " + scale + "; \n";												PUSH_LINE_INFO
+		str += "    // Send the invalid bins out of the clipping volume : \n";									PUSH_LINE_INFO
+		str += "    gl_Position = (b>=0) ? vec4((float(b)+0.5)*2.0/float(numBins)-1.0, 0.0, 0.0, 1.0) : vec4(2.0, 0.0, 0.0, 1.0); \n";	PUSH_LINE_INFO
+		str += "} \n";																PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+
+		return ShaderSource(str, "<GenerateHistogramPipeline::generate(" + toString(width) + ", " + toString(height) + ")>", 1, linesInfo);
+	}
+
+	ShaderSource GenerateHistogramPipeline::generateAccumulateCode(void)
+	{
+		// Fragment shader : the counts are accumulated by the blending.
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+
+		str += "#version 330 \n";														PUSH_LINE_INFO
+		str += "flat in vec4 mask; \n";														PUSH_LINE_INFO
+		str += "out vec4 " + getOutputPortName() + "; \n";											PUSH_LINE_INFO
+		str += "\n";																PUSH_LINE_INFO
+		str += "void main() \n";														PUSH_LINE_INFO
+		str += "{ \n";																PUSH_LINE_INFO
+		str += "    " + getOutputPortName() + " = mask; \n";										PUSH_LINE_INFO
+		str += "} \n";																PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+
+		return ShaderSource(str, "<GenerateHistogramPipeline::generate(...)>", 1, linesInfo);
+	}
+
+	/**
+	\fn PipelineLayout GenerateHistogramPipeline::generate(int width, int height, int numBins, const std::string& channels, float minimum, float maximum, int flags, const ShaderSource& pre)
+	\brief Construct a pipeline computing the histograms of the channels of a texture.
+	\param width Width of the input texture.
+	\param height Height of the input texture.
+	\param numBins Number of bins (the width of the output texture).
+	\param channels Channels to be binned, among "RGBA".
+	\param minimum Lower bound of the first bin.
+	\param maximum Upper bound of the last bin (included).
+	\param flags Possible flags associated to the histogram (see Glip::Modules::HistogramModules::Flag).
+	\param pre Add a filtering function before the binning.
+	\return A complete pipeline layout.
+
+	The <b>pre-function</b> will be applied on the input texels. It should be a block of code declaring the function <i>pre</i> as in the following example :
+	\code
+	vec4 pre(in vec4 colorFromTexture, in vec2 x)
+	{
+		return modifiedColor;
+	}
+	\endcode
+
+	The position is normalized from 0.0 to 1.0. You are allowed to declare uniform variables in this filter.
+	**/
+	PipelineLayout GenerateHistogramPipeline::generate(int width, int height, int numBins, const std::string& channels, float minimum, float maximum, int flags, const ShaderSource& pre)
+	{
+		if(width<1 || height<1)
+			throw Exception("GenerateHistogramPipeline::generate - Invalid size : " + toString(width) + "x" + toString(height) + ".", __FILE__, __LINE__, Exception::ModuleException);
+
+		if(numBins<1)
+			throw Exception("GenerateHistogramPipeline::generate - Invalid number of bins : " + toString(numBins) + ".", __FILE__, __LINE__, Exception::ModuleException);
+
+		if(!(minimum<maximum))
+			throw Exception("GenerateHistogramPipeline::generate - Invalid range : [" + toString(minimum) + ", " + toString(maximum) + "].", __FILE__, __LINE__, Exception::ModuleException);
+
+		if(!pre.getOutputVars().empty() && !pre.requiresCompatibility())
+			throw Exception("GenerateHistogramPipeline::generate - A PRE-function cannot have an output (its own output port(s)).", __FILE__, __LINE__, Exception::ModuleException);
+
+		const std::vector<int> channelsList = getChannels(channels);
+		const int numChannels = static_cast<int>(channelsList.size());
+
+		// The counters of the compute path live in shared memory (at least 32kB), and the bins are spread over a single work group :
+		const bool compute = ((flags & NoCompute)==0) && isComputeAvailable() && numBins<=1024 && numBins*numChannels<=8192;
+		PipelineLayout pipelineLayout("Histogram" + toString(width) + "x" + toString(height) + "Pipeline");
+
+		pipelineLayout.addInput(getInputPortName());
+		pipelineLayout.addOutput(getOutputPortName());
+
+		std::string firstName;
+
+		if(compute)
+		{
+			const int	localSize = std::max(numBins, 256),
+					bandHeight = std::min(std::max((64*localSize)/width, 1), height),
+					numBands = (height + bandHeight - 1)/bandHeight;
+
+			HdlTextureFormat	countFormat(numBins, numBands, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST),
+						sumFormat(numBins, 1, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+
+			pipelineLayout.add(ComputeFilterLayout("HistogramCount", countFormat, generateCountCode(width, height, numBins, bandHeight, channelsList, minimum, maximum, pre)), "HistogramCount");
+			pipelineLayout.add(FilterLayout("HistogramSum", sumFormat, generateSumCode(numBands, width*height, flags)), "HistogramSum");
+
+			pipelineLayout.connect("HistogramCount", getOutputPortName(), "HistogramSum", getInputPortName());
+			pipelineLayout.connectToOutput("HistogramSum", getOutputPortName(), getOutputPortName());
+			firstName = "HistogramCount";
+		}
+		else
+		{
+			HdlTextureFormat format(numBins, 1, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+			ShaderSource	vertexSource = generateScatterCode(width, height, numBins, channelsList, minimum, maximum, flags, pre),
+					fragmentSource = generateAccumulateCode();
+			GeometryPrimitives::InstancedPointsGrid2D grid(width, height*numChannels);
+
+			std::map<GLenum, ShaderSource*> sources;
+			sources[GL_VERTEX_SHADER] = &vertexSource;
+			sources[GL_FRAGMENT_SHADER] = &fragmentSource;
+
+			FilterLayout filterLayout("HistogramScatter", format, sources, &grid);
+			filterLayout.enableBlending(GL_ONE, GL_ONE, GL_FUNC_ADD);
+
+			pipelineLayout.add(filterLayout, "HistogramScatter");
+			pipelineLayout.connectToOutput("HistogramScatter", getOutputPortName(), getOutputPortName());
+			firstName = "HistogramScatter";
+		}
+
+		pipelineLayout.connectToInput(getInputPortName(), firstName, getInputPortName());
+
+		// Add the ports declared in PRE :
+		for(std::vector<std::string>::const_iterator it=pre.getInputVars().begin(); it!=pre.getInputVars().end(); it++)
+		{
+			if((*it)==getInputPortName())
+				throw Exception("GenerateHistogramPipeline::generate - The PRE function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
+
+			pipelineLayout.addInput(*it);
+			pipelineLayout.connectToInput(*it, firstName, *it);
+		}
+
+		return pipelineLayout;
+	}
+
+	void GenerateHistogramPipeline::apply(LAYOUT_LOADER_ARGUMENTS_LIST)
+	{
+		UNUSED_PARAMETER(currentPath)
+		UNUSED_PARAMETER(dynamicPaths)
+		UNUSED_PARAMETER(geometryList)
+		UNUSED_PARAMETER(filterList)
+		UNUSED_PARAMETER(mainPipelineName)
+		UNUSED_PARAMETER(staticPaths)
+		UNUSED_PARAMETER(requiredFormatList)
+		UNUSED_PARAMETER(requiredSourceList)
+		UNUSED_PARAMETER(requiredGeometryList)
+		UNUSED_PARAMETER(requiredPipelineList)
+		UNUSED_PARAMETER(moduleList)
+		UNUSED_PARAMETER(executionSource)
+		UNUSED_PARAMETER(executionSourceName)
+		UNUSED_PARAMETER(executionStartLine)
+
+		FORMAT_MUST_EXIST( arguments[0] )
+		PIPELINE_MUST_NOT_EXIST( arguments[1] )
+
+		CONST_ITERATOR_TO_FORMAT( itFormat, arguments[0] )
+
+		int numBins = 0;
+		if(!fromString(arguments[2], numBins) || numBins<1)
+			throw Exception("Cannot read a valid number of bins from \"" + arguments[2] + "\".", sourceName, startLine, Exception::ClientScriptException);
+
+		// Read the optional channels and range, then the flags :
+		std::string channels = "RGB";
+		float	minimum = 0.0f,
+			maximum = 1.0f;
+		int flags = 0;
+		unsigned int k = 3;
+
+		if(k<arguments.size() && arguments[k].find_first_not_of("RGBA")==std::string::npos)
+		{
+			channels = arguments[k];
+			k++;
+		}
+
+		if(k<arguments.size() && fromString(arguments[k], minimum))
+		{
+			k++;
+			if(k>=arguments.size() || !fromString(arguments[k], maximum))
+				throw Exception("The lower bound of the range must be followed by its upper bound.", sourceName, startLine, Exception::ClientScriptException);
+			k++;
+		}
+
+		for(; k<arguments.size(); k++)
+			flags = flags | static_cast<int>(getFlag(arguments[k]));
+
+		// Read the PRE function :
+		ShaderSource pre("");
+
+		if(!body.empty())
+		{
+			VanillaParser parser(body, sourceName, bodyLine);
+			bool preAlreadySet = false;
+
+			for(std::vector<Element>::iterator it=parser.elements.begin(); it!=parser.elements.end(); it++)
+			{
+				if(it->strKeyword=="PRE")
+				{
+					if(preAlreadySet)
+						throw Exception("PRE code already set.", it->sourceName, it->startLine, Exception::ClientScriptException);
+
+					if(it->arguments.size()==1 && it->noBody)
+					{
+						SOURCE_MUST_EXIST( it->arguments.front() )
+						CONST_ITERATOR_TO_SOURCE( its, it->arguments.front() )
+						pre = its->second;
+					}
+					else if(it->noArgument && !it->body.empty())
+					{
+						ShaderSource src(it->body, it->sourceName, it->bodyLine);
+						pre = src;
+					}
+					else
+						throw Exception("The PRE code can have either one argument or one body.", it->sourceName, it->startLine, Exception::ClientScriptException);
+
+					preAlreadySet = true;
+				}
+				else
+					throw Exception("Unknown keyword \"" + it->strKeyword + "\". Expected PRE.", it->sourceName, it->startLine, Exception::ClientScriptException);
+			}
+		}
+
+		APPEND_NEW_PIPELINE(arguments[1], generate(itFormat->second.getWidth(), itFormat->second.getHeight(), numBins, channels, minimum, maximum, flags, pre))
+	}
+
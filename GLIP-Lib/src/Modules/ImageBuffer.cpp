@@ -25,6 +25,7 @@
 #include <fstream>
 #include "Modules/ImageBuffer.hpp"
 #include "Core/Exception.hpp"
+#include "Modules/UploadQueue.hpp"
 
 using namespace Glip;
 using namespace Glip::CoreGL;
@@ -279,7 +280,7 @@ using namespace Glip::Modules;
 
 	/**
 	\fn const ImageBuffer& ImageBuffer::operator>>(HdlTexture& texture) const
-	\brief Write buffer to a texture and the following properties : minification and magnification filters, S and T wrapping modes.
+	\brief Write buffer to a texture and the following properties : minification and magnification filters, S and T wrapping modes. The storage of the texture is reallocated if it is not immutable (see HdlTexture::isImmutable), use ImageBuffer::upload to stream images to an existing texture.
 	\param texture The texture to be written.
 	\return This.
 	**/
@@ -289,28 +290,38 @@ using namespace Glip::Modules;
 			throw Exception("ImageBuffer::operator>> - Texture and ImageBuffer objects are incompatible.", __FILE__, __LINE__, Exception::ModuleException);
 		else
 		{
-			// Bind : 
-			texture.bind();
-
-			glPixelStorei(GL_UNPACK_ALIGNMENT, getAlignment());
-
-			// Write :
-			glTexImage2D(GL_TEXTURE_2D, 0, getGLMode(), getWidth(), getHeight(), 0, descriptor.aliasMode, getGLDepth(), table->getPtr());
+			// Write (in the immutable storage of the texture if it has one, the mipmaps are also regenerated) :
+			texture.write(const_cast<void*>(table->getPtr()), descriptor.aliasMode, getGLDepth(), getAlignment());
 
 			GLenum err = glGetError();
 			if(err!=GL_NO_ERROR)
-				throw Exception("ImageBuffer::operator>> - Unable to copy data to texture (glTexImage2D). (OpenGL error : " + getGLEnumNameSafe(err) + ").", __FILE__, __LINE__, Exception::ModuleException);
+				throw Exception("ImageBuffer::operator>> - Unable to copy data to texture. (OpenGL error : " + getGLEnumNameSafe(err) + ").", __FILE__, __LINE__, Exception::ModuleException);
 
-			if( texture.getMaxLevel()>0 )
-			{
-				glGenerateMipmap(GL_TEXTURE_2D);
+			HdlTexture::unbind();
 
-				#ifdef __GLIPLIB_TRACK_GL_ERRORS__
-					OPENGL_ERROR_TRACKER("ImageBuffer::operator>>", "glGenerateMipmap()")
-				#endif
-			}
+			texture.setMinFilter(getMinFilter());
+			texture.setMagFilter(getMagFilter());
+			texture.setSWrapping(getSWrapping());
+			texture.setTWrapping(getTWrapping());
 
-			HdlTexture::unbind();
+			return (*this);
+		}
+	}
+
+	/**
+	\fn const ImageBuffer& ImageBuffer::upload(HdlTexture& texture, UploadQueue& queue) const
+	\brief Write buffer to a texture through an upload queue and the following properties : minification and magnification filters, S and T wrapping modes. Contrary to ImageBuffer::operator>>, the storage of the texture is kept and the function returns once the data is copied to a buffer of the queue, without waiting for the transfer.
+	\param texture The texture to be written.
+	\param queue The queue issuing the transfer.
+	\return This.
+	**/
+	const ImageBuffer& ImageBuffer::upload(HdlTexture& texture, UploadQueue& queue) const
+	{
+		if(!isCompatibleWith(texture))
+			throw Exception("ImageBuffer::upload - Texture and ImageBuffer objects are incompatible.", __FILE__, __LINE__, Exception::ModuleException);
+		else
+		{
+			queue.write(texture, *this);
 
 			texture.setMinFilter(getMinFilter());
 			texture.setMagFilter(getMagFilter());
@@ -468,10 +479,10 @@ using namespace Glip::Modules;
 		// Shortcut : 
 		if(sameLayout && sameDepth && !xFlip)
 		{
-			const size_t rowSize = table->getRowSize();
+			const int pixelSize = descriptor.getPixelSize(getGLDepth());
 			
 			for(int y=0; y<height; y++)
-				std::memcpy(reinterpret_cast<char*>(table->getRowPtr(yDst + y)), reinterpret_cast<const char*>(src.table->getRowPtr(ySrc + rowOffset + rowDirection*y)), rowSize);
+				std::memcpy(reinterpret_cast<char*>(table->getRowPtr(yDst + y)) + xDst*pixelSize, reinterpret_cast<const char*>(src.table->getRowPtr(ySrc + rowOffset + rowDirection*y)) + xSrc*pixelSize, width*pixelSize);
 		}
 		else if(!table->isNormalized() && src.table->isNormalized())
 		{
@@ -487,14 +498,14 @@ using namespace Glip::Modules;
 			if(isBlack)
 			{
 				for(int y=0; y<height; y++)
-					std::memset(table->getRowPtr(yDst + y), 0, width*dstPixelSize);
+					std::memset(reinterpret_cast<char*>(table->getRowPtr(yDst + y)) + xDst*dstPixelSize, 0, width*dstPixelSize);
 			}
 			else
 			{
 				for(int y=0; y<height; y++)
 				{
-					char* dstRow = reinterpret_cast<char*>(table->getRowPtr(yDst + y));
-					const char* srcRow = reinterpret_cast<const char*>(src.table->getRowPtr(ySrc + rowOffset + rowDirection*y));
+					char* dstRow = reinterpret_cast<char*>(table->getRowPtr(yDst + y)) + xDst*dstPixelSize;
+					const char* srcRow = reinterpret_cast<const char*>(src.table->getRowPtr(ySrc + rowOffset + rowDirection*y)) + xSrc*srcPixelSize;
 			
 					for(int x=0; x<width; x++)
 					{
@@ -524,7 +535,7 @@ using namespace Glip::Modules;
 			if(isBlack)
 			{
 				for(int y=0; y<height; y++)
-					std::memset(table->getRowPtr(yDst + y), 0, width*dstPixelSize);
+					std::memset(reinterpret_cast<char*>(table->getRowPtr(yDst + y)) + xDst*dstPixelSize, 0, width*dstPixelSize);
 			}
 			else
 			{
@@ -534,8 +545,8 @@ using namespace Glip::Modules;
 
 				for(int y=0; y<height; y++)
 				{
-					char* dstRow = reinterpret_cast<char*>(table->getRowPtr(yDst + y));
-					const char* srcRow = reinterpret_cast<const char*>(src.table->getRowPtr(ySrc + rowOffset + rowDirection*y));
+					char* dstRow = reinterpret_cast<char*>(table->getRowPtr(yDst + y)) + xDst*dstPixelSize;
+					const char* srcRow = reinterpret_cast<const char*>(src.table->getRowPtr(ySrc + rowOffset + rowDirection*y)) + xSrc*srcPixelSize;
 			
 					for(int x=0; x<width; x++)
 					{
@@ -65,7 +65,10 @@
 										"ADD_PATH",
 										"CALL",
 										"SAFE_CALL",
-										"UNIQUE"
+										"UNIQUE",
+										"HALO",
+										"COMPUTE_FILTER_LAYOUT",
+										"INSTANCED_GRID_2D"
 									};
 
 // LayoutLoader
@@ -970,6 +973,21 @@
 
 			geometryList.insert( std::pair<std::string, GeometryModel>( e.name, GeometryPrimitives::PointsGrid3D(w,h,z)) );
 		}
+		else if(e.arguments[0]==keywords[KW_LL_INSTANCED_GRID_2D])
+		{
+			if(e.arguments.size()!=3)
+				throw Exception("The model \"" + std::string(keywords[KW_LL_INSTANCED_GRID_2D]) + "\" requires to have exactly 3 arguments (included) in geometry \"" + e.name + "\".", e.sourceName, e.startLine, Exception::ClientScriptException);
+
+			int w, h;
+
+			if(!fromString(e.arguments[1], w))
+				throw Exception("Cannot read width for instanced 2D grid geometry \"" + e.name + "\". Token : \"" + e.arguments[1] + "\".", e.sourceName, e.startLine, Exception::ClientScriptException);
+
+			if(!fromString(e.arguments[2], h))
+				throw Exception("Cannot read height for instanced 2D grid geometry \"" + e.name + "\". Token : \"" + e.arguments[2] + "\".", e.sourceName, e.startLine, Exception::ClientScriptException);
+
+			geometryList.insert( std::pair<std::string, GeometryModel>( e.name, GeometryPrimitives::InstancedPointsGrid2D(w,h) ) );
+		}
 		else if(e.arguments[0]==keywords[KW_LL_CUSTOM_MODEL])
 		{
 			if(e.arguments.size()!=3 && e.arguments.size()!=4)
@@ -1148,8 +1166,13 @@
 
 	void LayoutLoader::buildFilter(const VanillaParserSpace::Element& e)
 	{
+		const bool compute = (e.strKeyword==keywords[KW_LL_COMPUTE_FILTER_LAYOUT]);
+
 		// Preliminary tests :
-		preliminaryTests(e, 1, 1, 2, 0, "FilterLayout");
+		if(compute)
+			preliminaryTests(e, 1, 2, 2, 0, "ComputeFilterLayout");
+		else
+			preliminaryTests(e, 1, 1, 2, 0, "FilterLayout");
 		
 		// Find the format :
 		std::map<std::string,HdlTextureFormat>::iterator format = formatList.find(e.arguments[0]);
@@ -1168,15 +1191,18 @@
 				blendingEquation = GL_NONE;
 		bool depthTestingSet = false;
 			GLenum depthTestingFunction = GL_NONE;
+		bool haloSet = false;
+			int halo = -1;
+			std::string haloVariable;
 
-		// If the fragment source name is provided in the arguments : 
+		// If the fragment (or compute) source name is provided in the arguments : 
 		if(e.arguments.size()>1)
 		{
 			std::map<std::string,ShaderSource>::iterator fragmentSource = sourceList.find(e.arguments[1]);
 			if(fragmentSource==sourceList.end())
 				throw Exception("No ShaderSource with name \"" + e.arguments[1] + "\" was registered and can be use in Filter \"" + e.name + "\".", e.sourceName, e.startLine, Exception::ClientScriptException);
 			else
-				shaders[GL_FRAGMENT_SHADER] = &fragmentSource->second;
+				shaders[compute ? GL_COMPUTE_SHADER : GL_FRAGMENT_SHADER] = &fragmentSource->second;
 		}
 
 		// Scan the body for possible other shaders, geometry and settings :
@@ -1190,7 +1216,7 @@
 				std::map<GLenum, bool> setParametersTest;
 				setParametersTest[GL_VERTEX_SHADER]		= false;
 				setParametersTest[GL_FRAGMENT_SHADER]		= (shaders.find(GL_FRAGMENT_SHADER)!=shaders.end()); // The fragment shader is not already set.
-				setParametersTest[GL_COMPUTE_SHADER]		= false;
+				setParametersTest[GL_COMPUTE_SHADER]		= (shaders.find(GL_COMPUTE_SHADER)!=shaders.end());
 				#ifdef GLIP_USE_GL
 				setParametersTest[GL_TESS_CONTROL_SHADER]	= false;
 				setParametersTest[GL_TESS_EVALUATION_SHADER]	= false;
@@ -1203,9 +1229,26 @@
 
 				for(unsigned int k=0; k<parser.elements.size(); k++)
 				{
-					GLenum glId = getGLEnum(parser.elements[k].strKeyword);
+					const bool isHalo = (parser.elements[k].strKeyword==keywords[KW_LL_HALO]);
+					GLenum glId = isHalo ? GL_NONE : getGLEnum(parser.elements[k].strKeyword);
+
+					if(compute && glId!=GL_NONE && glId!=GL_CLEAR)
+						throw Exception("The parameter \"" + parser.elements[k].strKeyword + "\" is not allowed for a compute filter.", parser.elements[k].sourceName, parser.elements[k].startLine, Exception::ClientScriptException);
 					
-					if(glId==GL_VERTEX_SHADER)
+					if(isHalo)
+					{
+						if(haloSet)
+							throw Exception("The " + std::string(keywords[KW_LL_HALO]) + " parameter was already set.", parser.elements[k].sourceName, parser.elements[k].startLine, Exception::ClientScriptException);
+
+						preliminaryTests(parser.elements[k], -1, 1, 1, -1, e.name);
+
+						haloSet = true;
+						if(!fromString(parser.elements[k].arguments[0], halo))
+							haloVariable = parser.elements[k].arguments[0];
+						else if(halo<0)
+							throw Exception("The halo must be positive (or the name of an integer uniform variable).", parser.elements[k].sourceName, parser.elements[k].startLine, Exception::ClientScriptException);
+					}
+					else if(glId==GL_VERTEX_SHADER)
 					{
 						if(setParametersTest[GL_VERTEX_SHADER])
 							throw Exception("The GL_VERTEX_SHADER parameter was already set.", parser.elements[k].sourceName, parser.elements[k].startLine, Exception::ClientScriptException);
@@ -1367,7 +1410,10 @@
 		}
 
 		// Construct : 
-		filterList.insert( std::pair<std::string, FilterLayout>( e.name, FilterLayout(e.name, format->second, shaders, geometryPtr) ) );
+		if(compute)
+			filterList.insert( std::pair<std::string, FilterLayout>( e.name, ComputeFilterLayout(e.name, format->second, *shaders[GL_COMPUTE_SHADER]) ) );
+		else
+			filterList.insert( std::pair<std::string, FilterLayout>( e.name, FilterLayout(e.name, format->second, shaders, geometryPtr) ) );
 		std::map<std::string,FilterLayout>::iterator filterLayout = filterList.find(e.name);
 
 		// Apply the options, if needed : 
@@ -1382,6 +1428,12 @@
 
 		if(depthTestingSet)
 			filterLayout->second.enableDepthTesting(depthTestingFunction);
+
+		if(haloSet)
+		{
+			if(haloVariable.empty())	filterLayout->second.setHalo(halo);
+			else				filterLayout->second.setHalo(haloVariable);
+		}
 	}
 
 	void LayoutLoader::buildPipeline(const VanillaParserSpace::Element& e)
@@ -1712,6 +1764,7 @@
 						buildGeometry(rootParser.elements[k]);
 						break;
 					case KW_LL_FILTER_LAYOUT :
+					case KW_LL_COMPUTE_FILTER_LAYOUT :
 						buildFilter(rootParser.elements[k]);
 						break;
 					case KW_LL_PIPELINE_MAIN :
@@ -2515,6 +2568,10 @@
 						preliminaryTests(rootParser.elements[k], 1, 1, 2, 0, "FilterLayout");
 						result.filtersLayout.push_back( rootParser.elements[k].name );
 						break;
+					case KW_LL_COMPUTE_FILTER_LAYOUT :
+						preliminaryTests(rootParser.elements[k], 1, 2, 2, 0, "ComputeFilterLayout");
+						result.filtersLayout.push_back( rootParser.elements[k].name );
+						break;
 					case KW_LL_PIPELINE_MAIN :
 						preliminaryTests(rootParser.elements[k], 1, 0, 1, 0, "MainPipelineLayout");
 						result.mainPipeline = rootParser.elements[k].name;
@@ -2875,6 +2932,12 @@
 			e.arguments.push_back( toString(y+1) );
 			e.arguments.push_back( toString(z+1) );
 		}
+		else if(mdl.type==GeometryModel::InstancedPointsGrid2D)
+		{
+			e.arguments.push_back( LayoutLoader::getKeyword( KW_LL_INSTANCED_GRID_2D ) );
+			e.arguments.push_back( toString(mdl.getNumVertices()) );
+			e.arguments.push_back( toString(mdl.getNumInstances()) );
+		}
 		else if(mdl.type==GeometryModel::CustomModel)
 		{
 			e.arguments.push_back( LayoutLoader::getKeyword( KW_LL_CUSTOM_MODEL ) );
@@ -3027,6 +3090,17 @@
 			e.body += "\t" + el.getCode() + "\n";
 		}
 
+		if(fLayout.getHalo()>=0 || !fLayout.getHaloVariable().empty())
+		{
+			VanillaParserSpace::Element el;
+			el.strKeyword = LayoutLoader::getKeyword(KW_LL_HALO);
+			el.noName = true;
+			el.noBody = true;
+			el.noArgument = false;
+			el.arguments.push_back(fLayout.getHaloVariable().empty() ? toString(fLayout.getHalo()) : fLayout.getHaloVariable());
+			e.body += "\t" + el.getCode() + "\n";
+		}
+
 		return e;
 	}
 
@@ -27,6 +27,8 @@
 	#include "Core/Exception.hpp"
 	#include "Modules/LayoutLoader.hpp"
 	#include "Modules/FFT.hpp"
+	#include "Modules/Reduction.hpp"
+	#include "Modules/Histogram.hpp"
 	#include "Modules/GeometryLoader.hpp"
 
 	// Namespaces :
@@ -288,6 +290,8 @@
 			result.push_back( new ABORT_ERROR );
 			result.push_back( new GenerateFFT1DPipeline );
 			result.push_back( new GenerateFFT2DPipeline );
+			result.push_back( new GenerateReductionPipeline );
+			result.push_back( new GenerateHistogramPipeline );
 			result.push_back( new OBJLoader );
 			result.push_back( new STLLoader );
 
@@ -0,0 +1,370 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : ReadbackQueue.cpp                                                                         */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Module : Asynchronous readback of textures through pixel pack buffers.                    */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    ReadbackQueue.cpp
+ * \brief   Module : Asynchronous readback of textures through pixel pack buffers.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+	// Includes
+	#include "Core/Exception.hpp"
+	#include "Core/GLStateCache.hpp"
+	#include "Modules/ReadbackQueue.hpp"
+	#include "devDebugTools.hpp"
+
+	using namespace Glip;
+	using namespace Glip::CoreGL;
+	using namespace Glip::Modules;
+
+// ReadbackQueue::Ticket
+	/**
+	\fn ReadbackQueue::Ticket::Ticket(void)
+	\brief Build an invalid ticket.
+	**/
+	ReadbackQueue::Ticket::Ticket(void)
+	 :	slot(0),
+		serial(0)
+	{ }
+
+// ReadbackQueue::Slot
+	ReadbackQueue::Slot::Slot(void)
+	 :	buffer(NULL),
+		serial(0),
+		width(0),
+		height(0),
+		mode(GL_NONE),
+		depth(GL_NONE)
+	{ }
+
+	ReadbackQueue::Slot::~Slot(void)
+	{
+		delete buffer;
+	}
+
+// ReadbackQueue
+	/**
+	\fn ReadbackQueue::ReadbackQueue(int numBuffers)
+	\brief ReadbackQueue constructor.
+	\param numBuffers Number of pixel pack buffers in the ring, which is the number of readbacks which can be pending at the same time (at least 1). The buffers are allocated on first use.
+	**/
+	ReadbackQueue::ReadbackQueue(int numBuffers)
+	 :	position(-1),
+		counter(0),
+		mappedSlot(-1),
+		readFramebuffer(0)
+	{
+		if(numBuffers<1)
+			throw Exception("ReadbackQueue::ReadbackQueue - The number of buffers must be at least 1 (current : " + toString(numBuffers) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+		for(int k=0; k<numBuffers; k++)
+			slots.push_back(new Slot);
+	}
+
+	ReadbackQueue::~ReadbackQueue(void)
+	{
+		unmap();
+
+		for(std::vector<Slot*>::iterator it=slots.begin(); it!=slots.end(); it++)
+			delete *it;
+		slots.clear();
+
+		if(readFramebuffer!=0)
+		{
+			GLStateCache::forgetFramebuffer(readFramebuffer);
+			glDeleteFramebuffers(1, &readFramebuffer);
+		}
+	}
+
+	ReadbackQueue::Slot& ReadbackQueue::check(const Ticket& ticket, const std::string& caller) const
+	{
+		if(!isValid(ticket))
+			throw Exception("ReadbackQueue::" + caller + " - The ticket " + toString(ticket.serial) + " is not valid anymore (its buffer was reused by a newer readback).", __FILE__, __LINE__, Exception::ModuleException);
+
+		return *slots[ticket.slot];
+	}
+
+	/**
+	\fn int ReadbackQueue::getNumBuffers(void) const
+	\return The number of pixel pack buffers in the ring.
+	**/
+	int ReadbackQueue::getNumBuffers(void) const
+	{
+		return slots.size();
+	}
+
+	/**
+	\fn ReadbackQueue::Ticket ReadbackQueue::read(HdlTexture& texture, GLenum channel)
+	\brief Queue the readback of a whole texture.
+	\param texture The texture to read.
+	\param channel The channel to read (GL_RED, GL_GREEN, GL_BLUE or GL_ALPHA) or GL_NONE for all the channels (default).
+	\return The ticket of the readback.
+	**/
+	ReadbackQueue::Ticket ReadbackQueue::read(HdlTexture& texture, GLenum channel)
+	{
+		return read(texture, 0, 0, texture.getWidth(), texture.getHeight(), channel);
+	}
+
+	/**
+	\fn ReadbackQueue::Ticket ReadbackQueue::read(HdlTexture& texture, int x, int y, int width, int height, GLenum channel)
+	\brief Queue the readback of a rectangle of a texture. The function returns without waiting for the GPU.
+	\param texture The texture to read.
+	\param x Left edge of the rectangle, in pixels.
+	\param y Bottom edge of the rectangle, in pixels.
+	\param width Width of the rectangle.
+	\param height Height of the rectangle.
+	\param channel The channel to read (GL_RED, GL_GREEN, GL_BLUE or GL_ALPHA) or GL_NONE for all the channels (default). A single channel is returned in the GL_RED channel of the result.
+	\return The ticket of the readback.
+
+	The whole texture with all its channels is read with glGetTexImage, the other cases need the texture to be attached to a framebuffer and are read with glReadPixels.
+	**/
+	ReadbackQueue::Ticket ReadbackQueue::read(HdlTexture& texture, int x, int y, int width, int height, GLenum channel)
+	{
+		#if !defined(GLIP_USE_GLES) && !defined(GLIP_USE_GLES2) && !defined(GLIP_USE_GLES3)
+			const HdlTextureFormatDescriptor& descriptor = texture.getFormatDescriptor();
+
+			if(texture.isCompressed())
+				throw Exception("ReadbackQueue::read - Compressed textures can not be read back.", __FILE__, __LINE__, Exception::ModuleException);
+			if(x<0 || y<0 || width<=0 || height<=0 || x+width>texture.getWidth() || y+height>texture.getHeight())
+				throw Exception("ReadbackQueue::read - The rectangle (" + toString(x) + ", " + toString(y) + ", " + toString(width) + ", " + toString(height) + ") is not inside the texture (" + toString(texture.getWidth()) + "x" + toString(texture.getHeight()) + ").", __FILE__, __LINE__, Exception::ModuleException);
+			if(channel!=GL_NONE && channel!=GL_RED && channel!=GL_GREEN && channel!=GL_BLUE && channel!=GL_ALPHA)
+				throw Exception("ReadbackQueue::read - Invalid channel " + getGLEnumNameSafe(channel) + ".", __FILE__, __LINE__, Exception::ModuleException);
+			if(channel!=GL_NONE && !descriptor.hasChannel(channel))
+				throw Exception("ReadbackQueue::read - The texture (" + getGLEnumNameSafe(texture.getGLMode()) + ") has no channel " + getGLEnumNameSafe(channel) + ".", __FILE__, __LINE__, Exception::ModuleException);
+
+			position = (position + 1) % slots.size();
+			Slot& slot = *slots[position];
+
+			if(mappedSlot==position)
+				unmap();
+
+			// The previous readback of this buffer is forgotten :
+			slot.fence.release();
+			slot.serial	= 0;
+			slot.width	= width;
+			slot.height	= height;
+			slot.mode	= (channel==GL_NONE) ? descriptor.aliasMode : GL_RED;
+			slot.depth	= texture.getGLDepth();
+
+			const HdlTextureFormat format(slot.width, slot.height, slot.mode, slot.depth);
+
+			if(slot.buffer==NULL || slot.buffer->getSize()<static_cast<GLsizeiptr>(format.getSize()))
+			{
+				delete slot.buffer;
+				slot.buffer = NULL;
+				slot.buffer = new HdlPBO(format, GL_PIXEL_PACK_BUFFER, GL_STREAM_READ, HdlGeBO::isPersistentMappingSupported());
+			}
+
+			// The copy is queued, the data will be read once the buffer is mapped :
+			slot.buffer->bind(GL_PIXEL_PACK_BUFFER);
+
+			// Save the current packing alignment, and replace it with the one of the buffers :
+			GLint originalAlignment = 0;
+			glGetIntegerv(GL_PACK_ALIGNMENT, &originalAlignment);
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+			GLenum err = GL_NO_ERROR;
+
+			if(channel==GL_NONE && x==0 && y==0 && width==texture.getWidth() && height==texture.getHeight())
+			{
+				texture.bind();
+				glGetTexImage(GL_TEXTURE_2D, 0, slot.mode, slot.depth, NULL);
+				err = glGetError();
+				HdlTexture::unbind();
+			}
+			else
+			{
+				if(readFramebuffer==0)
+					glGenFramebuffers(1, &readFramebuffer);
+
+				GLStateCache::bindFramebuffer(readFramebuffer);
+				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.getID(), 0);
+				glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+				glReadPixels(x, y, width, height, (channel==GL_NONE) ? descriptor.aliasMode : channel, slot.depth, NULL);
+				err = glGetError();
+
+				// Do not keep a reference to the texture :
+				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+				GLStateCache::bindFramebuffer(0);
+			}
+
+			// Restore :
+			glPixelStorei(GL_PACK_ALIGNMENT, originalAlignment);
+			HdlGeBO::unbind(GL_PIXEL_PACK_BUFFER);
+
+			if(err!=GL_NO_ERROR)
+				throw Exception("ReadbackQueue::read - Unable to read the texture. (OpenGL error : " + getGLEnumNameSafe(err) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+			slot.fence.insert();
+			counter++;
+			slot.serial = counter;
+
+			Ticket ticket;
+			ticket.slot	= position;
+			ticket.serial	= counter;
+			return ticket;
+		#else
+			UNUSED_PARAMETER(texture)
+			UNUSED_PARAMETER(x)
+			UNUSED_PARAMETER(y)
+			UNUSED_PARAMETER(width)
+			UNUSED_PARAMETER(height)
+			UNUSED_PARAMETER(channel)
+			throw Exception("ReadbackQueue::read - Not currently supported under GLES.", __FILE__, __LINE__, Exception::GLException);
+		#endif
+	}
+
+	/**
+	\fn bool ReadbackQueue::isValid(const Ticket& ticket) const
+	\brief Test if the data of a readback is still available.
+	\param ticket The ticket of the readback.
+	\return True if the buffer of the readback was not reused by a newer readback.
+	**/
+	bool ReadbackQueue::isValid(const Ticket& ticket) const
+	{
+		return ticket.serial!=0 && ticket.slot>=0 && ticket.slot<static_cast<int>(slots.size()) && slots[ticket.slot]->serial==ticket.serial;
+	}
+
+	/**
+	\fn bool ReadbackQueue::isReady(const Ticket& ticket)
+	\brief Test, without blocking, if the GPU completed a readback.
+	\param ticket The ticket of the readback.
+	\return True if the data can be accessed without stalling, or raise an exception if the ticket is not valid anymore.
+	**/
+	bool ReadbackQueue::isReady(const Ticket& ticket)
+	{
+		return wait(ticket, 0.0);
+	}
+
+	/**
+	\fn bool ReadbackQueue::wait(const Ticket& ticket, double timeout)
+	\brief Wait for the GPU to complete a readback.
+	\param ticket The ticket of the readback.
+	\param timeout Maximum time to wait, in milliseconds. Negative values wait until the readback is completed (default).
+	\return True if the data can be accessed without stalling, false if the timeout expired first, or raise an exception if the ticket is not valid anymore.
+	**/
+	bool ReadbackQueue::wait(const Ticket& ticket, double timeout)
+	{
+		return check(ticket, "wait").fence.wait(timeout);
+	}
+
+	/**
+	\fn HdlTextureFormat ReadbackQueue::getFormat(const Ticket& ticket) const
+	\brief Get the format of the data of a readback (size of the rectangle, GL_RED mode for a single channel, alignment of 1 byte).
+	\param ticket The ticket of the readback.
+	\return The format of the data, or raise an exception if the ticket is not valid anymore.
+	**/
+	HdlTextureFormat ReadbackQueue::getFormat(const Ticket& ticket) const
+	{
+		const Slot& slot = check(ticket, "getFormat");
+		return HdlTextureFormat(slot.width, slot.height, slot.mode, slot.depth);
+	}
+
+	/**
+	\fn const void* ReadbackQueue::map(const Ticket& ticket)
+	\brief Map the buffer of a readback in the host memory, waiting for the GPU if needed. Only one buffer can be mapped at a time, the previous one is unmapped.
+	\param ticket The ticket of the readback.
+	\return A pointer to the data (rows of 1 byte alignment, bottom row first, see ReadbackQueue::getFormat) valid until ReadbackQueue::unmap is called.
+	**/
+	const void* ReadbackQueue::map(const Ticket& ticket)
+	{
+		Slot& slot = check(ticket, "map");
+
+		unmap();
+		slot.fence.wait();
+
+		void* ptr = slot.buffer->map(GL_READ_ONLY, GL_PIXEL_PACK_BUFFER);
+
+		if(ptr==NULL)
+		{
+			HdlGeBO::unbind(GL_PIXEL_PACK_BUFFER);
+			throw Exception("ReadbackQueue::map - Unable to map the buffer of the readback " + toString(ticket.serial) + ".", __FILE__, __LINE__, Exception::ModuleException);
+		}
+
+		mappedSlot = ticket.slot;
+		return ptr;
+	}
+
+	/**
+	\fn void ReadbackQueue::unmap(void)
+	\brief Unmap the buffer mapped by ReadbackQueue::map. Do nothing if no buffer is mapped.
+	**/
+	void ReadbackQueue::unmap(void)
+	{
+		if(mappedSlot>=0)
+		{
+			// Other readbacks might have been queued since the mapping, rebind the mapped buffer first :
+			slots[mappedSlot]->buffer->bind(GL_PIXEL_PACK_BUFFER);
+			HdlGeBO::unmap(GL_PIXEL_PACK_BUFFER);
+			HdlGeBO::unbind(GL_PIXEL_PACK_BUFFER);
+			mappedSlot = -1;
+		}
+	}
+
+	/**
+	\fn ImageBuffer* ReadbackQueue::get(const Ticket& ticket)
+	\brief Get the data of a readback in a new image, waiting for the GPU if needed.
+	\param ticket The ticket of the readback.
+	\return A new image of the format of the readback (see ReadbackQueue::getFormat), the user is responsible for its deletion.
+	**/
+	ImageBuffer* ReadbackQueue::get(const Ticket& ticket)
+	{
+		ImageBuffer* image = new ImageBuffer(getFormat(ticket));
+
+		try
+		{
+			get(ticket, *image);
+		}
+		catch(Exception& e)
+		{
+			delete image;
+			throw;
+		}
+
+		return image;
+	}
+
+	/**
+	\fn void ReadbackQueue::get(const Ticket& ticket, ImageBuffer& image, int x, int y)
+	\brief Copy the data of a readback into an existing image, waiting for the GPU if needed.
+	\param ticket The ticket of the readback.
+	\param image The target image, of the same depth. It can be larger than the readback.
+	\param x Left edge of the target rectangle in the image.
+	\param y Bottom edge of the target rectangle in the image.
+	**/
+	void ReadbackQueue::get(const Ticket& ticket, ImageBuffer& image, int x, int y)
+	{
+		const HdlTextureFormat format = getFormat(ticket);
+		void* ptr = const_cast<void*>(map(ticket));
+
+		try
+		{
+			const ImageBuffer data(ptr, format, 1);
+			image.blit(data, 0, 0, x, y, format.getWidth(), format.getHeight());
+		}
+		catch(Exception& e)
+		{
+			unmap();
+			Exception m("ReadbackQueue::get - Unable to copy the readback " + toString(ticket.serial) + " : ", __FILE__, __LINE__, Exception::ModuleException);
+			m << e;
+			throw m;
+		}
+
+		unmap();
+	}
+
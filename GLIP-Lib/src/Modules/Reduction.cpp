@@ -0,0 +1,473 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : Reduction.cpp                                                                             */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Reduction pipeline generator (sum, minimum, maximum, mean, argmin, argmax).               */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    Reduction.cpp
+ * \brief   Reduction pipeline generator (sum, minimum, maximum, mean, argmin, argmax).
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+	// Includes
+	#include "Core/Exception.hpp"
+	#include "Modules/Reduction.hpp"
+	#include "Core/ShaderSource.hpp"
+	#include "Core/HdlShader.hpp"
+
+	using namespace Glip;
+	using namespace Glip::CoreGL;
+	using namespace Glip::CorePipeline;
+	using namespace Glip::Modules;
+	using namespace Glip::Modules::ReductionModules;
+	using namespace Glip::Modules::VanillaParserSpace;
+
+// ReductionModules :
+namespace Glip
+{
+	namespace Modules
+	{
+		namespace ReductionModules
+		{
+			/**
+			\fn bool Glip::Modules::ReductionModules::isOperation(const std::string& str)
+			\brief Test if a string is the name of an operation.
+			\param str Name to be tested.
+			\return True if the string is the name of an operation.
+			**/
+			bool isOperation(const std::string& str)
+			{
+				return 	str=="Sum" || str=="SUM" || str=="Minimum" || str=="MIN" || str=="Maximum" || str=="MAX" ||
+					str=="Mean" || str=="MEAN" || str=="ArgMin" || str=="ARGMIN" || str=="ArgMax" || str=="ARGMAX";
+			}
+
+			/**
+			\fn Operation Glip::Modules::ReductionModules::getOperation(const std::string& str)
+			\brief Get the operation corresponding to a string.
+			\param str Name of the operation.
+			\return The operation corresponding to the string or raise an Exception otherwise.
+			**/
+			Operation getOperation(const std::string& str)
+			{
+				#define TEST(a, b, c) if(str== a || str== b) return c ;
+
+				TEST("Sum",		"SUM",		Sum);
+				TEST("Minimum",		"MIN",		Minimum);
+				TEST("Maximum",		"MAX",		Maximum);
+				TEST("Mean",		"MEAN",		Mean);
+				TEST("ArgMin",		"ARGMIN",	ArgMin);
+				TEST("ArgMax",		"ARGMAX",	ArgMax);
+
+				#undef TEST
+
+				throw Exception("GenerateReductionPipeline::getOperation - Unknown operation name : \"" + str + "\".", __FILE__, __LINE__, Exception::ModuleException);
+			}
+
+			/**
+			\fn Flag Glip::Modules::ReductionModules::getFlag(const std::string& str)
+			\brief Get the flag corresponding to a string.
+			\param str Name of the flag.
+			\return The flag corresponding to the string or raise an Exception otherwise.
+			**/
+			Flag getFlag(const std::string& str)
+			{
+				#define TEST(a, b, c) if(str== a || str== b) return c ;
+
+				TEST("Block8x8",	"BLOCK_8X8",	Block8x8);
+				TEST("NoCompute",	"NO_COMPUTE",	NoCompute);
+
+				#undef TEST
+
+				throw Exception("GenerateReductionPipeline::getFlag - Unknown flag name : \"" + str + "\".", __FILE__, __LINE__, Exception::ModuleException);
+			}
+		}
+	}
+}
+
+// GenerateReductionPipeline :
+	/**
+	\fn GenerateReductionPipeline::GenerateReductionPipeline(void)
+	\brief Module constructor.
+
+	This object can be added to a LayoutLoader via LayoutLoader::addModule().
+	**/
+	GenerateReductionPipeline::GenerateReductionPipeline(void)
+	 :	LayoutLoaderModule(	"GENERATE_REDUCTION_PIPELINE",
+					"DESCRIPTION{Generate a Pipeline reducing a texture to a single texel (sum, minimum, maximum, mean, argmin or argmax).}"
+					"ARGUMENT:format{Name of the format of the input texture.}"
+					"ARGUMENT:name{Name of the new pipeline.}"
+					"ARGUMENT:operations...{Either one operation for all the channels or one operation per channel : SUM, MIN, MAX, MEAN. ARGMIN and ARGMAX must be used alone.}"
+					"ARGUMENT:options...{Options to be used by the reduction : BLOCK_8X8, NO_COMPUTE.}"
+					"BODY_DESCRIPTION{PRE{...} block contains a filtering function to be applied before the reduction. It must define a function vec4 pre(in vec4 colorFromTexture, in vec2 x). It can declare its own uniform variables.}",
+					3,
+					8, //2 base + 4 operations + 2 options
+					0)
+	{ }
+
+	const std::string GenerateReductionPipeline::getInputPortName(void)
+	{
+		return "inputTexture";
+	}
+
+	const std::string GenerateReductionPipeline::getOutputPortName(void)
+	{
+		return "outputTexture";
+	}
+
+	/**
+	\fn bool GenerateReductionPipeline::isComputeAvailable(void)
+	\brief Test if the reductions can be performed with compute shaders.
+	\return True if the compute shaders are available.
+	**/
+	bool GenerateReductionPipeline::isComputeAvailable(void)
+	{
+		#if defined(GLIP_USE_GL)
+			return GLEW_VERSION_4_3 || GLEW_ARB_compute_shader;
+		#else
+			return false;
+		#endif
+	}
+
+	ShaderSource GenerateReductionPipeline::generateCode(int inputWidth, int inputHeight, int blockSize, const std::vector<Operation>& operations, bool first, bool last, int numPixels, bool compute, const ShaderSource& pre)
+	{
+		// inputWidth, inputHeight	: the size of the texture read by this pass.
+		// first, last			: the position of the pass in the pipeline, the PRE function is only applied by the first pass and the mean is normalized by the last pass.
+		// numPixels			: the number of pixels of the texture read by the first pass.
+
+		int lineCounter = 1;
+		#define PUSH_LINE_INFO { linesInfo[lineCounter] = ShaderSource::LineInfo(__FILE__, __LINE__); lineCounter++; }
+
+		std::string str;
+		std::map<int,ShaderSource::LineInfo> linesInfo;
+		const bool argMode = (operations.front()==ArgMin || operations.front()==ArgMax);
+		const char channels[] = {'r', 'g', 'b', 'a'};
+
+		if(compute)
+		{
+			str += "#version 430 \n";												PUSH_LINE_INFO
+			str += "layout(local_size_x = 8, local_size_y = 8) in; \n";								PUSH_LINE_INFO
+			str += "uniform sampler2D " + getInputPortName() + "; \n";								PUSH_LINE_INFO
+			str += "layout(rgba32f) writeonly uniform image2D " + getOutputPortName() + "; \n";					PUSH_LINE_INFO
+			str += "uniform ivec2 " + ComputeFilterLayout::regionOriginName + "; \n";							PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "#version 130 \n";												PUSH_LINE_INFO
+			str += "uniform sampler2D " + getInputPortName() + "; \n";								PUSH_LINE_INFO
+			str += "out vec4 " + getOutputPortName() + "; \n";									PUSH_LINE_INFO
+		}
+
+		if(first && !pre.empty())
+		{
+			str += pre.getSource();
+			for(int k=0; k<pre.getNumLines(); k++)
+				linesInfo[lineCounter+k] = pre.getLineInfo(k+1);
+
+			lineCounter += pre.getNumLines();
+		}
+
+		str += "\n";															PUSH_LINE_INFO
+		str += "vec4 fetch(in ivec2 p) \n";												PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    vec4 c = texelFetch(" + getInputPortName() + ", p, 0); \n";							PUSH_LINE_INFO
+
+		if(first && !pre.empty())
+		{
+			str += "    c = pre(c, (vec2(p)+vec2(0.5))/vec2(" + toString(inputWidth) + ", " + toString(inputHeight) + ")); \n";	PUSH_LINE_INFO
+		}
+
+		if(first && argMode)
+		{
+			str += "    c = vec4(c.r, float(p.x), float(p.y), 1.0); \n";							PUSH_LINE_INFO
+		}
+
+		str += "    return c; \n";													PUSH_LINE_INFO
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
+		str += "vec4 combine(in vec4 a, in vec4 b) \n";											PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+
+		if(operations.front()==ArgMin)
+		{
+			str += "    return (b.r<a.r) ? b : a; \n";										PUSH_LINE_INFO
+		}
+		else if(operations.front()==ArgMax)
+		{
+			str += "    return (b.r>a.r) ? b : a; \n";										PUSH_LINE_INFO
+		}
+		else
+		{
+			std::string combination;
+			for(int c=0; c<4; c++)
+			{
+				const Operation op = operations[operations.size()==1 ? 0 : c];
+				const std::string	a = std::string("a.") + channels[c],
+							b = std::string("b.") + channels[c];
+
+				if(c>0)
+					combination += ", ";
+
+				if(op==Minimum)
+					combination += "min(" + a + ", " + b + ")";
+				else if(op==Maximum)
+					combination += "max(" + a + ", " + b + ")";
+				else // Sum, Mean
+					combination += a + " + " + b;
+			}
+			str += "    return vec4(" + combination + "); \n";								PUSH_LINE_INFO
+		}
+
+		str += "} \n";															PUSH_LINE_INFO
+		str += "\n";															PUSH_LINE_INFO
+		str += "void main() \n";													PUSH_LINE_INFO
+		str += "{ \n";															PUSH_LINE_INFO
+		str += "    const ivec2 s = ivec2(" + toString(inputWidth) + ", " + toString(inputHeight) + "); \n";			PUSH_LINE_INFO
+		str += "    const int b = " + toString(blockSize) + "; \n";									PUSH_LINE_INFO
+
+		if(compute)
+		{
+			str += "    ivec2 q = " + ComputeFilterLayout::regionOriginName + " + ivec2(gl_GlobalInvocationID.xy); \n";		PUSH_LINE_INFO
+			str += "    if(any(greaterThanEqual(q, imageSize(" + getOutputPortName() + ")))) return; \n";			PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    ivec2 q = ivec2(gl_FragCoord.xy); \n";									PUSH_LINE_INFO
+		}
+
+		// Gather the block, clipped to the input (the first texel of the block is always inside) :
+		str += "    ivec2 o = q*b, \n";												PUSH_LINE_INFO
+		str += "          e = min(o + ivec2(b), s); \n";										PUSH_LINE_INFO
+		str += "    vec4 r = fetch(o); \n";												PUSH_LINE_INFO
+		str += "    for(int j=o.y; j<e.y; j++) \n";											PUSH_LINE_INFO
+		str += "        for(int i=o.x; i<e.x; i++) \n";										PUSH_LINE_INFO
+		str += "            if(i!=o.x || j!=o.y) r = combine(r, fetch(ivec2(i, j))); \n";					PUSH_LINE_INFO
+
+		if(last && !argMode)
+		{
+			for(int c=0; c<4; c++)
+			{
+				if(operations[operations.size()==1 ? 0 : c]==Mean)
+				{
+					str += std::string("    r.") + channels[c] + " = r." + channels[c] + "/float(" + toString(numPixels) + "); \n";	PUSH_LINE_INFO
+				}
+			}
+		}
+
+		if(compute)
+		{
+			str += "    imageStore(" + getOutputPortName() + ", q, r); \n";							PUSH_LINE_INFO
+		}
+		else
+		{
+			str += "    " + getOutputPortName() + " = r; \n";									PUSH_LINE_INFO
+		}
+
+		str += "} \n";															PUSH_LINE_INFO
+
+		#undef PUSH_LINE_INFO
+
+		return ShaderSource(str, "<GenerateReductionPipeline::generate(" + toString(inputWidth) + ", " + toString(inputHeight) + ")>", 1, linesInfo);
+	}
+
+	/**
+	\fn PipelineLayout GenerateReductionPipeline::generate(int width, int height, ReductionModules::Operation operation, int flags, const ShaderSource& pre)
+	\brief Construct a pipeline reducing all the channels with the same operation.
+	\param width Width of the input texture.
+	\param height Height of the input texture.
+	\param operation Operation to be performed on all the channels (see Glip::Modules::ReductionModules::Operation).
+	\param flags Possible flags associated to the reduction (see Glip::Modules::ReductionModules::Flag).
+	\param pre Add a filtering function before the reduction.
+	\return A complete pipeline layout.
+	**/
+	PipelineLayout GenerateReductionPipeline::generate(int width, int height, ReductionModules::Operation operation, int flags, const ShaderSource& pre)
+	{
+		return generate(width, height, std::vector<Operation>(1, operation), flags, pre);
+	}
+
+	/**
+	\fn PipelineLayout GenerateReductionPipeline::generate(int width, int height, const std::vector<ReductionModules::Operation>& operations, int flags, const ShaderSource& pre)
+	\brief Construct a pipeline reducing a texture to a single texel.
+	\param width Width of the input texture.
+	\param height Height of the input texture.
+	\param operations Either one operation for all the channels or four operations, one per channel (see Glip::Modules::ReductionModules::Operation).
+	\param flags Possible flags associated to the reduction (see Glip::Modules::ReductionModules::Flag).
+	\param pre Add a filtering function before the reduction.
+	\return A complete pipeline layout.
+
+	The <b>pre-function</b> will be applied on the input texels. It should be a block of code declaring the function <i>pre</i> as in the following example :
+	\code
+	vec4 pre(in vec4 colorFromTexture, in vec2 x)
+	{
+		return modifiedColor;
+	}
+	\endcode
+
+	The position is normalized from 0.0 to 1.0. You are allowed to declare uniform variables in this filter.
+	**/
+	PipelineLayout GenerateReductionPipeline::generate(int width, int height, const std::vector<ReductionModules::Operation>& operations, int flags, const ShaderSource& pre)
+	{
+		if(width<1 || height<1)
+			throw Exception("GenerateReductionPipeline::generate - Invalid size : " + toString(width) + "x" + toString(height) + ".", __FILE__, __LINE__, Exception::ModuleException);
+
+		if(operations.size()!=1 && operations.size()!=4)
+			throw Exception("GenerateReductionPipeline::generate - Either one operation for all the channels or four operations must be given (current : " + toString(operations.size()) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+		for(std::vector<Operation>::const_iterator it=operations.begin(); it!=operations.end(); it++)
+		{
+			if(((*it)==ArgMin || (*it)==ArgMax) && operations.size()!=1)
+				throw Exception("GenerateReductionPipeline::generate - The operations ArgMin and ArgMax cannot be combined with other operations.", __FILE__, __LINE__, Exception::ModuleException);
+		}
+
+		if(!pre.getOutputVars().empty() && !pre.requiresCompatibility())
+			throw Exception("GenerateReductionPipeline::generate - A PRE-function cannot have an output (its own output port(s)).", __FILE__, __LINE__, Exception::ModuleException);
+
+		const int blockSize = ((flags & Block8x8)!=0) ? 8 : 4;
+		const bool compute = ((flags & NoCompute)==0) && isComputeAvailable();
+		PipelineLayout pipelineLayout("Reduction" + toString(width) + "x" + toString(height) + "Pipeline");
+
+		pipelineLayout.addInput(getInputPortName());
+		pipelineLayout.addOutput(getOutputPortName());
+
+		int	w = width,
+			h = height,
+			pass = 0;
+		std::string previousName;
+
+		// At least one pass, even for a single texel (the PRE function and the normalization must be applied) :
+		do
+		{
+			const int	ow = (w + blockSize - 1)/blockSize,
+					oh = (h + blockSize - 1)/blockSize;
+			const bool	first = (pass==0),
+					last = (ow==1 && oh==1);
+			const std::string name = "Reduction" + toString(pass);
+
+			HdlTextureFormat format(ow, oh, GL_RGBA32F, GL_FLOAT, GL_NEAREST, GL_NEAREST);
+			ShaderSource shader = generateCode(w, h, blockSize, operations, first, last, width*height, compute, pre);
+
+			if(compute)
+				pipelineLayout.add(ComputeFilterLayout(name, format, shader), name);
+			else
+				pipelineLayout.add(FilterLayout(name, format, shader), name);
+
+			if(first)
+			{
+				pipelineLayout.connectToInput(getInputPortName(), name, getInputPortName());
+
+				// Add the ports declared in PRE :
+				for(std::vector<std::string>::const_iterator it=pre.getInputVars().begin(); it!=pre.getInputVars().end(); it++)
+				{
+					if((*it)==getInputPortName())
+						throw Exception("GenerateReductionPipeline::generate - The PRE function cannot declare the input port \"" + getInputPortName() + "\" as it is already used.", __FILE__, __LINE__, Exception::ModuleException);
+
+					pipelineLayout.addInput(*it);
+					pipelineLayout.connectToInput(*it, name, *it);
+				}
+			}
+			else
+				pipelineLayout.connect(previousName, getOutputPortName(), name, getInputPortName());
+
+			previousName = name;
+			w = ow;
+			h = oh;
+			pass++;
+		}
+		while(w>1 || h>1);
+
+		pipelineLayout.connectToOutput(previousName, getOutputPortName(), getOutputPortName());
+
+		return pipelineLayout;
+	}
+
+	void GenerateReductionPipeline::apply(LAYOUT_LOADER_ARGUMENTS_LIST)
+	{
+		UNUSED_PARAMETER(currentPath)
+		UNUSED_PARAMETER(dynamicPaths)
+		UNUSED_PARAMETER(geometryList)
+		UNUSED_PARAMETER(filterList)
+		UNUSED_PARAMETER(mainPipelineName)
+		UNUSED_PARAMETER(staticPaths)
+		UNUSED_PARAMETER(requiredFormatList)
+		UNUSED_PARAMETER(requiredSourceList)
+		UNUSED_PARAMETER(requiredGeometryList)
+		UNUSED_PARAMETER(requiredPipelineList)
+		UNUSED_PARAMETER(moduleList)
+		UNUSED_PARAMETER(executionSource)
+		UNUSED_PARAMETER(executionSourceName)
+		UNUSED_PARAMETER(executionStartLine)
+
+		FORMAT_MUST_EXIST( arguments[0] )
+		PIPELINE_MUST_NOT_EXIST( arguments[1] )
+
+		CONST_ITERATOR_TO_FORMAT( itFormat, arguments[0] )
+
+		// Read the operations, then the flags :
+		std::vector<Operation> operations;
+		int flags = 0;
+		for(unsigned int k=2; k<arguments.size(); k++)
+		{
+			if(isOperation(arguments[k]))
+			{
+				if(flags!=0)
+					throw Exception("The operations must be given before the options (\"" + arguments[k] + "\").", sourceName, startLine, Exception::ClientScriptException);
+
+				operations.push_back(getOperation(arguments[k]));
+			}
+			else
+				flags = flags | static_cast<int>(getFlag(arguments[k]));
+		}
+
+		if(operations.empty())
+			throw Exception("No operation was given.", sourceName, startLine, Exception::ClientScriptException);
+
+		// Read the PRE function :
+		ShaderSource pre("");
+
+		if(!body.empty())
+		{
+			VanillaParser parser(body, sourceName, bodyLine);
+			bool preAlreadySet = false;
+
+			for(std::vector<Element>::iterator it=parser.elements.begin(); it!=parser.elements.end(); it++)
+			{
+				if(it->strKeyword=="PRE")
+				{
+					if(preAlreadySet)
+						throw Exception("PRE code already set.", it->sourceName, it->startLine, Exception::ClientScriptException);
+
+					if(it->arguments.size()==1 && it->noBody)
+					{
+						SOURCE_MUST_EXIST( it->arguments.front() )
+						CONST_ITERATOR_TO_SOURCE( its, it->arguments.front() )
+						pre = its->second;
+					}
+					else if(it->noArgument && !it->body.empty())
+					{
+						ShaderSource src(it->body, it->sourceName, it->bodyLine);
+						pre = src;
+					}
+					else
+						throw Exception("The PRE code can have either one argument or one body.", it->sourceName, it->startLine, Exception::ClientScriptException);
+
+					preAlreadySet = true;
+				}
+				else
+					throw Exception("Unknown keyword \"" + it->strKeyword + "\". Expected PRE.", it->sourceName, it->startLine, Exception::ClientScriptException);
+			}
+		}
+
+		APPEND_NEW_PIPELINE(arguments[1], generate(itFormat->second.getWidth(), itFormat->second.getHeight(), operations, flags, pre))
+	}
+
@@ -0,0 +1,421 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : TiledExecutor.cpp                                                                         */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Module : Tiled execution of a pipeline on large host images.                              */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    TiledExecutor.cpp
+ * \brief   Module : Tiled execution of a pipeline on large host images.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+	// Includes
+	#include <algorithm>
+	#include "Core/Exception.hpp"
+	#include "Modules/TiledExecutor.hpp"
+	#include "devDebugTools.hpp"
+
+	using namespace Glip;
+	using namespace Glip::CoreGL;
+	using namespace Glip::CorePipeline;
+	using namespace Glip::Modules;
+
+// TiledExecutor
+	/**
+	\fn TiledExecutor::TiledExecutor(Pipeline& _pipeline, int _tileWidth, int _tileHeight, int _halo)
+	\brief TiledExecutor constructor.
+	\param _pipeline The pipeline to apply. It must be built for inputs and outputs of size _tileWidth x _tileHeight and must be maintained in memory while this object exists.
+	\param _tileWidth Width of the tiles, halo included.
+	\param _tileHeight Height of the tiles, halo included.
+	\param _halo Width of the overlap on each side of the tiles. Default is -1 which means that the halo declared by the filters is used (see Pipeline::getHalo).
+	**/
+	TiledExecutor::TiledExecutor(Pipeline& _pipeline, int _tileWidth, int _tileHeight, int _halo)
+	 :	pipeline(_pipeline),
+		tileWidth(_tileWidth),
+		tileHeight(_tileHeight),
+		fixedHalo(_halo)
+	{
+		if(tileWidth<=0 || tileHeight<=0 || tileWidth>HdlAbstractTextureFormat::getMaxSize() || tileHeight>HdlAbstractTextureFormat::getMaxSize())
+			throw Exception("TiledExecutor::TiledExecutor - Invalid tile size (" + toString(tileWidth) + "x" + toString(tileHeight) + "), the maximum size is " + toString(HdlAbstractTextureFormat::getMaxSize()) + ".", __FILE__, __LINE__, Exception::ModuleException);
+
+		pendingTiles[0].valid = false;
+		pendingTiles[1].valid = false;
+	}
+
+	TiledExecutor::~TiledExecutor(void)
+	{
+		clean();
+	}
+
+	void TiledExecutor::clean(void)
+	{
+		for(int s=0; s<2; s++)
+		{
+			for(std::vector<HdlTexture*>::iterator it=inputsTiles[s].begin(); it!=inputsTiles[s].end(); it++)
+				delete *it;
+			for(std::vector<HdlGeBO*>::iterator it=readbackBuffers[s].begin(); it!=readbackBuffers[s].end(); it++)
+				delete *it;
+
+			inputsTiles[s].clear();
+			readbackBuffers[s].clear();
+			pendingTiles[s].valid = false;
+		}
+
+		readbackFormats.clear();
+	}
+
+	void TiledExecutor::split(int size, int tileSize, int halo, std::vector<int>& origins, std::vector<int>& starts, std::vector<int>& lengths)
+	{
+		const int core = tileSize - 2*halo;
+
+		origins.clear();
+		starts.clear();
+		lengths.clear();
+
+		// The tiles are shifted to stay inside the image, the borders of the image are then the borders of the tiles :
+		for(int start=0; start<size; start+=core)
+		{
+			origins.push_back(std::max(0, std::min(start - halo, size - tileSize)));
+			starts.push_back(start);
+			lengths.push_back(std::min(core, size - start));
+		}
+	}
+
+	const ImageBuffer& TiledExecutor::prepare(const std::vector<const ImageBuffer*>& inputs, const std::vector<ImageBuffer*>& outputs)
+	{
+		if(static_cast<int>(inputs.size())!=pipeline.getNumInputPort())
+			throw Exception("TiledExecutor::prepare - The pipeline " + pipeline.getFullName() + " has " + toString(pipeline.getNumInputPort()) + " input(s), " + toString(inputs.size()) + " image(s) given.", __FILE__, __LINE__, Exception::ModuleException);
+		if(static_cast<int>(outputs.size())!=pipeline.getNumOutputPort())
+			throw Exception("TiledExecutor::prepare - The pipeline " + pipeline.getFullName() + " has " + toString(pipeline.getNumOutputPort()) + " output(s), " + toString(outputs.size()) + " image(s) given (NULL for the outputs not needed).", __FILE__, __LINE__, Exception::ModuleException);
+
+		// All the images must have the same size :
+		std::vector<const ImageBuffer*> images(inputs.begin(), inputs.end());
+		for(std::vector<ImageBuffer*>::const_iterator it=outputs.begin(); it!=outputs.end(); it++)
+		{
+			if(*it!=NULL)
+				images.push_back(*it);
+		}
+
+		if(images.empty())
+			throw Exception("TiledExecutor::prepare - No image given.", __FILE__, __LINE__, Exception::ModuleException);
+
+		for(std::vector<const ImageBuffer*>::const_iterator it=images.begin(); it!=images.end(); it++)
+		{
+			if(*it==NULL)
+				throw Exception("TiledExecutor::prepare - Missing input image.", __FILE__, __LINE__, Exception::ModuleException);
+			if((*it)->getWidth()!=images.front()->getWidth() || (*it)->getHeight()!=images.front()->getHeight())
+				throw Exception("TiledExecutor::prepare - The images do not have the same size (" + toString((*it)->getWidth()) + "x" + toString((*it)->getHeight()) + " and " + toString(images.front()->getWidth()) + "x" + toString(images.front()->getHeight()) + ").", __FILE__, __LINE__, Exception::ModuleException);
+			if((*it)->getWidth()<tileWidth || (*it)->getHeight()<tileHeight)
+				throw Exception("TiledExecutor::prepare - The images (" + toString((*it)->getWidth()) + "x" + toString((*it)->getHeight()) + ") are smaller than a tile (" + toString(tileWidth) + "x" + toString(tileHeight) + "), apply the pipeline directly.", __FILE__, __LINE__, Exception::ModuleException);
+		}
+
+		// Input tiles, same format as the images (without mipmaps) :
+		for(int s=0; s<2; s++)
+		{
+			inputsTiles[s].resize(inputs.size(), NULL);
+
+			for(unsigned int i=0; i<inputs.size(); i++)
+			{
+				HdlTextureFormat format(*inputs[i]);
+				format.setSize(tileWidth, tileHeight);
+				format.setBaseLevel(0);
+				format.setMaxLevel(0);
+
+				if(inputsTiles[s][i]!=NULL && inputsTiles[s][i]->format()==format)
+					continue;
+
+				delete inputsTiles[s][i];
+				inputsTiles[s][i] = NULL;
+				inputsTiles[s][i] = new HdlTexture(format);
+				inputsTiles[s][i]->allocate();
+			}
+		}
+
+		// Readback buffers, in the format of the destination images :
+		readbackFormats.clear();
+
+		for(int s=0; s<2; s++)
+			readbackBuffers[s].resize(outputs.size(), NULL);
+
+		for(unsigned int i=0; i<outputs.size(); i++)
+		{
+			if(outputs[i]==NULL)
+			{
+				readbackFormats.push_back(HdlTextureFormat(1, 1, GL_RGBA, GL_UNSIGNED_BYTE)); // Unused.
+				continue;
+			}
+
+			const HdlTexture& target = pipeline.out(i);
+
+			if(target.getWidth()<tileWidth || target.getHeight()<tileHeight)
+				throw Exception("TiledExecutor::prepare - The output " + pipeline.getOutputPortName(i) + " of " + pipeline.getFullName() + " (" + toString(target.getWidth()) + "x" + toString(target.getHeight()) + ") is smaller than a tile (" + toString(tileWidth) + "x" + toString(tileHeight) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+			readbackFormats.push_back(HdlTextureFormat(target.getWidth(), target.getHeight(), outputs[i]->getGLMode(), outputs[i]->getGLDepth()));
+
+			// Rows aligned as in the destination image :
+			const int		alignment	= outputs[i]->getAlignment();
+			const GLsizeiptr	rowSize		= ((readbackFormats[i].getWidth()*readbackFormats[i].getPixelSize() + alignment - 1)/alignment)*alignment,
+						size		= rowSize * readbackFormats[i].getHeight();
+
+			for(int s=0; s<2; s++)
+			{
+				if(readbackBuffers[s][i]!=NULL && readbackBuffers[s][i]->getSize()==size)
+					continue;
+
+				delete readbackBuffers[s][i];
+				readbackBuffers[s][i] = NULL;
+				readbackBuffers[s][i] = new HdlGeBO(size, GL_PIXEL_PACK_BUFFER, GL_STREAM_READ);
+			}
+		}
+
+		return *images.front();
+	}
+
+	void TiledExecutor::upload(const ImageBuffer& image, HdlTexture& texture, int x, int y)
+	{
+		#if !defined(GLIP_USE_GLES) && !defined(GLIP_USE_GLES2)
+			texture.bind();
+
+			GLint originalAlignment = 0;
+			glGetIntegerv(GL_UNPACK_ALIGNMENT, &originalAlignment);
+
+			// Read the tile directly from the image :
+			glPixelStorei(GL_UNPACK_ALIGNMENT, image.getAlignment());
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, image.getWidth());
+			glPixelStorei(GL_UNPACK_SKIP_PIXELS, x);
+			glPixelStorei(GL_UNPACK_SKIP_ROWS, y);
+
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, tileWidth, tileHeight, image.getDescriptor().aliasMode, image.getGLDepth(), image.getPtr());
+
+			const GLenum err = glGetError();
+
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+			glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+			glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, originalAlignment);
+			HdlTexture::unbind();
+
+			if(err!=GL_NO_ERROR)
+				throw Exception("TiledExecutor::upload - Unable to copy the tile at (" + toString(x) + ", " + toString(y) + ") to the texture (glTexSubImage2D). (OpenGL error : " + getGLEnumNameSafe(err) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+			texture.touch();
+		#else
+			UNUSED_PARAMETER(image)
+			UNUSED_PARAMETER(texture)
+			UNUSED_PARAMETER(x)
+			UNUSED_PARAMETER(y)
+			throw Exception("TiledExecutor::upload - Not currently supported under GLES2.", __FILE__, __LINE__, Exception::GLException);
+		#endif
+	}
+
+	void TiledExecutor::readback(int slot, const std::vector<ImageBuffer*>& outputs)
+	{
+		#if !defined(GLIP_USE_GLES) && !defined(GLIP_USE_GLES2) && !defined(GLIP_USE_GLES3)
+			GLint originalAlignment = 0;
+			glGetIntegerv(GL_PACK_ALIGNMENT, &originalAlignment);
+
+			for(unsigned int i=0; i<outputs.size(); i++)
+			{
+				if(outputs[i]==NULL)
+					continue;
+
+				// The copy is queued, the data will be read once the buffer is mapped (see TiledExecutor::stitch) :
+				readbackBuffers[slot][i]->bind(GL_PIXEL_PACK_BUFFER);
+				pipeline.out(i).bind();
+				glPixelStorei(GL_PACK_ALIGNMENT, outputs[i]->getAlignment());
+
+				glGetTexImage(GL_TEXTURE_2D, 0, outputs[i]->getDescriptor().aliasMode, outputs[i]->getGLDepth(), NULL);
+
+				const GLenum err = glGetError();
+
+				glPixelStorei(GL_PACK_ALIGNMENT, originalAlignment);
+				HdlTexture::unbind();
+				HdlGeBO::unbind(GL_PIXEL_PACK_BUFFER);
+
+				if(err!=GL_NO_ERROR)
+					throw Exception("TiledExecutor::readback - Unable to read the output " + pipeline.getOutputPortName(i) + " (glGetTexImage). (OpenGL error : " + getGLEnumNameSafe(err) + ").", __FILE__, __LINE__, Exception::ModuleException);
+			}
+		#else
+			UNUSED_PARAMETER(slot)
+			UNUSED_PARAMETER(outputs)
+			throw Exception("TiledExecutor::readback - Not currently supported under GLES.", __FILE__, __LINE__, Exception::GLException);
+		#endif
+	}
+
+	void TiledExecutor::stitch(int slot, const std::vector<ImageBuffer*>& outputs)
+	{
+		PendingTile& tile = pendingTiles[slot];
+
+		if(!tile.valid)
+			return ;
+
+		tile.valid = false;
+
+		for(unsigned int i=0; i<outputs.size(); i++)
+		{
+			if(outputs[i]==NULL)
+				continue;
+
+			void* ptr = readbackBuffers[slot][i]->map(GL_READ_ONLY, GL_PIXEL_PACK_BUFFER);
+
+			try
+			{
+				if(ptr==NULL)
+					throw Exception("TiledExecutor::stitch - Unable to map the readback buffer of the output " + pipeline.getOutputPortName(i) + ".", __FILE__, __LINE__, Exception::ModuleException);
+
+				const ImageBuffer result(ptr, readbackFormats[i], outputs[i]->getAlignment());
+				outputs[i]->blit(result, tile.xTile, tile.yTile, tile.xImage, tile.yImage, tile.width, tile.height);
+			}
+			catch(Exception& e)
+			{
+				HdlGeBO::unmap(GL_PIXEL_PACK_BUFFER);
+				HdlGeBO::unbind(GL_PIXEL_PACK_BUFFER);
+				throw;
+			}
+
+			HdlGeBO::unmap(GL_PIXEL_PACK_BUFFER);
+			HdlGeBO::unbind(GL_PIXEL_PACK_BUFFER);
+		}
+	}
+
+	/**
+	\fn int TiledExecutor::getTileWidth(void) const
+	\return The width of the tiles, halo included.
+	**/
+	int TiledExecutor::getTileWidth(void) const
+	{
+		return tileWidth;
+	}
+
+	/**
+	\fn int TiledExecutor::getTileHeight(void) const
+	\return The height of the tiles, halo included.
+	**/
+	int TiledExecutor::getTileHeight(void) const
+	{
+		return tileHeight;
+	}
+
+	/**
+	\fn int TiledExecutor::getHalo(void)
+	\brief Get the width of the overlap on each side of the tiles.
+	\return The halo given to the constructor, or the current halo of the pipeline (see Pipeline::getHalo), which is -1 if it is unknown.
+	**/
+	int TiledExecutor::getHalo(void)
+	{
+		return (fixedHalo>=0) ? fixedHalo : pipeline.getHalo();
+	}
+
+	/**
+	\fn int TiledExecutor::getNumTiles(int width, int height)
+	\brief Get the number of tiles needed to process images of a given size.
+	\param width The width of the images.
+	\param height The height of the images.
+	\return The number of tiles, or 0 if the halo is unknown or too large for the tiles.
+	**/
+	int TiledExecutor::getNumTiles(int width, int height)
+	{
+		const int	halo		= getHalo(),
+				coreWidth	= tileWidth - 2*halo,
+				coreHeight	= tileHeight - 2*halo;
+
+		if(halo<0 || coreWidth<=0 || coreHeight<=0)
+			return 0;
+		else
+			return ((width + coreWidth - 1)/coreWidth) * ((height + coreHeight - 1)/coreHeight);
+	}
+
+	/**
+	\fn void TiledExecutor::process(const std::vector<const ImageBuffer*>& inputs, const std::vector<ImageBuffer*>& outputs)
+	\brief Apply the pipeline to the images, tile by tile.
+	\param inputs The input images, one per input port of the pipeline, all of the same size (larger than a tile).
+	\param outputs The destination images, one per output port of the pipeline (NULL for the outputs which are not needed), of the same size as the inputs. The results are converted to their format.
+	**/
+	void TiledExecutor::process(const std::vector<const ImageBuffer*>& inputs, const std::vector<ImageBuffer*>& outputs)
+	{
+		try
+		{
+			const ImageBuffer&	reference	= prepare(inputs, outputs);
+			const int		halo		= getHalo();
+
+			if(halo<0)
+				throw Exception("TiledExecutor::process - The halo of the pipeline " + pipeline.getFullName() + " is unknown, it must be declared by its filters or given to the constructor.", __FILE__, __LINE__, Exception::ModuleException);
+			if(2*halo>=tileWidth || 2*halo>=tileHeight)
+				throw Exception("TiledExecutor::process - The halo (" + toString(halo) + ") is too large for the tiles (" + toString(tileWidth) + "x" + toString(tileHeight) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+			std::vector<int>	xOrigins, xStarts, xLengths,
+						yOrigins, yStarts, yLengths;
+
+			split(reference.getWidth(), tileWidth, halo, xOrigins, xStarts, xLengths);
+			split(reference.getHeight(), tileHeight, halo, yOrigins, yStarts, yLengths);
+
+			int slot = 0;
+
+			for(unsigned int ty=0; ty<yOrigins.size(); ty++)
+			{
+				for(unsigned int tx=0; tx<xOrigins.size(); tx++)
+				{
+					// Upload in the textures which are not read by the previous tile :
+					for(unsigned int i=0; i<inputs.size(); i++)
+						upload(*inputs[i], *inputsTiles[slot][i], xOrigins[tx], yOrigins[ty]);
+
+					for(unsigned int i=0; i<inputs.size(); i++)
+						pipeline << *inputsTiles[slot][i];
+					pipeline << Pipeline::Process;
+
+					readback(slot, outputs);
+
+					PendingTile& tile = pendingTiles[slot];
+					tile.valid	= true;
+					tile.xTile	= xStarts[tx] - xOrigins[tx];
+					tile.yTile	= yStarts[ty] - yOrigins[ty];
+					tile.xImage	= xStarts[tx];
+					tile.yImage	= yStarts[ty];
+					tile.width	= xLengths[tx];
+					tile.height	= yLengths[ty];
+
+					// Copy the previous tile while the GPU processes this one :
+					slot = 1 - slot;
+					stitch(slot, outputs);
+				}
+			}
+
+			stitch(1 - slot, outputs);
+		}
+		catch(Exception& e)
+		{
+			pendingTiles[0].valid = false;
+			pendingTiles[1].valid = false;
+
+			Exception m("TiledExecutor::process - Exception caught while processing the tiles with the pipeline " + pipeline.getFullName() + " : ", __FILE__, __LINE__, Exception::ModuleException);
+			m << e;
+			throw m;
+		}
+	}
+
+	/**
+	\fn void TiledExecutor::process(const ImageBuffer& input, ImageBuffer& output)
+	\brief Apply a pipeline with a single input and a single output to an image, tile by tile.
+	\param input The input image.
+	\param output The destination image, of the same size as the input.
+	**/
+	void TiledExecutor::process(const ImageBuffer& input, ImageBuffer& output)
+	{
+		std::vector<const ImageBuffer*> inputs(1, &input);
+		std::vector<ImageBuffer*> outputs(1, &output);
+
+		process(inputs, outputs);
+	}
+
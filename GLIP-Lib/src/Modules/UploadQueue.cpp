@@ -0,0 +1,299 @@
+/* ************************************************************************************************************* */
+/*                                                                                                               */
+/*     GLIP-LIB                                                                                                  */
+/*     OpenGL Image Processing LIBrary                                                                           */
+/*                                                                                                               */
+/*     Author        : R. Kerviche                                                                               */
+/*     LICENSE       : MIT License                                                                               */
+/*     Website       : glip-lib.net                                                                              */
+/*                                                                                                               */
+/*     File          : UploadQueue.cpp                                                                           */
+/*     Original Date : October 16th 2026                                                                         */
+/*                                                                                                               */
+/*     Description   : Module : Streaming upload of textures through pixel unpack buffers.                       */
+/*                                                                                                               */
+/* ************************************************************************************************************* */
+
+/**
+ * \file    UploadQueue.cpp
+ * \brief   Module : Streaming upload of textures through pixel unpack buffers.
+ * \author  R. KERVICHE
+ * \date    October 16th 2026
+**/
+
+	// Includes
+	#include <cstring>
+	#include "Core/Exception.hpp"
+	#include "Modules/UploadQueue.hpp"
+	#include "devDebugTools.hpp"
+
+	using namespace Glip;
+	using namespace Glip::CoreGL;
+	using namespace Glip::Modules;
+
+// UploadQueue::Slot
+	UploadQueue::Slot::Slot(void)
+	 :	buffer(NULL)
+	{ }
+
+	UploadQueue::Slot::~Slot(void)
+	{
+		delete buffer;
+	}
+
+// UploadQueue
+	/**
+	\fn UploadQueue::UploadQueue(int numBuffers)
+	\brief UploadQueue constructor.
+	\param numBuffers Number of pixel unpack buffers in the ring (at least 1). The buffers are allocated on first use.
+	**/
+	UploadQueue::UploadQueue(int numBuffers)
+	 :	position(-1),
+		mappedSlot(-1),
+		target(NULL),
+		alignment(1),
+		pixelFormat(GL_NONE),
+		pixelDepth(GL_NONE),
+		mappedSize(0),
+		numOrphanings(0)
+	{
+		if(numBuffers<1)
+			throw Exception("UploadQueue::UploadQueue - The number of buffers must be at least 1 (current : " + toString(numBuffers) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+		for(int k=0; k<numBuffers; k++)
+			slots.push_back(new Slot);
+
+		region[0] = region[1] = region[2] = region[3] = 0;
+	}
+
+	UploadQueue::~UploadQueue(void)
+	{
+		if(mappedSlot>=0)
+		{
+			slots[mappedSlot]->buffer->bind(GL_PIXEL_UNPACK_BUFFER);
+			HdlGeBO::unmap(GL_PIXEL_UNPACK_BUFFER);
+			HdlGeBO::unbind(GL_PIXEL_UNPACK_BUFFER);
+		}
+
+		for(std::vector<Slot*>::iterator it=slots.begin(); it!=slots.end(); it++)
+			delete *it;
+		slots.clear();
+	}
+
+	/**
+	\fn int UploadQueue::getNumBuffers(void) const
+	\return The number of pixel unpack buffers in the ring.
+	**/
+	int UploadQueue::getNumBuffers(void) const
+	{
+		return slots.size();
+	}
+
+	/**
+	\fn int UploadQueue::getNumOrphanings(void) const
+	\return The number of times a buffer was still in use by the GPU when it came back in the ring and had its storage orphaned (or, for persistently mapped buffers, had to be waited for). A large count means that the ring is too short for the latency of the GPU.
+	**/
+	int UploadQueue::getNumOrphanings(void) const
+	{
+		return numOrphanings;
+	}
+
+	/**
+	\fn bool UploadQueue::isMapped(void) const
+	\return True if a buffer is mapped, waiting for UploadQueue::submit.
+	**/
+	bool UploadQueue::isMapped(void) const
+	{
+		return mappedSlot>=0;
+	}
+
+	/**
+	\fn void* UploadQueue::map(HdlTexture& texture, int x, int y, int width, int height, GLenum _pixelFormat, GLenum _pixelDepth, int _alignment)
+	\brief Map the next buffer of the ring, to be filled with the data of a rectangle of the texture. The upload is issued by UploadQueue::submit.
+	\param texture The target texture, which must be maintained in memory until UploadQueue::submit is called.
+	\param x Left edge of the rectangle, in pixels.
+	\param y Bottom edge of the rectangle, in pixels.
+	\param width Width of the rectangle (default, 0, is the width of the texture minus x).
+	\param height Height of the rectangle (default, 0, is the height of the texture minus y).
+	\param _pixelFormat The pixel format of the data (considered the same as the texture layout if not provided).
+	\param _pixelDepth The depth of the data (considered the same as the texture layout if not provided).
+	\param _alignment Byte alignment of the rows of the data (considered the same as the texture if not provided).
+	\return A pointer to the mapped buffer, of UploadQueue::getMappedSize bytes.
+	**/
+	void* UploadQueue::map(HdlTexture& texture, int x, int y, int width, int height, GLenum _pixelFormat, GLenum _pixelDepth, int _alignment)
+	{
+		#if !defined(GLIP_USE_GLES) && !defined(GLIP_USE_GLES2) && !defined(GLIP_USE_GLES3)
+			if(mappedSlot>=0)
+				throw Exception("UploadQueue::map - A buffer is already mapped, UploadQueue::submit must be called first.", __FILE__, __LINE__, Exception::ModuleException);
+			if(texture.isCompressed())
+				throw Exception("UploadQueue::map - Compressed textures are not supported.", __FILE__, __LINE__, Exception::ModuleException);
+
+			if(width<=0)		width		= texture.getWidth() - x;
+			if(height<=0)		height		= texture.getHeight() - y;
+			if(_pixelFormat==GL_ZERO)	_pixelFormat	= texture.getGLMode();
+			if(_pixelDepth==GL_ZERO)	_pixelDepth	= texture.getGLDepth();
+			if(_alignment<0)	_alignment	= texture.getAlignment();
+
+			if(x<0 || y<0 || width<=0 || height<=0 || x+width>texture.getWidth() || y+height>texture.getHeight())
+				throw Exception("UploadQueue::map - The rectangle (" + toString(x) + ", " + toString(y) + ", " + toString(width) + ", " + toString(height) + ") is not inside the texture (" + toString(texture.getWidth()) + "x" + toString(texture.getHeight()) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+			if(_alignment!=1 && _alignment!=4 && _alignment!=8)
+				throw Exception("UploadQueue::map - Alignment value must be either 1, 4 or 8 (received : " + toString(_alignment) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+			const HdlTextureFormat format(width, height, _pixelFormat, _pixelDepth);
+			const size_t	rowSize	= (format.getRowSize() + static_cast<size_t>(_alignment-1)) & ~static_cast<size_t>(_alignment-1),
+					size	= rowSize * height;
+
+			// glTexSubImage2D needs an existing storage, allocate it now (before any unpack buffer is bound) :
+			texture.allocate();
+
+			position = (position + 1) % slots.size();
+			Slot& slot = *slots[position];
+
+			if(slot.buffer==NULL || slot.buffer->getSize()<static_cast<GLsizeiptr>(size))
+			{
+				delete slot.buffer;
+				slot.buffer = NULL;
+				slot.buffer = new HdlPBO(width, height, format.getNumChannels(), format.getChannelDepth(), GL_PIXEL_UNPACK_BUFFER, GL_STREAM_DRAW, size, HdlGeBO::isPersistentMappingSupported());
+			}
+			else if(slot.buffer->isPersistent())
+			{
+				// The storage of a persistent buffer cannot be orphaned, wait for the GPU if it is still reading it :
+				if(!slot.fence.isSignaled())
+					numOrphanings++;
+				slot.fence.wait();
+			}
+			else if(slot.fence.isPending() && (!HdlFence::isSupported() || !slot.fence.isSignaled()))
+			{
+				// The GPU might still be reading this buffer, give it a new storage instead of waiting :
+				slot.buffer->write(NULL);
+				numOrphanings++;
+			}
+			slot.fence.release();
+
+			void* ptr = slot.buffer->map(GL_WRITE_ONLY, GL_PIXEL_UNPACK_BUFFER);
+
+			if(ptr==NULL)
+			{
+				HdlGeBO::unbind(GL_PIXEL_UNPACK_BUFFER);
+				throw Exception("UploadQueue::map - Unable to map the buffer.", __FILE__, __LINE__, Exception::ModuleException);
+			}
+
+			mappedSlot	= position;
+			target		= &texture;
+			region[0]	= x;
+			region[1]	= y;
+			region[2]	= width;
+			region[3]	= height;
+			alignment	= _alignment;
+			pixelFormat	= HdlTextureFormatDescriptorsList::get(_pixelFormat).aliasMode;
+			pixelDepth	= _pixelDepth;
+			mappedSize	= size;
+
+			return ptr;
+		#else
+			UNUSED_PARAMETER(texture)
+			UNUSED_PARAMETER(x)
+			UNUSED_PARAMETER(y)
+			UNUSED_PARAMETER(width)
+			UNUSED_PARAMETER(height)
+			UNUSED_PARAMETER(_pixelFormat)
+			UNUSED_PARAMETER(_pixelDepth)
+			UNUSED_PARAMETER(_alignment)
+			throw Exception("UploadQueue::map - Not currently supported under GLES.", __FILE__, __LINE__, Exception::GLException);
+		#endif
+	}
+
+	/**
+	\fn size_t UploadQueue::getMappedSize(void) const
+	\return The size, in bytes, of the data expected in the mapped buffer (0 if no buffer is mapped).
+	**/
+	size_t UploadQueue::getMappedSize(void) const
+	{
+		return (mappedSlot>=0) ? mappedSize : 0;
+	}
+
+	/**
+	\fn void UploadQueue::submit(void)
+	\brief Unmap the buffer and issue the update of the texture. The function returns without waiting for the transfer.
+	**/
+	void UploadQueue::submit(void)
+	{
+		if(mappedSlot<0)
+			throw Exception("UploadQueue::submit - No buffer is mapped.", __FILE__, __LINE__, Exception::ModuleException);
+
+		Slot& slot = *slots[mappedSlot];
+		HdlTexture& texture = *target;
+
+		mappedSlot	= -1;
+		target		= NULL;
+
+		slot.buffer->bind(GL_PIXEL_UNPACK_BUFFER);
+		HdlGeBO::unmap(GL_PIXEL_UNPACK_BUFFER);
+
+		texture.bind();
+
+		// Save the current packing alignment, and replace it with the one of the data :
+		GLint originalAlignment = 0;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &originalAlignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+		glTexSubImage2D(GL_TEXTURE_2D, 0, region[0], region[1], region[2], region[3], pixelFormat, pixelDepth, NULL);
+
+		const GLenum err = glGetError();
+
+		if(err==GL_NO_ERROR && texture.getMaxLevel()>0)
+		{
+			glGenerateMipmap(GL_TEXTURE_2D);
+
+			#ifdef __GLIPLIB_TRACK_GL_ERRORS__
+				OPENGL_ERROR_TRACKER("UploadQueue::submit", "glGenerateMipmap()")
+			#endif
+		}
+
+		// Restore :
+		glPixelStorei(GL_UNPACK_ALIGNMENT, originalAlignment);
+		HdlGeBO::unbind(GL_PIXEL_UNPACK_BUFFER);
+		HdlTexture::unbind();
+
+		if(err!=GL_NO_ERROR)
+			throw Exception("UploadQueue::submit - Unable to update the texture (glTexSubImage2D). (OpenGL error : " + getGLEnumNameSafe(err) + ").", __FILE__, __LINE__, Exception::ModuleException);
+
+		// The buffer can be reused without orphaning once this fence is signaled :
+		slot.fence.insert();
+		texture.touch();
+	}
+
+	/**
+	\fn void UploadQueue::write(HdlTexture& texture, const void* data, int x, int y, int width, int height, GLenum _pixelFormat, GLenum _pixelDepth, int _alignment)
+	\brief Upload data to a rectangle of a texture (see UploadQueue::map for the parameters). The function returns once the data is copied to the buffer, without waiting for the transfer.
+	\param texture The target texture.
+	\param data The data, bottom row first.
+	\param x Left edge of the rectangle, in pixels.
+	\param y Bottom edge of the rectangle, in pixels.
+	\param width Width of the rectangle.
+	\param height Height of the rectangle.
+	\param _pixelFormat The pixel format of the data.
+	\param _pixelDepth The depth of the data.
+	\param _alignment Byte alignment of the rows of the data.
+	**/
+	void UploadQueue::write(HdlTexture& texture, const void* data, int x, int y, int width, int height, GLenum _pixelFormat, GLenum _pixelDepth, int _alignment)
+	{
+		void* ptr = map(texture, x, y, width, height, _pixelFormat, _pixelDepth, _alignment);
+		std::memcpy(ptr, data, mappedSize);
+		submit();
+	}
+
+	/**
+	\fn void UploadQueue::write(HdlTexture& texture, const ImageBuffer& image, int x, int y)
+	\brief Upload an image to a texture.
+	\param texture The target texture.
+	\param image The image, it must fit in the texture at the given position.
+	\param x Left edge of the target rectangle, in pixels.
+	\param y Bottom edge of the target rectangle, in pixels.
+	**/
+	void UploadQueue::write(HdlTexture& texture, const ImageBuffer& image, int x, int y)
+	{
+		write(texture, image.getPtr(), x, y, image.getWidth(), image.getHeight(), image.getGLMode(), image.getGLDepth(), image.getAlignment());
+	}
+
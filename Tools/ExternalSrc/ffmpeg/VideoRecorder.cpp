@@ -24,7 +24,7 @@
 	   #ifndef __USE_PBO__
 		textureReader("VideoRecorder_TextureReader", format)
 	   #else
-		textureReader("VideoRecorder_PBOTextureReader", format, GL_STREAM_READ_ARB)
+		recordFormat(format), readbackQueue(NULL)
 	   #endif
 	{
 		int retCode = 0;
@@ -206,10 +206,32 @@
 			video_outbuf_size 	= format.getSize();
 			video_outbuf 		= reinterpret_cast<uint8_t*>( av_malloc(video_outbuf_size) );
 		#endif
+
+		#ifdef __USE_PBO__
+			// Two buffers : the frame being transferred and the previous one, being encoded :
+			readbackQueue = new Modules::ReadbackQueue(2);
+		#endif
 	}
 
 	VideoRecorder::~VideoRecorder(void)
 	{
+		#ifdef __USE_PBO__
+			// The last frame is still in the queue :
+			try
+			{
+				if(readbackQueue->isValid(pendingFrame))
+					encodePendingFrame();
+			}
+			catch(std::exception& e)
+			{
+				#ifdef __VIDEO_RECORDER_VERBOSE__
+					std::cout << "VideoRecorder::~VideoRecorder - Could not encode the last frame : " << e.what() << std::endl;
+				#endif
+			}
+
+			delete readbackQueue;
+		#endif
+
 		// Write the trailer, if any. The trailer must be written before you
 		// close the CodecContexts open when you wrote the header; otherwise
 		// av_write_trailer() may try to use memory that was freed on
@@ -264,19 +286,22 @@
 
 	const __ReadOnly_HdlTextureFormat& VideoRecorder::format(void)
 	{
-		return textureReader;
+		#ifndef __USE_PBO__
+			return textureReader;
+		#else
+			return recordFormat;
+		#endif
 	}
 
 	void VideoRecorder::process(void)
 	{
-		int 		retCode = 0;
 		HdlTexture& 	texture	= in();
 
-		// Read texture :
-		textureReader << texture << OutputDevice::Process;
-
-		// Copy the texture to the buffer :
 		#ifndef __USE_PBO__
+			// Read texture :
+			textureReader << texture << OutputDevice::Process;
+
+			// Copy the texture to the buffer :
 			for(int i=0; i<textureReader.getHeight(); i++)
 			{
 				for(int j=0; j<textureReader.getWidth(); j++)
@@ -285,13 +310,38 @@
 						*(buffer->data[0] + i*textureReader.getWidth()*3 + j*3 + k) = static_cast<unsigned char>(textureReader(j,i,k)*255);
 				}
 			}
+
+			encodeFrame();
 		#else
-			unsigned char* ptr = reinterpret_cast<unsigned char*>(textureReader.startReadingMemory());
+			// Queue the readback of this frame and encode the previous one, its transfer had a whole frame to complete :
+			const Modules::ReadbackQueue::Ticket ticket = readbackQueue->read(texture);
 
-			memcpy(buffer->data[0], ptr, textureReader.getNumPixels()*3);
+			if(readbackQueue->isValid(pendingFrame))
+				encodePendingFrame();
 
-			textureReader.endReadingMemory();
+			pendingFrame = ticket;
 		#endif
+	}
+
+	#ifdef __USE_PBO__
+	void VideoRecorder::encodePendingFrame(void)
+	{
+		// Copy the texture to the buffer (RGB24, 1 byte alignment) :
+		const unsigned char* ptr = reinterpret_cast<const unsigned char*>(readbackQueue->map(pendingFrame));
+
+		memcpy(buffer->data[0], ptr, recordFormat.getNumPixels()*3);
+
+		readbackQueue->unmap();
+
+		pendingFrame = Modules::ReadbackQueue::Ticket();
+
+		encodeFrame();
+	}
+	#endif
+
+	void VideoRecorder::encodeFrame(void)
+	{
+		int retCode = 0;
 
 		// Convert from RGB24 if needed :
 		if(swsContext!=NULL)
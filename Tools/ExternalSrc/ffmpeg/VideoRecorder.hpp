@@ -21,7 +21,7 @@
 	// Display messages on std::cout :
 	//#define __VIDEO_RECORDER_VERBOSE__
 
-	// Use PBOs for uploading data to the GPU :
+	// Use PBOs for reading data from the GPU :
 	#define __USE_PBO__
 
 	#include "GLIPLib.hpp"
@@ -59,12 +59,18 @@
 
 			// From GLIP lib :
 			#ifndef __USE_PBO__
-				TextureReader		textureReader;
+				TextureReader			textureReader;
 			#else
-				PBOTextureReader	textureReader;
+				HdlTextureFormat		recordFormat;
+				Modules::ReadbackQueue		*readbackQueue;
+				Modules::ReadbackQueue::Ticket	pendingFrame;
 			#endif
 
 			 OutputDevice::OutputDeviceLayout declareLayout(void);
+			void encodeFrame(void);
+			#ifdef __USE_PBO__
+				void encodePendingFrame(void);
+			#endif
 		
 			// Inherited from OutputDevice :
 			void process(void);
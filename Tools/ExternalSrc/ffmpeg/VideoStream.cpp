@@ -25,7 +25,7 @@
 			#ifdef __VIDEO_STREAM_VERBOSE__
 				std::cout << "VideoStream::VideoStream - Using PBO for uploading data to the GPU." << std::endl;
 			#endif
-			pbo = NULL;
+			uploader = NULL;
 		#else
 			#ifdef __VIDEO_STREAM_VERBOSE__
 				std::cout << "VideoStream::VideoStream - Using standard method HdlTexture::write for uploading data to the GPU." << std::endl;
@@ -132,8 +132,8 @@
 		}
 
 		#ifdef __USE_PBO__
-			// Create PBO for uplodaing data to GPU :
-			pbo = new HdlPBO(frameFormat, GL_PIXEL_UNPACK_BUFFER_ARB,GL_STREAM_DRAW_ARB);
+			// Create the ring of PBOs for uploading data to GPU (one more than the frames buffered, the oldest is then likely consumed) :
+			uploader = new Modules::UploadQueue(numFrameBuffered+1);
 		#endif
 
 		// Finish by forcing read of first frame :
@@ -143,8 +143,7 @@
 	VideoStream::~VideoStream(void)
 	{
 		#ifdef __USE_PBO__
-			HdlPBO::unmap(GL_PIXEL_UNPACK_BUFFER_ARB);
-			delete pbo;
+			delete uploader;
 		#endif
 
 		for(std::vector<HdlTexture*>::iterator it=textureBuffers.begin(); it!=textureBuffers.end(); it++)
@@ -233,13 +232,7 @@
 						#ifndef __USE_PBO__
 							textureBuffers[idCurrentBufferForWritting]->write(pFrameRGB->data[0]);
 						#else
-							unsigned char* ptr = reinterpret_cast<unsigned char*>(pbo->map());
-
-							memcpy(ptr, pFrameRGB->data[0], textureBuffers.front()->getNumPixels()*3);
-
-							HdlPBO::unmap(GL_PIXEL_UNPACK_BUFFER_ARB);
-
-							pbo->copyToTexture(*textureBuffers[idCurrentBufferForWritting]);
+							uploader->write(*textureBuffers[idCurrentBufferForWritting], pFrameRGB->data[0], 0, 0, 0, 0, GL_RGB, GL_UNSIGNED_BYTE, 1);
 						#endif
 
 						// Change links :
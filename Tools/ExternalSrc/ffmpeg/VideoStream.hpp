@@ -52,7 +52,7 @@
 			std::vector<HdlTexture*>	textureBuffers;
 
 			#ifdef __USE_PBO__
-				HdlPBO 			*pbo;
+				Modules::UploadQueue	*uploader;
 			#endif
 
 			// Misc :
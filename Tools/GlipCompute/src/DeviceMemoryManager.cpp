@@ -75,7 +75,7 @@
 		if(it==resources.end())
 		{
 			// Copy not found, need to load it.
-			Glip::CoreGL::HdlTexture* texture = loadImage(filename);
+			Glip::CoreGL::HdlTexture* texture = loadImage(filename, uploadQueue);
 
 			if((currentMemory + texture->getSize())>maxMemory && currentMemory>0)
 				forget( maxMemory - (currentMemory + texture->getSize()) );
@@ -27,6 +27,7 @@
 										currentMemory;
 			std::map<std::string, Glip::CoreGL::HdlTexture*>	resources;
 			std::list<Glip::CoreGL::HdlTexture*>			history;
+			Glip::Modules::UploadQueue				uploadQueue;
 
 			void remember(Glip::CoreGL::HdlTexture* ptr);
 			void forget(size_t oblivionSize);
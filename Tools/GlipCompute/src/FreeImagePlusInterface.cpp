@@ -14,12 +14,14 @@
 /*                                                                                                               */
 /* ************************************************************************************************************* */
 
+#include <cstring>
+#include <algorithm>
 #include "FreeImagePlusInterface.hpp"
 
 	// To be impletemented : read Bayer data directly from RAW files.
 	// See http://sourceforge.net/p/freeimage/discussion/36110/thread/2bd2ff7f/?limit=50
 
-	Glip::CoreGL::HdlTexture* loadImage(const std::string& filename)
+	Glip::CoreGL::HdlTexture* loadImage(const std::string& filename, Glip::Modules::UploadQueue& queue)
 	{
 		fipImage inputImage;
 
@@ -81,17 +83,19 @@
 
 		Glip::CoreGL::HdlTexture* texture = new Glip::CoreGL::HdlTexture(format);
 
-		texture->write(inputImage.accessPixels(), fipMode, GL_ZERO, 4);
+		// The decoding of the next image overlaps the transfer :
+		queue.write(*texture, inputImage.accessPixels(), 0, 0, 0, 0, fipMode, GL_ZERO, 4);
 
 		return texture;
 	}
 
-	void saveImage(Glip::CoreGL::HdlTexture& texture, const std::string& filename)
+	void saveImage(Glip::Modules::ReadbackQueue& queue, const Glip::Modules::ReadbackQueue::Ticket& ticket, const std::string& filename)
 	{
-		const Glip::CoreGL::HdlTextureFormatDescriptor& descriptor = texture.getFormatDescriptor();
-		const GLenum depth = texture.getGLDepth();
+		const Glip::CoreGL::HdlTextureFormat format = queue.getFormat(ticket);
+		const Glip::CoreGL::HdlTextureFormatDescriptor& descriptor = format.getFormatDescriptor();
+		const GLenum depth = format.getGLDepth();
 
-		const int bpp = descriptor.getPixelSizeInBits(texture.getGLDepth());
+		const int bpp = descriptor.getPixelSizeInBits(depth);
 
 		// Determine the type of the output image : 
 		FREE_IMAGE_TYPE fipType = FIT_UNKNOWN;
@@ -118,33 +122,46 @@
 		if(fipType==FIT_UNKNOWN)
 			throw Glip::Exception("Could not save image to \"" + filename + "\", format is incompatible with FreeImage interface (" + Glip::toString(descriptor.numChannels) + " channels, " + Glip::getGLEnumName(depth) + " depth, " + Glip::toString(bpp) + " bits per pixel.)", __FILE__, __LINE__, Glip::Exception::ClientException);
 
-		fipImage outputImage(fipType, texture.getWidth(), texture.getHeight(), bpp);
+		fipImage outputImage(fipType, format.getWidth(), format.getHeight(), bpp);
 		
 		if(!outputImage.isValid())
 			throw Glip::Exception("Could not save image to \"" + filename + "\", format is incompatible.", __FILE__, __LINE__, Glip::Exception::ClientException);
 
-		GLenum 	fipMode	= GL_NONE;
+		bool swapRedBlue = false;
 
 		// Flip the channels : 
-		switch(texture.getGLMode())
+		switch(format.getGLMode())
 		{
 			case GL_RED:
-				fipMode = GL_RED;
-				break;
 			case GL_LUMINANCE:
-				fipMode = GL_LUMINANCE;
 				break;
 			case GL_RGB:
-				fipMode = GL_BGR;
-				break;
 			case GL_RGBA:
-				fipMode = GL_BGRA;
+				swapRedBlue = true;
 				break;
 			default : 
-				throw Glip::Exception("[INTERNAL ERROR] Cannot swap channels for type : " + Glip::CoreGL::getGLEnumName(texture.getGLMode()) + ".", __FILE__, __LINE__, Glip::Exception::ClientException);
+				throw Glip::Exception("[INTERNAL ERROR] Cannot swap channels for type : " + Glip::CoreGL::getGLEnumName(format.getGLMode()) + ".", __FILE__, __LINE__, Glip::Exception::ClientException);
+		}
+
+		// Copy the rows, the buffer has a 1 byte alignment and the scanlines of FreeImage are aligned on 4 bytes : 
+		const unsigned char* data = reinterpret_cast<const unsigned char*>(queue.map(ticket));
+		const int	pixelSize	= bpp/8,
+				channelSize	= pixelSize/descriptor.numChannels,
+				rowSize		= format.getWidth()*pixelSize;
+
+		for(int y=0; y<format.getHeight(); y++)
+		{
+			unsigned char* scanLine = reinterpret_cast<unsigned char*>(outputImage.getScanLine(y));
+			std::memcpy(scanLine, data + y*rowSize, rowSize);
+
+			if(swapRedBlue)
+			{
+				for(int x=0; x<format.getWidth(); x++)
+					std::swap_ranges(scanLine + x*pixelSize, scanLine + x*pixelSize + channelSize, scanLine + x*pixelSize + 2*channelSize);
+			}
 		}
 
-		texture.read(outputImage.accessPixels(), fipMode, GL_ZERO, 4);
+		queue.unmap();
 
 		// Save : 
 		bool test = outputImage.save(filename.c_str());
@@ -20,8 +20,8 @@
 	#include <FreeImagePlus.h>
 	#include "GLIPLib.hpp"
 
-	extern Glip::CoreGL::HdlTexture* loadImage(const std::string& filename);
-	extern void saveImage(Glip::CoreGL::HdlTexture& texture, const std::string& filename);
+	extern Glip::CoreGL::HdlTexture* loadImage(const std::string& filename, Glip::Modules::UploadQueue& queue);
+	extern void saveImage(Glip::Modules::ReadbackQueue& queue, const Glip::Modules::ReadbackQueue::Ticket& ticket, const std::string& filename);
 
 #endif
 
@@ -17,6 +17,7 @@
 // Include : 
 	#include "GlipCompute.hpp"
 	#include <unistd.h>
+	#include <algorithm>
 
 // Constants : 
 	const std::string versionString = 
@@ -74,6 +75,11 @@ Other options : \n\
 		Default is 128 MB.\n\
  -s, --preserve	Preserve the pipeline definition after its first creation.\n\
 		New inputs sizes will be ignored as required elements.\n\
+ -c, --cache	Directory in which the binaries of the programs are cached\n\
+		(must exist). This reduces the creation time of the pipeline\n\
+		on the next runs. The statistics of the cache are shown at\n\
+		the end of the processing.\n\
+		E.g. : -c ./cache\n\
  -d, --display	Name of the host, X server and display to target for the\n\
 		context.\n\
 		E.g. : -d host:xServer.screenId\n\
@@ -682,6 +688,14 @@ Link : <http://glip-lib.net/>\
 			{
 				flags = static_cast<GCFlags>(flags | ForcePreservePipeline);
 			}
+			else if(arg=="-c" || arg=="--cache")
+			{
+				it++;
+				if(it!=arguments.end())
+					Glip::CoreGL::HdlProgramCache::enable(*it);
+				else
+					RETURN_ERROR(-1, "Missing directory for argument " << arg << ".")
+			}
 			else if(arg=="-d" || arg=="--display")
 			{
 				it++;
@@ -820,6 +834,7 @@ Link : <http://glip-lib.net/>\
 		Glip::CorePipeline::Pipeline* pipeline = NULL;
 		std::vector<Glip::CoreGL::HdlTexture*> inputTextures;
 		DeviceMemoryManager* deviceMemoryManager = NULL;
+		Glip::Modules::ReadbackQueue* readbackQueue = NULL;
 
 		try
 		{
@@ -928,11 +943,26 @@ Link : <http://glip-lib.net/>\
 				// Compute :
 				(*pipeline) << Glip::CorePipeline::Pipeline::Process;
 
+				// Queue the readbacks of all the outputs first, the transfers then overlap the encoding of the images : 
+				if(readbackQueue==NULL || readbackQueue->getNumBuffers()<pipeline->getNumOutputPort())
+				{
+					delete readbackQueue;
+					readbackQueue = NULL;
+					readbackQueue = new Glip::Modules::ReadbackQueue(std::max(pipeline->getNumOutputPort(), 1));
+				}
+
+				std::vector<Glip::Modules::ReadbackQueue::Ticket> tickets(pipeline->getNumOutputPort());
+				for(int k=0; k<pipeline->getNumOutputPort(); k++)
+				{
+					if(!outputsSorted[k].empty())
+						tickets[k] = readbackQueue->read(pipeline->out(k));
+				}
+
 				// Save the outputs : 
 				for(int k=0; k<pipeline->getNumOutputPort(); k++)
 				{
 					if(!outputsSorted[k].empty())
-						saveImage(pipeline->out(k), outputsSorted[k]);
+						saveImage(*readbackQueue, tickets[k], outputsSorted[k]);
 				}
 
 				// Clean : 
@@ -946,7 +976,11 @@ Link : <http://glip-lib.net/>\
 			returnCode = -1;
 		}
 
+		if(Glip::CoreGL::HdlProgramCache::isEnabled())
+			std::cout << "Program cache : " << Glip::CoreGL::HdlProgramCache::getNumHits() << " hit(s), " << Glip::CoreGL::HdlProgramCache::getNumMisses() << " miss(es), " << Glip::CoreGL::HdlProgramCache::getNumRejected() << " rejected, " << Glip::CoreGL::HdlProgramCache::getNumStored() << " stored." << std::endl;
+
 		delete deviceMemoryManager;
+		delete readbackQueue;
 		delete pipeline;
 		pipeline = NULL;
 